@@ -99,9 +99,19 @@ typedef struct {
 unsigned long 	ulGetEMACRxData( void );
 
 /*
- * Send usTxDataLen bytes from uip_buf.
+ * Queue usTxDataLen bytes from uip_buf for transmission and give uip_buf a new
+ * buffer.  Does not block.  Returns pdFAIL, without sending the frame, if the
+ * Tx ring is full.
  */
-void vSendEMACTxData( unsigned short usTxDataLen );
+long lSendEMACTxData( unsigned short usTxDataLen );
+
+/*
+ * Wait up to xTicksToWait for the EMAC to finish sending a frame and for its
+ * Tx descriptor to be reclaimed.  Returns pdPASS if a descriptor was reclaimed
+ * since the last call, or pdFAIL if the wait timed out.  Call it with a block
+ * time of 0 to discard a reclaim that nothing was waiting for.
+ */
+long lEMACWaitForTxSpace( portTickType xTicksToWait );
 
 /*
  * Prepare the Ethernet hardware ready for TCP/IP comms.
@@ -25,8 +25,8 @@
 #include <stdint.h>
 
 /* EMAC Memory Buffer configuration for 16K Ethernet RAM. */
-#define NUM_RX_FRAG         3           /* Num.of RX Fragments. */
-#define NUM_TX_FRAG         2           /* Num.of TX Fragments. */
+#define NUM_RX_FRAG         6           /* Num.of RX Fragments. */
+#define NUM_TX_FRAG         4           /* Num.of TX Fragments. */
 #define ETH_FRAG_SIZE       1536        /* Packet Fragment size 1536 Bytes   */
 
 #define ETH_MAX_FLEN        1536        /* Max. Ethernet Frame Size          */
@@ -68,7 +68,7 @@ typedef struct {                        /* TX Status struct                  */
 #define TX_DESC_CTRL(i)     (*(unsigned int *)(TX_DESC_BASE+4 + 8*i))
 #define TX_STAT_INFO(i)     (*(unsigned int *)(TX_STAT_BASE   + 4*i))
 #define ETH_BUF(i)          ( ETH_BUF_BASE + ETH_FRAG_SIZE*i )
-#define ETH_NUM_BUFFERS		( NUM_TX_FRAG + NUM_RX_FRAG + 1 ) /* There are in fact 2 more buffers than descriptors as the two Tx descriptors use the same buffer to speed up the uip Tx. */
+#define ETH_NUM_BUFFERS		( NUM_TX_FRAG + NUM_RX_FRAG ) /* One buffer per Rx descriptor, one for uip_buf, and one per frame in the Tx ring - which holds at most NUM_TX_FRAG - 1.  The descriptors and buffers must fit in the 16K of AHB SRAM bank 1. */
 
 
 /* MAC Configuration Register 1 */
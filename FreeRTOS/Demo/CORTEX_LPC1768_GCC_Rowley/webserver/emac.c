@@ -57,6 +57,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
+#include "timers.h"
 
 /* Hardware specific includes. */
 #include "EthDev_LPC17xx.h"
@@ -73,15 +74,15 @@
 #define emac10BASE_T_MODE			( 0x0002 )
 #define emacPINSEL2_VALUE			( 0x50150105 )
 
-/* If no buffers are available, then wait this long before looking again.... */
-#define emacBUFFER_WAIT_DELAY	( 3 / portTICK_RATE_MS )
+/* The free buffer list can hold every buffer, plus the one unused position
+that tells a full list apart from an empty one. */
+#define emacFREE_LIST_LENGTH		( ETH_NUM_BUFFERS + 1 )
 
-/* ...and don't look more than this many times. */
-#define emacBUFFER_WAIT_ATTEMPTS	( 30 )
+/* Move a free buffer list index on by one, wrapping at the end of the list. */
+#define emacNEXT_FREE_INDEX( ulIndex )	( ( ( ulIndex ) + 1UL ) % ( unsigned long ) emacFREE_LIST_LENGTH )
 
-/* Index to the Tx descriptor that is always used first for every Tx.  The second
-descriptor is then used to re-send in order to speed up the uIP Tx process. */
-#define emacTX_DESC_INDEX			( 0 )
+/* Move a Tx descriptor index on by one, wrapping at the end of the ring. */
+#define emacNEXT_TX_INDEX( ulIndex )	( ( ( ulIndex ) + 1UL ) % ( unsigned long ) NUM_TX_FRAG )
 
 /*-----------------------------------------------------------*/
 
@@ -107,16 +108,28 @@ static void prvConfigurePHY( void );
 static long prvSetupLinkStatus( void );
 
 /*
- * Search the pool of buffers to find one that is free.  If a buffer is found
- * mark it as in use before returning its address.
+ * Take a buffer from the free buffer list.  Returns NULL if the list is empty.
+ * Only called by the uIP task.
  */
 static unsigned char *prvGetNextBuffer( void );
 
 /*
- * Return an allocated buffer to the pool of free buffers.
+ * Put a buffer back on the free buffer list.  Only called when reclaiming Tx
+ * descriptors, which is serialised by prvReclaimTxDescriptors().
  */
 static void prvReturnBuffer( unsigned char *pucBuffer );
 
+/*
+ * Return the buffers of the Tx descriptors the EMAC has finished sending to
+ * the pool, freeing the descriptors for reuse.  prvReclaimTxDescriptors() is
+ * pended to the timer service task by the EMAC interrupt, and calls
+ * prvReclaimSentTxDescriptors() from within a critical section.  The
+ * interrupt calls prvReclaimSentTxDescriptors() directly if the call cannot be
+ * pended.
+ */
+static void prvReclaimTxDescriptors( void *pvParameter1, unsigned long ulParameter2 );
+static void prvReclaimSentTxDescriptors( void );
+
 /*
  * Send lValue to the lPhyReg within the PHY.
  */
@@ -130,21 +143,36 @@ static unsigned short prvReadPHY( unsigned char ucPhyReg, long *plStatus );
 
 /*-----------------------------------------------------------*/
 
-/* The semaphore used to wake the uIP task when data arrives. */
+/* The semaphore used to wake the uIP task when data arrives.  It is a member
+of the queue set the uIP task blocks on. */
 extern xSemaphoreHandle xEMACSemaphore;
 
-/* Each ucBufferInUse index corresponds to a position in the pool of buffers.
-If the index contains a 1 then the buffer within pool is in use, if it
-contains a 0 then the buffer is free. */
-static unsigned char ucBufferInUse[ ETH_NUM_BUFFERS ] = { pdFALSE };
+/* The buffers not held by a descriptor or by uip_buf.  Buffers are only ever
+taken from the list by the uIP task, and only ever put back when Tx
+descriptors are reclaimed, so the list is a ring with one writer at each end.
+Each index is only written by its own end, so neither end needs a critical
+section.  The Rx path does not use the list at all - see ulGetEMACRxData(). */
+static unsigned char *pucFreeBuffers[ emacFREE_LIST_LENGTH ];
+static volatile unsigned long ulFreeBuffersHead = 0;	/* Next position to put a returned buffer. */
+static volatile unsigned long ulFreeBuffersTail = 0;	/* Next position to take a buffer from. */
 
 /* The uip_buffer is not a fixed array, but instead gets pointed to the buffers
 allocated within this file. */
 unsigned char * uip_buf;
 
-/* Store the length of the data being sent so the data can be sent twice.  The
-value will be set back to 0 once the data has been sent twice. */
-static unsigned short usSendLen = 0;
+/* The Tx descriptors from ulTxReclaimIndex up to, but not including,
+EMAC->TxProduceIndex hold frames that are queued or have been sent but whose
+buffers have not yet been returned to the pool.  One descriptor is always left
+unused so a full ring can be told apart from an empty one. */
+static volatile unsigned long ulTxReclaimIndex = 0;
+
+/* Set while a call to prvReclaimTxDescriptors() is pending, so the interrupt
+does not post another for every frame. */
+static volatile long lTxReclaimPending = pdFALSE;
+
+/* Given each time Tx descriptors are reclaimed, so the uIP task can wait for
+space in the ring when it is full - see lEMACWaitForTxSpace(). */
+static xSemaphoreHandle xTxReclaimedSemaphore = NULL;
 
 /*-----------------------------------------------------------*/
 
@@ -153,6 +181,14 @@ long lEMACInit( void )
 long lReturn = pdPASS;
 unsigned long ulID1, ulID2;
 
+	/* lEMACInit() is called again if it fails, so only create the semaphore
+	the first time. */
+	if( xTxReclaimedSemaphore == NULL )
+	{
+		vSemaphoreCreateBinary( xTxReclaimedSemaphore );
+		xSemaphoreTake( xTxReclaimedSemaphore, 0 );
+	}
+
 	/* Reset peripherals, configure port pins and registers. */
 	prvSetupEMACHardware();
 
@@ -205,37 +241,13 @@ unsigned long ulID1, ulID2;
 
 static unsigned char *prvGetNextBuffer( void )
 {
-long x;
 unsigned char *pucReturn = NULL;
-unsigned long ulAttempts = 0;
+unsigned long ulTail = ulFreeBuffersTail;
 
-	while( pucReturn == NULL )
+	if( ulTail != ulFreeBuffersHead )
 	{
-		/* Look through the buffers to find one that is not in use by
-		anything else. */
-		for( x = 0; x < ETH_NUM_BUFFERS; x++ )
-		{
-			if( ucBufferInUse[ x ] == pdFALSE )
-			{
-				ucBufferInUse[ x ] = pdTRUE;
-				pucReturn = ( unsigned char * ) ETH_BUF( x );
-				break;
-			}
-		}
-
-		/* Was a buffer found? */
-		if( pucReturn == NULL )
-		{
-			ulAttempts++;
-
-			if( ulAttempts >= emacBUFFER_WAIT_ATTEMPTS )
-			{
-				break;
-			}
-
-			/* Wait then look again. */
-			vTaskDelay( emacBUFFER_WAIT_DELAY );
-		}
+		pucReturn = pucFreeBuffers[ ulTail ];
+		ulFreeBuffersTail = emacNEXT_FREE_INDEX( ulTail );
 	}
 
 	return pucReturn;
@@ -253,9 +265,15 @@ long x, lNextBuffer = 0;
 		RX_DESC_CTRL( x ) = RCTRL_INT | ( ETH_FRAG_SIZE - 1 );
 		RX_STAT_INFO( x ) = 0;
 		RX_STAT_HASHCRC( x ) = 0;
+		lNextBuffer++;
+	}
 
-		/* The Ethernet buffer is now in use. */
-		ucBufferInUse[ lNextBuffer ] = pdTRUE;
+	/* The remaining buffers start on the free list. */
+	ulFreeBuffersHead = 0;
+	ulFreeBuffersTail = 0;
+	while( lNextBuffer < ETH_NUM_BUFFERS )
+	{
+		prvReturnBuffer( ( unsigned char * ) ETH_BUF( lNextBuffer ) );
 		lNextBuffer++;
 	}
 
@@ -283,6 +301,7 @@ long x, lNextBuffer = 0;
 
 	/* Tx Descriptors Point to 0 */
 	EMAC->TxProduceIndex = 0;
+	ulTxReclaimIndex = 0;
 }
 /*-----------------------------------------------------------*/
 
@@ -418,17 +437,49 @@ unsigned short usLinkStatus;
 
 static void prvReturnBuffer( unsigned char *pucBuffer )
 {
-unsigned long ul;
+unsigned long ulHead = ulFreeBuffersHead;
+
+	/* The buffer is stored before the head is moved on, so the uIP task never
+	sees the position until it is valid. */
+	pucFreeBuffers[ ulHead ] = pucBuffer;
+	ulFreeBuffersHead = emacNEXT_FREE_INDEX( ulHead );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReclaimSentTxDescriptors( void )
+{
+unsigned long ulIndex = ulTxReclaimIndex;
 
-	/* Return a buffer to the pool of free buffers. */
-	for( ul = 0; ul < ETH_NUM_BUFFERS; ul++ )
+	/* The EMAC has finished with every descriptor before its consume
+	index. */
+	while( ulIndex != EMAC->TxConsumeIndex )
 	{
-		if( ETH_BUF( ul ) == ( unsigned long ) pucBuffer )
-		{
-			ucBufferInUse[ ul ] = pdFALSE;
-			break;
-		}
+		prvReturnBuffer( ( unsigned char * ) TX_DESC_PACKET( ulIndex ) );
+		TX_DESC_PACKET( ulIndex ) = ( unsigned long ) NULL;
+		ulIndex = emacNEXT_TX_INDEX( ulIndex );
+	}
+
+	/* lSendEMACTxData() can now reuse the descriptors. */
+	ulTxReclaimIndex = ulIndex;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReclaimTxDescriptors( void *pvParameter1, unsigned long ulParameter2 )
+{
+	( void ) pvParameter1;
+	( void ) ulParameter2;
+
+	/* The interrupt reclaims descriptors itself if it cannot pend this
+	function, so must not run while this is part way through. */
+	taskENTER_CRITICAL();
+	{
+		lTxReclaimPending = pdFALSE;
+		prvReclaimSentTxDescriptors();
 	}
+	taskEXIT_CRITICAL();
+
+	/* Wake the uIP task if it is waiting for space in the ring. */
+	xSemaphoreGive( xTxReclaimedSemaphore );
 }
 /*-----------------------------------------------------------*/
 
@@ -436,23 +487,23 @@ unsigned long ulGetEMACRxData( void )
 {
 unsigned long ulLen = 0;
 long lIndex;
+unsigned char *pucReceived;
 
 	if( EMAC->RxProduceIndex != EMAC->RxConsumeIndex )
 	{
-		/* Mark the current buffer as free as uip_buf is going to be set to
-		the buffer that contains the received data. */
-		prvReturnBuffer( uip_buf );
-
-		ulLen = ( RX_STAT_INFO( EMAC->RxConsumeIndex ) & RINFO_SIZE ) - 3;
-		uip_buf = ( unsigned char * ) RX_DESC_PACKET( EMAC->RxConsumeIndex );
+		lIndex = EMAC->RxConsumeIndex;
+		ulLen = ( RX_STAT_INFO( lIndex ) & RINFO_SIZE ) - 3;
 
-		/* Allocate a new buffer to the descriptor. */
-        RX_DESC_PACKET( EMAC->RxConsumeIndex ) = ( unsigned long ) prvGetNextBuffer();
+		/* uip_buf is set to the buffer that contains the received data, and
+		the buffer uip_buf pointed to is given to the descriptor in its place.
+		Swapping the two means receiving never has to wait for, or search
+		for, a free buffer. */
+		pucReceived = ( unsigned char * ) RX_DESC_PACKET( lIndex );
+		RX_DESC_PACKET( lIndex ) = ( unsigned long ) uip_buf;
+		uip_buf = pucReceived;
 
 		/* Move the consume index onto the next position, ensuring it wraps to
 		the beginning at the appropriate place. */
-		lIndex = EMAC->RxConsumeIndex;
-
 		lIndex++;
 		if( lIndex >= NUM_RX_FRAG )
 		{
@@ -466,38 +517,40 @@ long lIndex;
 }
 /*-----------------------------------------------------------*/
 
-void vSendEMACTxData( unsigned short usTxDataLen )
+long lSendEMACTxData( unsigned short usTxDataLen )
 {
-unsigned long ulAttempts = 0UL;
-
-	/* Check to see if the Tx descriptor is free, indicated by its buffer being
-	NULL. */
-	while( TX_DESC_PACKET( emacTX_DESC_INDEX ) != ( unsigned long ) NULL )
+unsigned long ulProduceIndex, ulNextIndex;
+long lReturn = pdFAIL;
+
+	ulProduceIndex = EMAC->TxProduceIndex;
+	ulNextIndex = emacNEXT_TX_INDEX( ulProduceIndex );
+
+	/* Is there a free descriptor, and a buffer to replace uip_buf with?  If
+	not pdFAIL is returned rather than waiting - the caller can wait with
+	lEMACWaitForTxSpace() and try again.  There is a buffer for every
+	descriptor in the ring, so the second test only guards against uip_buf
+	ever being left NULL. */
+	if( ( ulNextIndex != ulTxReclaimIndex ) && ( ulFreeBuffersTail != ulFreeBuffersHead ) )
 	{
-		/* Wait for the Tx descriptor to become available. */
-		vTaskDelay( emacBUFFER_WAIT_DELAY );
-
-		ulAttempts++;
-		if( ulAttempts > emacBUFFER_WAIT_ATTEMPTS )
-		{
-			/* Something has gone wrong as the Tx descriptor is still in use.
-			Clear it down manually, the data it was sending will probably be
-			lost. */
-			prvReturnBuffer( ( unsigned char * ) TX_DESC_PACKET( emacTX_DESC_INDEX ) );
-			break;
-		}
+		/* Setup the Tx descriptor for transmission, then pass it to the EMAC
+		by moving the produce index on.  Frames already in the ring continue
+		to be sent in the meantime. */
+		TX_DESC_PACKET( ulProduceIndex ) = ( unsigned long ) uip_buf;
+		TX_DESC_CTRL( ulProduceIndex ) = ( usTxDataLen | TCTRL_LAST | TCTRL_INT );
+		EMAC->TxProduceIndex = ulNextIndex;
+
+		/* uip_buf is being sent by the Tx descriptor.  Allocate a new buffer. */
+		uip_buf = prvGetNextBuffer();
+		lReturn = pdPASS;
 	}
 
-	/* Setup the Tx descriptor for transmission.  Remember the length of the
-	data being sent so the second descriptor can be used to send it again from
-	within the ISR. */
-	usSendLen = usTxDataLen;
-	TX_DESC_PACKET( emacTX_DESC_INDEX ) = ( unsigned long ) uip_buf;
-	TX_DESC_CTRL( emacTX_DESC_INDEX ) = ( usTxDataLen | TCTRL_LAST | TCTRL_INT );
-	EMAC->TxProduceIndex = ( emacTX_DESC_INDEX + 1 );
+	return lReturn;
+}
+/*-----------------------------------------------------------*/
 
-	/* uip_buf is being sent by the Tx descriptor.  Allocate a new buffer. */
-	uip_buf = prvGetNextBuffer();
+long lEMACWaitForTxSpace( portTickType xTicksToWait )
+{
+	return xSemaphoreTake( xTxReclaimedSemaphore, xTicksToWait );
 }
 /*-----------------------------------------------------------*/
 
@@ -567,6 +620,7 @@ void vEMAC_ISR( void )
 unsigned long ulStatus;
 long lHigherPriorityTaskWoken = pdFALSE;
 
+	traceISR_ENTER( vtTraceIsrEMAC );
 	ulStatus = EMAC->IntStatus;
 
 	/* Clear the interrupt. */
@@ -580,25 +634,25 @@ long lHigherPriorityTaskWoken = pdFALSE;
 
 	if( ulStatus & INT_TX_DONE )
 	{
-		if( usSendLen > 0 )
+		/* One or more frames have been sent.  Returning their buffers to the
+		pool is left to the timer service task, which runs as soon as the
+		interrupt exits.  A single pended call reclaims every descriptor
+		sent by the time it runs.  If the request cannot be posted the
+		buffers are returned here instead. */
+		if( lTxReclaimPending == pdFALSE )
 		{
-			/* Send the data again, using the second descriptor.  As there are
-			only two descriptors the index is set back to 0. */
-			TX_DESC_PACKET( ( emacTX_DESC_INDEX + 1 ) ) = TX_DESC_PACKET( emacTX_DESC_INDEX );
-			TX_DESC_CTRL( ( emacTX_DESC_INDEX + 1 ) ) = ( usSendLen | TCTRL_LAST | TCTRL_INT );
-			EMAC->TxProduceIndex = ( emacTX_DESC_INDEX );
-
-			/* This is the second Tx so set usSendLen to 0 to indicate that the
-			Tx descriptors will be free again. */
-			usSendLen = 0UL;
-		}
-		else
-		{
-			/* The Tx buffer is no longer required. */
-			prvReturnBuffer( ( unsigned char * ) TX_DESC_PACKET( emacTX_DESC_INDEX ) );
-            TX_DESC_PACKET( emacTX_DESC_INDEX ) = ( unsigned long ) NULL;
+			if( xTimerPendFunctionCallFromISR( prvReclaimTxDescriptors, NULL, 0UL, &lHigherPriorityTaskWoken ) == pdPASS )
+			{
+				lTxReclaimPending = pdTRUE;
+			}
+			else
+			{
+				prvReclaimSentTxDescriptors();
+				xSemaphoreGiveFromISR( xTxReclaimedSemaphore, &lHigherPriorityTaskWoken );
+			}
 		}
 	}
 
+	traceISR_EXIT( vtTraceIsrEMAC );
 	portEND_SWITCHING_ISR( lHigherPriorityTaskWoken );
 }
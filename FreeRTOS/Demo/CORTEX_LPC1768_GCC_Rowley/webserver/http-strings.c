@@ -73,6 +73,9 @@ const char http_content_type_jpg [29] =
 const char http_content_type_binary[43] = 
 /* "Content-type: application/octet-stream\r\n\r\n" */
 {0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x74, 0x79, 0x70, 0x65, 0x3a, 0x20, 0x61, 0x70, 0x70, 0x6c, 0x69, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2f, 0x6f, 0x63, 0x74, 0x65, 0x74, 0x2d, 0x73, 0x74, 0x72, 0x65, 0x61, 0x6d, 0xd, 0xa, 0xd, 0xa, };
+const char http_content_type_json[35] = 
+/* "Content-type: application/json\r\n\r\n" */
+{0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x74, 0x79, 0x70, 0x65, 0x3a, 0x20, 0x61, 0x70, 0x70, 0x6c, 0x69, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2f, 0x6a, 0x73, 0x6f, 0x6e, 0xd, 0xa, 0xd, 0xa, };
 const char http_html[6] = 
 /* ".html" */
 {0x2e, 0x68, 0x74, 0x6d, 0x6c, };
@@ -100,3 +103,6 @@ const char http_text[5] =
 const char http_txt[5] = 
 /* ".txt" */
 {0x2e, 0x74, 0x78, 0x74, };
+const char http_json[6] = 
+/* ".json" */
+{0x2e, 0x6a, 0x73, 0x6f, 0x6e, };
@@ -23,6 +23,7 @@ extern const char http_content_type_png [28];
 extern const char http_content_type_gif [28];
 extern const char http_content_type_jpg [29];
 extern const char http_content_type_binary[43];
+extern const char http_content_type_json[35];
 extern const char http_html[6];
 extern const char http_shtml[7];
 extern const char http_htm[5];
@@ -32,3 +33,4 @@ extern const char http_gif[5];
 extern const char http_jpg[5];
 extern const char http_text[5];
 extern const char http_txt[5];
+extern const char http_json[6];
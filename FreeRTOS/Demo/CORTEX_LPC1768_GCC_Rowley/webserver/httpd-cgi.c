@@ -54,15 +54,23 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* For MALLOC_VERSION, which selects the heap implementation. */
+#include "vtUtilities.h"
+
 HTTPD_CGI_CALL(file, "file-stats", file_stats);
 HTTPD_CGI_CALL(tcp, "tcp-connections", tcp_stats);
 HTTPD_CGI_CALL(net, "net-stats", net_stats);
 HTTPD_CGI_CALL(rtos, "rtos-stats", rtos_stats );
 HTTPD_CGI_CALL(run, "run-time", run_time );
 HTTPD_CGI_CALL(io, "led-io", led_io );
+HTTPD_CGI_CALL(json, "json-stats", json_stats );
 
 
-static const struct httpd_cgi_call *calls[] = { &file, &tcp, &net, &rtos, &run, &io, NULL };
+static const struct httpd_cgi_call *calls[] = { &file, &tcp, &net, &rtos, &run, &io, &json, NULL };
 
 /*---------------------------------------------------------------------------*/
 static
@@ -294,6 +302,344 @@ static PT_THREAD(led_io(struct httpd_state *s, char *ptr))
   PSOCK_GENERATOR_SEND(&s->sout, generate_io_state, NULL);
   PSOCK_END(&s->sout);
 }
+/*---------------------------------------------------------------------------*/
+
+/* The most tasks /stats.json can report. */
+#define httpdJSON_MAX_TASKS		16
+
+/* Everything /stats.json reports is copied here when a request starts, and the
+generators below only format the copy.  uIP calls a generator again when a
+segment has to be retransmitted, and it must produce exactly the same bytes,
+so the live values cannot be used.  The copy is shared by all connections, so
+it belongs to one response at a time - json_owner - from when it is taken until
+that response has been acknowledged or its connection has gone.  A second
+request waits for it rather than refreshing it under the first. */
+static struct httpd_state *json_owner = NULL;
+
+#if configUSE_TRACE_FACILITY == 1
+static xTaskStatusType xJsonTasks[ httpdJSON_MAX_TASKS ];
+#endif
+static unsigned portBASE_TYPE uxJsonTaskCount;
+static unsigned long long ullJsonTotalRunTime;
+static unsigned portBASE_TYPE uxJsonIdlePercent;
+static portTickType xJsonTickCount;
+
+#if configQUEUE_REGISTRY_SIZE > 0
+typedef struct JSON_QUEUE
+{
+	signed char *pcName;
+	unsigned portBASE_TYPE uxWaiting;
+	unsigned portBASE_TYPE uxLength;
+} xJsonQueue;
+
+static xJsonQueue xJsonQueues[ configQUEUE_REGISTRY_SIZE ];
+static unsigned portBASE_TYPE uxJsonQueueCount;
+#endif
+
+#if MALLOC_VERSION == 3
+#define httpdJSON_MAX_POOLS		8
+static xHeapPoolStats xJsonPools[ httpdJSON_MAX_POOLS ];
+static unsigned portBASE_TYPE uxJsonPoolCount;
+#endif
+#if MALLOC_VERSION == 4
+static xHeapStats xJsonHeap;
+#endif
+#if MALLOC_VERSION == 2 || MALLOC_VERSION == 3
+static size_t xJsonFreeHeap;
+#endif
+
+#if UIP_STATISTICS
+static struct uip_stats xJsonUipStats;
+#endif
+
+static const char * const pcJsonTaskStates[] = { "running", "ready", "blocked", "suspended", "deleted" };
+
+/* Copy a name into a JSON string, escaping anything that would end it early.
+Returns the number of characters written. */
+static int json_copy_string( char *pcOut, const signed char *pcIn )
+{
+char *pcStart = pcOut;
+
+	*pcOut++ = '"';
+	while( *pcIn != 0x00 )
+	{
+		if( ( *pcIn == '"' ) || ( *pcIn == '\\' ) )
+		{
+			*pcOut++ = '\\';
+			*pcOut++ = ( char ) *pcIn;
+		}
+		else if( *pcIn >= ' ' )
+		{
+			*pcOut++ = ( char ) *pcIn;
+		}
+		pcIn++;
+	}
+	*pcOut++ = '"';
+	*pcOut = 0x00;
+
+	return ( int ) ( pcOut - pcStart );
+}
+
+/* Write a 64 bit count in decimal.  The printf() used on the target does not
+support long long, so the count is written as two nine digit halves. */
+static int json_copy_u64( char *pcOut, unsigned long long ullValue )
+{
+unsigned long ulHigh, ulLow;
+
+	ulHigh = ( unsigned long ) ( ullValue / 1000000000ULL );
+	ulLow = ( unsigned long ) ( ullValue % 1000000000ULL );
+
+	if( ulHigh > 0UL )
+	{
+		return sprintf( pcOut, "%u%09u", ( unsigned int ) ulHigh, ( unsigned int ) ulLow );
+	}
+
+	return sprintf( pcOut, "%u", ( unsigned int ) ulLow );
+}
+
+static void json_take_snapshot( void )
+{
+#if configQUEUE_REGISTRY_SIZE > 0
+unsigned portBASE_TYPE ux;
+xQueueHandle xQueue;
+signed char *pcName;
+#endif
+
+	xJsonTickCount = xTaskGetTickCount();
+
+	#if configUSE_TRACE_FACILITY == 1
+		uxJsonTaskCount = uxTaskGetSystemState( xJsonTasks, httpdJSON_MAX_TASKS, &ullJsonTotalRunTime );
+	#else
+		uxJsonTaskCount = 0;
+		ullJsonTotalRunTime = 0ULL;
+	#endif
+
+	#if configGENERATE_RUN_TIME_STATS == 1
+		uxJsonIdlePercent = uxTaskGetIdleRunTimePercent();
+	#else
+		uxJsonIdlePercent = 0;
+	#endif
+
+	#if configQUEUE_REGISTRY_SIZE > 0
+		uxJsonQueueCount = 0;
+		for( ux = 0; ux < configQUEUE_REGISTRY_SIZE; ux++ )
+		{
+			if( xQueueGetRegistryEntry( ux, &pcName, &xQueue ) == pdTRUE )
+			{
+				xJsonQueues[ uxJsonQueueCount ].pcName = pcName;
+				xJsonQueues[ uxJsonQueueCount ].uxWaiting = uxQueueMessagesWaiting( xQueue );
+				xJsonQueues[ uxJsonQueueCount ].uxLength = uxQueueGetLength( xQueue );
+				uxJsonQueueCount++;
+			}
+		}
+	#endif
+
+	#if MALLOC_VERSION == 2
+		xJsonFreeHeap = xPortGetFreeHeapSize();
+	#elif MALLOC_VERSION == 3
+		xJsonFreeHeap = xPortGetFreeHeapSize();
+		for( uxJsonPoolCount = 0; uxJsonPoolCount < httpdJSON_MAX_POOLS; uxJsonPoolCount++ )
+		{
+			if( xPortGetHeapPoolStats( uxJsonPoolCount, &( xJsonPools[ uxJsonPoolCount ] ) ) != pdPASS )
+			{
+				break;
+			}
+		}
+	#elif MALLOC_VERSION == 4
+		vPortGetHeapStats( &xJsonHeap );
+	#endif
+
+	#if UIP_STATISTICS
+		memcpy( &xJsonUipStats, &uip_stat, sizeof( xJsonUipStats ) );
+	#endif
+}
+/*---------------------------------------------------------------------------*/
+
+static unsigned short
+generate_json_head(void *arg)
+{
+char *pcOut = ( char * ) uip_appdata;
+
+	( void ) arg;
+	pcOut += sprintf( pcOut, "{\"tick\":%u,\"tick_hz\":%u,\"cpu_idle\":%u,\"total_run_time\":", ( unsigned int ) xJsonTickCount, ( unsigned int ) configTICK_RATE_HZ, ( unsigned int ) uxJsonIdlePercent );
+	pcOut += json_copy_u64( pcOut, ullJsonTotalRunTime );
+	pcOut += sprintf( pcOut, ",\"tasks\":[" );
+
+	return ( unsigned short ) ( pcOut - ( char * ) uip_appdata );
+}
+/*---------------------------------------------------------------------------*/
+
+#if configUSE_TRACE_FACILITY == 1
+static unsigned short
+generate_json_task(void *arg)
+{
+struct httpd_state *s = ( struct httpd_state * ) arg;
+xTaskStatusType *pxTask = &( xJsonTasks[ s->count ] );
+char *pcOut = ( char * ) uip_appdata;
+
+	pcOut += sprintf( pcOut, "%s{\"name\":", ( s->count == 0 ) ? "" : "," );
+	pcOut += json_copy_string( pcOut, pxTask->pcTaskName );
+	pcOut += sprintf( pcOut, ",\"number\":%u,\"state\":\"%s\",\"priority\":%u,\"base_priority\":%u,\"stack_free\":%u,\"run_time\":",
+		( unsigned int ) pxTask->xTaskNumber, pcJsonTaskStates[ pxTask->eCurrentState ], ( unsigned int ) pxTask->uxCurrentPriority,
+		( unsigned int ) pxTask->uxBasePriority, ( unsigned int ) pxTask->usStackHighWaterMark );
+	pcOut += json_copy_u64( pcOut, pxTask->ullRunTimeCounter );
+	pcOut += sprintf( pcOut, "}" );
+
+	return ( unsigned short ) ( pcOut - ( char * ) uip_appdata );
+}
+#endif
+/*---------------------------------------------------------------------------*/
+
+static unsigned short
+generate_json_queues_head(void *arg)
+{
+	( void ) arg;
+	return ( unsigned short ) sprintf( ( char * ) uip_appdata, "],\"queues\":[" );
+}
+/*---------------------------------------------------------------------------*/
+
+#if configQUEUE_REGISTRY_SIZE > 0
+static unsigned short
+generate_json_queue(void *arg)
+{
+struct httpd_state *s = ( struct httpd_state * ) arg;
+xJsonQueue *pxQueue = &( xJsonQueues[ s->count ] );
+char *pcOut = ( char * ) uip_appdata;
+
+	pcOut += sprintf( pcOut, "%s{\"name\":", ( s->count == 0 ) ? "" : "," );
+	pcOut += json_copy_string( pcOut, pxQueue->pcName );
+	pcOut += sprintf( pcOut, ",\"waiting\":%u,\"length\":%u}", ( unsigned int ) pxQueue->uxWaiting, ( unsigned int ) pxQueue->uxLength );
+
+	return ( unsigned short ) ( pcOut - ( char * ) uip_appdata );
+}
+#endif
+/*---------------------------------------------------------------------------*/
+
+static unsigned short
+generate_json_heap(void *arg)
+{
+char *pcOut = ( char * ) uip_appdata;
+
+	( void ) arg;
+
+	#if MALLOC_VERSION == 1
+		/* The C library heap does not report its usage. */
+		pcOut += sprintf( pcOut, "],\"heap\":{\"allocator\":\"heap_3\"" );
+	#elif MALLOC_VERSION == 2
+		pcOut += sprintf( pcOut, "],\"heap\":{\"allocator\":\"heap_2\",\"free\":%u", ( unsigned int ) xJsonFreeHeap );
+	#elif MALLOC_VERSION == 3
+		pcOut += sprintf( pcOut, "],\"heap\":{\"allocator\":\"heap_4\",\"free\":%u,\"pools\":[", ( unsigned int ) xJsonFreeHeap );
+	#elif MALLOC_VERSION == 4
+		pcOut += sprintf( pcOut, "],\"heap\":{\"allocator\":\"heap_5\",\"free\":%u,\"min_free\":%u,\"largest_block\":%u,\"smallest_block\":%u,\"free_blocks\":%u",
+			( unsigned int ) xJsonHeap.xAvailableHeapSpaceInBytes, ( unsigned int ) xJsonHeap.xMinimumEverFreeBytesRemaining,
+			( unsigned int ) xJsonHeap.xSizeOfLargestFreeBlockInBytes, ( unsigned int ) xJsonHeap.xSizeOfSmallestFreeBlockInBytes,
+			( unsigned int ) xJsonHeap.uxNumberOfFreeBlocks );
+	#endif
+
+	return ( unsigned short ) ( pcOut - ( char * ) uip_appdata );
+}
+/*---------------------------------------------------------------------------*/
+
+#if MALLOC_VERSION == 3
+static unsigned short
+generate_json_pool(void *arg)
+{
+struct httpd_state *s = ( struct httpd_state * ) arg;
+xHeapPoolStats *pxPool = &( xJsonPools[ s->count ] );
+
+	return ( unsigned short ) sprintf( ( char * ) uip_appdata, "%s{\"block_size\":%u,\"blocks\":%u,\"free\":%u,\"min_free\":%u,\"allocations\":%u,\"overflows\":%u}%s",
+		( s->count == 0 ) ? "" : ",", ( unsigned int ) pxPool->xBlockSize, ( unsigned int ) pxPool->uxTotalBlocks,
+		( unsigned int ) pxPool->uxFreeBlocks, ( unsigned int ) pxPool->uxMinimumEverFreeBlocks,
+		( unsigned int ) pxPool->ulAllocations, ( unsigned int ) pxPool->ulOverflows,
+		( s->count == ( uxJsonPoolCount - 1 ) ) ? "]" : "" );
+}
+#endif
+/*---------------------------------------------------------------------------*/
+
+static unsigned short
+generate_json_tail(void *arg)
+{
+char *pcOut = ( char * ) uip_appdata;
+
+	( void ) arg;
+
+	#if MALLOC_VERSION == 3
+		if( uxJsonPoolCount == 0 )
+		{
+			/* No pools were listed, so the array is still open. */
+			pcOut += sprintf( pcOut, "]" );
+		}
+	#endif
+
+	#if UIP_STATISTICS
+		pcOut += sprintf( pcOut, "},\"uip\":{\"ip\":{\"recv\":%u,\"sent\":%u,\"drop\":%u,\"chkerr\":%u}",
+			xJsonUipStats.ip.recv, xJsonUipStats.ip.sent, xJsonUipStats.ip.drop, xJsonUipStats.ip.chkerr );
+		pcOut += sprintf( pcOut, ",\"icmp\":{\"recv\":%u,\"sent\":%u,\"drop\":%u}",
+			xJsonUipStats.icmp.recv, xJsonUipStats.icmp.sent, xJsonUipStats.icmp.drop );
+		pcOut += sprintf( pcOut, ",\"tcp\":{\"recv\":%u,\"sent\":%u,\"drop\":%u,\"chkerr\":%u,\"ackerr\":%u,\"rst\":%u,\"rexmit\":%u,\"syndrop\":%u,\"synrst\":%u}}}",
+			xJsonUipStats.tcp.recv, xJsonUipStats.tcp.sent, xJsonUipStats.tcp.drop, xJsonUipStats.tcp.chkerr, xJsonUipStats.tcp.ackerr,
+			xJsonUipStats.tcp.rst, xJsonUipStats.tcp.rexmit, xJsonUipStats.tcp.syndrop, xJsonUipStats.tcp.synrst );
+	#else
+		pcOut += sprintf( pcOut, "}}" );
+	#endif
+
+	return ( unsigned short ) ( pcOut - ( char * ) uip_appdata );
+}
+/*---------------------------------------------------------------------------*/
+
+/* Streams the statistics as one JSON object.  Each task, queue and heap pool
+is sent as a segment of its own, so only one row is ever formatted at a time
+and the size of the response is not limited by the uIP buffer. */
+static
+PT_THREAD(json_stats(struct httpd_state *s, char *ptr))
+{
+  PSOCK_BEGIN(&s->sout);
+  ( void ) ptr;
+
+  PSOCK_WAIT_UNTIL(&s->sout, json_owner == NULL);
+  json_owner = s;
+  json_take_snapshot();
+
+  PSOCK_GENERATOR_SEND(&s->sout, generate_json_head, s);
+
+#if configUSE_TRACE_FACILITY == 1
+  for(s->count = 0; s->count < uxJsonTaskCount; ++s->count) {
+    PSOCK_GENERATOR_SEND(&s->sout, generate_json_task, s);
+  }
+#endif
+
+  PSOCK_GENERATOR_SEND(&s->sout, generate_json_queues_head, s);
+
+#if configQUEUE_REGISTRY_SIZE > 0
+  for(s->count = 0; s->count < uxJsonQueueCount; ++s->count) {
+    PSOCK_GENERATOR_SEND(&s->sout, generate_json_queue, s);
+  }
+#endif
+
+  PSOCK_GENERATOR_SEND(&s->sout, generate_json_heap, s);
+
+#if MALLOC_VERSION == 3
+  for(s->count = 0; s->count < uxJsonPoolCount; ++s->count) {
+    PSOCK_GENERATOR_SEND(&s->sout, generate_json_pool, s);
+  }
+#endif
+
+  PSOCK_GENERATOR_SEND(&s->sout, generate_json_tail, s);
+
+  /* PSOCK_GENERATOR_SEND() only returns once the data has been acknowledged,
+  so nothing can need to be generated from the snapshot again. */
+  json_owner = NULL;
+
+  PSOCK_END(&s->sout);
+}
+/*---------------------------------------------------------------------------*/
+void
+httpd_cgi_release(struct httpd_state *s)
+{
+  if(json_owner == s) {
+    json_owner = NULL;
+  }
+}
 
 /** @} */
 
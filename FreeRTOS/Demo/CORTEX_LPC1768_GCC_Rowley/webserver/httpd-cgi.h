@@ -79,6 +79,10 @@ static PT_THREAD(function(struct httpd_state *, char *)); \
 static const struct httpd_cgi_call name = {str, function}
 
 void httpd_cgi_init(void);
+
+/* Called when a connection ends, so that a response that was cut short does
+   not keep resources shared between connections. */
+void httpd_cgi_release(struct httpd_state *s);
 #endif /* __HTTPD_CGI_H__ */
 
 /** @} */
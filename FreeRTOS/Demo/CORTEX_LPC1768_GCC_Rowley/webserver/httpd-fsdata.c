@@ -538,6 +538,12 @@ static const char data_tcp_shtml[] = {
 	0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0xa, 0x3c, 0x2f, 0x68, 
 	0x74, 0x6d, 0x6c, 0x3e, 0xa, 0xa, 0};
 
+static const char data_stats_json[] = {
+	/* /stats.json */
+	0x2f, 0x73, 0x74, 0x61, 0x74, 0x73, 0x2e, 0x6a, 0x73, 0x6f, 0x6e, 0,
+	0x25, 0x21, 0x20, 0x6a, 0x73, 0x6f, 0x6e, 0x2d, 0x73, 0x74, 
+	0x61, 0x74, 0x73, 0xa, 0};
+
 const struct httpd_fsdata_file file_404_html[] = {{NULL, data_404_html, data_404_html + 10, sizeof(data_404_html) - 10, 0}};
 
 const struct httpd_fsdata_file file_index_html[] = {{file_404_html, data_index_html, data_index_html + 12, sizeof(data_index_html) - 12, 0}};
@@ -552,6 +558,8 @@ const struct httpd_fsdata_file file_stats_shtml[] = {{file_runtime_shtml, data_s
 
 const struct httpd_fsdata_file file_tcp_shtml[] = {{file_stats_shtml, data_tcp_shtml, data_tcp_shtml + 11, sizeof(data_tcp_shtml) - 11, 0}};
 
-#define HTTPD_FS_ROOT file_tcp_shtml
+const struct httpd_fsdata_file file_stats_json[] = {{file_tcp_shtml, data_stats_json, data_stats_json + 12, sizeof(data_stats_json) - 12, 0}};
+
+#define HTTPD_FS_ROOT file_stats_json
 
-#define HTTPD_FS_NUMFILES 7
+#define HTTPD_FS_NUMFILES 8
@@ -132,7 +132,10 @@ PT_THREAD(handle_script(struct httpd_state *s))
   PT_BEGIN(&s->scriptpt);
 
 
-  while(s->file.len > 0) {
+  /* The file data is terminated with a zero so that strchr() stops at the
+     end of it, but the terminator is counted in the file length.  Stop at it
+     rather than sending it, as a stray zero byte breaks JSON parsers. */
+  while(s->file.len > 0 && *s->file.data != 0) {
 
     /* Check if we should start executing a script. */
     if(*s->file.data == ISO_percent &&
@@ -207,6 +210,8 @@ PT_THREAD(send_headers(struct httpd_state *s, const char *statushdr))
     PSOCK_SEND_STR(&s->sout, http_content_type_gif);
   } else if(strncmp(http_jpg, ptr, 4) == 0) {
     PSOCK_SEND_STR(&s->sout, http_content_type_jpg);
+  } else if(strncmp(http_json, ptr, 5) == 0) {
+    PSOCK_SEND_STR(&s->sout, http_content_type_json);
   } else {
     PSOCK_SEND_STR(&s->sout, http_content_type_plain);
   }
@@ -233,7 +238,8 @@ PT_THREAD(handle_output(struct httpd_state *s))
 		   send_headers(s,
 		   http_header_200));
     ptr = strchr(s->filename, ISO_period);
-    if(ptr != NULL && strncmp(ptr, http_shtml, 6) == 0) {
+    if(ptr != NULL && (strncmp(ptr, http_shtml, 6) == 0 ||
+		       strncmp(ptr, http_json, 5) == 0)) {
       PT_INIT(&s->scriptpt);
       PT_WAIT_THREAD(&s->outputpt, handle_script(s));
     } else {
@@ -308,7 +314,9 @@ httpd_appcall(void)
   struct httpd_state *s = (struct httpd_state *)&(uip_conn->appstate);
 
   if(uip_closed() || uip_aborted() || uip_timedout()) {
+    httpd_cgi_release(s);
   } else if(uip_connected()) {
+    httpd_cgi_release(s);
     PSOCK_INIT(&s->sin, s->inputbuf, sizeof(s->inputbuf) - 1);
     PSOCK_INIT(&s->sout, s->inputbuf, sizeof(s->inputbuf) - 1);
     PT_INIT(&s->outputpt);
@@ -320,6 +328,7 @@ httpd_appcall(void)
     if(uip_poll()) {
       ++s->timer;
       if(s->timer >= 20) {
+	httpd_cgi_release(s);
 	uip_abort();
       }
     } else {
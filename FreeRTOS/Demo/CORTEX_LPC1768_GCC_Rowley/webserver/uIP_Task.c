@@ -57,6 +57,7 @@
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "queue.h"
 #include "semphr.h"
 
 /* uip includes. */
@@ -70,6 +71,10 @@
 #include "EthDev_LPC17xx.h"
 #include "EthDev.h"
 #include "ParTest.h"
+#include "uIP_Task.h"
+
+/* For VT_HANDLE_FATAL_ERROR(). */
+#include "vtUtilities.h"
 
 /*-----------------------------------------------------------*/
 
@@ -82,6 +87,19 @@
 /* Standard constant. */
 #define uipTOTAL_FRAME_HEADER_SIZE	54
 
+/* The number of commands that can be queued for the uIP task. */
+#define uipCOMMAND_QUEUE_LENGTH		( 4 )
+
+/* The queue set holds one event for the EMAC semaphore, and one for each
+space in the command queue. */
+#define uipEVENT_SET_LENGTH			( uipCOMMAND_QUEUE_LENGTH + 1 )
+
+/* How many times prvSendFrame() waits for space in a full Tx ring, and for how
+long each time, before it drops the frame.  Sending a full ring at 10Mbps takes
+a few milliseconds. */
+#define uipTX_ATTEMPTS				( 3 )
+#define uipTX_WAIT					( 10 / portTICK_RATE_MS )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -89,6 +107,25 @@
  */
 static void prvSetMACAddress( void );
 
+/*
+ * Returns the number of ticks until the periodic uIP timer expires, which is
+ * the longest time the uIP task can block without delaying periodic
+ * processing.
+ */
+static portTickType prvTicksUntilExpiry( struct timer *pxTimer );
+
+/*
+ * Process a command sent to the uIP task using xuIPSendCommand().
+ */
+static void prvProcessCommand( unsigned long ulCommand );
+
+/*
+ * Send the uip_len bytes in uip_buf.  If the Tx ring is full wait for the EMAC
+ * to free a descriptor and try again, and if it stays full drop the frame and
+ * count it in uip_stat.
+ */
+static void prvSendFrame( void );
+
 /*
  * Port functions required by the uIP stack.
  */
@@ -100,6 +137,13 @@ clock_time_t clock_time( void );
 /* The semaphore used by the ISR to wake the uIP task. */
 xSemaphoreHandle xEMACSemaphore = NULL;
 
+/* Commands sent to the uIP task by other tasks. */
+static xQueueHandle xuIPCommandQueue = NULL;
+
+/* The uIP task blocks on this set, which contains both xEMACSemaphore and
+xuIPCommandQueue, so it is woken by whichever is used first. */
+static xQueueSetHandle xuIPEventSet = NULL;
+
 /*-----------------------------------------------------------*/
 
 void clock_init(void)
@@ -119,6 +163,8 @@ void vuIP_Task( void *pvParameters )
 portBASE_TYPE i;
 uip_ipaddr_t xIPAddr;
 struct timer periodic_timer, arp_timer;
+xQueueSetMemberHandle xActivatedMember;
+unsigned long ulCommand;
 extern void ( vEMAC_ISR_Wrapper )( void );
 
 	( void ) pvParameters;
@@ -133,8 +179,29 @@ extern void ( vEMAC_ISR_Wrapper )( void );
 	uip_setnetmask( xIPAddr );
 	httpd_init();
 
-	/* Create the semaphore used to wake the uIP task. */
+	/* Create the semaphore used to wake the uIP task when data arrives, and
+	the queue used to send it commands, then add both to the set the task
+	blocks on.  This must be done before the EMAC interrupt is enabled.
+	Without any one of them the task could never be woken, and retrying would
+	not help as they only fail when the heap is exhausted, so a failure is
+	fatal. */
 	vSemaphoreCreateBinary( xEMACSemaphore );
+	xuIPEventSet = xQueueCreateSet( uipEVENT_SET_LENGTH );
+	xuIPCommandQueue = xQueueCreate( uipCOMMAND_QUEUE_LENGTH, sizeof( unsigned long ) );
+	if( ( xEMACSemaphore == NULL ) || ( xuIPEventSet == NULL ) || ( xuIPCommandQueue == NULL ) )
+	{
+		VT_HANDLE_FATAL_ERROR( 0 );
+	}
+
+	xSemaphoreTake( xEMACSemaphore, 0 );
+	if( xQueueAddToSet( xEMACSemaphore, xuIPEventSet ) != pdPASS )
+	{
+		VT_HANDLE_FATAL_ERROR( 0 );
+	}
+	if( xQueueAddToSet( xuIPCommandQueue, xuIPEventSet ) != pdPASS )
+	{
+		VT_HANDLE_FATAL_ERROR( 0 );
+	}
 
 	/* Initialise the MAC. */
 	while( lEMACInit() != pdPASS )
@@ -157,6 +224,10 @@ extern void ( vEMAC_ISR_Wrapper )( void );
 	portEXIT_CRITICAL();
 
 
+	/* Frames are sent with prvSendFrame(), which only blocks while the Tx
+	ring is full.  uIP retransmits TCP segments that are dropped, but not ARP,
+	ICMP or UDP frames, so they are waited for rather than dropped as soon as
+	the ring fills. */
 	for( ;; )
 	{
 		/* Is there received data ready to be processed? */
@@ -176,7 +247,7 @@ extern void ( vEMAC_ISR_Wrapper )( void );
 				if( uip_len > 0 )
 				{
 					uip_arp_out();
-					vSendEMACTxData( uip_len );
+					prvSendFrame();
 				}
 			}
 			else if( xHeader->type == htons( UIP_ETHTYPE_ARP ) )
@@ -188,7 +259,7 @@ extern void ( vEMAC_ISR_Wrapper )( void );
 				uip_len is set to a value > 0. */
 				if( uip_len > 0 )
 				{
-					vSendEMACTxData( uip_len );
+					prvSendFrame();
 				}
 			}
 		}
@@ -207,7 +278,7 @@ extern void ( vEMAC_ISR_Wrapper )( void );
 					if( uip_len > 0 )
 					{
 						uip_arp_out();
-						vSendEMACTxData( uip_len );
+						prvSendFrame();
 					}
 				}
 
@@ -221,10 +292,23 @@ extern void ( vEMAC_ISR_Wrapper )( void );
 			else
 			{
 				/* We did not receive a packet, and there was no periodic
-				processing to perform.  Block for a fixed period.  If a packet
-				is received during this period we will be woken by the ISR
-				giving us the Semaphore. */
-				xSemaphoreTake( xEMACSemaphore, configTICK_RATE_HZ / 2 );
+				processing to perform.  Block until the periodic timer next
+				expires, unless the ISR gives the semaphore because a packet
+				was received, or another task sends a command, first.  Every
+				member returned by the set must be read exactly once. */
+				xActivatedMember = xQueueSelectFromSet( xuIPEventSet, prvTicksUntilExpiry( &periodic_timer ) );
+
+				if( xActivatedMember == xEMACSemaphore )
+				{
+					xSemaphoreTake( xEMACSemaphore, 0 );
+				}
+				else if( xActivatedMember == xuIPCommandQueue )
+				{
+					if( xQueueReceive( xuIPCommandQueue, &ulCommand, 0 ) == pdPASS )
+					{
+						prvProcessCommand( ulCommand );
+					}
+				}
 			}
 		}
 	}
@@ -246,6 +330,96 @@ struct uip_eth_addr xAddr;
 }
 /*-----------------------------------------------------------*/
 
+static portTickType prvTicksUntilExpiry( struct timer *pxTimer )
+{
+clock_time_t xElapsed;
+portTickType xReturn = 0;
+
+	/* clock_time() is the tick count, so the timer is measured in ticks. */
+	xElapsed = clock_time() - pxTimer->start;
+	if( xElapsed < pxTimer->interval )
+	{
+		xReturn = ( portTickType ) ( pxTimer->interval - xElapsed );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessCommand( unsigned long ulCommand )
+{
+portBASE_TYPE i;
+
+	if( ( ulCommand == uipCOMMAND_POLL_CONNECTIONS ) && ( uip_buf != NULL ) )
+	{
+		for( i = 0; i < UIP_CONNS; i++ )
+		{
+			uip_poll_conn( &uip_conns[ i ] );
+
+			/* If the above function invocation resulted in data that
+			should be sent out on the network, the global variable
+			uip_len is set to a value > 0. */
+			if( uip_len > 0 )
+			{
+				uip_arp_out();
+				prvSendFrame();
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendFrame( void )
+{
+long lAttempt;
+
+	/* The semaphore is given on every reclaim, including those that happened
+	while nothing was waiting.  Discard any such give now so the first wait
+	below does not return at once.  This is done before the first attempt so
+	a reclaim that frees space after it is not lost. */
+	( void ) lEMACWaitForTxSpace( 0 );
+
+	for( lAttempt = 0; lAttempt <= uipTX_ATTEMPTS; lAttempt++ )
+	{
+		if( lSendEMACTxData( uip_len ) == pdPASS )
+		{
+			break;
+		}
+
+		/* The ring is full.  There is no point trying again until a
+		descriptor has been reclaimed. */
+		if( lAttempt < uipTX_ATTEMPTS )
+		{
+			( void ) lEMACWaitForTxSpace( uipTX_WAIT );
+		}
+	}
+
+	#if UIP_STATISTICS == 1
+	{
+		if( lAttempt > uipTX_ATTEMPTS )
+		{
+			/* uIP has no link layer statistics, so count the frame as
+			dropped at the IP layer. */
+			uip_stat.ip.drop++;
+		}
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xuIPSendCommand( unsigned long ulCommand, portTickType xTicksToWait )
+{
+portBASE_TYPE xReturn = pdFAIL;
+
+	if( xuIPCommandQueue != NULL )
+	{
+		xReturn = xQueueSend( xuIPCommandQueue, &ulCommand, xTicksToWait );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 void vApplicationProcessFormInput( char *pcInputString )
 {
 char *c;
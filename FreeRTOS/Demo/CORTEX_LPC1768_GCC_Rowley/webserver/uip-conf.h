@@ -77,6 +77,16 @@ typedef uint8_t u8_t;
  */
 typedef uint16_t u16_t;
 
+/**
+ * 32 bit datatype
+ *
+ * This typedef defines the 32-bit type used by the architecture
+ * specific checksum code in uip_arch.c.
+ *
+ * \hideinitializer
+ */
+typedef uint32_t u32_t;
+
 /**
  * Statistics datatype
  *
@@ -101,6 +111,16 @@ typedef unsigned short uip_stats_t;
  */
 #define UIP_CONF_MAX_LISTENPORTS 40
 
+/**
+ * ARP table size.
+ *
+ * Enough for the dozens of hosts a node on a plant network talks to
+ * without evicting entries that are still in use.
+ *
+ * \hideinitializer
+ */
+#define UIP_CONF_ARPTAB_SIZE     64
+
 /**
  * uIP buffer size.
  *
@@ -143,6 +163,15 @@ typedef unsigned short uip_stats_t;
  */
 #define UIP_CONF_STATISTICS      1
 
+/**
+ * Use the word at a time checksum and 32-bit add in uip_arch.c in
+ * place of the generic byte at a time versions in uip.c.
+ *
+ * \hideinitializer
+ */
+#define UIP_ARCH_CHKSUM          1
+#define UIP_ARCH_ADD32           1
+
 /* Here we include the header file for the application(s) we use in
    our project. */
 /*#include "smtp.h"*/
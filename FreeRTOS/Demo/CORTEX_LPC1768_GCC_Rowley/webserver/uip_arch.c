@@ -0,0 +1,231 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+	FreeRTOS supports many tools and architectures. V7.0.0 is sponsored by:
+	Atollic AB - Atollic provides professional embedded systems development 
+	tools for C/C++ development, code analysis and test automation.  
+	See http://www.atollic.com
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * Cortex-M3 implementations of the uIP checksum and 32-bit add primitives.
+ * uip.c omits its own byte-at-a-time versions when uip-conf.h sets
+ * UIP_ARCH_CHKSUM and UIP_ARCH_ADD32.
+ *
+ * The checksum is accumulated a 32-bit word at a time in host (little endian)
+ * byte order, and the carry out of each addition is folded straight back
+ * into the accumulator.  The ones complement sum is independent of byte
+ * order (RFC 1071) so the result only needs swapping once at the end.
+ */
+
+#include "uip.h"
+
+#define BUF ((struct uip_tcpip_hdr *)&uip_buf[UIP_LLH_LEN])
+
+/* Add a 32-bit word to the accumulator with end around carry.  The compiler
+turns this into an ADDS/ADC pair. */
+#define CHKSUM_ADD(acc, w) do {               \
+    u32_t chksum_w = (w);                     \
+    (acc) += chksum_w;                        \
+    (acc) += ((acc) < chksum_w);              \
+  } while(0)
+
+/*---------------------------------------------------------------------------*/
+void
+uip_add32(u8_t *op32, u16_t op16)
+{
+  u32_t sum;
+
+  sum = ((u32_t)op32[0] << 24) | ((u32_t)op32[1] << 16) |
+        ((u32_t)op32[2] << 8) | (u32_t)op32[3];
+  sum += op16;
+
+  uip_acc32[0] = (u8_t)(sum >> 24);
+  uip_acc32[1] = (u8_t)(sum >> 16);
+  uip_acc32[2] = (u8_t)(sum >> 8);
+  uip_acc32[3] = (u8_t)sum;
+}
+/*---------------------------------------------------------------------------*/
+static u16_t
+chksum(u16_t sum, const u8_t *data, u16_t len)
+{
+  const u32_t *words;
+  u32_t acc = 0;
+  int odd;
+
+  /* An odd start address puts every following byte in the other half of its
+     16-bit word.  Taking the first byte on its own and summing the rest in
+     host order then produces the network order sum directly, so the final
+     swap is skipped. */
+  odd = ((unsigned long)data & 1) != 0;
+  if(odd && len > 0) {
+    acc = (u32_t)data[0] << 8;
+    ++data;
+    --len;
+  }
+
+  /* Reach word alignment.  uip_buf is word aligned, so the IP header behind
+     the 14 byte Ethernet header always takes this path. */
+  if(((unsigned long)data & 2) != 0 && len >= 2) {
+    acc += *(const u16_t *)data;
+    data += 2;
+    len -= 2;
+  }
+
+  words = (const u32_t *)data;
+  while(len >= 32) {
+    CHKSUM_ADD(acc, words[0]);
+    CHKSUM_ADD(acc, words[1]);
+    CHKSUM_ADD(acc, words[2]);
+    CHKSUM_ADD(acc, words[3]);
+    CHKSUM_ADD(acc, words[4]);
+    CHKSUM_ADD(acc, words[5]);
+    CHKSUM_ADD(acc, words[6]);
+    CHKSUM_ADD(acc, words[7]);
+    words += 8;
+    len -= 32;
+  }
+  while(len >= 4) {
+    CHKSUM_ADD(acc, *words);
+    ++words;
+    len -= 4;
+  }
+
+  data = (const u8_t *)words;
+  if(len >= 2) {
+    CHKSUM_ADD(acc, *(const u16_t *)data);
+    data += 2;
+    len -= 2;
+  }
+  if(len > 0) {
+    /* Trailing byte is the low byte of a host order halfword. */
+    CHKSUM_ADD(acc, data[0]);
+  }
+
+  /* Fold to 16 bits, twice to absorb the carry of the first fold. */
+  acc = (acc >> 16) + (acc & 0xffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+
+  if(!odd) {
+    acc = ((acc & 0xff) << 8) | (acc >> 8);
+  }
+
+  /* Add the caller's running sum, which is already in network order. */
+  acc += sum;
+  acc = (acc >> 16) + (acc & 0xffff);
+
+  return (u16_t)acc;
+}
+/*---------------------------------------------------------------------------*/
+u16_t
+uip_chksum(u16_t *data, u16_t len)
+{
+  return htons(chksum(0, (u8_t *)data, len));
+}
+/*---------------------------------------------------------------------------*/
+#ifndef UIP_ARCH_IPCHKSUM
+u16_t
+uip_ipchksum(void)
+{
+  u16_t sum;
+
+  sum = chksum(0, &uip_buf[UIP_LLH_LEN], UIP_IPH_LEN);
+  return (sum == 0) ? 0xffff : htons(sum);
+}
+#endif
+/*---------------------------------------------------------------------------*/
+static u16_t
+upper_layer_chksum(u8_t proto)
+{
+  u16_t upper_layer_len;
+  u16_t sum;
+
+#if UIP_CONF_IPV6
+  upper_layer_len = (((u16_t)(BUF->len[0]) << 8) + BUF->len[1]);
+#else /* UIP_CONF_IPV6 */
+  upper_layer_len = (((u16_t)(BUF->len[0]) << 8) + BUF->len[1]) - UIP_IPH_LEN;
+#endif /* UIP_CONF_IPV6 */
+
+  /* Pseudo header protocol and length.  This addition cannot carry. */
+  sum = upper_layer_len + proto;
+  sum = chksum(sum, (u8_t *)&BUF->srcipaddr[0], 2 * sizeof(uip_ipaddr_t));
+
+  /* Upper layer header and data. */
+  sum = chksum(sum, &uip_buf[UIP_IPH_LEN + UIP_LLH_LEN], upper_layer_len);
+
+  return (sum == 0) ? 0xffff : htons(sum);
+}
+/*---------------------------------------------------------------------------*/
+#if UIP_CONF_IPV6
+u16_t
+uip_icmp6chksum(void)
+{
+  return upper_layer_chksum(UIP_PROTO_ICMP6);
+}
+#endif /* UIP_CONF_IPV6 */
+/*---------------------------------------------------------------------------*/
+u16_t
+uip_tcpchksum(void)
+{
+  return upper_layer_chksum(UIP_PROTO_TCP);
+}
+/*---------------------------------------------------------------------------*/
+#if UIP_UDP_CHECKSUMS
+u16_t
+uip_udpchksum(void)
+{
+  return upper_layer_chksum(UIP_PROTO_UDP);
+}
+#endif /* UIP_UDP_CHECKSUMS */
+/*---------------------------------------------------------------------------*/
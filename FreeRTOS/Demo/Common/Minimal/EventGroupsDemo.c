@@ -0,0 +1,574 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+	FreeRTOS supports many tools and architectures. V7.0.0 is sponsored by:
+	Atollic AB - Atollic provides professional embedded systems development 
+	tools for C/C++ development, code analysis and test automation.  
+	See http://www.atollic.com
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+	Tests the event group API.
+
+	A control task drives two waiter tasks, which have a lower priority and
+	suspend themselves between tests.  For each test the control task gives a
+	waiter the call to make - xEventGroupWaitBits() or xEventGroupSync(), with
+	the bits, options and block time to use - then resumes it and lets it block
+	before changing the event group and checking the result.  Each cycle tests:
+
+		- waiting for all of a set of bits, which must not return until the last
+		  of them is set, and must leave the bits set;
+		- waiting for any of a set of bits with clear on exit, which must clear
+		  only the bits waited for;
+		- a wait that times out, which must block for its whole block time and
+		  must not clear anything, and waits with no block time;
+		- a three way rendezvous with xEventGroupSync(), and a rendezvous that
+		  times out;
+		- setting and clearing bits from an interrupt - the control task posts a
+		  request that vEventGroupsISRTests(), called from the tick hook, carries
+		  out with xEventGroupSetBitsFromISR() or xEventGroupClearBitsFromISR();
+		- deleting an event group that both waiters are blocked on, which must
+		  unblock them with a value of 0.
+*/
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+/* Demo app include files. */
+#include "EventGroupsDemo.h"
+
+/* The number of waiter tasks. */
+#define egWAITERS						( 2 )
+
+/* Priorities of the tasks.  The waiters only run when the control task
+blocks. */
+#define egWAITER_PRIORITY				( tskIDLE_PRIORITY + 1 )
+#define egCONTROL_PRIORITY				( tskIDLE_PRIORITY + 2 )
+
+/* The control task polls for the waiters to finish, for at most egMAX_POLLS
+times egPOLL_DELAY.  egPOLL_DELAY is also long enough for a waiter that has
+been resumed to reach its blocking call. */
+#define egPOLL_DELAY					( 10 / portTICK_RATE_MS )
+#define egMAX_POLLS						( 200 )
+#define egSHORT_DELAY					( 20 / portTICK_RATE_MS )
+#define egTIMEOUT						( 50 / portTICK_RATE_MS )
+#define egNO_DELAY						( ( portTickType ) 0 )
+
+/* The bits used by the tests. */
+#define egBIT_0							( ( xEventBitsType ) 0x01 )
+#define egBIT_1							( ( xEventBitsType ) 0x02 )
+#define egBIT_2							( ( xEventBitsType ) 0x04 )
+#define egBIT_3							( ( xEventBitsType ) 0x08 )
+#define egBIT_4							( ( xEventBitsType ) 0x10 )
+#define egBIT_5							( ( xEventBitsType ) 0x20 )
+#define egBIT_6							( ( xEventBitsType ) 0x40 )
+#define egBIT_7							( ( xEventBitsType ) 0x80 )
+#define egSYNC_BITS						( egBIT_0 | egBIT_1 | egBIT_2 )
+
+/* The call a waiter task makes the next time it is resumed. */
+typedef struct EG_WAITER_COMMAND
+{
+	xEventGroupHandle xEventGroup;
+	portBASE_TYPE xSync;				/* pdTRUE to call xEventGroupSync(), pdFALSE to call xEventGroupWaitBits(). */
+	xEventBitsType uxBitsToSet;			/* Only used by xEventGroupSync(). */
+	xEventBitsType uxBitsToWaitFor;
+	portBASE_TYPE xClearOnExit;			/* Only used by xEventGroupWaitBits(). */
+	portBASE_TYPE xWaitForAllBits;		/* Only used by xEventGroupWaitBits(). */
+	portTickType xTicksToWait;
+} xEGWaiterCommand;
+
+/* The tasks as described at the top of this file. */
+static void prvWaiterTask( void *pvParameters );
+static void prvControlTask( void *pvParameters );
+
+/* The tests run by the control task, one function per group of tests. */
+static void prvTestWaitBits( void );
+static void prvTestSync( void );
+static void prvTestISR( void );
+static void prvTestDelete( void );
+
+/* Give a waiter a call to make, then resume it and let it block. */
+static void prvStartWait( unsigned portBASE_TYPE uxWaiter, xEventGroupHandle xEventGroup, xEventBitsType uxBitsToWaitFor, portBASE_TYPE xClearOnExit, portBASE_TYPE xWaitForAllBits, portTickType xTicksToWait );
+static void prvStartSync( unsigned portBASE_TYPE uxWaiter, xEventGroupHandle xEventGroup, xEventBitsType uxBitsToSet, xEventBitsType uxBitsToWaitFor, portTickType xTicksToWait );
+static void prvResumeWaiter( unsigned portBASE_TYPE uxWaiter );
+
+/* Wait for a waiter to return from its call, and check the value it
+returned. */
+static void prvCheckWaiterResult( unsigned portBASE_TYPE uxWaiter, xEventBitsType uxExpected );
+
+/* Check the value of the event group, then clear it. */
+static void prvCheckAndClearBits( xEventBitsType uxExpected );
+
+/* The names of the waiter tasks. */
+static const char * const pcWaiterNames[ egWAITERS ] = { "EGWait0", "EGWait1" };
+
+/* The event group used by all the tests other than the deletion test. */
+static xEventGroupHandle xEventGroup;
+
+/* The waiter tasks, the calls they are to make, and what the calls
+returned. */
+static xTaskHandle xWaiterTasks[ egWAITERS ];
+static xEGWaiterCommand xWaiterCommands[ egWAITERS ];
+static volatile xEventBitsType uxWaiterResults[ egWAITERS ];
+static volatile portTickType xWaiterBlockTimes[ egWAITERS ];
+static volatile portBASE_TYPE xWaiterDone[ egWAITERS ];
+
+/* Requests posted by the control task to vEventGroupsISRTests(), and the
+results of carrying them out. */
+static volatile xEventBitsType uxISRBitsToSet = 0, uxISRBitsToClear = 0;
+static volatile xEventBitsType uxISRBitsBeforeClear = 0;
+static volatile portBASE_TYPE xISRSetResult = pdFAIL, xISRClearResult = pdFAIL;
+
+/* Variables used to detect and latch errors. */
+static volatile portBASE_TYPE xErrorOccurred = pdFALSE;
+static volatile unsigned portBASE_TYPE uxControlCycles = 0;
+
+/*-----------------------------------------------------------*/
+
+void vStartEventGroupTasks( void )
+{
+unsigned portBASE_TYPE ux;
+
+	xEventGroup = xEventGroupCreate();
+
+	if( xEventGroup == NULL )
+	{
+		return;
+	}
+
+	/* The waiters suspend themselves straight away, and only run when the
+	control task resumes them. */
+	for( ux = 0; ux < egWAITERS; ux++ )
+	{
+		xTaskCreate( prvWaiterTask, ( signed char * ) pcWaiterNames[ ux ], configMINIMAL_STACK_SIZE, ( void * ) ux, egWAITER_PRIORITY, &( xWaiterTasks[ ux ] ) );
+	}
+
+	xTaskCreate( prvControlTask, ( signed char * ) "EGCtrl", configMINIMAL_STACK_SIZE, NULL, egCONTROL_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+unsigned portBASE_TYPE uxWaiter = ( unsigned portBASE_TYPE ) pvParameters;
+xEGWaiterCommand *pxCommand = &( xWaiterCommands[ uxWaiter ] );
+portTickType xStartTime;
+xEventBitsType uxResult;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+
+		xStartTime = xTaskGetTickCount();
+
+		if( pxCommand->xSync == pdTRUE )
+		{
+			uxResult = xEventGroupSync( pxCommand->xEventGroup, pxCommand->uxBitsToSet, pxCommand->uxBitsToWaitFor, pxCommand->xTicksToWait );
+		}
+		else
+		{
+			uxResult = xEventGroupWaitBits( pxCommand->xEventGroup, pxCommand->uxBitsToWaitFor, pxCommand->xClearOnExit, pxCommand->xWaitForAllBits, pxCommand->xTicksToWait );
+		}
+
+		xWaiterBlockTimes[ uxWaiter ] = xTaskGetTickCount() - xStartTime;
+		uxWaiterResults[ uxWaiter ] = uxResult;
+		xWaiterDone[ uxWaiter ] = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	/* Let the waiters run until they suspend themselves. */
+	vTaskDelay( egSHORT_DELAY );
+
+	for( ;; )
+	{
+		prvTestWaitBits();
+		prvTestSync();
+		prvTestISR();
+		prvTestDelete();
+
+		uxControlCycles++;
+		vTaskDelay( egSHORT_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestWaitBits( void )
+{
+xEventBitsType uxReturned;
+
+	/* Wait for all of two bits.  Setting one of them must not unblock the
+	waiter, setting the second must, and neither is cleared. */
+	prvStartWait( 0, xEventGroup, egBIT_0 | egBIT_1, pdFALSE, pdTRUE, portMAX_DELAY );
+	xEventGroupSetBits( xEventGroup, egBIT_0 );
+	vTaskDelay( egSHORT_DELAY );
+
+	if( xWaiterDone[ 0 ] != pdFALSE )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	xEventGroupSetBits( xEventGroup, egBIT_1 );
+	prvCheckWaiterResult( 0, egBIT_0 | egBIT_1 );
+	prvCheckAndClearBits( egBIT_0 | egBIT_1 );
+
+	/* Wait for either of two bits, clearing them on exit.  Only the bit that
+	was waited for may be cleared.  The clear is done by the task that sets
+	the bits, so it has happened by the time xEventGroupSetBits() returns. */
+	prvStartWait( 0, xEventGroup, egBIT_0 | egBIT_2, pdTRUE, pdFALSE, portMAX_DELAY );
+	xEventGroupSetBits( xEventGroup, egBIT_2 | egBIT_3 );
+
+	if( xEventGroupGetBits( xEventGroup ) != egBIT_3 )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	prvCheckWaiterResult( 0, egBIT_2 | egBIT_3 );
+	prvCheckAndClearBits( egBIT_3 );
+
+	/* A wait that times out must block for its whole block time, return the
+	bits that are set, and leave them set even though it asked for the bits
+	to be cleared. */
+	xEventGroupSetBits( xEventGroup, egBIT_5 );
+	prvStartWait( 0, xEventGroup, egBIT_4 | egBIT_5, pdTRUE, pdTRUE, egTIMEOUT );
+	prvCheckWaiterResult( 0, egBIT_5 );
+
+	if( xWaiterBlockTimes[ 0 ] < egTIMEOUT )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	prvCheckAndClearBits( egBIT_5 );
+
+	/* With no block time a wait returns at once, whether or not the bits
+	are set, and only clears them if they are. */
+	uxReturned = xEventGroupWaitBits( xEventGroup, egBIT_6, pdTRUE, pdTRUE, egNO_DELAY );
+
+	if( uxReturned != 0 )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	xEventGroupSetBits( xEventGroup, egBIT_6 | egBIT_7 );
+	uxReturned = xEventGroupWaitBits( xEventGroup, egBIT_6, pdTRUE, pdTRUE, egNO_DELAY );
+
+	if( uxReturned != ( egBIT_6 | egBIT_7 ) )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	prvCheckAndClearBits( egBIT_7 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestSync( void )
+{
+xEventBitsType uxReturned;
+
+	/* Both waiters reach the rendezvous first, so they block with their bits
+	set.  The control task arrives last, so it does not block, and all three
+	must see every rendezvous bit set.  The bits are then cleared. */
+	prvStartSync( 0, xEventGroup, egBIT_0, egSYNC_BITS, portMAX_DELAY );
+	prvStartSync( 1, xEventGroup, egBIT_1, egSYNC_BITS, portMAX_DELAY );
+
+	if( ( xWaiterDone[ 0 ] != pdFALSE ) || ( xWaiterDone[ 1 ] != pdFALSE ) )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	if( xEventGroupGetBits( xEventGroup ) != ( egBIT_0 | egBIT_1 ) )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	uxReturned = xEventGroupSync( xEventGroup, egBIT_2, egSYNC_BITS, egTIMEOUT );
+
+	if( ( uxReturned & egSYNC_BITS ) != egSYNC_BITS )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	prvCheckWaiterResult( 0, egSYNC_BITS );
+	prvCheckWaiterResult( 1, egSYNC_BITS );
+	prvCheckAndClearBits( 0 );
+
+	/* A rendezvous that nobody else reaches times out, and leaves the bit
+	the task set. */
+	uxReturned = xEventGroupSync( xEventGroup, egBIT_2, egSYNC_BITS, egTIMEOUT );
+
+	if( uxReturned != egBIT_2 )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	prvCheckAndClearBits( egBIT_2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestISR( void )
+{
+unsigned portBASE_TYPE uxPolls;
+
+	/* A bit set from the interrupt must unblock the waiter. */
+	prvStartWait( 0, xEventGroup, egBIT_4, pdTRUE, pdTRUE, portMAX_DELAY );
+	xISRSetResult = pdFAIL;
+	uxISRBitsToSet = egBIT_4;
+	prvCheckWaiterResult( 0, egBIT_4 );
+
+	if( ( xISRSetResult != pdPASS ) || ( uxISRBitsToSet != 0 ) )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	prvCheckAndClearBits( 0 );
+
+	/* A bit cleared from the interrupt must be cleared, and only that bit.
+	The clear is carried out by the timer service task, so wait for it. */
+	xEventGroupSetBits( xEventGroup, egBIT_5 | egBIT_6 );
+	xISRClearResult = pdFAIL;
+	uxISRBitsToClear = egBIT_6;
+
+	for( uxPolls = 0; uxPolls < egMAX_POLLS; uxPolls++ )
+	{
+		if( ( uxISRBitsToClear == 0 ) && ( xEventGroupGetBits( xEventGroup ) == egBIT_5 ) )
+		{
+			break;
+		}
+
+		vTaskDelay( egPOLL_DELAY );
+	}
+
+	if( ( xISRClearResult != pdPASS ) || ( uxISRBitsBeforeClear != ( egBIT_5 | egBIT_6 ) ) )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	prvCheckAndClearBits( egBIT_5 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestDelete( void )
+{
+xEventGroupHandle xDeletedGroup;
+
+	/* Delete an event group while both waiters are blocked on it, one in
+	xEventGroupWaitBits() and one in xEventGroupSync().  Both must unblock
+	and see a value of 0. */
+	xDeletedGroup = xEventGroupCreate();
+
+	if( xDeletedGroup == NULL )
+	{
+		xErrorOccurred = pdTRUE;
+		return;
+	}
+
+	prvStartWait( 0, xDeletedGroup, egBIT_0, pdFALSE, pdTRUE, portMAX_DELAY );
+	prvStartSync( 1, xDeletedGroup, egBIT_1, egBIT_0 | egBIT_1, portMAX_DELAY );
+
+	if( ( xWaiterDone[ 0 ] != pdFALSE ) || ( xWaiterDone[ 1 ] != pdFALSE ) )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	vEventGroupDelete( xDeletedGroup );
+
+	prvCheckWaiterResult( 0, 0 );
+	prvCheckWaiterResult( 1, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartWait( unsigned portBASE_TYPE uxWaiter, xEventGroupHandle xEventGroupToUse, xEventBitsType uxBitsToWaitFor, portBASE_TYPE xClearOnExit, portBASE_TYPE xWaitForAllBits, portTickType xTicksToWait )
+{
+xEGWaiterCommand *pxCommand = &( xWaiterCommands[ uxWaiter ] );
+
+	pxCommand->xEventGroup = xEventGroupToUse;
+	pxCommand->xSync = pdFALSE;
+	pxCommand->uxBitsToSet = 0;
+	pxCommand->uxBitsToWaitFor = uxBitsToWaitFor;
+	pxCommand->xClearOnExit = xClearOnExit;
+	pxCommand->xWaitForAllBits = xWaitForAllBits;
+	pxCommand->xTicksToWait = xTicksToWait;
+
+	prvResumeWaiter( uxWaiter );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartSync( unsigned portBASE_TYPE uxWaiter, xEventGroupHandle xEventGroupToUse, xEventBitsType uxBitsToSet, xEventBitsType uxBitsToWaitFor, portTickType xTicksToWait )
+{
+xEGWaiterCommand *pxCommand = &( xWaiterCommands[ uxWaiter ] );
+
+	pxCommand->xEventGroup = xEventGroupToUse;
+	pxCommand->xSync = pdTRUE;
+	pxCommand->uxBitsToSet = uxBitsToSet;
+	pxCommand->uxBitsToWaitFor = uxBitsToWaitFor;
+	pxCommand->xClearOnExit = pdTRUE;
+	pxCommand->xWaitForAllBits = pdTRUE;
+	pxCommand->xTicksToWait = xTicksToWait;
+
+	prvResumeWaiter( uxWaiter );
+}
+/*-----------------------------------------------------------*/
+
+static void prvResumeWaiter( unsigned portBASE_TYPE uxWaiter )
+{
+	/* The waiter must be suspended, waiting for its next command. */
+	if( xTaskIsTaskSuspended( xWaiterTasks[ uxWaiter ] ) != pdTRUE )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	xWaiterDone[ uxWaiter ] = pdFALSE;
+	vTaskResume( xWaiterTasks[ uxWaiter ] );
+
+	/* The waiter has a lower priority than this task, so it only runs, and
+	reaches its blocking call, when this task blocks. */
+	vTaskDelay( egPOLL_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckWaiterResult( unsigned portBASE_TYPE uxWaiter, xEventBitsType uxExpected )
+{
+unsigned portBASE_TYPE uxPolls;
+
+	for( uxPolls = 0; uxPolls < egMAX_POLLS; uxPolls++ )
+	{
+		if( xWaiterDone[ uxWaiter ] == pdTRUE )
+		{
+			break;
+		}
+
+		vTaskDelay( egPOLL_DELAY );
+	}
+
+	if( ( xWaiterDone[ uxWaiter ] != pdTRUE ) || ( uxWaiterResults[ uxWaiter ] != uxExpected ) )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	/* Give the waiter time to suspend itself again. */
+	vTaskDelay( egPOLL_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckAndClearBits( xEventBitsType uxExpected )
+{
+	if( xEventGroupClearBits( xEventGroup, egBIT_0 | egBIT_1 | egBIT_2 | egBIT_3 | egBIT_4 | egBIT_5 | egBIT_6 | egBIT_7 ) != uxExpected )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vEventGroupsISRTests( void )
+{
+/* The xHigherPriorityTaskWoken parameter is not used in this case as this
+function is called from the tick hook anyway.  However the API requires it
+to be present. */
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	if( xEventGroup == NULL )
+	{
+		return;
+	}
+
+	if( uxISRBitsToSet != 0 )
+	{
+		xISRSetResult = xEventGroupSetBitsFromISR( xEventGroup, uxISRBitsToSet, &xHigherPriorityTaskWoken );
+		uxISRBitsToSet = 0;
+	}
+
+	if( uxISRBitsToClear != 0 )
+	{
+		uxISRBitsBeforeClear = xEventGroupGetBitsFromISR( xEventGroup );
+		xISRClearResult = xEventGroupClearBitsFromISR( xEventGroup, uxISRBitsToClear );
+		uxISRBitsToClear = 0;
+	}
+
+	( void ) xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+/* This is called to check that all the created tasks are still running. */
+portBASE_TYPE xAreEventGroupTasksStillRunning( void )
+{
+portBASE_TYPE xReturn;
+static unsigned portBASE_TYPE uxLastControlCycles = 0;
+
+	/* Is the control task still cycling? */
+	if( uxLastControlCycles == uxControlCycles )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+	else
+	{
+		uxLastControlCycles = uxControlCycles;
+	}
+
+	if( xErrorOccurred == pdTRUE )
+	{
+		xReturn = pdFAIL;
+	}
+	else
+	{
+		xReturn = pdTRUE;
+	}
+
+	return xReturn;
+}
+
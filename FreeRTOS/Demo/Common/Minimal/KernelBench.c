@@ -0,0 +1,695 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+	FreeRTOS supports many tools and architectures. V7.0.0 is sponsored by:
+	Atollic AB - Atollic provides professional embedded systems development 
+	tools for C/C++ development, code analysis and test automation.  
+	See http://www.atollic.com
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+
+/*
+ * Kernel micro-benchmarks.  Rather than checking that the kernel behaves
+ * correctly, as the other standard demo tasks do, these tasks measure how long
+ * the basic kernel operations take:
+ *
+ * "timestamp" - the cost of reading the timestamp itself, which is included in
+ * every other figure.
+ *
+ * "queue_send" and "queue_receive" - a send to, then a receive from, a queue
+ * that has space/data available, so neither blocks.  Measured for a range of
+ * item sizes, the item size in bytes being given as the parameter.
+ *
+ * "semaphore_wake" - from the start of a binary semaphore 'give' to the point
+ * at which a higher priority task that was blocked on the semaphore is running.
+ *
+ * "mutex_take_give" - an uncontended mutex take followed by a give.
+ *
+ * "mutex_inherit" - from the point a higher priority task attempts to take a
+ * mutex that is held by this task, to the point this task is running again
+ * having inherited the priority of the higher priority task.
+ *
+ * "mutex_disinherit" - from the start of the mutex 'give' that returns this
+ * task to its original priority to the point at which the higher priority task
+ * is running again holding the mutex.
+ *
+ * "timer_command" - the time taken by xTimerReset() when the timer service
+ * task has a higher priority than the benchmark, so includes the processing of
+ * the command by the timer service task.  Only measured if configUSE_TIMERS is
+ * 1 and configTIMER_TASK_PRIORITY is higher than the benchmark priority.
+ *
+ * "context_switch" - from a taskYIELD() in one task to the point at which a
+ * task of the same priority is running.
+ *
+ * Each benchmark is run benchITERATIONS times and the result is output as a
+ * single line of JSON, for example:
+ *
+ * {"bench":"queue_send","param":16,"samples":1000,"min":310,"mean":318,"max":702,"hz":100000000}
+ *
+ * The times are in timestamp counts, and "hz" is the rate at which the
+ * timestamp counts, so each line can be interpreted on its own.  A final line
+ * with "bench" set to "complete" gives the number of errors found.
+ *
+ * FreeRTOSConfig.h must define benchGET_TIMESTAMP() to return a free running
+ * count as an unsigned long (the differences between two timestamps are
+ * calculated with unsigned arithmetic, so the count can wrap), and
+ * benchTIMESTAMP_HZ to the rate at which it counts.  On a Cortex-M3 the DWT
+ * cycle counter gives times in CPU cycles.  benchCONFIGURE_TIMESTAMP() can
+ * optionally be defined to start the counter.  The lines are output with
+ * printf() unless benchOUTPUT_LINE() is defined.  Only %s and %u are used to
+ * format them, as the cut down sprintf() implementations used on small targets
+ * often have no length modifiers.
+ *
+ * The benchmark tasks are created at uxPriority and uxPriority + 1, so for
+ * representative results there should be no other tasks at those priorities or
+ * above, other than the timer service task.  Interrupts (including the tick)
+ * are not disabled, so occasional samples include the time taken by interrupts -
+ * the "min" figure is the one to use when comparing kernel changes.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+
+/* Demo program include files. */
+#include "KernelBench.h"
+
+#ifndef benchGET_TIMESTAMP
+	#error benchGET_TIMESTAMP() and benchTIMESTAMP_HZ must be defined in FreeRTOSConfig.h to use the kernel benchmarks.
+#endif
+
+#ifndef benchCONFIGURE_TIMESTAMP
+	#define benchCONFIGURE_TIMESTAMP()
+#endif
+
+#ifndef benchITERATIONS
+	#define benchITERATIONS			( 1000UL )
+#endif
+
+#ifndef benchOUTPUT_LINE
+	#define benchOUTPUT_LINE( pcLine ) printf( "%s\n", ( pcLine ) )
+#endif
+
+/* The controller task formats the results, so needs a larger stack. */
+#define benchCONTROLLER_STACK_SIZE	( configMINIMAL_STACK_SIZE * 4 )
+#define benchHELPER_STACK_SIZE		configMINIMAL_STACK_SIZE
+
+/* The queue benchmarks are run for each of these item sizes, in bytes. */
+#define benchNUM_ITEM_SIZES			( 4 )
+#define benchMAX_ITEM_SIZE			( 64 )
+
+#define benchDONT_BLOCK				( ( portTickType ) 0 )
+
+/* The period of the timer used by the timer command benchmark.  The timer is
+reset before it expires, so its callback never executes. */
+#define benchTIMER_PERIOD			( ( portTickType ) 10000 / portTICK_RATE_MS )
+
+/* The maximum time the controller waits for the timer command queue to have
+space. */
+#define benchTIMER_BLOCK_TIME		( ( portTickType ) 100 / portTICK_RATE_MS )
+
+#define benchLINE_LENGTH			( 160 )
+
+/*-----------------------------------------------------------*/
+
+/* The statistics collected for one benchmark. */
+typedef struct BENCH_RESULT
+{
+	unsigned long ulSamples;
+	unsigned long ulMin;
+	unsigned long ulMax;
+	unsigned long long ullTotal;
+} xBenchResult;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that runs each benchmark in turn and outputs the results.
+ */
+static void prvBenchControllerTask( void *pvParameters );
+
+/*
+ * The higher priority tasks that block on the semaphore and mutex during the
+ * semaphore_wake and mutex benchmarks.
+ */
+static void prvSemaphoreWakeTask( void *pvParameters );
+static void prvMutexContenderTask( void *pvParameters );
+
+/*
+ * The task that shares the processor with the controller task during the
+ * context_switch benchmark.
+ */
+static void prvYieldTask( void *pvParameters );
+
+/*
+ * The callback of the timer used by the timer_command benchmark.
+ */
+#if configUSE_TIMERS == 1
+	static void prvBenchTimerCallback( xTimerHandle xTimer );
+#endif
+
+/*
+ * The benchmarks themselves, each of which is called from the controller task.
+ */
+static void prvBenchTimestamp( void );
+static void prvBenchQueues( void );
+static void prvBenchSemaphoreWake( void );
+static void prvBenchMutex( void );
+static void prvBenchTimerCommand( void );
+static void prvBenchContextSwitch( void );
+
+/*
+ * Utilities to collect and output the statistics.
+ */
+static void prvResultReset( xBenchResult *pxResult );
+static void prvResultAdd( xBenchResult *pxResult, unsigned long ulSample );
+static void prvResultOutput( const char *pcName, unsigned long ulParameter, const xBenchResult *pxResult );
+
+/*-----------------------------------------------------------*/
+
+/* The queue item sizes, and a queue for each. */
+static const unsigned portBASE_TYPE uxItemSizes[ benchNUM_ITEM_SIZES ] = { 1, 4, 16, benchMAX_ITEM_SIZE };
+static xQueueHandle xQueues[ benchNUM_ITEM_SIZES ];
+
+/* The objects the helper tasks block on. */
+static xSemaphoreHandle xWakeSemaphore = NULL;
+static xSemaphoreHandle xYieldStartSemaphore = NULL;
+#if configUSE_MUTEXES == 1
+	static xSemaphoreHandle xMutex = NULL;
+	static xSemaphoreHandle xMutexStartSemaphore = NULL;
+#endif
+
+#if configUSE_TIMERS == 1
+	static xTimerHandle xBenchTimer = NULL;
+#endif
+
+/* Timestamps taken by the helper tasks, and a count of the number of times
+each helper has run, so the controller can check it ran when expected. */
+static volatile unsigned long ulWakeTime = 0UL, ulWakeCycles = 0UL;
+static volatile unsigned long ulContendTime = 0UL, ulAcquireTime = 0UL, ulMutexCycles = 0UL;
+static volatile unsigned long ulYieldTime = 0UL;
+static volatile portBASE_TYPE xYieldRunning = pdFALSE;
+
+/* The priority of the controller task. */
+static unsigned portBASE_TYPE uxBenchPriority = tskIDLE_PRIORITY;
+
+/* Flags and counts that can be queried by the application. */
+static volatile portBASE_TYPE xBenchmarksComplete = pdFALSE;
+static volatile unsigned long ulErrorCount = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vStartKernelBenchmarks( unsigned portBASE_TYPE uxPriority )
+{
+unsigned portBASE_TYPE ux;
+
+	uxBenchPriority = uxPriority;
+	benchCONFIGURE_TIMESTAMP();
+
+	for( ux = 0; ux < benchNUM_ITEM_SIZES; ux++ )
+	{
+		xQueues[ ux ] = xQueueCreate( 1, uxItemSizes[ ux ] );
+		configASSERT( xQueues[ ux ] );
+	}
+
+	/* The binary semaphores are created 'given', so take them straight away
+	so the helper tasks block when they first run. */
+	vSemaphoreCreateBinary( xWakeSemaphore );
+	configASSERT( xWakeSemaphore );
+	xSemaphoreTake( xWakeSemaphore, benchDONT_BLOCK );
+	vSemaphoreCreateBinary( xYieldStartSemaphore );
+	configASSERT( xYieldStartSemaphore );
+	xSemaphoreTake( xYieldStartSemaphore, benchDONT_BLOCK );
+
+	#if configUSE_MUTEXES == 1
+	{
+		xMutex = xSemaphoreCreateMutex();
+		configASSERT( xMutex );
+		vSemaphoreCreateBinary( xMutexStartSemaphore );
+		configASSERT( xMutexStartSemaphore );
+		xSemaphoreTake( xMutexStartSemaphore, benchDONT_BLOCK );
+		xTaskCreate( prvMutexContenderTask, ( signed char * ) "BMutex", benchHELPER_STACK_SIZE, NULL, uxPriority + 1, NULL );
+	}
+	#endif
+
+	#if configUSE_TIMERS == 1
+	{
+		xBenchTimer = xTimerCreate( ( const signed char * ) "Bench", benchTIMER_PERIOD, pdFALSE, NULL, prvBenchTimerCallback );
+		configASSERT( xBenchTimer );
+	}
+	#endif
+
+	xTaskCreate( prvSemaphoreWakeTask, ( signed char * ) "BWake", benchHELPER_STACK_SIZE, NULL, uxPriority + 1, NULL );
+	xTaskCreate( prvYieldTask, ( signed char * ) "BYield", benchHELPER_STACK_SIZE, NULL, uxPriority, NULL );
+	xTaskCreate( prvBenchControllerTask, ( signed char * ) "BCtrl", benchCONTROLLER_STACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xAreKernelBenchmarksComplete( void )
+{
+	return xBenchmarksComplete;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xAreKernelBenchmarkTasksStillRunning( void )
+{
+portBASE_TYPE xReturn;
+
+	if( ulErrorCount == 0UL )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchControllerTask( void *pvParameters )
+{
+char cLine[ benchLINE_LENGTH ];
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	prvBenchTimestamp();
+	prvBenchQueues();
+	prvBenchSemaphoreWake();
+	prvBenchMutex();
+	prvBenchTimerCommand();
+	prvBenchContextSwitch();
+
+	sprintf( cLine, "{\"bench\":\"complete\",\"errors\":%u}", ( unsigned int ) ulErrorCount );
+	vTaskSuspendAll();
+	{
+		benchOUTPUT_LINE( cLine );
+	}
+	xTaskResumeAll();
+
+	xBenchmarksComplete = pdTRUE;
+
+	/* There is nothing more to do. */
+	for( ;; )
+	{
+		vTaskDelay( portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTimestamp( void )
+{
+xBenchResult xResult;
+unsigned long ulStart, ulEnd, ul;
+
+	prvResultReset( &xResult );
+	for( ul = 0UL; ul < benchITERATIONS; ul++ )
+	{
+		ulStart = benchGET_TIMESTAMP();
+		ulEnd = benchGET_TIMESTAMP();
+		prvResultAdd( &xResult, ulEnd - ulStart );
+	}
+	prvResultOutput( "timestamp", 0UL, &xResult );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchQueues( void )
+{
+xBenchResult xSendResult, xReceiveResult;
+unsigned long ulStart, ulSent, ulReceived, ul;
+unsigned portBASE_TYPE ux;
+portBASE_TYPE xSendStatus, xReceiveStatus;
+unsigned char ucItem[ benchMAX_ITEM_SIZE ] = { 0 };
+
+	for( ux = 0; ux < benchNUM_ITEM_SIZES; ux++ )
+	{
+		prvResultReset( &xSendResult );
+		prvResultReset( &xReceiveResult );
+
+		for( ul = 0UL; ul < benchITERATIONS; ul++ )
+		{
+			/* The queue has space for one item, and is empty, so neither
+			call blocks. */
+			ulStart = benchGET_TIMESTAMP();
+			xSendStatus = xQueueSend( xQueues[ ux ], ucItem, benchDONT_BLOCK );
+			ulSent = benchGET_TIMESTAMP();
+			xReceiveStatus = xQueueReceive( xQueues[ ux ], ucItem, benchDONT_BLOCK );
+			ulReceived = benchGET_TIMESTAMP();
+
+			if( ( xSendStatus == pdPASS ) && ( xReceiveStatus == pdPASS ) )
+			{
+				prvResultAdd( &xSendResult, ulSent - ulStart );
+				prvResultAdd( &xReceiveResult, ulReceived - ulSent );
+			}
+			else
+			{
+				ulErrorCount++;
+			}
+		}
+
+		prvResultOutput( "queue_send", ( unsigned long ) uxItemSizes[ ux ], &xSendResult );
+		prvResultOutput( "queue_receive", ( unsigned long ) uxItemSizes[ ux ], &xReceiveResult );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchSemaphoreWake( void )
+{
+xBenchResult xResult;
+unsigned long ulStart, ulCycles, ul;
+
+	prvResultReset( &xResult );
+	for( ul = 0UL; ul < benchITERATIONS; ul++ )
+	{
+		ulCycles = ulWakeCycles;
+
+		/* The semaphore wake task has the higher priority, so runs before
+		xSemaphoreGive() returns. */
+		ulStart = benchGET_TIMESTAMP();
+		xSemaphoreGive( xWakeSemaphore );
+
+		if( ulWakeCycles != ulCycles )
+		{
+			prvResultAdd( &xResult, ulWakeTime - ulStart );
+		}
+		else
+		{
+			ulErrorCount++;
+		}
+	}
+	prvResultOutput( "semaphore_wake", 0UL, &xResult );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSemaphoreWakeTask( void *pvParameters )
+{
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xSemaphoreTake( xWakeSemaphore, portMAX_DELAY ) == pdPASS )
+		{
+			ulWakeTime = benchGET_TIMESTAMP();
+			ulWakeCycles++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchMutex( void )
+{
+	#if configUSE_MUTEXES == 1
+	{
+	xBenchResult xResult, xInheritResult, xDisinheritResult;
+	unsigned long ulStart, ulEnd, ulCycles, ul;
+
+		/* First the uncontended case. */
+		prvResultReset( &xResult );
+		for( ul = 0UL; ul < benchITERATIONS; ul++ )
+		{
+			ulStart = benchGET_TIMESTAMP();
+			xSemaphoreTake( xMutex, benchDONT_BLOCK );
+			xSemaphoreGive( xMutex );
+			ulEnd = benchGET_TIMESTAMP();
+			prvResultAdd( &xResult, ulEnd - ulStart );
+		}
+		prvResultOutput( "mutex_take_give", 0UL, &xResult );
+
+		/* Then with the higher priority contender task blocking on the mutex
+		while this task holds it. */
+		prvResultReset( &xInheritResult );
+		prvResultReset( &xDisinheritResult );
+		for( ul = 0UL; ul < benchITERATIONS; ul++ )
+		{
+			if( xSemaphoreTake( xMutex, benchDONT_BLOCK ) != pdPASS )
+			{
+				ulErrorCount++;
+				continue;
+			}
+
+			/* The contender runs, blocks on the mutex, so raises the priority
+			of this task, and this task runs again. */
+			ulCycles = ulMutexCycles;
+			xSemaphoreGive( xMutexStartSemaphore );
+			ulEnd = benchGET_TIMESTAMP();
+			prvResultAdd( &xInheritResult, ulEnd - ulContendTime );
+
+			#if INCLUDE_uxTaskPriorityGet == 1
+			{
+				if( uxTaskPriorityGet( NULL ) != ( uxBenchPriority + 1 ) )
+				{
+					ulErrorCount++;
+				}
+			}
+			#endif
+
+			/* Giving the mutex back returns this task to its own priority,
+			and the contender runs before xSemaphoreGive() returns. */
+			ulStart = benchGET_TIMESTAMP();
+			xSemaphoreGive( xMutex );
+
+			if( ulMutexCycles != ulCycles )
+			{
+				prvResultAdd( &xDisinheritResult, ulAcquireTime - ulStart );
+			}
+			else
+			{
+				ulErrorCount++;
+			}
+		}
+		prvResultOutput( "mutex_inherit", 0UL, &xInheritResult );
+		prvResultOutput( "mutex_disinherit", 0UL, &xDisinheritResult );
+	}
+	#endif /* configUSE_MUTEXES */
+}
+/*-----------------------------------------------------------*/
+
+#if configUSE_MUTEXES == 1
+
+	static void prvMutexContenderTask( void *pvParameters )
+	{
+		/* Just to remove compiler warning. */
+		( void ) pvParameters;
+
+		for( ;; )
+		{
+			if( xSemaphoreTake( xMutexStartSemaphore, portMAX_DELAY ) == pdPASS )
+			{
+				ulContendTime = benchGET_TIMESTAMP();
+				if( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS )
+				{
+					ulAcquireTime = benchGET_TIMESTAMP();
+					ulMutexCycles++;
+					xSemaphoreGive( xMutex );
+				}
+			}
+		}
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+static void prvBenchTimerCommand( void )
+{
+	#if configUSE_TIMERS == 1
+	{
+	xBenchResult xResult;
+	unsigned long ulStart, ulEnd, ul;
+
+		/* If the timer service task does not have the higher priority this
+		would only measure the time to post the command. */
+		if( configTIMER_TASK_PRIORITY > uxBenchPriority )
+		{
+			prvResultReset( &xResult );
+			for( ul = 0UL; ul < benchITERATIONS; ul++ )
+			{
+				ulStart = benchGET_TIMESTAMP();
+				if( xTimerReset( xBenchTimer, benchTIMER_BLOCK_TIME ) == pdPASS )
+				{
+					ulEnd = benchGET_TIMESTAMP();
+					prvResultAdd( &xResult, ulEnd - ulStart );
+				}
+				else
+				{
+					ulErrorCount++;
+				}
+			}
+			xTimerStop( xBenchTimer, benchTIMER_BLOCK_TIME );
+			prvResultOutput( "timer_command", 0UL, &xResult );
+		}
+	}
+	#endif /* configUSE_TIMERS */
+}
+/*-----------------------------------------------------------*/
+
+#if configUSE_TIMERS == 1
+
+	static void prvBenchTimerCallback( xTimerHandle xTimer )
+	{
+		/* The timer is always reset or stopped before it expires, so there is
+		nothing to do. */
+		( void ) xTimer;
+	}
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+static void prvBenchContextSwitch( void )
+{
+xBenchResult xResult;
+unsigned long ulEnd, ul;
+
+	/* The yield task has the same priority as this task, so each taskYIELD()
+	runs the yield task, which takes a timestamp then yields straight back. */
+	prvResultReset( &xResult );
+	xYieldRunning = pdTRUE;
+	xSemaphoreGive( xYieldStartSemaphore );
+
+	for( ul = 0UL; ul < benchITERATIONS; ul++ )
+	{
+		taskYIELD();
+		ulEnd = benchGET_TIMESTAMP();
+		prvResultAdd( &xResult, ulEnd - ulYieldTime );
+	}
+
+	/* Let the yield task see that the benchmark has finished, so it blocks on
+	its semaphore again. */
+	xYieldRunning = pdFALSE;
+	taskYIELD();
+
+	prvResultOutput( "context_switch", 0UL, &xResult );
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldTask( void *pvParameters )
+{
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xSemaphoreTake( xYieldStartSemaphore, portMAX_DELAY ) == pdPASS )
+		{
+			while( xYieldRunning == pdTRUE )
+			{
+				ulYieldTime = benchGET_TIMESTAMP();
+				taskYIELD();
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvResultReset( xBenchResult *pxResult )
+{
+	pxResult->ulSamples = 0UL;
+	pxResult->ulMin = ~0UL;
+	pxResult->ulMax = 0UL;
+	pxResult->ullTotal = 0ULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResultAdd( xBenchResult *pxResult, unsigned long ulSample )
+{
+	pxResult->ulSamples++;
+	pxResult->ullTotal += ulSample;
+
+	if( ulSample < pxResult->ulMin )
+	{
+		pxResult->ulMin = ulSample;
+	}
+
+	if( ulSample > pxResult->ulMax )
+	{
+		pxResult->ulMax = ulSample;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvResultOutput( const char *pcName, unsigned long ulParameter, const xBenchResult *pxResult )
+{
+char cLine[ benchLINE_LENGTH ];
+unsigned long ulMean = 0UL, ulMin = 0UL;
+
+	if( pxResult->ulSamples > 0UL )
+	{
+		ulMean = ( unsigned long ) ( pxResult->ullTotal / pxResult->ulSamples );
+		ulMin = pxResult->ulMin;
+	}
+	else
+	{
+		ulErrorCount++;
+	}
+
+	sprintf( cLine, "{\"bench\":\"%s\",\"param\":%u,\"samples\":%u,\"min\":%u,\"mean\":%u,\"max\":%u,\"hz\":%u}",
+			 pcName, ( unsigned int ) ulParameter, ( unsigned int ) pxResult->ulSamples, ( unsigned int ) ulMin,
+			 ( unsigned int ) ulMean, ( unsigned int ) pxResult->ulMax, ( unsigned int ) benchTIMESTAMP_HZ );
+
+	/* The scheduler is suspended so this task cannot be switched out while
+	the C library is part way through outputting the line. */
+	vTaskSuspendAll();
+	{
+		benchOUTPUT_LINE( cLine );
+	}
+	xTaskResumeAll();
+}
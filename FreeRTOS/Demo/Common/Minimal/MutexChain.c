@@ -0,0 +1,836 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+	FreeRTOS supports many tools and architectures. V7.0.0 is sponsored by:
+	Atollic AB - Atollic provides professional embedded systems development 
+	tools for C/C++ development, code analysis and test automation.  
+	See http://www.atollic.com
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+	Tests priority inheritance through a chain of mutexes, and the deletion of
+	a task that holds a mutex.
+
+	Three link tasks each hold one mutex of a chain.  Each link after the first
+	then blocks on the mutex held by the link before it, and the top task blocks
+	on the mutex held by the last link:
+
+		Link0 holds xChain[ 0 ]
+		Link1 holds xChain[ 1 ] and waits for xChain[ 0 ]
+		Link2 holds xChain[ 2 ] and waits for xChain[ 1 ]
+		Top waits for xChain[ 2 ]
+
+	Each task has a higher base priority than the task before it, and the
+	control task, which has a higher priority than all of them, builds the
+	chain one task at a time.  As each task blocks, every task further down
+	the chain must inherit its priority - Link0 ends up running at the priority
+	of Top, three mutexes away.  The control task then lowers and raises the
+	priority of Top while it is blocked and checks the whole chain follows.
+	Finally it lets Link0 go, and the chain unwinds with each task giving back
+	its mutexes and returning to its base priority.
+
+	Each cycle then builds the chain again, but Top only waits for a limited
+	time.  While Top waits the whole chain runs at its priority, and when it
+	gives up waiting the chain must fall back to the priority of Link2, the
+	highest priority task still waiting in it.
+
+	Two more tests are run with only part of the chain:
+
+		- Top waits with a timeout for the mutex held by Link0 alone.  Link0
+		  inherits the priority of Top, and drops back to its base priority
+		  when Top gives up waiting.
+
+		- Link0 holds a second mutex as well as xChain[ 0 ].  Link1 waits for
+		  xChain[ 0 ] and Top waits for the second mutex, so Link0 runs at the
+		  priority of Top.  When Link0 gives the second mutex back it must keep
+		  the priority it inherited from Link1 through xChain[ 0 ], and only
+		  drop to its base priority when it gives xChain[ 0 ] back too.
+
+	Before the first cycle the control task also creates a task that takes a
+	recursive mutex, and deletes it while it holds the mutex.  Once the idle
+	task has freed the deleted task a new task is created - its TCB may well
+	use the same memory - and neither it nor the control task must be treated
+	as the holder of the mutex.  If INCLUDE_xSemaphoreGetMutexHolder is 1 the
+	control task also checks directly that the mutex has no holder once the
+	task is deleted.  This is only done once, before the death tasks first
+	check the number of tasks in the system has not changed.
+*/
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Demo app include files. */
+#include "MutexChain.h"
+
+/* The number of mutexes, and link tasks, in the chain. */
+#define mchainLINKS						( 3 )
+
+/* Priorities of the tasks.  The base priority of link n is
+mchainLINK_PRIORITY + n. */
+#define mchainLINK_PRIORITY				( tskIDLE_PRIORITY + 1 )
+#define mchainTOP_PRIORITY				( mchainLINK_PRIORITY + mchainLINKS )
+#define mchainCONTROL_PRIORITY			( mchainTOP_PRIORITY + 1 )
+#define mchainDELETE_TEST_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+/* The control task polls for the other tasks to reach each step, for at most
+mchainMAX_POLLS times mchainPOLL_DELAY. */
+#define mchainPOLL_DELAY				( 10 / portTICK_RATE_MS )
+#define mchainMAX_POLLS					( 200 )
+#define mchainSHORT_DELAY				( 20 / portTICK_RATE_MS )
+#define mchainNO_DELAY					( ( portTickType ) 0 )
+
+/* How long Top waits in the timeout tests.  Long enough for the control task
+to see the chain inherit the priority of Top before Top gives up. */
+#define mchainTIMEOUT					( 100 / portTICK_RATE_MS )
+
+/* Long enough for the idle task to free a deleted task. */
+#define mchainCLEAN_UP_DELAY			( 200 / portTICK_RATE_MS )
+
+/* The tasks as described at the top of this file. */
+static void prvLinkTask( void *pvParameters );
+static void prvTopTask( void *pvParameters );
+static void prvControlTask( void *pvParameters );
+
+/* Wait until a condition checked by prvStepDone() is met. */
+static portBASE_TYPE prvWaitForStep( portBASE_TYPE xStep, unsigned portBASE_TYPE uxParameter );
+static portBASE_TYPE prvStepDone( portBASE_TYPE xStep, unsigned portBASE_TYPE uxParameter );
+
+/* The tests run by the control task each cycle. */
+static void prvTestChain( void );
+static void prvTestChainTimeout( void );
+static void prvTestWaiterTimeout( void );
+static void prvTestTwoMutexes( void );
+
+/* Let the first uxLinks link tasks build the chain, checking the priority of
+Link0 as each one blocks. */
+static void prvBuildChain( unsigned portBASE_TYPE uxLinks );
+
+/* Have Top wait for xMutex for up to xTicksToWait, and wait for Link0 to
+inherit its priority. */
+static void prvStartTop( xSemaphoreHandle xMutex, portTickType xTicksToWait );
+
+/* Let Link0 go, and check every task gives back its mutexes and returns to
+its base priority. */
+static void prvUnwindChain( unsigned portBASE_TYPE uxLastTopCycles );
+
+/* Check the priority every link task is running at. */
+static void prvCheckChainPriorities( unsigned portBASE_TYPE uxExpectedPriority );
+
+/* Check the priorities Top saw the link tasks running at when it gave up
+waiting.  Each must be uxExpectedPriority, or its base priority if that is
+higher. */
+static void prvCheckTimeoutPriorities( unsigned portBASE_TYPE uxExpectedPriority );
+
+/* The steps prvWaitForStep() can wait for. */
+#define mchainSTEP_HOLDING				( 0 )	/* The given link task holds its mutex and is suspended. */
+#define mchainSTEP_LINK0_PRIORITY		( 1 )	/* Link0 runs at the given priority. */
+#define mchainSTEP_UNWOUND				( 2 )	/* Top has completed another cycle, and all the tasks are suspended again. */
+#define mchainSTEP_TOP_DONE				( 3 )	/* Top has completed another cycle and is suspended again. */
+#define mchainSTEP_DELETE_READY			( 4 )	/* The task to be deleted holds its mutex and is suspended. */
+#define mchainSTEP_PROBED				( 5 )	/* The probe task has completed. */
+
+#if ( INCLUDE_vTaskDelete == 1 ) && ( configUSE_RECURSIVE_MUTEXES == 1 )
+
+	/* The holder deletion test described at the top of this file. */
+	static void prvTestHolderDeletion( void );
+	static void prvDeletedHolderTask( void *pvParameters );
+	static void prvProbeTask( void *pvParameters );
+
+	static xSemaphoreHandle xDeleteMutex;
+	static xTaskHandle xDeletedHolder;
+	static volatile portBASE_TYPE xDeletedHolderHolding = pdFALSE, xProbeDone = pdFALSE;
+
+#endif
+
+/* The names of the link tasks. */
+static const char * const pcLinkNames[ mchainLINKS ] = { "MuLnk0", "MuLnk1", "MuLnk2" };
+
+/* The mutexes that make up the chain, and the second mutex held by Link0 in
+the two mutex test. */
+static xSemaphoreHandle xChain[ mchainLINKS ], xSecondMutex;
+
+/* The mutex Top waits for, and for how long. */
+static xSemaphoreHandle xTopMutex;
+static portTickType xTopTicksToWait;
+
+/* The priorities of the link tasks when Top last gave up waiting. */
+static volatile unsigned portBASE_TYPE uxPrioritiesAfterTimeout[ mchainLINKS ];
+
+/* Set when Link0 is to take xSecondMutex as well as xChain[ 0 ]. */
+static volatile portBASE_TYPE xLink0HoldsSecond = pdFALSE;
+
+/* Handles of the tasks, so the control task can resume them and check their
+priorities. */
+static xTaskHandle xLinkTasks[ mchainLINKS ], xTopTask;
+
+/* Variables used to detect and latch errors. */
+static volatile portBASE_TYPE xErrorOccurred = pdFALSE;
+static volatile portBASE_TYPE xLinkHolding[ mchainLINKS ];
+static volatile unsigned portBASE_TYPE uxTopCycles = 0, uxControlCycles = 0;
+
+/*-----------------------------------------------------------*/
+
+void vStartMutexChainTasks( void )
+{
+unsigned portBASE_TYPE ux;
+
+	for( ux = 0; ux < mchainLINKS; ux++ )
+	{
+		xChain[ ux ] = xSemaphoreCreateMutex();
+
+		if( xChain[ ux ] == NULL )
+		{
+			return;
+		}
+	}
+
+	xSecondMutex = xSemaphoreCreateMutex();
+
+	if( xSecondMutex == NULL )
+	{
+		return;
+	}
+
+	#if ( INCLUDE_vTaskDelete == 1 ) && ( configUSE_RECURSIVE_MUTEXES == 1 )
+	{
+		xDeleteMutex = xSemaphoreCreateRecursiveMutex();
+
+		if( xDeleteMutex == NULL )
+		{
+			return;
+		}
+	}
+	#endif
+
+	/* The link and top tasks suspend themselves straight away, and only run
+	when the control task resumes them. */
+	for( ux = 0; ux < mchainLINKS; ux++ )
+	{
+		xTaskCreate( prvLinkTask, ( signed char * ) pcLinkNames[ ux ], configMINIMAL_STACK_SIZE, ( void * ) ux, mchainLINK_PRIORITY + ux, &( xLinkTasks[ ux ] ) );
+	}
+
+	xTaskCreate( prvTopTask, ( signed char * ) "MuTop", configMINIMAL_STACK_SIZE, NULL, mchainTOP_PRIORITY, &xTopTask );
+	xTaskCreate( prvControlTask, ( signed char * ) "MuCtrl", configMINIMAL_STACK_SIZE, NULL, mchainCONTROL_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvLinkTask( void *pvParameters )
+{
+unsigned portBASE_TYPE uxLink = ( unsigned portBASE_TYPE ) pvParameters;
+
+	for( ;; )
+	{
+		/* Wait for the control task to build the chain. */
+		vTaskSuspend( NULL );
+
+		/* Nothing else takes this mutex, so it must be available. */
+		if( xSemaphoreTake( xChain[ uxLink ], mchainNO_DELAY ) != pdPASS )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+
+		xLinkHolding[ uxLink ] = pdTRUE;
+
+		if( uxLink == 0 )
+		{
+			if( xLink0HoldsSecond == pdTRUE )
+			{
+				if( xSemaphoreTake( xSecondMutex, mchainNO_DELAY ) != pdPASS )
+				{
+					xErrorOccurred = pdTRUE;
+				}
+			}
+
+			/* The first link holds its mutex until the control task lets the
+			chain unwind. */
+			vTaskSuspend( NULL );
+
+			if( xLink0HoldsSecond == pdTRUE )
+			{
+				/* Top, which is waiting for the second mutex, runs as soon as
+				it is given.  Link1 is still waiting for xChain[ 0 ], so this
+				task must keep the priority inherited from Link1. */
+				if( xSemaphoreGive( xSecondMutex ) != pdPASS )
+				{
+					xErrorOccurred = pdTRUE;
+				}
+
+				if( uxTaskPriorityGet( NULL ) != ( mchainLINK_PRIORITY + 1 ) )
+				{
+					xErrorOccurred = pdTRUE;
+				}
+			}
+		}
+		else
+		{
+			/* Block on the mutex held by the link before this one.  This task
+			has a higher priority than that link, so the link inherits it, and
+			so does every link before it in the chain. */
+			if( xSemaphoreTake( xChain[ uxLink - 1 ], portMAX_DELAY ) != pdPASS )
+			{
+				xErrorOccurred = pdTRUE;
+			}
+
+			if( xSemaphoreGive( xChain[ uxLink - 1 ] ) != pdPASS )
+			{
+				xErrorOccurred = pdTRUE;
+			}
+		}
+
+		/* Hand the mutex on to the task blocked on it.  That task has a
+		higher base priority, so it runs straight away, and this task drops
+		back to its own base priority. */
+		xLinkHolding[ uxLink ] = pdFALSE;
+
+		if( xSemaphoreGive( xChain[ uxLink ] ) != pdPASS )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+
+		if( uxTaskPriorityGet( NULL ) != ( mchainLINK_PRIORITY + uxLink ) )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTopTask( void *pvParameters )
+{
+unsigned portBASE_TYPE ux;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+
+		/* Block on the mutex chosen by the control task.  If the block time
+		is limited the mutex is held for longer, so the wait must time out. */
+		if( xTopTicksToWait == portMAX_DELAY )
+		{
+			if( xSemaphoreTake( xTopMutex, portMAX_DELAY ) != pdPASS )
+			{
+				xErrorOccurred = pdTRUE;
+			}
+
+			if( xSemaphoreGive( xTopMutex ) != pdPASS )
+			{
+				xErrorOccurred = pdTRUE;
+			}
+		}
+		else
+		{
+			if( xSemaphoreTake( xTopMutex, xTopTicksToWait ) != pdFAIL )
+			{
+				xErrorOccurred = pdTRUE;
+			}
+
+			/* Record the priorities of the links before this task suspends
+			itself, as suspending a task also stops it waiting for a mutex,
+			and would hide a holder that kept the priority of this task. */
+			for( ux = 0; ux < mchainLINKS; ux++ )
+			{
+				uxPrioritiesAfterTimeout[ ux ] = uxTaskPriorityGet( xLinkTasks[ ux ] );
+			}
+		}
+
+		uxTopCycles++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	#if ( INCLUDE_vTaskDelete == 1 ) && ( configUSE_RECURSIVE_MUTEXES == 1 )
+	{
+		prvTestHolderDeletion();
+	}
+	#endif
+
+	for( ;; )
+	{
+		prvTestChain();
+		prvTestChainTimeout();
+		prvTestWaiterTimeout();
+		prvTestTwoMutexes();
+
+		uxControlCycles++;
+		vTaskDelay( mchainSHORT_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestChain( void )
+{
+unsigned portBASE_TYPE uxLastTopCycles = uxTopCycles;
+
+	/* Build the whole chain, with Top waiting at the end of it. */
+	prvBuildChain( mchainLINKS );
+	prvStartTop( xChain[ mchainLINKS - 1 ], portMAX_DELAY );
+	prvCheckChainPriorities( mchainTOP_PRIORITY );
+
+	/* A change to the priority of the blocked top task must pass down the
+	whole chain.  When it is lowered the links inherit from the last link,
+	which now has the highest priority left in the chain. */
+	vTaskPrioritySet( xTopTask, tskIDLE_PRIORITY );
+	prvCheckChainPriorities( mchainLINK_PRIORITY + mchainLINKS - 1 );
+
+	vTaskPrioritySet( xTopTask, mchainTOP_PRIORITY );
+	prvCheckChainPriorities( mchainTOP_PRIORITY );
+
+	prvUnwindChain( uxLastTopCycles );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestChainTimeout( void )
+{
+unsigned portBASE_TYPE uxLastTopCycles = uxTopCycles;
+
+	/* Build the whole chain again, but this time Top gives up waiting.  The
+	links must then inherit from the last link, as when the priority of Top
+	was lowered. */
+	prvBuildChain( mchainLINKS );
+	prvStartTop( xChain[ mchainLINKS - 1 ], mchainTIMEOUT );
+	prvCheckChainPriorities( mchainTOP_PRIORITY );
+
+	if( prvWaitForStep( mchainSTEP_TOP_DONE, uxLastTopCycles ) != pdPASS )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	prvCheckTimeoutPriorities( mchainLINK_PRIORITY + mchainLINKS - 1 );
+	prvCheckChainPriorities( mchainLINK_PRIORITY + mchainLINKS - 1 );
+
+	prvUnwindChain( uxLastTopCycles );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestWaiterTimeout( void )
+{
+unsigned portBASE_TYPE uxLastTopCycles = uxTopCycles;
+
+	/* Top waits with a timeout for the mutex held by Link0, and nothing
+	else.  Link0 must drop back to its base priority once Top gives up. */
+	prvBuildChain( 1 );
+	prvStartTop( xChain[ 0 ], mchainTIMEOUT );
+
+	if( prvWaitForStep( mchainSTEP_TOP_DONE, uxLastTopCycles ) != pdPASS )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	prvCheckTimeoutPriorities( mchainLINK_PRIORITY );
+
+	if( uxTaskPriorityGet( xLinkTasks[ 0 ] ) != mchainLINK_PRIORITY )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	prvUnwindChain( uxLastTopCycles );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestTwoMutexes( void )
+{
+unsigned portBASE_TYPE uxLastTopCycles = uxTopCycles;
+
+	/* Link0 holds xChain[ 0 ], which Link1 waits for, and the second mutex,
+	which Top waits for.  Link0 checks its own priority after giving back the
+	second mutex, as Top runs as soon as it does. */
+	xLink0HoldsSecond = pdTRUE;
+	prvBuildChain( 2 );
+	prvStartTop( xSecondMutex, portMAX_DELAY );
+
+	/* Link1 does not hold the second mutex, so it does not inherit from
+	Top. */
+	if( uxTaskPriorityGet( xLinkTasks[ 1 ] ) != ( mchainLINK_PRIORITY + 1 ) )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	prvUnwindChain( uxLastTopCycles );
+	xLink0HoldsSecond = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBuildChain( unsigned portBASE_TYPE uxLinks )
+{
+unsigned portBASE_TYPE ux;
+
+	/* Let the first link take its mutex and suspend itself again. */
+	vTaskResume( xLinkTasks[ 0 ] );
+	if( prvWaitForStep( mchainSTEP_HOLDING, 0 ) != pdPASS )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	/* Add the other links one at a time.  As each blocks on the mutex held by
+	the link before it, the whole chain below it must inherit its
+	priority. */
+	for( ux = 1; ux < uxLinks; ux++ )
+	{
+		vTaskResume( xLinkTasks[ ux ] );
+		if( prvWaitForStep( mchainSTEP_LINK0_PRIORITY, mchainLINK_PRIORITY + ux ) != pdPASS )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+
+		if( xLinkHolding[ ux ] != pdTRUE )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartTop( xSemaphoreHandle xMutex, portTickType xTicksToWait )
+{
+	/* Top is suspended, so it is safe to change what it waits for. */
+	xTopMutex = xMutex;
+	xTopTicksToWait = xTicksToWait;
+
+	vTaskResume( xTopTask );
+	if( prvWaitForStep( mchainSTEP_LINK0_PRIORITY, mchainTOP_PRIORITY ) != pdPASS )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnwindChain( unsigned portBASE_TYPE uxLastTopCycles )
+{
+unsigned portBASE_TYPE ux;
+
+	/* Let Link0 go.  Every task gives its mutexes back and suspends itself
+	again, so all return to their base priorities. */
+	vTaskResume( xLinkTasks[ 0 ] );
+	if( prvWaitForStep( mchainSTEP_UNWOUND, uxLastTopCycles ) != pdPASS )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+
+	for( ux = 0; ux < mchainLINKS; ux++ )
+	{
+		if( uxTaskPriorityGet( xLinkTasks[ ux ] ) != ( mchainLINK_PRIORITY + ux ) )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+
+		if( xLinkHolding[ ux ] != pdFALSE )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckChainPriorities( unsigned portBASE_TYPE uxExpectedPriority )
+{
+unsigned portBASE_TYPE ux;
+
+	/* The changes are made by the kernel while the priority of the top task
+	is set, and the link tasks are all blocked or suspended, so there is
+	nothing to wait for. */
+	for( ux = 0; ux < mchainLINKS; ux++ )
+	{
+		if( uxTaskPriorityGet( xLinkTasks[ ux ] ) != uxExpectedPriority )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTimeoutPriorities( unsigned portBASE_TYPE uxExpectedPriority )
+{
+unsigned portBASE_TYPE ux, uxExpected;
+
+	for( ux = 0; ux < mchainLINKS; ux++ )
+	{
+		uxExpected = mchainLINK_PRIORITY + ux;
+
+		if( uxExpectedPriority > uxExpected )
+		{
+			uxExpected = uxExpectedPriority;
+		}
+
+		if( uxPrioritiesAfterTimeout[ ux ] != uxExpected )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvWaitForStep( portBASE_TYPE xStep, unsigned portBASE_TYPE uxParameter )
+{
+unsigned portBASE_TYPE uxPolls;
+
+	for( uxPolls = 0; uxPolls < mchainMAX_POLLS; uxPolls++ )
+	{
+		if( prvStepDone( xStep, uxParameter ) == pdTRUE )
+		{
+			/* Give the task that completed the step time to block or
+			suspend itself after doing so. */
+			vTaskDelay( mchainPOLL_DELAY );
+			return pdPASS;
+		}
+
+		vTaskDelay( mchainPOLL_DELAY );
+	}
+
+	return pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvStepDone( portBASE_TYPE xStep, unsigned portBASE_TYPE uxParameter )
+{
+portBASE_TYPE xReturn;
+unsigned portBASE_TYPE ux;
+
+	switch( xStep )
+	{
+		case mchainSTEP_HOLDING:
+			xReturn = ( ( xLinkHolding[ uxParameter ] == pdTRUE ) && ( xTaskIsTaskSuspended( xLinkTasks[ uxParameter ] ) == pdTRUE ) );
+			break;
+
+		case mchainSTEP_LINK0_PRIORITY:
+			xReturn = ( uxTaskPriorityGet( xLinkTasks[ 0 ] ) == uxParameter );
+			break;
+
+		case mchainSTEP_TOP_DONE:
+			xReturn = ( ( uxTopCycles != uxParameter ) && ( xTaskIsTaskSuspended( xTopTask ) == pdTRUE ) );
+			break;
+
+		case mchainSTEP_UNWOUND:
+			xReturn = ( ( uxTopCycles != uxParameter ) && ( xTaskIsTaskSuspended( xTopTask ) == pdTRUE ) );
+			for( ux = 0; ux < mchainLINKS; ux++ )
+			{
+				if( ( xLinkHolding[ ux ] != pdFALSE ) || ( xTaskIsTaskSuspended( xLinkTasks[ ux ] ) != pdTRUE ) )
+				{
+					xReturn = pdFALSE;
+				}
+			}
+			break;
+
+		#if ( INCLUDE_vTaskDelete == 1 ) && ( configUSE_RECURSIVE_MUTEXES == 1 )
+
+			case mchainSTEP_DELETE_READY:
+				xReturn = ( ( xDeletedHolderHolding == pdTRUE ) && ( xTaskIsTaskSuspended( xDeletedHolder ) == pdTRUE ) );
+				break;
+
+			case mchainSTEP_PROBED:
+				xReturn = xProbeDone;
+				break;
+
+		#endif
+
+		default:
+			xReturn = pdFALSE;
+			break;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 ) && ( configUSE_RECURSIVE_MUTEXES == 1 )
+
+	static void prvTestHolderDeletion( void )
+	{
+		/* Create a task that takes the mutex and then suspends itself, and
+		delete it while it holds the mutex. */
+		if( xTaskCreate( prvDeletedHolderTask, ( signed char * ) "MuDel", configMINIMAL_STACK_SIZE, NULL, mchainDELETE_TEST_PRIORITY, &xDeletedHolder ) != pdPASS )
+		{
+			xErrorOccurred = pdTRUE;
+			return;
+		}
+
+		if( prvWaitForStep( mchainSTEP_DELETE_READY, 0 ) != pdPASS )
+		{
+			xErrorOccurred = pdTRUE;
+			return;
+		}
+
+		#if ( INCLUDE_xSemaphoreGetMutexHolder == 1 )
+		{
+			if( xSemaphoreGetMutexHolder( xDeleteMutex ) != xDeletedHolder )
+			{
+				xErrorOccurred = pdTRUE;
+			}
+		}
+		#endif
+
+		vTaskDelete( xDeletedHolder );
+
+		#if ( INCLUDE_xSemaphoreGetMutexHolder == 1 )
+		{
+			if( xSemaphoreGetMutexHolder( xDeleteMutex ) != NULL )
+			{
+				xErrorOccurred = pdTRUE;
+			}
+		}
+		#endif
+
+		/* Give the idle task time to free the TCB. */
+		vTaskDelay( mchainCLEAN_UP_DELAY );
+
+		/* The mutex has no holder, so this task cannot give it. */
+		if( xSemaphoreGiveRecursive( xDeleteMutex ) == pdPASS )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+
+		/* Nor can a task created in the memory the deleted task used. */
+		if( xTaskCreate( prvProbeTask, ( signed char * ) "MuProbe", configMINIMAL_STACK_SIZE, NULL, mchainDELETE_TEST_PRIORITY, NULL ) != pdPASS )
+		{
+			xErrorOccurred = pdTRUE;
+			return;
+		}
+
+		if( prvWaitForStep( mchainSTEP_PROBED, 0 ) != pdPASS )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+
+		vTaskDelay( mchainCLEAN_UP_DELAY );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 ) && ( configUSE_RECURSIVE_MUTEXES == 1 )
+
+	static void prvDeletedHolderTask( void *pvParameters )
+	{
+		/* Just to remove compiler warning. */
+		( void ) pvParameters;
+
+		if( xSemaphoreTakeRecursive( xDeleteMutex, mchainNO_DELAY ) != pdPASS )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+
+		xDeletedHolderHolding = pdTRUE;
+
+		/* Wait to be deleted. */
+		for( ;; )
+		{
+			vTaskSuspend( NULL );
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 ) && ( configUSE_RECURSIVE_MUTEXES == 1 )
+
+	static void prvProbeTask( void *pvParameters )
+	{
+		/* Just to remove compiler warning. */
+		( void ) pvParameters;
+
+		if( xSemaphoreGiveRecursive( xDeleteMutex ) == pdPASS )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+
+		/* The mutex was never given back, so it cannot be taken either.
+		Blocking on it must not touch the deleted task. */
+		if( xSemaphoreTakeRecursive( xDeleteMutex, mchainSHORT_DELAY ) == pdPASS )
+		{
+			xErrorOccurred = pdTRUE;
+		}
+
+		xProbeDone = pdTRUE;
+		vTaskDelete( NULL );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+/* This is called to check that all the created tasks are still running. */
+portBASE_TYPE xAreMutexChainTasksStillRunning( void )
+{
+portBASE_TYPE xReturn;
+static unsigned portBASE_TYPE uxLastControlCycles = 0;
+
+	/* Is the control task still cycling? */
+	if( uxLastControlCycles == uxControlCycles )
+	{
+		xErrorOccurred = pdTRUE;
+	}
+	else
+	{
+		uxLastControlCycles = uxControlCycles;
+	}
+
+	if( xErrorOccurred == pdTRUE )
+	{
+		xReturn = pdFAIL;
+	}
+	else
+	{
+		xReturn = pdTRUE;
+	}
+
+	return xReturn;
+}
+
@@ -112,10 +112,27 @@ struct ethip_hdr {
 
 #define ARP_HWTYPE_ETH 1
 
+/* ARP table entries are linked by slot number, which is the table index
+   plus one so that zero means "no entry" and the all zero startup state
+   is an empty table. An 8-bit slot number is enough for a table that
+   holds a full /24. */
+#if UIP_ARPTAB_SIZE < 256
+typedef u8_t arp_slot_t;
+#else
+typedef u16_t arp_slot_t;
+#endif
+#define ARP_NONE 0
+#define ARP_ENTRY(slot) (&arp_table[(slot) - 1])
+
 struct arp_entry {
   u16_t ipaddr[2];
   struct uip_eth_addr ethaddr;
   u8_t time;
+  arp_slot_t slot;           /* Slot number of this entry. */
+  arp_slot_t hash_next;      /* Next entry in the same hash bucket, or
+				next free entry. */
+  arp_slot_t lru_prev;       /* Towards the most recently used entry. */
+  arp_slot_t lru_next;       /* Towards the least recently used entry. */
 };
 
 static const struct uip_eth_addr broadcast_ethaddr =
@@ -124,14 +141,106 @@ static const u16_t broadcast_ipaddr[2] = {0xffff,0xffff};
 
 static struct arp_entry arp_table[UIP_ARPTAB_SIZE];
 static u16_t ipaddr[2];
-static u8_t i, c;
+
+/* Entries in use hang off arp_hash[], keyed on their IP address, and are
+   also kept on a doubly linked list ordered by use: arp_lru_head is the
+   entry most recently looked up or refreshed and arp_lru_tail is the
+   one to evict when the table is full. Entries freed by the timer are
+   chained through hash_next from arp_free; entries never used yet are
+   those from arp_unused onwards. */
+static arp_slot_t arp_hash[UIP_ARPTAB_HASHSIZE];
+static arp_slot_t arp_lru_head, arp_lru_tail;
+static arp_slot_t arp_free;
+static u16_t arp_unused;
 
 static u8_t arptime;
-static u8_t tmpage;
 
 #define BUF   ((struct arp_hdr *)&uip_buf[0])
 #define IPBUF ((struct ethip_hdr *)&uip_buf[0])
 /*-----------------------------------------------------------------------------------*/
+static u16_t
+arp_hashfn(u16_t *addr)
+{
+  const u8_t *a = (const u8_t *)addr;
+
+  /* Hosts on the local network usually differ only in the last
+     octet(s), so those go in unchanged. For a fixed prefix this maps
+     every host of a /24 to its own bucket once the hash table has 256
+     or more buckets. */
+  return (a[3] ^ ((u16_t)a[2] << 1) ^ ((u16_t)a[1] << 3) ^ a[0]) &
+    (UIP_ARPTAB_HASHSIZE - 1);
+}
+/*-----------------------------------------------------------------------------------*/
+static struct arp_entry *
+arp_lookup(u16_t *addr)
+{
+  arp_slot_t n;
+
+  for(n = arp_hash[arp_hashfn(addr)]; n != ARP_NONE;
+      n = ARP_ENTRY(n)->hash_next) {
+    if(uip_ipaddr_cmp(addr, ARP_ENTRY(n)->ipaddr)) {
+      return ARP_ENTRY(n);
+    }
+  }
+  return NULL;
+}
+/*-----------------------------------------------------------------------------------*/
+static void
+arp_lru_unlink(struct arp_entry *tabptr)
+{
+  if(tabptr->lru_prev != ARP_NONE) {
+    ARP_ENTRY(tabptr->lru_prev)->lru_next = tabptr->lru_next;
+  } else {
+    arp_lru_head = tabptr->lru_next;
+  }
+  if(tabptr->lru_next != ARP_NONE) {
+    ARP_ENTRY(tabptr->lru_next)->lru_prev = tabptr->lru_prev;
+  } else {
+    arp_lru_tail = tabptr->lru_prev;
+  }
+}
+/*-----------------------------------------------------------------------------------*/
+static void
+arp_lru_push(struct arp_entry *tabptr)
+{
+  tabptr->lru_prev = ARP_NONE;
+  tabptr->lru_next = arp_lru_head;
+  if(arp_lru_head != ARP_NONE) {
+    ARP_ENTRY(arp_lru_head)->lru_prev = tabptr->slot;
+  } else {
+    arp_lru_tail = tabptr->slot;
+  }
+  arp_lru_head = tabptr->slot;
+}
+/*-----------------------------------------------------------------------------------*/
+static void
+arp_lru_touch(struct arp_entry *tabptr)
+{
+  if(arp_lru_head != tabptr->slot) {
+    arp_lru_unlink(tabptr);
+    arp_lru_push(tabptr);
+  }
+}
+/*-----------------------------------------------------------------------------------*/
+static void
+arp_remove(struct arp_entry *tabptr)
+{
+  arp_slot_t *link;
+
+  /* Buckets are short, so finding the link that points at the entry is
+     cheap. */
+  for(link = &arp_hash[arp_hashfn(tabptr->ipaddr)];
+      *link != tabptr->slot;
+      link = &ARP_ENTRY(*link)->hash_next);
+  *link = tabptr->hash_next;
+
+  arp_lru_unlink(tabptr);
+
+  memset(tabptr->ipaddr, 0, 4);
+  tabptr->hash_next = arp_free;
+  arp_free = tabptr->slot;
+}
+/*-----------------------------------------------------------------------------------*/
 /**
  * Initialize the ARP module.
  *
@@ -140,9 +249,11 @@ static u8_t tmpage;
 void
 uip_arp_init(void)
 {
-  for(i = 0; i < UIP_ARPTAB_SIZE; ++i) {
-    memset(arp_table[i].ipaddr, 0, 4);
-  }
+  memset(arp_table, 0, sizeof(arp_table));
+  memset(arp_hash, 0, sizeof(arp_hash));
+  arp_lru_head = arp_lru_tail = ARP_NONE;
+  arp_free = ARP_NONE;
+  arp_unused = 0;
 }
 /*-----------------------------------------------------------------------------------*/
 /**
@@ -158,79 +269,57 @@ void
 uip_arp_timer(void)
 {
   struct arp_entry *tabptr;
+  arp_slot_t n;
 
   ++arptime;
-  for(i = 0; i < UIP_ARPTAB_SIZE; ++i) {
-    tabptr = &arp_table[i];
-    if((tabptr->ipaddr[0] | tabptr->ipaddr[1]) != 0 &&
-       arptime - tabptr->time >= UIP_ARP_MAXAGE) {
-      memset(tabptr->ipaddr, 0, 4);
+
+  /* Only entries in use are visited. */
+  for(n = arp_lru_head; n != ARP_NONE; ) {
+    tabptr = ARP_ENTRY(n);
+    n = tabptr->lru_next;
+    if((u8_t)(arptime - tabptr->time) >= UIP_ARP_MAXAGE) {
+      arp_remove(tabptr);
     }
   }
-
 }
 /*-----------------------------------------------------------------------------------*/
 static void
 uip_arp_update(u16_t *ipaddr, struct uip_eth_addr *ethaddr)
 {
   register struct arp_entry *tabptr;
-  /* Walk through the ARP mapping table and try to find an entry to
-     update. If none is found, the IP -> MAC address mapping is
-     inserted in the ARP table. */
-  for(i = 0; i < UIP_ARPTAB_SIZE; ++i) {
-
-    tabptr = &arp_table[i];
-    /* Only check those entries that are actually in use. */
-    if(tabptr->ipaddr[0] != 0 &&
-       tabptr->ipaddr[1] != 0) {
-
-      /* Check if the source IP address of the incoming packet matches
-         the IP address in this ARP table entry. */
-      if(ipaddr[0] == tabptr->ipaddr[0] &&
-	 ipaddr[1] == tabptr->ipaddr[1]) {
-	
-	/* An old entry found, update this and return. */
-	memcpy(tabptr->ethaddr.addr, ethaddr->addr, 6);
-	tabptr->time = arptime;
-
-	return;
-      }
-    }
-  }
-
-  /* If we get here, no existing ARP table entry was found, so we
-     create one. */
-
-  /* First, we try to find an unused entry in the ARP table. */
-  for(i = 0; i < UIP_ARPTAB_SIZE; ++i) {
-    tabptr = &arp_table[i];
-    if(tabptr->ipaddr[0] == 0 &&
-       tabptr->ipaddr[1] == 0) {
-      break;
-    }
+  u16_t h;
+
+  /* If there is an entry for this IP address already, refresh it. */
+  tabptr = arp_lookup(ipaddr);
+  if(tabptr != NULL) {
+    memcpy(tabptr->ethaddr.addr, ethaddr->addr, 6);
+    tabptr->time = arptime;
+    arp_lru_touch(tabptr);
+    return;
   }
 
-  /* If no unused entry is found, we try to find the oldest entry and
-     throw it away. */
-  if(i == UIP_ARPTAB_SIZE) {
-    tmpage = 0;
-    c = 0;
-    for(i = 0; i < UIP_ARPTAB_SIZE; ++i) {
-      tabptr = &arp_table[i];
-      if(arptime - tabptr->time > tmpage) {
-	tmpage = arptime - tabptr->time;
-	c = i;
-      }
-    }
-    i = c;
-    tabptr = &arp_table[i];
+  /* Otherwise take an unused entry or, if the table is full, throw away
+     the least recently used one. */
+  if(arp_free != ARP_NONE) {
+    tabptr = ARP_ENTRY(arp_free);
+    arp_free = tabptr->hash_next;
+  } else if(arp_unused < UIP_ARPTAB_SIZE) {
+    tabptr = &arp_table[arp_unused];
+    tabptr->slot = (arp_slot_t)(++arp_unused);
+  } else {
+    tabptr = ARP_ENTRY(arp_lru_tail);
+    arp_remove(tabptr);
+    arp_free = tabptr->hash_next;
   }
 
-  /* Now, i is the ARP table entry which we will fill with the new
-     information. */
   memcpy(tabptr->ipaddr, ipaddr, 4);
   memcpy(tabptr->ethaddr.addr, ethaddr->addr, 6);
   tabptr->time = arptime;
+
+  h = arp_hashfn(ipaddr);
+  tabptr->hash_next = arp_hash[h];
+  arp_hash[h] = tabptr->slot;
+  arp_lru_push(tabptr);
 }
 /*-----------------------------------------------------------------------------------*/
 /**
@@ -393,14 +482,9 @@ uip_arp_out(void)
       uip_ipaddr_copy(ipaddr, IPBUF->destipaddr);
     }
 
-    for(i = 0; i < UIP_ARPTAB_SIZE; ++i) {
-      tabptr = &arp_table[i];
-      if(uip_ipaddr_cmp(ipaddr, tabptr->ipaddr)) {
-	break;
-      }
-    }
+    tabptr = arp_lookup(ipaddr);
 
-    if(i == UIP_ARPTAB_SIZE) {
+    if(tabptr == NULL) {
       /* The destination address was not in our ARP table, so we
 	 overwrite the IP packet with an ARP request. */
 
@@ -424,6 +508,9 @@ uip_arp_out(void)
       return;
     }
 
+    /* Keep hosts we are talking to at the front of the LRU list. */
+    arp_lru_touch(tabptr);
+
     /* Build an ethernet header. */
     memcpy(IPBUF->ethhdr.dest.addr, tabptr->ethaddr.addr, 6);
   }
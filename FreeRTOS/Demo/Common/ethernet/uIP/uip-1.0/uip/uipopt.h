@@ -339,7 +339,8 @@
  * The size of the ARP table.
  *
  * This option should be set to a larger value if this uIP node will
- * have many connections from the local network.
+ * have many connections from the local network. 254 entries hold
+ * every host of a /24 network.
  *
  * \hideinitializer
  */
@@ -349,6 +350,33 @@
 #define UIP_ARPTAB_SIZE 8
 #endif
 
+/**
+ * The number of hash buckets used to look up ARP table entries.
+ *
+ * This must be a power of two. The default is the smallest power of
+ * two that is not less than UIP_ARPTAB_SIZE, so that buckets hold one
+ * entry on average.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_ARPTAB_HASHSIZE
+#define UIP_ARPTAB_HASHSIZE UIP_CONF_ARPTAB_HASHSIZE
+#elif UIP_ARPTAB_SIZE <= 8
+#define UIP_ARPTAB_HASHSIZE 8
+#elif UIP_ARPTAB_SIZE <= 16
+#define UIP_ARPTAB_HASHSIZE 16
+#elif UIP_ARPTAB_SIZE <= 32
+#define UIP_ARPTAB_HASHSIZE 32
+#elif UIP_ARPTAB_SIZE <= 64
+#define UIP_ARPTAB_HASHSIZE 64
+#elif UIP_ARPTAB_SIZE <= 128
+#define UIP_ARPTAB_HASHSIZE 128
+#elif UIP_ARPTAB_SIZE <= 256
+#define UIP_ARPTAB_HASHSIZE 256
+#else
+#define UIP_ARPTAB_HASHSIZE 512
+#endif
+
 /**
  * The maxium age of ARP table entries measured in 10ths of seconds.
  *
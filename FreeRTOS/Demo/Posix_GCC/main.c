@@ -0,0 +1,363 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+	FreeRTOS supports many tools and architectures. V7.0.0 is sponsored by:
+	Atollic AB - Atollic provides professional embedded systems development 
+	tools for C/C++ development, code analysis and test automation.  
+	See http://www.atollic.com
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ *******************************************************************************
+ * -NOTE- The Posix port is a simulation only!  Do not expect to get real time
+ * behaviour from the Posix port or this demo application.  It is provided so
+ * the kernel and the standard demo tasks can be built and run on a Linux host,
+ * for example as part of an automated build.
+ *******************************************************************************
+ *
+ * main() creates all the demo application tasks, then starts the scheduler.
+ * The web documentation provides more details of the standard demo application
+ * tasks, which provide no particular functionality but do provide a good
+ * example of how to use the FreeRTOS API.
+ *
+ * In addition to the standard demo tasks, the following tasks and tests are
+ * defined and/or created within this file:
+ *
+ * "Check" task - This only executes every five seconds but has a high priority
+ * to ensure it gets processor time.  Its main function is to check that all the
+ * standard demo tasks are still operational.  While no errors have been
+ * discovered the check task will print out "OK" and the current simulated tick
+ * time.  If an error is discovered in the execution of a task then the check
+ * task will print out an appropriate error message.
+ *
+ * The demo runs forever, unless the number of seconds to run for is given on
+ * the command line.  In that case the check task ends the scheduler once that
+ * time has elapsed, and the process exit status is 0 if no errors were found
+ * and 1 otherwise.
+ *
+ * If the first command line argument is "bench" the kernel benchmarks (see
+ * KernelBench.c) are run instead of the demo tasks.  Each result is printed as
+ * a line of JSON, then the scheduler is ended and the process exit status is 0
+ * if no errors were found and 1 otherwise.
+ *
+ */
+
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Standard demo includes. */
+#include "BlockQ.h"
+#include "integer.h"
+#include "semtest.h"
+#include "PollQ.h"
+#include "GenQTest.h"
+#include "QPeek.h"
+#include "recmutex.h"
+#include "MutexChain.h"
+#include "EventGroupsDemo.h"
+#include "flop.h"
+#include "TimerDemo.h"
+#include "countsem.h"
+#include "death.h"
+#include "dynamic.h"
+#include "KernelBench.h"
+
+/* Priorities at which the tasks are created. */
+#define mainCHECK_TASK_PRIORITY		( configMAX_PRIORITIES - 1 )
+#define mainQUEUE_POLL_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainSEM_TEST_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainBLOCK_Q_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define mainCREATOR_TASK_PRIORITY   ( tskIDLE_PRIORITY + 3 )
+#define mainINTEGER_TASK_PRIORITY   ( tskIDLE_PRIORITY )
+#define mainGEN_QUEUE_TASK_PRIORITY	( tskIDLE_PRIORITY )
+#define mainFLOP_TASK_PRIORITY		( tskIDLE_PRIORITY )
+#define mainBENCH_PRIORITY			( tskIDLE_PRIORITY + 1 )
+
+#define mainTIMER_TEST_PERIOD		( 50 )
+
+/* The period of the check task. */
+#define mainCHECK_PERIOD_MS			( 5000 )
+
+/* Task function prototypes. */
+static void prvCheckTask( void *pvParameters );
+
+/* The number of seconds to run for, or 0 to run forever. */
+static unsigned long ulRunTimeSeconds = 0UL;
+
+/* Set by the check task if an error is found in any of the demo tasks. */
+static volatile int iErrorFound = 0;
+
+/* Set if the kernel benchmarks are being run rather than the demo tasks. */
+static portBASE_TYPE xRunningBenchmarks = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+	if( ( argc > 1 ) && ( strcmp( argv[ 1 ], "bench" ) == 0 ) )
+	{
+		/* Only the benchmark tasks are created, so they are not disturbed by
+		the demo tasks.  The idle hook ends the scheduler once they are done. */
+		xRunningBenchmarks = pdTRUE;
+		vStartKernelBenchmarks( mainBENCH_PRIORITY );
+		vTaskStartScheduler();
+
+		return iErrorFound;
+	}
+
+	if( argc > 1 )
+	{
+		ulRunTimeSeconds = strtoul( argv[ 1 ], NULL, 0 );
+	}
+
+	/* Start the check task as described at the top of this file. */
+	xTaskCreate( prvCheckTask, ( signed char * ) "Check", configMINIMAL_STACK_SIZE, NULL, mainCHECK_TASK_PRIORITY, NULL );
+
+	/* Create the standard demo tasks. */
+	vStartBlockingQueueTasks( mainBLOCK_Q_PRIORITY );
+	vStartSemaphoreTasks( mainSEM_TEST_PRIORITY );
+	vStartPolledQueueTasks( mainQUEUE_POLL_PRIORITY );
+	vStartIntegerMathTasks( mainINTEGER_TASK_PRIORITY );
+	vStartGenericQueueTasks( mainGEN_QUEUE_TASK_PRIORITY );
+	vStartQueuePeekTasks();
+	vStartMathTasks( mainFLOP_TASK_PRIORITY );
+	vStartRecursiveMutexTasks();
+	vStartMutexChainTasks();
+	vStartEventGroupTasks();
+	vStartTimerDemoTask( mainTIMER_TEST_PERIOD );
+	vStartCountingSemaphoreTasks();
+	vStartDynamicPriorityTasks();
+
+	/* The suicide tasks must be created last as they need to know how many
+	tasks were running prior to their creation in order to ascertain whether
+	or not the correct/expected number of tasks are running at any given time. */
+	vCreateSuicidalTasks( mainCREATOR_TASK_PRIORITY );
+
+	/* Start the scheduler itself. */
+	vTaskStartScheduler();
+
+	/* Only get here if the check task ended the scheduler, or if there was
+	not enough heap space to create the idle and other system tasks. */
+	return iErrorFound;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTask( void *pvParameters )
+{
+portTickType xNextWakeTime;
+const portTickType xCycleFrequency = mainCHECK_PERIOD_MS / portTICK_RATE_MS;
+unsigned long ulSecondsElapsed = 0UL;
+const char *pcStatusMessage = "OK";
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	/* Initialise xNextWakeTime - this only needs to be done once. */
+	xNextWakeTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		/* Place this task in the blocked state until it is time to run again. */
+		vTaskDelayUntil( &xNextWakeTime, xCycleFrequency );
+
+		/* Check the standard demo tasks are running without error. */
+		if( xAreTimerDemoTasksStillRunning( xCycleFrequency ) != pdTRUE )
+		{
+			pcStatusMessage = "Error: TimerDemo";
+		}
+		else if( xAreIntegerMathsTaskStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: IntMath";
+		}
+		else if( xAreGenericQueueTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: GenQueue";
+		}
+		else if( xAreQueuePeekTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: QueuePeek";
+		}
+		else if( xAreBlockingQueuesStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: BlockQueue";
+		}
+		else if( xAreSemaphoreTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: SemTest";
+		}
+		else if( xArePollingQueuesStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: PollQueue";
+		}
+		else if( xAreMathsTaskStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: Flop";
+		}
+		else if( xAreRecursiveMutexTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: RecMutex";
+		}
+		else if( xAreMutexChainTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: MutexChain";
+		}
+		else if( xAreEventGroupTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: EventGroups";
+		}
+		else if( xAreCountingSemaphoreTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: CountSem";
+		}
+		else if( xAreDynamicPriorityTasksStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: Dynamic";
+		}
+		else if( xIsCreateTaskStillRunning() != pdTRUE )
+		{
+			pcStatusMessage = "Error: Death";
+		}
+
+		if( *pcStatusMessage != 'O' )
+		{
+			iErrorFound = 1;
+		}
+
+		/* This is the only task that uses stdout.  The scheduler is suspended
+		so this task cannot be switched out while the C library is holding the
+		stdout lock. */
+		vTaskSuspendAll();
+		{
+			printf( "%s - %u\n", pcStatusMessage, ( unsigned int ) xTaskGetTickCount() );
+			fflush( stdout );
+		}
+		xTaskResumeAll();
+
+		ulSecondsElapsed += mainCHECK_PERIOD_MS / 1000UL;
+		if( ( ulRunTimeSeconds != 0UL ) && ( ulSecondsElapsed >= ulRunTimeSeconds ) )
+		{
+			vTaskEndScheduler();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+const unsigned long ulMicrosecondsToSleep = 1000UL;
+
+	if( ( xRunningBenchmarks == pdTRUE ) && ( xAreKernelBenchmarksComplete() == pdTRUE ) )
+	{
+		if( xAreKernelBenchmarkTasksStillRunning() != pdTRUE )
+		{
+			iErrorFound = 1;
+		}
+
+		fflush( stdout );
+		vTaskEndScheduler();
+	}
+
+	/* Sleep to reduce CPU load, but don't sleep indefinitely in case there are
+	tasks waiting to be terminated by the idle task.  The sleep is cut short by
+	the next tick. */
+	usleep( ulMicrosecondsToSleep );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	/* Can be implemented if required, but probably not required in this
+	environment and running this demo. */
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( void )
+{
+	/* Can be implemented if required, but not required in this
+	environment and running this demo. */
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	/* Call the periodic timer and event group tests, which test the API
+	functions that can be called from an ISR.  The demo tasks are not created
+	when the benchmarks are run. */
+	if( xRunningBenchmarks == pdFALSE )
+	{
+		vTimerPeriodicISRTests();
+		vEventGroupsISRTests();
+	}
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulMainGetBenchTimestamp( void )
+{
+struct timespec xNow;
+
+	/* Called through benchGET_TIMESTAMP(), defined in FreeRTOSConfig.h. */
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( unsigned long ) ( ( xNow.tv_sec * 1000000000UL ) + xNow.tv_nsec );
+}
+/*-----------------------------------------------------------*/
@@ -178,6 +178,18 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define configIDLE_SHOULD_YIELD		1
 #endif
 
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#endif
+
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+	#ifndef portGET_HIGHEST_PRIORITY
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION is set to 1 but the port being used does not provide an optimised task selection mechanism.  Set configUSE_PORT_OPTIMISED_TASK_SELECTION to 0 in FreeRTOSConfig.h.
+	#endif
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
 #if configMAX_TASK_NAME_LEN < 1
 	#error configMAX_TASK_NAME_LEN must be set to a minimum of 1 in FreeRTOSConfig.h
 #endif
@@ -192,10 +204,16 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 
 /* The timers module relies on xTaskGetSchedulerState(). */
 #if configUSE_TIMERS == 1
-	// mtj sets these values 
-	#define configTIMER_TASK_PRIORITY  tskIDLE_PRIORITY
-	#define configTIMER_QUEUE_LENGTH	20
-	#define configTIMER_TASK_STACK_DEPTH	   (2*configMINIMAL_STACK_SIZE)
+	// mtj sets these values (unless the application has its own)
+	#ifndef configTIMER_TASK_PRIORITY
+		#define configTIMER_TASK_PRIORITY  tskIDLE_PRIORITY
+	#endif
+	#ifndef configTIMER_QUEUE_LENGTH
+		#define configTIMER_QUEUE_LENGTH	20
+	#endif
+	#ifndef configTIMER_TASK_STACK_DEPTH
+		#define configTIMER_TASK_STACK_DEPTH	   (2*configMINIMAL_STACK_SIZE)
+	#endif
 	// end of mtj settings
 	#ifndef configTIMER_TASK_PRIORITY
 		#error If configUSE_TIMERS is set to 1 then configTIMER_TASK_PRIORITY must also be defined.
@@ -219,6 +237,10 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define INCLUDE_xTaskGetCurrentTaskHandle 0
 #endif
 
+#ifndef INCLUDE_xSemaphoreGetMutexHolder
+	#define INCLUDE_xSemaphoreGetMutexHolder 0
+#endif
+
 
 #ifndef portSET_INTERRUPT_MASK_FROM_ISR
 	#define portSET_INTERRUPT_MASK_FROM_ISR() 0
@@ -406,6 +428,99 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTASK_INCREMENT_TICK( xTickCount )
 #endif
 
+#ifndef traceMOVED_TASK_TO_READY_STATE
+	/* Called when a task is placed in a ready list, for example when it is
+	unblocked by an event or a timeout. */
+	#define traceMOVED_TASK_TO_READY_STATE( pxTCB )
+#endif
+
+#ifndef traceISR_ENTER
+	/* Not called by the kernel.  Application interrupt handlers can call
+	traceISR_ENTER() and traceISR_EXIT() on entry and exit, passing an
+	identifier for the interrupt, so a trace recorder can see them. */
+	#define traceISR_ENTER( ucIsrId )
+#endif
+
+#ifndef traceISR_EXIT
+	#define traceISR_EXIT( ucIsrId )
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE
+	#define traceSTREAM_BUFFER_CREATE( pxStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE_FAILED
+	#define traceSTREAM_BUFFER_CREATE_FAILED()
+#endif
+
+#ifndef traceSTREAM_BUFFER_DELETE
+	#define traceSTREAM_BUFFER_DELETE( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RESET
+	#define traceSTREAM_BUFFER_RESET( xStreamBuffer )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+	#define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND
+	#define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FAILED
+	#define traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FROM_ISR
+	#define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+	#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE
+	#define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FAILED
+	#define traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FROM_ISR
+	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE
+	#define traceTASK_NOTIFY_TAKE()
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE_BLOCK
+	#define traceTASK_NOTIFY_TAKE_BLOCK()
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT
+	#define traceTASK_NOTIFY_WAIT()
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT_BLOCK
+	#define traceTASK_NOTIFY_WAIT_BLOCK()
+#endif
+
+#ifndef traceTASK_NOTIFY
+	#define traceTASK_NOTIFY()
+#endif
+
+#ifndef traceTASK_NOTIFY_FROM_ISR
+	#define traceTASK_NOTIFY_FROM_ISR()
+#endif
+
+#ifndef traceTASK_NOTIFY_GIVE_FROM_ISR
+	#define traceTASK_NOTIFY_GIVE_FROM_ISR()
+#endif
+
 #ifndef traceTIMER_CREATE
 	#define traceTIMER_CREATE( pxNewTimer )
 #endif
@@ -422,10 +537,58 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTIMER_EXPIRED( pxTimer )
 #endif
 
+#ifndef traceTIMER_CALLBACK_RETURN
+	#define traceTIMER_CALLBACK_RETURN( pxTimer )
+#endif
+
 #ifndef traceTIMER_COMMAND_RECEIVED
 	#define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue )
 #endif
 
+#ifndef tracePEND_FUNC_CALL_FROM_ISR
+	#define tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn )
+#endif
+
+#ifndef tracePEND_FUNC_CALL
+	#define tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn )
+#endif
+
+#ifndef traceEVENT_GROUP_CREATE
+	#define traceEVENT_GROUP_CREATE( xEventGroup )
+#endif
+
+#ifndef traceEVENT_GROUP_CREATE_FAILED
+	#define traceEVENT_GROUP_CREATE_FAILED()
+#endif
+
+#ifndef traceEVENT_GROUP_SYNC_BLOCK
+	#define traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor )
+#endif
+
+#ifndef traceEVENT_GROUP_SYNC_END
+	#define traceEVENT_GROUP_SYNC_END( xEventGroup, uxBitsToSet, uxBitsToWaitFor, xTimeoutOccurred )
+#endif
+
+#ifndef traceEVENT_GROUP_WAIT_BITS_BLOCK
+	#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )
+#endif
+
+#ifndef traceEVENT_GROUP_WAIT_BITS_END
+	#define traceEVENT_GROUP_WAIT_BITS_END( xEventGroup, uxBitsToWaitFor, xTimeoutOccurred )
+#endif
+
+#ifndef traceEVENT_GROUP_CLEAR_BITS
+	#define traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear )
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS
+	#define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )
+#endif
+
+#ifndef traceEVENT_GROUP_DELETE
+	#define traceEVENT_GROUP_DELETE( xEventGroup )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
@@ -442,16 +605,83 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 		#endif /* portALT_GET_RUN_TIME_COUNTER_VALUE */
 	#endif /* portGET_RUN_TIME_COUNTER_VALUE */
 
+	#ifndef configRUN_TIME_STATS_WINDOW_TICKS
+		/* The length, in ticks, of the window over which per task CPU load
+		is measured.  The run time counter must not wrap more than once in
+		this time. */
+		#define configRUN_TIME_STATS_WINDOW_TICKS configTICK_RATE_HZ
+	#endif
+
 #endif /* configGENERATE_RUN_TIME_STATS */
 
 #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
 	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
 
+#ifndef configUSE_TASK_NOTIFICATIONS
+	#define configUSE_TASK_NOTIFICATIONS 1
+#endif
+
+#ifndef configUSE_TICKLESS_IDLE
+	#define configUSE_TICKLESS_IDLE 0
+#endif
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	#ifndef portSUPPRESS_TICKS_AND_SLEEP
+		#error configUSE_TICKLESS_IDLE is set but the port being used does not define portSUPPRESS_TICKS_AND_SLEEP().  Either set configUSE_TICKLESS_IDLE to 0 in FreeRTOSConfig.h or provide an implementation.
+	#endif
+
+#endif /* configUSE_TICKLESS_IDLE */
+
+#ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
+	/* Entering and exiting a sleep mode has a cost, so the tick is only
+	suppressed if the idle period is expected to be at least this many ticks
+	long. */
+	#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 2
+#endif
+
+#if configEXPECTED_IDLE_TIME_BEFORE_SLEEP < 2
+	#error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than 2
+#endif
+
+#ifndef configPRE_SLEEP_PROCESSING
+	/* Called immediately before the processor is put to sleep.  Setting the
+	parameter to 0 prevents the port from executing its own wait for interrupt
+	instruction, allowing the application to enter a deeper sleep mode itself. */
+	#define configPRE_SLEEP_PROCESSING( x )
+#endif
+
+#ifndef configPOST_SLEEP_PROCESSING
+	/* Called immediately after the processor wakes from sleep. */
+	#define configPOST_SLEEP_PROCESSING( x )
+#endif
+
 #ifndef configUSE_MALLOC_FAILED_HOOK
 	#define configUSE_MALLOC_FAILED_HOOK 0
 #endif
 
+#ifndef configUSE_QUEUE_SETS
+	#define configUSE_QUEUE_SETS 0
+#endif
+
+#ifndef configUSE_TIMING_WHEEL
+	/* Defaults to 0, in which case delayed tasks and active timers are held in
+	sorted lists. */
+	#define configUSE_TIMING_WHEEL 0
+#endif
+
+#ifndef configTIMING_WHEEL_SLOT_BITS
+	/* Each level of a timing wheel has ( 1 << configTIMING_WHEEL_SLOT_BITS )
+	slots. */
+	#define configTIMING_WHEEL_SLOT_BITS 4
+#endif
+
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	/* Defaults to 0 for backward compatibility. */
+	#define configSUPPORT_STATIC_ALLOCATION 0
+#endif
+
 #ifndef portPRIVILEGE_BIT
 	#define portPRIVILEGE_BIT ( ( unsigned portBASE_TYPE ) 0x00 )
 #endif
@@ -468,5 +698,118 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define vPortFreeAligned( pvBlockToFree ) vPortFree( pvBlockToFree )
 #endif
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real task, queue and timer structures are not
+ * accessible to the application.  However, when configSUPPORT_STATIC_ALLOCATION
+ * is 1 the application must be able to declare the memory those structures
+ * occupy.  The structures below have the same size and alignment as the real
+ * structures but do not expose their members, and so can be used for that
+ * purpose.  The kernel asserts that the sizes match when a static object is
+ * created, so the two definitions must be updated together.
+ */
+typedef struct xSTATIC_LIST_ITEM
+{
+	portTickType xDummy1;
+	void *pvDummy2[ 4 ];
+} xStaticListItem;
+
+typedef struct xSTATIC_MINI_LIST_ITEM
+{
+	portTickType xDummy1;
+	void *pvDummy2[ 2 ];
+} xStaticMiniListItem;
+
+typedef struct xSTATIC_LIST
+{
+	unsigned portBASE_TYPE uxDummy1;
+	void *pvDummy2;
+	xStaticMiniListItem xDummy3;
+} xStaticList;
+
+/* Mirrors the tskTCB structure defined in tasks.c. */
+typedef struct xSTATIC_TCB
+{
+	void				*pxDummy1;
+	#if ( portUSING_MPU_WRAPPERS == 1 )
+		xMPU_SETTINGS	xDummy2;
+	#endif
+	xStaticListItem		xDummy3[ 2 ];
+	unsigned portBASE_TYPE uxDummy4;
+	void				*pxDummy5;
+	signed char			ucDummy6[ configMAX_TASK_NAME_LEN ];
+	#if ( portSTACK_GROWTH > 0 )
+		void			*pxDummy7;
+	#endif
+	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+		unsigned portBASE_TYPE uxDummy8;
+	#endif
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		unsigned portBASE_TYPE uxDummy9;
+	#endif
+	#if ( configUSE_MUTEXES == 1 )
+		unsigned portBASE_TYPE uxDummy10;
+		xStaticList xDummy17;
+		void			*pvDummy18[ 2 ];
+	#endif
+	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+		void			*pxDummy11;
+	#endif
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		unsigned long long	ullDummy12;
+		unsigned long	ulDummy13[ 3 ];
+	#endif
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		unsigned long	ulDummy14;
+		unsigned char	ucDummy15;
+	#endif
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char	ucDummy16;
+	#endif
+} xStaticTask;
+
+/* Mirrors the xQUEUE structure defined in queue.c.  Semaphores and mutexes
+are queues, so the same structure is used to hold them. */
+typedef struct xSTATIC_QUEUE
+{
+	void *pvDummy1[ 4 ];
+	xStaticList xDummy2[ 2 ];
+	unsigned portBASE_TYPE uxDummy3[ 3 ];
+	signed portBASE_TYPE xDummy4[ 2 ];
+	#if ( configUSE_MUTEXES == 1 )
+		xStaticListItem xDummy7;
+	#endif
+	#if ( configUSE_QUEUE_SETS == 1 )
+		void *pvDummy5;
+	#endif
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy6;
+	#endif
+} xStaticQueue;
+typedef xStaticQueue xStaticSemaphore;
+
+/* Mirrors the xTIMER structure defined in timers.c. */
+typedef struct xSTATIC_TIMER
+{
+	void *pvDummy1;
+	xStaticListItem xDummy2;
+	portTickType xDummy3;
+	unsigned portBASE_TYPE uxDummy4;
+	void *pvDummy5[ 2 ];
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy6;
+	#endif
+} xStaticTimer;
+
+/* Mirrors the xEVENT_GROUP structure defined in event_groups.c. */
+typedef struct xSTATIC_EVENT_GROUP
+{
+	portTickType xDummy1;
+	xStaticList xDummy2;
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy3;
+	#endif
+} xStaticEventGroup;
+
 #endif /* INC_FREERTOS_H */
 
@@ -0,0 +1,221 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+	FreeRTOS supports many tools and architectures. V7.0.0 is sponsored by:
+	Atollic AB - Atollic provides professional embedded systems development 
+	tools for C/C++ development, code analysis and test automation.  
+	See http://www.atollic.com
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+
+#ifndef POOL_QUEUE_H
+#define POOL_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+	#error "#include FreeRTOS.h" must appear in source files before "#include pool_queue.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A pool queue passes fixed size blocks between tasks and interrupts by
+ * reference rather than by copy.  The blocks are allocated once, when the pool
+ * queue is created.  A sender acquires a free block, fills it in place, then
+ * sends it.  The receiver is given a pointer to the same block, and releases it
+ * back to the pool once it has finished with the contents.  Only the pointer
+ * is ever copied through the underlying queues, so the time taken to pass a
+ * message does not depend on the size of the block.
+ *
+ * Ownership of a block moves with the pointer - a task must not access a block
+ * after it has sent or released it.
+ */
+
+/**
+ * Type by which pool queues are referenced.
+ */
+typedef void * xPoolQueueHandle;
+
+/**
+ * pool_queue. h
+ * <pre>
+ xPoolQueueHandle xPoolQueueCreate( unsigned portBASE_TYPE uxBlockCount, size_t xBlockSize );
+ * </pre>
+ *
+ * Creates a pool queue, and the pool of blocks that it passes.
+ *
+ * @param uxBlockCount The number of blocks in the pool.  This is also the
+ * maximum number of messages that can be queued at any one time.
+ *
+ * @param xBlockSize The size of each block in bytes.  Every block is aligned
+ * to portBYTE_ALIGNMENT.
+ *
+ * @return A handle to the created pool queue, or NULL if there was not enough
+ * heap memory available.
+ *
+ * \defgroup xPoolQueueCreate xPoolQueueCreate
+ * \ingroup PoolQueueManagement
+ */
+xPoolQueueHandle xPoolQueueCreate( unsigned portBASE_TYPE uxBlockCount, size_t xBlockSize );
+
+/**
+ * pool_queue. h
+ * <pre>
+ void *pvPoolQueueAcquire( xPoolQueueHandle xPoolQueue, portTickType xTicksToWait );
+ void *pvPoolQueueAcquireFromISR( xPoolQueueHandle xPoolQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * Take a free block from the pool so it can be filled in and then sent with
+ * xPoolQueueSend().  If no block is free the task version will block for up
+ * to xTicksToWait ticks for one to be released.
+ *
+ * @return A pointer to the block, or NULL if no block was available.
+ *
+ * \defgroup pvPoolQueueAcquire pvPoolQueueAcquire
+ * \ingroup PoolQueueManagement
+ */
+void *pvPoolQueueAcquire( xPoolQueueHandle xPoolQueue, portTickType xTicksToWait );
+void *pvPoolQueueAcquireFromISR( xPoolQueueHandle xPoolQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/**
+ * pool_queue. h
+ * <pre>
+ signed portBASE_TYPE xPoolQueueSend( xPoolQueueHandle xPoolQueue, void *pvBlock );
+ signed portBASE_TYPE xPoolQueueSendFromISR( xPoolQueueHandle xPoolQueue, void *pvBlock, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * Send a block that was obtained from pvPoolQueueAcquire() to the receiver.
+ * As the queue can hold every block in the pool this never needs to block.
+ *
+ * @return pdPASS if the block was queued.
+ *
+ * \defgroup xPoolQueueSend xPoolQueueSend
+ * \ingroup PoolQueueManagement
+ */
+signed portBASE_TYPE xPoolQueueSend( xPoolQueueHandle xPoolQueue, void *pvBlock );
+signed portBASE_TYPE xPoolQueueSendFromISR( xPoolQueueHandle xPoolQueue, void *pvBlock, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/**
+ * pool_queue. h
+ * <pre>
+ void *pvPoolQueueReceive( xPoolQueueHandle xPoolQueue, portTickType xTicksToWait );
+ void *pvPoolQueueReceiveFromISR( xPoolQueueHandle xPoolQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * Receive the next block that was sent with xPoolQueueSend().  The task
+ * version will block for up to xTicksToWait ticks for a block to arrive.  The
+ * block must be returned to the pool with vPoolQueueRelease() once its
+ * contents are no longer needed.
+ *
+ * @return A pointer to the received block, or NULL if nothing was received.
+ *
+ * \defgroup pvPoolQueueReceive pvPoolQueueReceive
+ * \ingroup PoolQueueManagement
+ */
+void *pvPoolQueueReceive( xPoolQueueHandle xPoolQueue, portTickType xTicksToWait );
+void *pvPoolQueueReceiveFromISR( xPoolQueueHandle xPoolQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/**
+ * pool_queue. h
+ * <pre>
+ void vPoolQueueRelease( xPoolQueueHandle xPoolQueue, void *pvBlock );
+ void vPoolQueueReleaseFromISR( xPoolQueueHandle xPoolQueue, void *pvBlock, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * Return a block to the pool.  A block obtained from pvPoolQueueAcquire() can
+ * also be released without being sent.
+ *
+ * \defgroup vPoolQueueRelease vPoolQueueRelease
+ * \ingroup PoolQueueManagement
+ */
+void vPoolQueueRelease( xPoolQueueHandle xPoolQueue, void *pvBlock );
+void vPoolQueueReleaseFromISR( xPoolQueueHandle xPoolQueue, void *pvBlock, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/**
+ * pool_queue. h
+ * <pre>
+ unsigned portBASE_TYPE uxPoolQueueBlocksFree( xPoolQueueHandle xPoolQueue );
+ unsigned portBASE_TYPE uxPoolQueueMessagesWaiting( xPoolQueueHandle xPoolQueue );
+ * </pre>
+ *
+ * Return the number of blocks that are free in the pool, and the number of
+ * blocks that have been sent but not yet received.
+ *
+ * \defgroup uxPoolQueueBlocksFree uxPoolQueueBlocksFree
+ * \ingroup PoolQueueManagement
+ */
+unsigned portBASE_TYPE uxPoolQueueBlocksFree( xPoolQueueHandle xPoolQueue );
+unsigned portBASE_TYPE uxPoolQueueMessagesWaiting( xPoolQueueHandle xPoolQueue );
+
+/**
+ * pool_queue. h
+ * <pre>
+ void vPoolQueueDelete( xPoolQueueHandle xPoolQueue );
+ * </pre>
+ *
+ * Delete a pool queue and free its blocks.  No task may be blocked on the
+ * pool queue, and no block may still be in use.
+ *
+ * \defgroup vPoolQueueDelete vPoolQueueDelete
+ * \ingroup PoolQueueManagement
+ */
+void vPoolQueueDelete( xPoolQueueHandle xPoolQueue );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POOL_QUEUE_H */
+
@@ -363,6 +363,44 @@ void vPortFree( void *pv ) PRIVILEGED_FUNCTION;
 void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Usage of a single size class of the fixed block heap (heap_4.c only).
+ */
+typedef struct xHEAP_POOL_STATS
+{
+	size_t xBlockSize;							/*< The size of every block in the class. */
+	unsigned portBASE_TYPE uxTotalBlocks;		/*< The number of blocks in the class. */
+	unsigned portBASE_TYPE uxFreeBlocks;		/*< The number of blocks currently free. */
+	unsigned portBASE_TYPE uxMinimumEverFreeBlocks;	/*< The lowest value uxFreeBlocks has had since boot. */
+	unsigned long ulAllocations;				/*< The number of blocks allocated from the class. */
+	unsigned long ulOverflows;					/*< The number of requests that fitted this class best but found it empty. */
+} xHeapPoolStats;
+
+/*
+ * Query the size classes of the fixed block heap (heap_4.c only).
+ * xPortGetHeapPoolStats() returns pdFAIL if uxPool is not less than the value
+ * returned by uxPortGetHeapPoolCount().
+ */
+unsigned portBASE_TYPE uxPortGetHeapPoolCount( void ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xPortGetHeapPoolStats( unsigned portBASE_TYPE uxPool, xHeapPoolStats *pxStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fragmentation statistics for the coalescing heap (heap_5.c only).  The
+ * largest and smallest free block sizes exclude the block header, so are the
+ * largest and smallest requests those blocks could satisfy.
+ */
+typedef struct xHEAP_STATS
+{
+	size_t xAvailableHeapSpaceInBytes;			/*< The total heap size currently available - this is the sum of all the free blocks, not the largest block that can be allocated. */
+	size_t xSizeOfLargestFreeBlockInBytes;		/*< The maximum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xSizeOfSmallestFreeBlockInBytes;		/*< The minimum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapStats() is called. */
+	unsigned portBASE_TYPE uxNumberOfFreeBlocks;	/*< The number of free memory blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xMinimumEverFreeBytesRemaining;		/*< The minimum amount of total free memory (sum of all free blocks) there has been in the heap since the system booted. */
+} xHeapStats;
+
+void vPortGetHeapStats( xHeapStats *pxHeapStats ) PRIVILEGED_FUNCTION;
+size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
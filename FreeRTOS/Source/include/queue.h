@@ -79,6 +79,20 @@ extern "C" {
  */
 typedef void * xQueueHandle;
 
+/**
+ * Type by which queue sets are referenced.  For example, a call to
+ * xQueueCreateSet() returns an xQueueSetHandle variable that can then be used
+ * as a parameter to xQueueSelectFromSet(), xQueueAddToSet(), etc.
+ */
+typedef void * xQueueSetHandle;
+
+/**
+ * Queue sets can contain both queues and semaphores, so xQueueSetMemberHandle
+ * is defined as a type to be used where a parameter or return value can be
+ * either an xQueueHandle or an xSemaphoreHandle.
+ */
+typedef void * xQueueSetMemberHandle;
+
 
 /* For internal use only. */
 #define	queueSEND_TO_BACK	( 0 )
@@ -143,6 +157,65 @@ typedef void * xQueueHandle;
  */
 xQueueHandle xQueueCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize );
 
+/**
+ * queue. h
+ * <pre>
+ xQueueHandle xQueueCreateStatic(
+									unsigned portBASE_TYPE uxQueueLength,
+									unsigned portBASE_TYPE uxItemSize,
+									unsigned char *pucQueueStorageBuffer,
+									xStaticQueue *pxStaticQueue
+								);
+ * </pre>
+ *
+ * Creates a new queue instance using memory provided by the application
+ * writer rather than memory allocated from the FreeRTOS heap.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ *
+ * @param pucQueueStorageBuffer If uxItemSize is not zero then this must point
+ * to an array of at least ( uxQueueLength * uxItemSize ) bytes, which is used
+ * to hold the queued items.  If uxItemSize is zero then it can be NULL.
+ *
+ * @param pxStaticQueue Must point to a variable of type xStaticQueue, which
+ * will be used to hold the queue's data structure.
+ *
+ * @return If the queue is created then a handle to the created queue is
+ * returned.  If pxStaticQueue is NULL, or a storage buffer is required but
+ * not provided, then NULL is returned.
+ *
+ * Example usage:
+   <pre>
+ #define QUEUE_LENGTH	10
+ #define ITEM_SIZE		sizeof( unsigned long )
+
+ // The variable used to hold the queue's data structure.
+ static xStaticQueue xStaticQueueBuffer;
+
+ // The array to use as the queue's storage area.
+ static unsigned char ucQueueStorage[ QUEUE_LENGTH * ITEM_SIZE ];
+
+ void vATask( void *pvParameters )
+ {
+ xQueueHandle xQueue1;
+
+	// Create a queue capable of containing 10 unsigned long values.  No
+	// memory is obtained from the heap.
+	xQueue1 = xQueueCreateStatic( QUEUE_LENGTH, ITEM_SIZE, ucQueueStorage, &xStaticQueueBuffer );
+
+	// ... Rest of task code.
+ }
+ </pre>
+ * \defgroup xQueueCreateStatic xQueueCreateStatic
+ * \ingroup QueueManagement
+ */
+xQueueHandle xQueueCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorageBuffer, xStaticQueue *pxStaticQueue );
+
 /**
  * queue. h
  * <pre>
@@ -780,6 +853,23 @@ signed portBASE_TYPE xQueueGenericReceive( xQueueHandle xQueue, void * const pvB
  */
 unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle xQueue );
 
+/**
+ * queue. h
+ * <pre>unsigned portBASE_TYPE uxQueueGetLength( const xQueueHandle xQueue );</pre>
+ *
+ * Return the number of items the queue can hold, as passed to xQueueCreate()
+ * when the queue was created.  Together with uxQueueMessagesWaiting() this
+ * gives the fill level of the queue.
+ *
+ * @param xQueue A handle to the queue being queried.
+ *
+ * @return The length of the queue.
+ *
+ * \page uxQueueGetLength uxQueueGetLength
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE uxQueueGetLength( const xQueueHandle xQueue );
+
 /**
  * queue. h
  * <pre>void vQueueDelete( xQueueHandle xQueue );</pre>
@@ -1176,6 +1266,282 @@ signed portBASE_TYPE xQueueGenericSendFromISR( xQueueHandle pxQueue, const void
  */
 signed portBASE_TYPE xQueueReceiveFromISR( xQueueHandle pxQueue, void * const pvBuffer, signed portBASE_TYPE *pxTaskWoken );
 
+/**
+ * queue. h
+ * <pre>
+ signed portBASE_TYPE xQueueSendMultiple(
+									xQueueHandle xQueue,
+									const void * pvItemsToQueue,
+									unsigned portBASE_TYPE uxItemCount,
+									portTickType xTicksToWait
+								);
+ * </pre>
+ *
+ * Post up to uxItemCount items to the back of a queue in a single operation.
+ * The items are copied with at most two memcpy() calls, and the critical
+ * section, queue lock and event list check are paid once per call rather than
+ * once per item.
+ *
+ * If the queue is full the calling task will block for up to xTicksToWait
+ * ticks for space to become available.  As soon as there is space for at
+ * least one item, as many items as will fit are posted and the function
+ * returns.
+ *
+ * This function must not be used on a semaphore or mutex.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of items.  Each item is the
+ * size the queue was created with.
+ *
+ * @param uxItemCount The number of items in the pvItemsToQueue array.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it be full.
+ *
+ * @return The number of items posted, which will be less than uxItemCount if
+ * the queue did not have room for them all, and zero if the call timed out.
+ *
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+signed portBASE_TYPE xQueueSendMultiple( xQueueHandle pxQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait );
+
+/**
+ * queue. h
+ * <pre>
+ signed portBASE_TYPE xQueueSendMultipleFromISR(
+									xQueueHandle xQueue,
+									const void * pvItemsToQueue,
+									unsigned portBASE_TYPE uxItemCount,
+									signed portBASE_TYPE *pxHigherPriorityTaskWoken
+								);
+ * </pre>
+ *
+ * A version of xQueueSendMultiple() that can be called from an interrupt
+ * service routine.  Posts as many of the items as will fit and never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the items
+ * unblocked a task with a priority higher than the currently running task,
+ * in which case a context switch should be requested before the interrupt
+ * is exited.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+signed portBASE_TYPE xQueueSendMultipleFromISR( xQueueHandle pxQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/**
+ * queue. h
+ * <pre>
+ signed portBASE_TYPE xQueueReceiveMultiple(
+									xQueueHandle xQueue,
+									void *pvBuffer,
+									unsigned portBASE_TYPE uxMaxItems,
+									portTickType xTicksToWait
+								);
+ * </pre>
+ *
+ * Receive up to uxMaxItems items from a queue in a single operation.  If the
+ * queue is empty the calling task will block for up to xTicksToWait ticks for
+ * an item to arrive.  As soon as at least one item is available, all the
+ * items that are available, up to uxMaxItems, are removed and the function
+ * returns.
+ *
+ * This function must not be used on a semaphore or mutex.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will
+ * be copied.  The buffer must be large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of
+ * the call.
+ *
+ * @return The number of items received, or zero if the call timed out.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+signed portBASE_TYPE xQueueReceiveMultiple( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait );
+
+/**
+ * queue. h
+ * <pre>
+ signed portBASE_TYPE xQueueReceiveMultipleFromISR(
+									xQueueHandle xQueue,
+									void *pvBuffer,
+									unsigned portBASE_TYPE uxMaxItems,
+									signed portBASE_TYPE *pxTaskWoken
+								);
+ * </pre>
+ *
+ * A version of xQueueReceiveMultiple() that can be called from an interrupt
+ * service routine.  Never blocks.
+ *
+ * @param pxTaskWoken Set to pdTRUE if removing the items unblocked a task
+ * with a priority higher than the currently running task.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+signed portBASE_TYPE xQueueReceiveMultipleFromISR( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, signed portBASE_TYPE *pxTaskWoken );
+
+/**
+ * queue. h
+ * <pre>
+ xQueueSetHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength );
+ * </pre>
+ *
+ * Queue sets provide a mechanism to allow a task to block (pend) on a read
+ * operation from multiple queues or semaphores simultaneously.
+ *
+ * A queue set must be explicitly created using a call to xQueueCreateSet()
+ * before it can be used.  Once created, standard FreeRTOS queues and
+ * semaphores can be added to the set using calls to xQueueAddToSet().
+ * xQueueSelectFromSet() is then used to determine which, if any, of the queues
+ * or semaphores contained in the set is in a state where a queue read or
+ * semaphore take operation would be successful.
+ *
+ * Note 1:  A receive (in the case of a queue) or take (in the case of a
+ * semaphore) operation must not be performed on a member of a queue set unless
+ * a call to xQueueSelectFromSet() has first returned a handle to that set
+ * member.
+ *
+ * Note 2:  Mutexes must not be added to a queue set, as the priority
+ * inheritance mechanism relies on tasks blocking on the mutex itself.
+ *
+ * Note 3:  An additional pointer's worth of RAM is required for each space in
+ * every queue added to a queue set.  Therefore counting semaphores that have a
+ * high maximum count value should not be added to a queue set.
+ *
+ * configUSE_QUEUE_SETS must be set to 1 in FreeRTOSConfig.h for queue sets to
+ * be available.
+ *
+ * @param uxEventQueueLength Queue sets store events that occur on the queues
+ * and semaphores contained in the set.  uxEventQueueLength specifies the
+ * maximum number of events that can be queued at once.  To be absolutely
+ * certain that events are not lost uxEventQueueLength should be set to the
+ * total sum of the length of the queues added to the set, where binary
+ * semaphores have a length of 1 and counting semaphores have a length set by
+ * their maximum count value.
+ *
+ * @return If the queue set is created successfully then a handle to the
+ * created queue set is returned.  Otherwise NULL is returned.
+ *
+ * \defgroup xQueueCreateSet xQueueCreateSet
+ * \ingroup QueueSets
+ */
+xQueueSetHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength );
+
+/**
+ * queue. h
+ * <pre>
+ portBASE_TYPE xQueueAddToSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+ * </pre>
+ *
+ * Adds a queue or semaphore to a queue set that was previously created by a
+ * call to xQueueCreateSet().
+ *
+ * Note:  A queue or semaphore can only be added to a set while it is empty,
+ * and can only be a member of one set at a time.
+ *
+ * @param xQueueOrSemaphore The handle of the queue or semaphore being added to
+ * the queue set (cast to an xQueueSetMemberHandle type).
+ *
+ * @param xQueueSet The handle of the queue set to which the queue or semaphore
+ * is being added.
+ *
+ * @return If the queue or semaphore was successfully added to the queue set
+ * then pdPASS is returned.  If the queue could not be successfully added to the
+ * queue set because it is already a member of a different queue set, or
+ * because it is not empty, then pdFAIL is returned.
+ *
+ * \defgroup xQueueAddToSet xQueueAddToSet
+ * \ingroup QueueSets
+ */
+portBASE_TYPE xQueueAddToSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+
+/**
+ * queue. h
+ * <pre>
+ portBASE_TYPE xQueueRemoveFromSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+ * </pre>
+ *
+ * Removes a queue or semaphore from a queue set.  A queue or semaphore can only
+ * be removed from a set if the queue or semaphore is empty.
+ *
+ * @param xQueueOrSemaphore The handle of the queue or semaphore being removed
+ * from the queue set (cast to an xQueueSetMemberHandle type).
+ *
+ * @param xQueueSet The handle of the queue set in which the queue or semaphore
+ * is included.
+ *
+ * @return If the queue or semaphore was successfully removed from the queue set
+ * then pdPASS is returned.  If the queue was not in the queue set, or the
+ * queue (or semaphore) was not empty, then pdFAIL is returned.
+ *
+ * \defgroup xQueueRemoveFromSet xQueueRemoveFromSet
+ * \ingroup QueueSets
+ */
+portBASE_TYPE xQueueRemoveFromSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+
+/**
+ * queue. h
+ * <pre>
+ xQueueSetMemberHandle xQueueSelectFromSet( xQueueSetHandle xQueueSet, portTickType xBlockTimeTicks );
+ * </pre>
+ *
+ * xQueueSelectFromSet() selects from the members of a queue set a queue or
+ * semaphore that either contains data (in the case of a queue) or is available
+ * to take (in the case of a semaphore).  xQueueSelectFromSet() effectively
+ * allows a task to block (pend) on a read operation on all the queues and
+ * semaphores in a queue set simultaneously.
+ *
+ * Note:  Each successful call to xQueueSelectFromSet() must be followed by
+ * exactly one read (or take) from the member whose handle was returned, using
+ * a block time of zero.
+ *
+ * @param xQueueSet The queue set on which the task will (potentially) block.
+ *
+ * @param xBlockTimeTicks The maximum time, in ticks, that the calling task will
+ * remain in the Blocked state (with other tasks executing) to wait for a member
+ * of the queue set to be ready for a successful queue read or semaphore take
+ * operation.
+ *
+ * @return xQueueSelectFromSet() will return the handle of a queue (cast to
+ * an xQueueSetMemberHandle type) contained in the queue set that contains data,
+ * or the handle of a semaphore (cast to an xQueueSetMemberHandle type)
+ * contained in the queue set that is available, or NULL if no such queue or
+ * semaphore exists before the specified block time expires.
+ *
+ * \defgroup xQueueSelectFromSet xQueueSelectFromSet
+ * \ingroup QueueSets
+ */
+xQueueSetMemberHandle xQueueSelectFromSet( xQueueSetHandle xQueueSet, portTickType xBlockTimeTicks );
+
+/**
+ * queue. h
+ * <pre>
+ xQueueSetMemberHandle xQueueSelectFromSetFromISR( xQueueSetHandle xQueueSet );
+ * </pre>
+ *
+ * A version of xQueueSelectFromSet() that can be used from an ISR.  Never
+ * blocks.
+ *
+ * \defgroup xQueueSelectFromSetFromISR xQueueSelectFromSetFromISR
+ * \ingroup QueueSets
+ */
+xQueueSetMemberHandle xQueueSelectFromSetFromISR( xQueueSetHandle xQueueSet );
+
 /*
  * Utilities to query queue that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -1221,11 +1587,14 @@ signed portBASE_TYPE xQueueCRSend( xQueueHandle pxQueue, const void *pvItemToQue
 signed portBASE_TYPE xQueueCRReceive( xQueueHandle pxQueue, void *pvBuffer, portTickType xTicksToWait );
 
 /*
- * For internal use only.  Use xSemaphoreCreateMutex() or
- * xSemaphoreCreateCounting() instead of calling these functions directly.
+ * For internal use only.  Use xSemaphoreCreateMutex(),
+ * xSemaphoreCreateCounting() or their static equivalents instead of calling
+ * these functions directly.
  */
 xQueueHandle xQueueCreateMutex( void );
 xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount );
+xQueueHandle xQueueCreateMutexStatic( xStaticQueue *pxStaticQueue );
+xQueueHandle xQueueCreateCountingSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue );
 
 /*
  * For internal use only.  Use xSemaphoreTakeMutexRecursive() or
@@ -1234,6 +1603,12 @@ xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue,
 portBASE_TYPE xQueueTakeMutexRecursive( xQueueHandle pxMutex, portTickType xBlockTime );
 portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex );
 
+/*
+ * For internal use only.  Use xSemaphoreGetMutexHolder() instead of calling
+ * this function directly.
+ */
+void *xQueueGetMutexHolder( xQueueHandle pxSemaphore );
+
 /*
  * The registry is provided as a means for kernel aware debuggers to
  * locate queues, semaphores and mutexes.  Call vQueueAddToRegistry() add
@@ -1258,6 +1633,25 @@ portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex );
 	void vQueueAddToRegistry( xQueueHandle xQueue, signed char *pcName );
 #endif
 
+/*
+ * Read back one slot of the queue registry, so an application can report on
+ * the queues it has registered (for example their fill levels).
+ *
+ * @param uxIndex The registry slot to read, from 0 to
+ * configQUEUE_REGISTRY_SIZE - 1.
+ *
+ * @param ppcQueueName Set to the name the queue was registered with.
+ *
+ * @param pxQueue Set to the handle of the queue.  The handle is only valid
+ * for as long as the queue is not deleted.
+ *
+ * @return pdTRUE if the slot is in use and ppcQueueName and pxQueue have
+ * been set, otherwise pdFALSE.
+ */
+#if configQUEUE_REGISTRY_SIZE > 0U
+	portBASE_TYPE xQueueGetRegistryEntry( unsigned portBASE_TYPE uxIndex, signed char **ppcQueueName, xQueueHandle *pxQueue );
+#endif
+
 /* Not a public API function, hence the 'Restricted' in the name. */
 void vQueueWaitForMessageRestricted( xQueueHandle pxQueue, portTickType xTicksToWait );
 
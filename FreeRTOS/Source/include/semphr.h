@@ -119,6 +119,42 @@ typedef xQueueHandle xSemaphoreHandle;
 														}																								\
 													}
 
+/**
+ * semphr. h
+ * <pre>vSemaphoreCreateBinaryStatic( xSemaphoreHandle xSemaphore, xStaticSemaphore *pxSemaphoreBuffer )</pre>
+ *
+ * <i>Macro</i> that creates a binary semaphore in the same way as
+ * vSemaphoreCreateBinary(), but using memory supplied by the application
+ * instead of memory allocated from the FreeRTOS heap.  Requires
+ * configSUPPORT_STATIC_ALLOCATION to be set to 1 in FreeRTOSConfig.h.
+ *
+ * @param xSemaphore Handle to the created semaphore.  Should be of type xSemaphoreHandle.
+ *
+ * @param pxSemaphoreBuffer Must point to a variable of type xStaticSemaphore,
+ * which will be used to hold the semaphore's data structure.
+ *
+ * Example usage:
+ <pre>
+ xSemaphoreHandle xSemaphore;
+ static xStaticSemaphore xSemaphoreBuffer;
+
+ void vATask( void * pvParameters )
+ {
+    // No memory is allocated, so the semaphore is always created.
+    vSemaphoreCreateBinaryStatic( xSemaphore, &xSemaphoreBuffer );
+ }
+ </pre>
+ * \defgroup vSemaphoreCreateBinaryStatic vSemaphoreCreateBinaryStatic
+ * \ingroup Semaphores
+ */
+#define vSemaphoreCreateBinaryStatic( xSemaphore, pxSemaphoreBuffer )	{																												\
+																			( xSemaphore ) = xQueueCreateStatic( ( unsigned portBASE_TYPE ) 1, semSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, ( pxSemaphoreBuffer ) );	\
+																			if( ( xSemaphore ) != NULL )																				\
+																			{																											\
+																				xSemaphoreGive( ( xSemaphore ) );																		\
+																			}																											\
+																		}
+
 /**
  * semphr. h
  * <pre>xSemaphoreTake( 
@@ -441,6 +477,27 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreGiveRecursive( xMutex )	xQueueGiveMutexRecursive( ( xMutex ) )
 
+/**
+ * semphr. h
+ * <pre>xTaskHandle xSemaphoreGetMutexHolder( xSemaphoreHandle xMutex );</pre>
+ *
+ * INCLUDE_xSemaphoreGetMutexHolder must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Returns the handle of the task that holds the mutex specified by the
+ * function parameter, if any.  NULL is returned if the semaphore is not a
+ * mutex, if the mutex is available, or if the task that held it has been
+ * deleted.
+ *
+ * The holder can change at any time, so the value returned is only reliable
+ * if the calling task holds the mutex, or controls the tasks that might take
+ * it.
+ *
+ * \defgroup xSemaphoreGetMutexHolder xSemaphoreGetMutexHolder
+ * \ingroup Semaphores
+ */
+#define xSemaphoreGetMutexHolder( xMutex )	xQueueGetMutexHolder( ( xQueueHandle ) ( xMutex ) )
+
 /* 
  * xSemaphoreAltGive() is an alternative version of xSemaphoreGive().
  *
@@ -593,6 +650,26 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateMutex() xQueueCreateMutex()
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateMutexStatic( xStaticSemaphore *pxMutexBuffer )</pre>
+ *
+ * <i>Macro</i> that creates a mutex in the same way as xSemaphoreCreateMutex(),
+ * but using memory supplied by the application instead of memory allocated
+ * from the FreeRTOS heap.  Requires configSUPPORT_STATIC_ALLOCATION to be set
+ * to 1 in FreeRTOSConfig.h.
+ *
+ * @param pxMutexBuffer Must point to a variable of type xStaticSemaphore,
+ * which will be used to hold the mutex's data structure.
+ *
+ * @return Handle to the created mutex, or NULL if pxMutexBuffer was NULL.
+ *
+ * \defgroup xSemaphoreCreateMutexStatic xSemaphoreCreateMutexStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( ( pxMutexBuffer ) )
+
+
 
 /**
  * semphr. h
@@ -648,6 +725,20 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateRecursiveMutex() xQueueCreateMutex()
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateRecursiveMutexStatic( xStaticSemaphore *pxMutexBuffer )</pre>
+ *
+ * <i>Macro</i> that creates a recursive mutex in the same way as
+ * xSemaphoreCreateRecursiveMutex(), but using memory supplied by the
+ * application.  Requires configSUPPORT_STATIC_ALLOCATION to be set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * \defgroup xSemaphoreCreateRecursiveMutexStatic xSemaphoreCreateRecursiveMutexStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateRecursiveMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( ( pxMutexBuffer ) )
+
 /**
  * semphr. h
  * <pre>xSemaphoreHandle xSemaphoreCreateCounting( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount )</pre>
@@ -711,6 +802,31 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateCounting( uxMaxCount, uxInitialCount ) xQueueCreateCountingSemaphore( ( uxMaxCount ), ( uxInitialCount ) )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateCountingStatic( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount, xStaticSemaphore *pxSemaphoreBuffer )</pre>
+ *
+ * <i>Macro</i> that creates a counting semaphore in the same way as
+ * xSemaphoreCreateCounting(), but using memory supplied by the application
+ * instead of memory allocated from the FreeRTOS heap.  Requires
+ * configSUPPORT_STATIC_ALLOCATION to be set to 1 in FreeRTOSConfig.h.
+ *
+ * @param uxMaxCount The maximum count value that can be reached.
+ *
+ * @param uxInitialCount The count value assigned to the semaphore when it is
+ *        created.
+ *
+ * @param pxSemaphoreBuffer Must point to a variable of type xStaticSemaphore,
+ *        which will be used to hold the semaphore's data structure.
+ *
+ * @return Handle to the created semaphore, or NULL if pxSemaphoreBuffer was
+ *         NULL.
+ *
+ * \defgroup xSemaphoreCreateCountingStatic xSemaphoreCreateCountingStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateCountingStatic( uxMaxCount, uxInitialCount, pxSemaphoreBuffer ) xQueueCreateCountingSemaphoreStatic( ( uxMaxCount ), ( uxInitialCount ), ( pxSemaphoreBuffer ) )
+
 
 #endif /* SEMAPHORE_H */
 
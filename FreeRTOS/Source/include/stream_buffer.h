@@ -0,0 +1,321 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+	FreeRTOS supports many tools and architectures. V7.0.0 is sponsored by:
+	Atollic AB - Atollic provides professional embedded systems development 
+	tools for C/C++ development, code analysis and test automation.  
+	See http://www.atollic.com
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "#include FreeRTOS.h" must appear in source files before "#include stream_buffer.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Stream buffers pass a continuous stream of bytes from exactly one writer
+ * (a task or an interrupt) to exactly one reader (a task or an interrupt).
+ * Unlike a queue, any number of bytes can be written or read in a single call,
+ * with the data copied in at most two memcpy() operations rather than one
+ * queue operation per byte.
+ *
+ * The writer only ever updates the head index and the reader only ever
+ * updates the tail index, so no critical section is needed to move the data
+ * itself.  It is therefore NOT safe to have more than one writer or more than
+ * one reader unless the application serialises access itself - for example by
+ * only writing from within a critical section.
+ *
+ * A task blocked on a stream buffer waits using its direct to task
+ * notification, so configUSE_TASK_NOTIFICATIONS must be set to 1.
+ */
+
+/**
+ * Type by which stream buffers are referenced.  For example, a call to
+ * xStreamBufferCreate() returns an xStreamBufferHandle variable that can then
+ * be used as a parameter to xStreamBufferSend(), xStreamBufferReceive(), etc.
+ */
+typedef void * xStreamBufferHandle;
+
+
+/**
+ * stream_buffer. h
+ * <pre>
+ xStreamBufferHandle xStreamBufferCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ * </pre>
+ *
+ * Creates a new stream buffer, allocating the storage it requires with
+ * pvPortMalloc().
+ *
+ * @param xBufferSizeBytes The total number of bytes the stream buffer will be
+ * able to hold at any one time.
+ *
+ * @param xTriggerLevelBytes The number of bytes that must be in the stream
+ * buffer before a task that is blocked on the stream buffer waiting for data
+ * is moved out of the blocked state.  A trigger level of 1 unblocks the reader
+ * as soon as any data is written.  A trigger level of 0 is treated as 1.  The
+ * trigger level cannot be larger than the buffer size.
+ *
+ * @return A handle to the created stream buffer, or NULL if there was not
+ * enough heap memory available.
+ *
+ * \defgroup xStreamBufferCreate xStreamBufferCreate
+ * \ingroup StreamBufferManagement
+ */
+xStreamBufferHandle xStreamBufferCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait );
+ * </pre>
+ *
+ * Copies bytes into a stream buffer.  Must only be called from a task.
+ *
+ * If there is not enough free space for all xDataLengthBytes the calling task
+ * will block for up to xTicksToWait ticks for space to become available.  If
+ * the timeout expires first then as many bytes as will fit are written.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being written to.
+ *
+ * @param pvTxData A pointer to the bytes to copy into the stream buffer.
+ *
+ * @param xDataLengthBytes The number of bytes to copy from pvTxData.
+ *
+ * @param xTicksToWait The maximum time the calling task should remain in the
+ * Blocked state waiting for enough space to become available.  Setting
+ * xTicksToWait to portMAX_DELAY will cause the task to wait indefinitely
+ * (without a timeout), provided INCLUDE_vTaskSuspend is set to 1.
+ *
+ * @return The number of bytes written to the stream buffer.
+ *
+ * \defgroup xStreamBufferSend xStreamBufferSend
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait );
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * Interrupt safe version of xStreamBufferSend().  Writes as many of the bytes
+ * as will fit and never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if writing the data caused a
+ * task that has a priority above the priority of the interrupted task to
+ * leave the Blocked state.  A context switch should then be requested before
+ * the interrupt exits.
+ *
+ * @return The number of bytes written to the stream buffer.
+ *
+ * \defgroup xStreamBufferSendFromISR xStreamBufferSendFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait );
+ * </pre>
+ *
+ * Copies up to xBufferLengthBytes bytes out of a stream buffer.  Must only be
+ * called from a task.
+ *
+ * If the stream buffer is empty the calling task will block for up to
+ * xTicksToWait ticks for data to arrive.  The task is unblocked once the
+ * number of bytes in the stream buffer reaches the trigger level, or the
+ * timeout expires, whichever happens first.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being read from.
+ *
+ * @param pvRxData A pointer to the buffer into which bytes are copied.
+ *
+ * @param xBufferLengthBytes The size of the buffer pointed to by pvRxData,
+ * which is also the maximum number of bytes that will be read.
+ *
+ * @param xTicksToWait The maximum time the calling task should remain in the
+ * Blocked state waiting for data.
+ *
+ * @return The number of bytes read from the stream buffer, which will be zero
+ * if the call timed out before any data arrived.
+ *
+ * \defgroup xStreamBufferReceive xStreamBufferReceive
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait );
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * Interrupt safe version of xStreamBufferReceive().  Never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if reading the data freed
+ * space that caused a task blocked in xStreamBufferSend() with a priority
+ * above the priority of the interrupted task to leave the Blocked state.
+ *
+ * @return The number of bytes read from the stream buffer.
+ *
+ * \defgroup xStreamBufferReceiveFromISR xStreamBufferReceiveFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/**
+ * stream_buffer. h
+ * <pre>
+ void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer );
+ * </pre>
+ *
+ * Frees the memory used by a stream buffer.  A stream buffer must not be
+ * deleted while a task is blocked on it.
+ *
+ * \defgroup vStreamBufferDelete vStreamBufferDelete
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer );
+
+/**
+ * stream_buffer. h
+ * <pre>
+ portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer );
+ * </pre>
+ *
+ * Empties a stream buffer.  A stream buffer can only be reset if no tasks are
+ * blocked on it.
+ *
+ * @return pdPASS if the stream buffer was reset, otherwise pdFAIL.
+ *
+ * \defgroup xStreamBufferReset xStreamBufferReset
+ * \ingroup StreamBufferManagement
+ */
+portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer );
+
+/**
+ * stream_buffer. h
+ * <pre>
+ portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel );
+ * </pre>
+ *
+ * Changes the trigger level of a stream buffer.
+ *
+ * @return pdTRUE if the new trigger level was set, or pdFALSE if the requested
+ * trigger level was larger than the size of the buffer.
+ *
+ * \defgroup xStreamBufferSetTriggerLevel xStreamBufferSetTriggerLevel
+ * \ingroup StreamBufferManagement
+ */
+portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel );
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer );
+ * </pre>
+ *
+ * @return The number of bytes that can currently be read from the stream
+ * buffer.  Safe to call from a task or an interrupt.
+ *
+ * \defgroup xStreamBufferBytesAvailable xStreamBufferBytesAvailable
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer );
+
+/**
+ * stream_buffer. h
+ * <pre>
+ size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer );
+ * </pre>
+ *
+ * @return The number of bytes that can currently be written to the stream
+ * buffer.  Safe to call from a task or an interrupt.
+ *
+ * \defgroup xStreamBufferSpacesAvailable xStreamBufferSpacesAvailable
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer );
+
+/**
+ * stream_buffer. h
+ * <pre>
+ portBASE_TYPE xStreamBufferIsEmpty( xStreamBufferHandle xStreamBuffer );
+ portBASE_TYPE xStreamBufferIsFull( xStreamBufferHandle xStreamBuffer );
+ * </pre>
+ *
+ * Query whether a stream buffer is empty or full.  Safe to call from a task
+ * or an interrupt.
+ *
+ * \defgroup xStreamBufferIsEmpty xStreamBufferIsEmpty
+ * \ingroup StreamBufferManagement
+ */
+#define xStreamBufferIsEmpty( xStreamBuffer ) ( ( xStreamBufferBytesAvailable( ( xStreamBuffer ) ) == ( size_t ) 0 ) ? pdTRUE : pdFALSE )
+#define xStreamBufferIsFull( xStreamBuffer ) ( ( xStreamBufferSpacesAvailable( ( xStreamBuffer ) ) == ( size_t ) 0 ) ? pdTRUE : pdFALSE )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STREAM_BUFFER_H */
+
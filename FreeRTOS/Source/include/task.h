@@ -123,6 +123,59 @@ typedef struct xTASK_PARAMTERS
 	xMemoryRegion xRegions[ portNUM_CONFIGURABLE_REGIONS ];
 } xTaskParameters;
 
+/*
+ * Actions that can be performed when xTaskNotify() is called.
+ */
+typedef enum
+{
+	eNoAction = 0,				/* Notify the task without updating its notify value. */
+	eSetBits,					/* Set bits in the task's notification value. */
+	eIncrement,					/* Increment the task's notification value. */
+	eSetValueWithOverwrite,		/* Set the task's notification value to a specific value even if the previous value has not yet been read by the task. */
+	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
+} eNotifyAction;
+
+/*
+ * Possible return values for eTaskConfirmSleepModeStatus().
+ */
+typedef enum
+{
+	eAbortSleep = 0,		/* A task has been made ready or a context switch pended since portSUPPRESS_TICKS_AND_SLEEP() was called - abort entering a sleep mode. */
+	eStandardSleep,			/* Enter a sleep mode that will not last any longer than the expected idle time. */
+	eNoTasksWaitingTimeout	/* No tasks are waiting for a timeout so it is safe to enter a sleep mode that can only be exited by an external interrupt. */
+} eSleepModeStatus;
+
+/*
+ * Task states returned by uxTaskGetSystemState().
+ */
+typedef enum
+{
+	eRunning = 0,	/* A task is querying the state of itself, so must be running. */
+	eReady,			/* The task being queried is in a ready or pending ready list. */
+	eBlocked,		/* The task being queried is in the Blocked state. */
+	eSuspended,		/* The task being queried is in the Suspended state. */
+	eDeleted		/* The task being queried has been deleted, but its TCB has not yet been freed. */
+} eTaskState;
+
+/*
+ * Used with the uxTaskGetSystemState() function to return the state of each
+ * task in the system.  All the fields are always present, whatever the
+ * configuration, so the layout does not change from build to build.
+ */
+typedef struct xTASK_STATUS
+{
+	xTaskHandle xHandle;						/* The handle of the task to which the rest of the information in the structure relates. */
+	const signed char *pcTaskName;				/* A pointer to the task's name.  This value will be invalid if the task was deleted since the structure was populated! */
+	unsigned portBASE_TYPE xTaskNumber;			/* A number unique to the task.  Only meaningful if configUSE_TRACE_FACILITY is 1. */
+	eTaskState eCurrentState;					/* The state in which the task existed when the structure was populated. */
+	unsigned portBASE_TYPE uxCurrentPriority;	/* The priority at which the task was running (may be inherited) when the structure was populated. */
+	unsigned portBASE_TYPE uxBasePriority;		/* The priority to which the task will return if its current priority has been inherited.  Only meaningful if configUSE_MUTEXES is 1. */
+	unsigned long long ullRunTimeCounter;		/* The total run time allocated to the task so far.  Only meaningful if configGENERATE_RUN_TIME_STATS is 1. */
+	unsigned long ulWindowRunTime;				/* The run time used by the task during the last complete load window.  Only meaningful if configGENERATE_RUN_TIME_STATS is 1. */
+	unsigned portBASE_TYPE uxWindowLoad;		/* ulWindowRunTime as a percentage of the length of the last complete load window.  Only meaningful if configGENERATE_RUN_TIME_STATS is 1. */
+	unsigned short usStackHighWaterMark;		/* The minimum amount of stack space that has remained for the task since it was created, in words. */
+} xTaskStatusType;
+
 /*
  * Defines the priority used by the idle task.  This must not be modified.
  *
@@ -275,6 +328,83 @@ typedef struct xTASK_PARAMTERS
  */
 #define xTaskCreate( pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask ) xTaskGenericCreate( ( pvTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), ( uxPriority ), ( pxCreatedTask ), ( NULL ), ( NULL ) )
 
+/**
+ * task. h
+ *<pre>
+ xTaskHandle xTaskCreateStatic(
+								  pdTASK_CODE pvTaskCode,
+								  const char * const pcName,
+								  unsigned short usStackDepth,
+								  void *pvParameters,
+								  unsigned portBASE_TYPE uxPriority,
+								  portSTACK_TYPE * const puxStackBuffer,
+								  xStaticTask * const pxTaskBuffer
+							  );</pre>
+ *
+ * Create a new task and add it to the list of tasks that are ready to run.
+ *
+ * Unlike xTaskCreate(), no memory is obtained from the FreeRTOS heap.  The
+ * memory used to hold the task's stack and its control block is instead
+ * provided by the application writer through the puxStackBuffer and
+ * pxTaskBuffer parameters, so the memory requirement is known at link time.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param pvTaskCode Pointer to the task entry function.  Tasks
+ * must be implemented to never return (i.e. continuous loop).
+ *
+ * @param pcName A descriptive name for the task.
+ *
+ * @param usStackDepth The size of the task stack specified as the number of
+ * variables the stack can hold - not the number of bytes.  puxStackBuffer must
+ * point to an array of at least usStackDepth portSTACK_TYPE variables.
+ *
+ * @param pvParameters Pointer that will be used as the parameter for the task
+ * being created.
+ *
+ * @param uxPriority The priority at which the task should run.
+ *
+ * @param puxStackBuffer Must point to a portSTACK_TYPE array that has at least
+ * usStackDepth indexes.  The array is used as the task's stack so must
+ * persist for the lifetime of the task.
+ *
+ * @param pxTaskBuffer Must point to a variable of type xStaticTask, which will
+ * be used to hold the task's data structures (its TCB).
+ *
+ * @return If neither puxStackBuffer nor pxTaskBuffer are NULL then the task
+ * will be created and a handle to the task is returned.  If either is NULL
+ * then the task is not created and NULL is returned.
+ *
+ * Example usage:
+   <pre>
+ #define STACK_SIZE 200
+
+ // Structure that will hold the TCB of the task being created.
+ static xStaticTask xTaskBuffer;
+
+ // Buffer that the task being created will use as its stack.
+ static portSTACK_TYPE xStack[ STACK_SIZE ];
+
+ // Function that creates a task.
+ void vOtherFunction( void )
+ {
+ xTaskHandle xHandle;
+
+	 // Create the task without using any dynamic memory allocation.
+	 xHandle = xTaskCreateStatic( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, xStack, &xTaskBuffer );
+
+	 // The handle can be used in the same way as one returned by
+	 // xTaskCreate(), including to delete the task.  Deleting the task does
+	 // not free the buffers, which the application can then reuse.
+	 vTaskDelete( xHandle );
+ }
+   </pre>
+ * \defgroup xTaskCreateStatic xTaskCreateStatic
+ * \ingroup Tasks
+ */
+xTaskHandle xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, portSTACK_TYPE * const puxStackBuffer, xStaticTask * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  *<pre>
@@ -1005,6 +1135,73 @@ portTickType xTaskGetTickCountFromISR( void ) PRIVILEGED_FUNCTION;
  */
 unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <PRE>unsigned portBASE_TYPE uxTaskGetSystemState( xTaskStatusType *pxTaskStatusArray, unsigned portBASE_TYPE uxArraySize, unsigned long long *pullTotalRunTime );</PRE>
+ *
+ * configUSE_TRACE_FACILITY or configGENERATE_RUN_TIME_STATS must be defined
+ * as 1 for this function to be available.  See the configuration section for
+ * more information.
+ *
+ * Populates an xTaskStatusType structure for each task in the system.  The
+ * structures contain the task handle, name, number, state, current and base
+ * priority, stack high water mark and, if configGENERATE_RUN_TIME_STATS is
+ * 1, the run time statistics of the task.  No text is formatted, so the
+ * function is cheap enough to be called periodically by a monitoring task,
+ * which can then pass the binary data on to a host for display.
+ *
+ * Run time is accumulated in 64 bits so the totals do not overflow.  The
+ * CPU load figures are taken from the last complete load window, which is
+ * configRUN_TIME_STATS_WINDOW_TICKS ticks long (one second by default).
+ *
+ * The scheduler is suspended while the task lists are walked.  Most of the
+ * time taken is in measuring the stack high water marks, which is
+ * proportional to the amount of unused stack.
+ *
+ * @param pxTaskStatusArray An array into which one xTaskStatusType
+ * structure per task is written.
+ *
+ * @param uxArraySize The number of structures pxTaskStatusArray can hold.
+ * This must be at least uxTaskGetNumberOfTasks().
+ *
+ * @param pullTotalRunTime If not NULL, set to the total run time of all
+ * tasks since the scheduler started (or 0 if configGENERATE_RUN_TIME_STATS
+ * is not 1).
+ *
+ * @return The number of structures written, or 0 if uxArraySize was too
+ * small.
+ *
+ * Example usage:
+   <pre>
+   #define mainMAX_TASKS 16
+
+   void vAMonitorTask( void *pvParameters )
+   {
+   static xTaskStatusType xStatus[ mainMAX_TASKS ];
+   unsigned portBASE_TYPE uxTasks, x;
+
+       for( ;; )
+       {
+           vTaskDelay( 1000 / portTICK_RATE_MS );
+
+           uxTasks = uxTaskGetSystemState( xStatus, mainMAX_TASKS, NULL );
+
+           for( x = 0; x < uxTasks; x++ )
+           {
+               if( xStatus[ x ].usStackHighWaterMark < 20 )
+               {
+                   // This task is close to overflowing its stack.
+               }
+           }
+       }
+   }
+   </pre>
+ *
+ * \page uxTaskGetSystemState uxTaskGetSystemState
+ * \ingroup TaskUtils
+ */
+unsigned portBASE_TYPE uxTaskGetSystemState( xTaskStatusType *pxTaskStatusArray, unsigned portBASE_TYPE uxArraySize, unsigned long long *pullTotalRunTime ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <PRE>void vTaskList( char *pcWriteBuffer );</PRE>
@@ -1012,11 +1209,14 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void ) PRIVILEGED_FUNCTION;
  * configUSE_TRACE_FACILITY must be defined as 1 for this function to be
  * available.  See the configuration section for more information.
  *
- * NOTE: This function will disable interrupts for its duration.  It is
- * not intended for normal application runtime use but as a debug aid.
+ * NOTE: This function formats text and allocates a temporary array from
+ * the FreeRTOS heap.  It is not intended for normal application runtime
+ * use but as a debug aid - use uxTaskGetSystemState() instead.
  *
- * Lists all the current tasks, along with their current state and stack
- * usage high water mark.
+ * Lists all the current tasks, along with their current state, priority,
+ * stack usage high water mark and task number.  It is implemented using
+ * uxTaskGetSystemState(), and writes an error line in place of the list if
+ * the temporary array cannot be allocated.
  *
  * Tasks are reported as blocked ('B'), ready ('R'), deleted ('D') or
  * suspended ('S').
@@ -1042,8 +1242,11 @@ void vTaskList( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
  * and return the timers current count value respectively.  The counter
  * should be at least 10 times the frequency of the tick count.
  *
- * NOTE: This function will disable interrupts for its duration.  It is
- * not intended for normal application runtime use but as a debug aid.
+ * NOTE: This function formats text and allocates a temporary array from
+ * the FreeRTOS heap.  It is not intended for normal application runtime
+ * use but as a debug aid - use uxTaskGetSystemState() instead.  It is
+ * implemented using uxTaskGetSystemState(), and writes an error line in
+ * place of the table if the temporary array cannot be allocated.
  *
  * Setting configGENERATE_RUN_TIME_STATS to 1 will result in a total
  * accumulated execution time being stored for each task.  The resolution
@@ -1063,6 +1266,22 @@ void vTaskList( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
  */
 void vTaskGetRunTimeStats( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <PRE>unsigned portBASE_TYPE uxTaskGetIdleRunTimePercent( void );</PRE>
+ *
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 for this function
+ * to be available.
+ *
+ * @return The percentage of the last complete load window spent in the
+ * idle task, or 0 if no window has completed yet.  100 minus this value
+ * is the CPU load.
+ *
+ * \page uxTaskGetIdleRunTimePercent uxTaskGetIdleRunTimePercent
+ * \ingroup TaskUtils
+ */
+unsigned portBASE_TYPE uxTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <PRE>void vTaskStartTrace( char * pcBuffer, unsigned portBASE_TYPE uxBufferSize );</PRE>
@@ -1157,6 +1376,172 @@ constant. */
  */
 portBASE_TYPE xTaskCallApplicationTaskHook( xTaskHandle xTask, void *pvParameter ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction );</PRE>
+ *
+ * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
+ * function to be available.
+ *
+ * Each task has a 32-bit notification value and a notification state that
+ * are held in its TCB.  Sending a notification to a task unblocks it if it is
+ * waiting in xTaskNotifyWait() or ulTaskNotifyTake(), and optionally updates
+ * its notification value.  This provides a faster and lighter weight
+ * alternative to a binary or counting semaphore, event flags, or a single item
+ * queue, when there is only ever one task that receives the event, because no
+ * separate queue object needs to be created and the queue send/receive path
+ * is not used.
+ *
+ * @param xTaskToNotify The handle of the task being notified.
+ *
+ * @param ulValue Data that can be sent with the notification.  How the data
+ * is used depends on the value of the eAction parameter.
+ *
+ * @param eAction Specifies how the notification updates the task's
+ * notification value:
+ *
+ * eSetBits - The notification value is bitwise ORed with ulValue.  Always
+ * returns pdPASS.
+ *
+ * eIncrement - The notification value is incremented (ulValue is not used).
+ * Always returns pdPASS.
+ *
+ * eSetValueWithOverwrite - The notification value is set to ulValue, even if
+ * the task had not yet read the previous value.  Always returns pdPASS.
+ *
+ * eSetValueWithoutOverwrite - The notification value is set to ulValue only if
+ * the task did not already have a notification pending, in which case pdPASS
+ * is returned.  Otherwise the value is left unchanged and pdFAIL is returned.
+ *
+ * eNoAction - The task is notified without its notification value being
+ * changed.  Always returns pdPASS.
+ *
+ * @param pulPreviousNotificationValue xTaskNotifyAndQuery() only.  If not NULL
+ * the task's notification value from before the update is written here.
+ *
+ * \page xTaskNotify xTaskNotify
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xTaskNotify() that can be called from an interrupt service
+ * routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the notification
+ * caused a task to unblock that has a priority at or above the priority of the
+ * task that was running when the interrupt occurred.  In that case a context
+ * switch should be requested with portEND_SWITCHING_ISR() before the interrupt
+ * exits.
+ *
+ * \page xTaskNotifyFromISR xTaskNotifyFromISR
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskGenericNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait );</PRE>
+ *
+ * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
+ * function to be available.
+ *
+ * Wait, with an optional timeout, for the calling task to receive a
+ * notification.  The task does not consume any CPU time while it is in the
+ * Blocked state.
+ *
+ * @param ulBitsToClearOnEntry Bits that are set in ulBitsToClearOnEntry are
+ * cleared in the calling task's notification value before the task checks
+ * for a pending notification, provided no notification was already pending.
+ *
+ * @param ulBitsToClearOnExit Bits that are set in ulBitsToClearOnExit are
+ * cleared in the calling task's notification value before the function
+ * returns, if a notification was received.
+ *
+ * @param pulNotificationValue If not NULL, the task's notification value is
+ * written here before any bits are cleared by ulBitsToClearOnExit.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ *
+ * @return pdTRUE if a notification was received (including one that was
+ * already pending when the function was called), otherwise pdFALSE.
+ *
+ * \page xTaskNotifyWait xTaskNotifyWait
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyGive( xTaskHandle xTaskToNotify );</PRE>
+ *
+ * Increments the notification value of xTaskToNotify.  Intended to be used
+ * with ulTaskNotifyTake() where the notification value is used in place of a
+ * binary or counting semaphore.
+ *
+ * \page xTaskNotifyGive xTaskNotifyGive
+ * \ingroup TaskNotifications
+ */
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+
+/**
+ * task. h
+ * <PRE>void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xTaskNotifyGive() that can be called from an interrupt service
+ * routine.  This is the notification equivalent of xSemaphoreGiveFromISR().
+ *
+ * \page vTaskNotifyGiveFromISR vTaskNotifyGiveFromISR
+ * \ingroup TaskNotifications
+ */
+void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait );</PRE>
+ *
+ * The notification equivalent of xSemaphoreTake().  Waits, with an optional
+ * timeout, for the calling task's notification value to be non-zero.
+ *
+ * @param xClearCountOnExit If pdTRUE the notification value is cleared to zero
+ * before the function exits, so it behaves like a binary semaphore.  If
+ * pdFALSE the notification value is decremented, so it behaves like a
+ * counting semaphore.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state.
+ *
+ * @return The task's notification value before it was cleared or decremented.
+ * Zero means the call timed out.
+ *
+ * \page ulTaskNotifyTake ulTaskNotifyTake
+ * \ingroup TaskNotifications
+ */
+unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyStateClear( xTaskHandle xTask );</PRE>
+ *
+ * If the notification state of the task referenced by xTask is "notified"
+ * then set it back to "not waiting for a notification".  The notification
+ * value is not altered.  Set xTask to NULL to clear the notification state of
+ * the calling task.
+ *
+ * @return pdTRUE if the task's notification state was "notified", otherwise
+ * pdFALSE.
+ *
+ * \page xTaskNotifyStateClear xTaskNotifyStateClear
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyStateClear( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
+
 
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
@@ -1174,6 +1559,36 @@ portBASE_TYPE xTaskCallApplicationTaskHook( xTaskHandle xTask, void *pvParameter
  */
 void vTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * configUSE_TICKLESS_IDLE must be set to a value other than 0 for this
+ * function to be available.
+ *
+ * Called by the port's portSUPPRESS_TICKS_AND_SLEEP() implementation after the
+ * tick interrupt has been suppressed for xTicksToJump tick periods.  Moves the
+ * tick count forward in a single step rather than calling
+ * vTaskIncrementTick() once for each tick that was skipped.
+ */
+void vTaskStepTick( portTickType xTicksToJump ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * configUSE_TICKLESS_IDLE must be set to a value other than 0 for this
+ * function to be available.
+ *
+ * Called from portSUPPRESS_TICKS_AND_SLEEP() with interrupts disabled, just
+ * before the processor is put to sleep, to confirm that nothing has happened
+ * since the expected idle time was calculated that means the sleep should be
+ * abandoned.
+ */
+eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -1229,6 +1644,47 @@ void vTaskPlaceOnEventListRestricted( const xList * const pxEventList, portTickT
  */
 signed portBASE_TYPE xTaskRemoveFromEventList( const xList * const pxEventList ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.
+ *
+ * Used by the event group implementation.  Places the calling task on an event
+ * list in the same way as vTaskPlaceOnEventList(), but the list is not ordered
+ * by priority.  Instead xItemValue (the bits the task is waiting for, and how
+ * it is waiting for them) is stored in the task's event list item, where it can
+ * be inspected by the task that sets the bits.
+ */
+void vTaskPlaceOnUnorderedEventList( xList * pxEventList, portTickType xItemValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.
+ *
+ * Used by the event group implementation.  Removes the task that owns
+ * pxEventListItem from an unordered event list and from the list of blocked
+ * tasks, places it on a ready queue, and stores xItemValue (the event bits that
+ * unblocked it) in its event list item.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * making the call, otherwise pdFALSE.
+ */
+signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem * pxEventListItem, portTickType xItemValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Returns the value held in the calling task's event list item, then restores
+ * the item to the value used when the task is placed on a priority ordered
+ * event list.  Used by the event group implementation to find out why a task
+ * that had been waiting on an event group was unblocked.
+ */
+portTickType uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -1281,16 +1737,40 @@ void vTaskMissedYield( void ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xTaskGetSchedulerState( void ) PRIVILEGED_FUNCTION;
 
 /*
- * Raises the priority of the mutex holder to that of the calling task should
- * the mutex holder have a priority less than the calling task.
+ * The functions below implement priority inheritance for the mutexes in
+ * queue.c.  Each mutex has an ownership list item that is kept in its
+ * holder's list of held mutexes, sorted by the priority of the highest
+ * priority task waiting for the mutex.  A task runs at the higher of its base
+ * priority and the priority at the head of that list.  Inheritance is
+ * transitive - if the holder is itself blocked on another mutex, the holder of
+ * that mutex inherits in turn.  pxWaitingTasks is the mutex's list of tasks
+ * waiting to take it.
  */
-void vTaskPriorityInherit( xTaskHandle * const pxMutexHolder ) PRIVILEGED_FUNCTION;
 
 /*
- * Set the priority of a task back to its proper priority in the case that it
- * inherited a higher priority while it was holding a semaphore.
+ * Called by a task that is about to block on a held mutex.  Raises the
+ * priority of the holder, and of anything the holder is blocked behind, to
+ * that of the calling task should it be lower.
  */
-void vTaskPriorityDisinherit( xTaskHandle * const pxMutexHolder ) PRIVILEGED_FUNCTION;
+void vTaskPriorityInherit( xListItem * const pxMutexItem, xList * const pxWaitingTasks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when the mutex is given back.  Removes the mutex from its holder and
+ * recalculates the holder's priority from the mutexes it still holds.
+ */
+void vTaskPriorityDisinherit( xListItem * const pxMutexItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by a task that stopped waiting for the mutex because its block time
+ * expired.  The holder no longer inherits the calling task's priority.
+ */
+void vTaskPriorityDisinheritAfterTimeout( xListItem * const pxMutexItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when the calling task has taken the mutex.  Records the calling task
+ * as the holder, which inherits from any tasks still waiting for the mutex.
+ */
+void vTaskMutexTaken( xListItem * const pxMutexItem, const xList * const pxWaitingTasks ) PRIVILEGED_FUNCTION;
 
 /*
  * Generic version of the task creation function which is in turn called by the
@@ -1298,6 +1778,17 @@ void vTaskPriorityDisinherit( xTaskHandle * const pxMutexHolder ) PRIVILEGED_FUN
  */
 signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions ) PRIVILEGED_FUNCTION;
 
+/*
+ * When configSUPPORT_STATIC_ALLOCATION is 1 the idle task is created using
+ * memory supplied by the application, which must therefore provide an
+ * implementation of this function.  *ppxIdleTaskTCBBuffer and
+ * *ppxIdleTaskStackBuffer must be set to point to memory that persists for
+ * the lifetime of the application, and *pusIdleTaskStackSize to the number of
+ * portSTACK_TYPE variables in the stack buffer (normally
+ * configMINIMAL_STACK_SIZE).
+ */
+void vApplicationGetIdleTaskMemory( xStaticTask **ppxIdleTaskTCBBuffer, portSTACK_TYPE **ppxIdleTaskStackBuffer, unsigned short *pusIdleTaskStackSize );
+
 #ifdef __cplusplus
 }
 #endif
@@ -79,6 +79,7 @@ as defined below. */
 #define tmrCOMMAND_STOP						1
 #define tmrCOMMAND_CHANGE_PERIOD			2
 #define tmrCOMMAND_DELETE					3
+#define tmrCOMMAND_EXECUTE_CALLBACK			( -1 )
 
 /*-----------------------------------------------------------
  * MACROS AND DEFINITIONS
@@ -95,6 +96,11 @@ typedef void * xTimerHandle;
 /* Define the prototype to which timer callback functions must conform. */
 typedef void (*tmrTIMER_CALLBACK)( xTimerHandle xTimer );
 
+/* Define the prototype to which functions executed by the timer service task
+through xTimerPendFunctionCall() and xTimerPendFunctionCallFromISR() must
+conform. */
+typedef void (*tmrPENDED_FUNCTION)( void *pvParameter1, unsigned long ulParameter2 );
+
 /**
  * xTimerHandle xTimerCreate( 	const signed char *pcTimerName,
  * 								portTickType xTimerPeriod,
@@ -225,6 +231,49 @@ typedef void (*tmrTIMER_CALLBACK)( xTimerHandle xTimer );
  */
 xTimerHandle xTimerCreate( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void * pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction ) PRIVILEGED_FUNCTION;
 
+/**
+ * xTimerHandle xTimerCreateStatic( const signed char *pcTimerName,
+ * 									portTickType xTimerPeriod,
+ * 									unsigned portBASE_TYPE uxAutoReload,
+ * 									void * pvTimerID,
+ * 									tmrTIMER_CALLBACK pxCallbackFunction,
+ * 									xStaticTimer *pxTimerBuffer );
+ *
+ * Creates a new software timer instance in the same way as xTimerCreate(),
+ * but the memory used to hold the timer is provided by the application writer
+ * through the pxTimerBuffer parameter instead of being allocated from the
+ * FreeRTOS heap.  configSUPPORT_STATIC_ALLOCATION must be set to 1 in
+ * FreeRTOSConfig.h for this function to be available.
+ *
+ * The parameters are as per xTimerCreate(), plus:
+ *
+ * @param pxTimerBuffer Must point to a variable of type xStaticTimer, which
+ * will be used to hold the timer's data structure.  Deleting the timer does
+ * not free this memory.
+ *
+ * @return If xTimerPeriod is greater than zero and pxTimerBuffer is not NULL
+ * then a handle to the newly created timer is returned, otherwise NULL is
+ * returned.
+ *
+ * Example usage:
+ *
+ * static xStaticTimer xTimerBuffer;
+ *
+ * void vAFunction( void )
+ * {
+ * xTimerHandle xTimer;
+ *
+ *     // Create a one-shot timer without using any dynamic memory allocation.
+ *     xTimer = xTimerCreateStatic( "Timer", 100, pdFALSE, NULL, vTimerCallback, &xTimerBuffer );
+ *
+ *     if( xTimer != NULL )
+ *     {
+ *         xTimerStart( xTimer, 0 );
+ *     }
+ * }
+ */
+xTimerHandle xTimerCreateStatic( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void * pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xStaticTimer *pxTimerBuffer ) PRIVILEGED_FUNCTION;
+
 /**
  * void *pvTimerGetTimerID( xTimerHandle xTimer );
  *
@@ -920,13 +969,153 @@ portBASE_TYPE xTimerIsTimerActive( xTimerHandle xTimer ) PRIVILEGED_FUNCTION;
  */
 #define xTimerResetFromISR( xTimer, pxHigherPriorityTaskWoken ) xTimerGenericCommand( ( xTimer ), tmrCOMMAND_START, ( xTaskGetTickCountFromISR() ), ( pxHigherPriorityTaskWoken ), 0U )
 
+/**
+ * portBASE_TYPE xTimerPendFunctionCallFromISR( tmrPENDED_FUNCTION xFunctionToPend,
+ *                                              void *pvParameter1,
+ *                                              unsigned long ulParameter2,
+ *                                              portBASE_TYPE *pxHigherPriorityTaskWoken );
+ *
+ * Used from an interrupt service routine to defer the execution of a function
+ * to the RTOS daemon task (the timer service task, hence this function is
+ * implemented in timers.c and is prefixed with 'Timer').
+ *
+ * Ideally an interrupt service routine (ISR) is kept as short as possible, but
+ * sometimes an ISR either has a lot of processing to do, or needs to perform
+ * processing that is not deterministic.  In these cases
+ * xTimerPendFunctionCallFromISR() can be used to defer processing of a function
+ * to the RTOS daemon task.  A mechanism is provided that allows the interrupt
+ * to return directly to the task that will subsequently execute the pended
+ * function.  This allows the callback function to execute contiguously in
+ * time with the interrupt - just as if the callback had executed in the
+ * interrupt itself - without each driver needing a task (and a stack) of its
+ * own to do the same.
+ *
+ * Functions pended to the daemon task run in the order in which they were
+ * posted, interleaved with the processing of timer commands.  They must not
+ * block, as that would delay every other timer and pended function.
+ *
+ * @param xFunctionToPend The function to execute from the timer service/
+ * daemon task.  The function must conform to the tmrPENDED_FUNCTION prototype.
+ *
+ * @param pvParameter1 The value of the callback function's first parameter.
+ * The parameter has a void * type to allow it to be used to pass any type.
+ * For example, unsigned longs can be cast to a void *, or the void * can be
+ * used to point to a structure.
+ *
+ * @param ulParameter2 The value of the callback function's second parameter.
+ *
+ * @param pxHigherPriorityTaskWoken As mentioned above, calling this function
+ * will result in a message being sent to the timer daemon task.  If the
+ * priority of the timer daemon task (which is set using
+ * configTIMER_TASK_PRIORITY in FreeRTOSConfig.h) is higher than the priority of
+ * the currently running task (the task the interrupt interrupted) then
+ * *pxHigherPriorityTaskWoken will be set to pdTRUE within
+ * xTimerPendFunctionCallFromISR(), indicating that a context switch should be
+ * requested before the interrupt exits.  For that reason
+ * *pxHigherPriorityTaskWoken must be initialised to pdFALSE.
+ *
+ * @return pdPASS is returned if the message was successfully sent to the
+ * timer daemon task, otherwise pdFALSE is returned - for example because the
+ * timer command queue was full.
+ *
+ * Example usage:
+ *
+ * // The callback function that will execute in the context of the daemon task.
+ * // Note callback functions must all use this same prototype.
+ * void vProcessInterface( void *pvParameter1, unsigned long ulParameter2 )
+ * {
+ * portBASE_TYPE xInterfaceToService;
+ *
+ *     // The interface that requires servicing is passed in the second
+ *     // parameter.  The first parameter is not used in this case.
+ *     xInterfaceToService = ( portBASE_TYPE ) ulParameter2;
+ *
+ *     // ...Perform the processing here...
+ * }
+ *
+ * // An ISR that receives data packets from multiple interfaces
+ * void vAnISR( void )
+ * {
+ * portBASE_TYPE xInterfaceToService, xHigherPriorityTaskWoken;
+ *
+ *     // Query the hardware to determine which interface needs processing.
+ *     xInterfaceToService = prvCheckInterfaces();
+ *
+ *     // The actual processing is to be deferred to a task.  Request the
+ *     // vProcessInterface() callback function is executed, passing in the
+ *     // number of the interface that needs processing.  The interface to
+ *     // service is passed in the second parameter.  The first parameter is
+ *     // not used in this case.
+ *     xHigherPriorityTaskWoken = pdFALSE;
+ *     xTimerPendFunctionCallFromISR( vProcessInterface, NULL, ( unsigned long ) xInterfaceToService, &xHigherPriorityTaskWoken );
+ *
+ *     // If xHigherPriorityTaskWoken is now set to pdTRUE then a context
+ *     // switch should be requested.  The macro used is port specific and will
+ *     // be either portYIELD_FROM_ISR() or portEND_SWITCHING_ISR() - refer to
+ *     // the documentation page for the port being used.
+ *     portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+ * }
+ */
+portBASE_TYPE xTimerPendFunctionCallFromISR( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * portBASE_TYPE xTimerPendFunctionCall( tmrPENDED_FUNCTION xFunctionToPend,
+ *                                       void *pvParameter1,
+ *                                       unsigned long ulParameter2,
+ *                                       portTickType xTicksToWait );
+ *
+ * Used to defer the execution of a function to the RTOS daemon task (the timer
+ * service task, hence this function is implemented in timers.c and is prefixed
+ * with 'Timer').  This is the version that is called from a task - see
+ * xTimerPendFunctionCallFromISR() for the version that is called from an
+ * interrupt.
+ *
+ * Pending a function from a task serialises it with the functions pended by
+ * interrupts, so a driver can keep all of its state in the daemon task
+ * without needing a mutex.
+ *
+ * xTimerPendFunctionCall() can be called before the scheduler has been
+ * started, in which case xTicksToWait must be 0.  The function then runs as
+ * soon as the daemon task first executes.
+ *
+ * @param xFunctionToPend The function to execute from the timer service/
+ * daemon task.  The function must conform to the tmrPENDED_FUNCTION prototype.
+ *
+ * @param pvParameter1 The value of the callback function's first parameter.
+ * The parameter has a void * type to allow it to be used to pass any type.
+ * For example, unsigned longs can be cast to a void *, or the void * can be
+ * used to point to a structure.
+ *
+ * @param ulParameter2 The value of the callback function's second parameter.
+ *
+ * @param xTicksToWait Calling this function will result in a message being
+ * sent to the timer daemon task on a queue.  xTicksToWait is the amount of
+ * time the calling task should remain in the Blocked state (so not using any
+ * processing time) for space to become available on the timer queue if the
+ * queue is found to be full.
+ *
+ * @return pdPASS is returned if the message was successfully sent to the
+ * timer daemon task, otherwise pdFALSE is returned.
+ */
+portBASE_TYPE xTimerPendFunctionCall( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
  */
 portBASE_TYPE xTimerCreateTimerTask( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * When configSUPPORT_STATIC_ALLOCATION is 1 the timer service task is created
+ * using memory supplied by the application, which must therefore provide an
+ * implementation of this function.  It is used in the same way as
+ * vApplicationGetIdleTaskMemory(), with *pusTimerTaskStackSize normally set to
+ * configTIMER_TASK_STACK_DEPTH.
+ */
+void vApplicationGetTimerTaskMemory( xStaticTask **ppxTimerTaskTCBBuffer, portSTACK_TYPE **ppxTimerTaskStackBuffer, unsigned short *pusTimerTaskStackSize );
 portBASE_TYPE xTimerGenericCommand( xTimerHandle xTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, portBASE_TYPE *pxHigherPriorityTaskWoken, portTickType xBlockTime ) PRIVILEGED_FUNCTION;
 
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,202 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+	FreeRTOS supports many tools and architectures. V7.0.0 is sponsored by:
+	Atollic AB - Atollic provides professional embedded systems development 
+	tools for C/C++ development, code analysis and test automation.  
+	See http://www.atollic.com
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * A hierarchical timing wheel, used by the scheduler in place of the sorted
+ * delayed task lists, and by the timer service task in place of the sorted
+ * active timer lists, when configUSE_TIMING_WHEEL is set to 1.
+ *
+ * Inserting an item into a sorted xList is O(n) in the number of items
+ * already in the list, and is performed from within critical sections.
+ * Inserting an item into a timing wheel takes the same time however many
+ * items the wheel holds.
+ *
+ * The wheel has wheelNUMBER_OF_LEVELS levels, each of which contains
+ * wheelSLOTS_PER_LEVEL unsorted xLists.  Each level corresponds to a group of
+ * configTIMING_WHEEL_SLOT_BITS bits of the tick count, with level 0 holding
+ * the least significant bits.  An item is placed in the level of the most
+ * significant group in which its expiry time differs from the current time,
+ * in the slot given by the value of that group within its expiry time.  Every
+ * item in a level 0 slot therefore expires at the same time.  When the
+ * current time reaches the start of a slot in a higher level the items in that
+ * slot are redistributed into the lower levels (cascaded), so each item is
+ * moved at most wheelNUMBER_OF_LEVELS - 1 times however long it is delayed.
+ *
+ * Items are placed by their absolute expiry time, so expiry times that have
+ * wrapped past the maximum tick count are simply held in the top level until
+ * the current time wraps too - there is no separate overflow list to switch.
+ *
+ * Items are held in ordinary xLists, so an item can still be removed from the
+ * wheel using vListRemove().  The item value holds the expiry time.
+ *
+ * Each wheel holds wheelNUMBER_OF_LEVELS * wheelSLOTS_PER_LEVEL xLists.  With
+ * 32 bit ticks and the default of 4 slot bits that is 128 lists.
+ */
+
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#ifndef INC_FREERTOS_H
+	#error "#include FreeRTOS.h" must appear in source files before "#include timing_wheel.h"
+#endif
+
+#include "list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ( configUSE_16_BIT_TICKS == 1 )
+	#define wheelTICK_BITS			( 16 )
+#else
+	#define wheelTICK_BITS			( 32 )
+#endif
+
+#define wheelSLOT_BITS				( configTIMING_WHEEL_SLOT_BITS )
+#define wheelSLOTS_PER_LEVEL		( 1 << wheelSLOT_BITS )
+#define wheelNUMBER_OF_LEVELS		( ( wheelTICK_BITS + wheelSLOT_BITS - 1 ) / wheelSLOT_BITS )
+
+#if ( ( configTIMING_WHEEL_SLOT_BITS < 1 ) || ( configTIMING_WHEEL_SLOT_BITS > 5 ) )
+	#error configTIMING_WHEEL_SLOT_BITS must be between 1 and 5, as the slots in use at each level are recorded in a 32 bit map.
+#endif
+
+/*
+ * Definition of a timing wheel.  Only the kernel should access the members.
+ */
+typedef struct xTIMING_WHEEL
+{
+	portTickType xTime;											/*< The time the wheel has been advanced to.  No item in the wheel expires at or before this time. */
+	unsigned long ulSlotsInUse[ wheelNUMBER_OF_LEVELS ];		/*< One bit per slot.  A bit is set when an item is placed in the slot, and cleared when the slot is found to be empty - so a set bit does not guarantee the slot still contains an item, as vListRemove() does not clear it. */
+	xList xSlots[ wheelNUMBER_OF_LEVELS ][ wheelSLOTS_PER_LEVEL ];	/*< The unsorted lists that hold the items. */
+} xTimingWheel;
+
+/*
+ * Must be called before a wheel is used.  Initialises every slot, and sets the
+ * time of the wheel to xTime.
+ *
+ * @param pxWheel The wheel to initialise.
+ *
+ * @param xTime The time to which the wheel is set, normally the current tick
+ * count.
+ */
+void vTimingWheelInitialise( xTimingWheel *pxWheel, portTickType xTime );
+
+/*
+ * Insert a list item into the wheel.  The item value must already be set to
+ * the time at which the item expires.
+ *
+ * An item that expires at the current time of the wheel has its item value
+ * set to the following tick, so it is returned by the next call to
+ * pxTimingWheelAdvance().  An expiry time that is numerically less than the
+ * current time of the wheel is taken to be after the tick count has wrapped.
+ *
+ * @param pxWheel The wheel into which the item is to be inserted.
+ *
+ * @param pxNewListItem The item to insert.
+ */
+void vTimingWheelInsert( xTimingWheel *pxWheel, xListItem *pxNewListItem );
+
+/*
+ * Advance the time of the wheel by one tick.
+ *
+ * @param pxWheel The wheel to advance.
+ *
+ * @return The list holding the items that expire at the new time.  The list
+ * may be empty.  The caller must remove every item from the list before the
+ * wheel is next advanced or skipped.
+ */
+xList *pxTimingWheelAdvance( xTimingWheel *pxWheel );
+
+/*
+ * Return the number of ticks from the current time of the wheel to the next
+ * time at which the wheel must be advanced rather than skipped.  This is
+ * either the time at which the nearest item expires, or an earlier time at
+ * which items must be cascaded into a lower level.  Returns portMAX_DELAY if
+ * the wheel is empty.
+ *
+ * @param pxWheel The wheel to query.
+ */
+portTickType xTimingWheelTicksToNextEvent( xTimingWheel *pxWheel );
+
+/*
+ * Move the time of the wheel forward by xTicksToSkip without processing the
+ * wheel for each tick.  xTicksToSkip must be less than the value returned by
+ * xTimingWheelTicksToNextEvent().
+ *
+ * @param pxWheel The wheel to skip forward.
+ *
+ * @param xTicksToSkip The number of ticks to move forward.
+ */
+void vTimingWheelSkip( xTimingWheel *pxWheel, portTickType xTicksToSkip );
+
+/*
+ * Access to the individual slots, so the items in the wheel can be walked in
+ * the same way as the items in a list.  Items are returned in no particular
+ * order.
+ */
+#define wheelNUMBER_OF_SLOTS					( wheelNUMBER_OF_LEVELS * wheelSLOTS_PER_LEVEL )
+#define wheelGET_SLOT( pxWheel, uxSlot )		( &( ( pxWheel )->xSlots[ ( uxSlot ) / wheelSLOTS_PER_LEVEL ][ ( uxSlot ) % wheelSLOTS_PER_LEVEL ] ) )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIMING_WHEEL_H */
+
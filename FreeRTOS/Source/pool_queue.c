@@ -0,0 +1,288 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+	FreeRTOS supports many tools and architectures. V7.0.0 is sponsored by:
+	Atollic AB - Atollic provides professional embedded systems development 
+	tools for C/C++ development, code analysis and test automation.  
+	See http://www.atollic.com
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "pool_queue.h"
+
+/*
+ * A pool queue is built from two ordinary queues that each hold block
+ * pointers.  xFreeBlocks holds the blocks that are available to be acquired,
+ * and xFilledBlocks holds the blocks that have been sent but not yet
+ * received.  Both queues can hold every block in the pool, so sending and
+ * releasing never block.
+ */
+typedef struct PoolQueueDefinition
+{
+	xQueueHandle xFreeBlocks;				/*< Pointers to blocks that can be acquired. */
+	xQueueHandle xFilledBlocks;				/*< Pointers to blocks that have been sent and are waiting to be received. */
+	unsigned char *pucBlocks;				/*< The start of the pool, which follows the structure in the same allocation. */
+	size_t xBlockStride;					/*< The block size rounded up to portBYTE_ALIGNMENT. */
+	unsigned portBASE_TYPE uxBlockCount;	/*< The number of blocks in the pool. */
+} xPOOL_QUEUE;
+
+/* The pool starts at the first aligned address after the structure. */
+#define poolHEADER_SIZE		( ( sizeof( xPOOL_QUEUE ) + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* Used by configASSERT() to check a pointer passed back in by the application
+really is the start of one of the blocks in the pool. */
+#define poolIS_VALID_BLOCK( pxPoolQueue, pvBlock )																			\
+	( ( ( unsigned char * ) ( pvBlock ) >= ( pxPoolQueue )->pucBlocks ) &&												\
+	  ( ( unsigned char * ) ( pvBlock ) < ( ( pxPoolQueue )->pucBlocks + ( ( pxPoolQueue )->xBlockStride * ( pxPoolQueue )->uxBlockCount ) ) ) &&	\
+	  ( ( ( size_t ) ( ( unsigned char * ) ( pvBlock ) - ( pxPoolQueue )->pucBlocks ) % ( pxPoolQueue )->xBlockStride ) == ( size_t ) 0 ) )
+
+/*-----------------------------------------------------------*/
+
+xPoolQueueHandle xPoolQueueCreate( unsigned portBASE_TYPE uxBlockCount, size_t xBlockSize )
+{
+xPOOL_QUEUE *pxPoolQueue;
+size_t xBlockStride;
+unsigned portBASE_TYPE ux;
+void *pvBlock;
+
+	configASSERT( uxBlockCount > ( unsigned portBASE_TYPE ) 0 );
+	configASSERT( xBlockSize > ( size_t ) 0 );
+
+	xBlockStride = ( xBlockSize + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+	/* The structure and the blocks are allocated together. */
+	pxPoolQueue = ( xPOOL_QUEUE * ) pvPortMalloc( poolHEADER_SIZE + ( xBlockStride * ( size_t ) uxBlockCount ) );
+
+	if( pxPoolQueue != NULL )
+	{
+		pxPoolQueue->pucBlocks = ( ( unsigned char * ) pxPoolQueue ) + poolHEADER_SIZE;
+		pxPoolQueue->xBlockStride = xBlockStride;
+		pxPoolQueue->uxBlockCount = uxBlockCount;
+		pxPoolQueue->xFreeBlocks = xQueueCreate( uxBlockCount, ( unsigned portBASE_TYPE ) sizeof( void * ) );
+		pxPoolQueue->xFilledBlocks = xQueueCreate( uxBlockCount, ( unsigned portBASE_TYPE ) sizeof( void * ) );
+
+		if( ( pxPoolQueue->xFreeBlocks != NULL ) && ( pxPoolQueue->xFilledBlocks != NULL ) )
+		{
+			/* Every block starts off free. */
+			for( ux = ( unsigned portBASE_TYPE ) 0; ux < uxBlockCount; ux++ )
+			{
+				pvBlock = ( void * ) ( pxPoolQueue->pucBlocks + ( xBlockStride * ( size_t ) ux ) );
+				( void ) xQueueSend( pxPoolQueue->xFreeBlocks, &pvBlock, ( portTickType ) 0 );
+			}
+		}
+		else
+		{
+			if( pxPoolQueue->xFreeBlocks != NULL )
+			{
+				vQueueDelete( pxPoolQueue->xFreeBlocks );
+			}
+
+			if( pxPoolQueue->xFilledBlocks != NULL )
+			{
+				vQueueDelete( pxPoolQueue->xFilledBlocks );
+			}
+
+			vPortFree( pxPoolQueue );
+			pxPoolQueue = NULL;
+		}
+	}
+
+	return ( xPoolQueueHandle ) pxPoolQueue;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPoolQueueAcquire( xPoolQueueHandle xPoolQueue, portTickType xTicksToWait )
+{
+xPOOL_QUEUE * const pxPoolQueue = ( xPOOL_QUEUE * ) xPoolQueue;
+void *pvBlock;
+
+	configASSERT( pxPoolQueue );
+
+	if( xQueueReceive( pxPoolQueue->xFreeBlocks, &pvBlock, xTicksToWait ) != pdPASS )
+	{
+		pvBlock = NULL;
+	}
+
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPoolQueueAcquireFromISR( xPoolQueueHandle xPoolQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xPOOL_QUEUE * const pxPoolQueue = ( xPOOL_QUEUE * ) xPoolQueue;
+void *pvBlock;
+
+	configASSERT( pxPoolQueue );
+
+	if( xQueueReceiveFromISR( pxPoolQueue->xFreeBlocks, &pvBlock, pxHigherPriorityTaskWoken ) != pdPASS )
+	{
+		pvBlock = NULL;
+	}
+
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xPoolQueueSend( xPoolQueueHandle xPoolQueue, void *pvBlock )
+{
+xPOOL_QUEUE * const pxPoolQueue = ( xPOOL_QUEUE * ) xPoolQueue;
+
+	configASSERT( pxPoolQueue );
+	configASSERT( poolIS_VALID_BLOCK( pxPoolQueue, pvBlock ) );
+
+	/* Only the pointer is copied into the queue. */
+	return xQueueSend( pxPoolQueue->xFilledBlocks, &pvBlock, ( portTickType ) 0 );
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xPoolQueueSendFromISR( xPoolQueueHandle xPoolQueue, void *pvBlock, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xPOOL_QUEUE * const pxPoolQueue = ( xPOOL_QUEUE * ) xPoolQueue;
+
+	configASSERT( pxPoolQueue );
+	configASSERT( poolIS_VALID_BLOCK( pxPoolQueue, pvBlock ) );
+
+	return xQueueSendFromISR( pxPoolQueue->xFilledBlocks, &pvBlock, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+void *pvPoolQueueReceive( xPoolQueueHandle xPoolQueue, portTickType xTicksToWait )
+{
+xPOOL_QUEUE * const pxPoolQueue = ( xPOOL_QUEUE * ) xPoolQueue;
+void *pvBlock;
+
+	configASSERT( pxPoolQueue );
+
+	if( xQueueReceive( pxPoolQueue->xFilledBlocks, &pvBlock, xTicksToWait ) != pdPASS )
+	{
+		pvBlock = NULL;
+	}
+
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPoolQueueReceiveFromISR( xPoolQueueHandle xPoolQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xPOOL_QUEUE * const pxPoolQueue = ( xPOOL_QUEUE * ) xPoolQueue;
+void *pvBlock;
+
+	configASSERT( pxPoolQueue );
+
+	if( xQueueReceiveFromISR( pxPoolQueue->xFilledBlocks, &pvBlock, pxHigherPriorityTaskWoken ) != pdPASS )
+	{
+		pvBlock = NULL;
+	}
+
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vPoolQueueRelease( xPoolQueueHandle xPoolQueue, void *pvBlock )
+{
+xPOOL_QUEUE * const pxPoolQueue = ( xPOOL_QUEUE * ) xPoolQueue;
+
+	configASSERT( pxPoolQueue );
+	configASSERT( poolIS_VALID_BLOCK( pxPoolQueue, pvBlock ) );
+
+	/* There is always space as the free queue can hold every block. */
+	( void ) xQueueSend( pxPoolQueue->xFreeBlocks, &pvBlock, ( portTickType ) 0 );
+}
+/*-----------------------------------------------------------*/
+
+void vPoolQueueReleaseFromISR( xPoolQueueHandle xPoolQueue, void *pvBlock, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xPOOL_QUEUE * const pxPoolQueue = ( xPOOL_QUEUE * ) xPoolQueue;
+
+	configASSERT( pxPoolQueue );
+	configASSERT( poolIS_VALID_BLOCK( pxPoolQueue, pvBlock ) );
+
+	( void ) xQueueSendFromISR( pxPoolQueue->xFreeBlocks, &pvBlock, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxPoolQueueBlocksFree( xPoolQueueHandle xPoolQueue )
+{
+xPOOL_QUEUE * const pxPoolQueue = ( xPOOL_QUEUE * ) xPoolQueue;
+
+	configASSERT( pxPoolQueue );
+
+	return uxQueueMessagesWaiting( pxPoolQueue->xFreeBlocks );
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxPoolQueueMessagesWaiting( xPoolQueueHandle xPoolQueue )
+{
+xPOOL_QUEUE * const pxPoolQueue = ( xPOOL_QUEUE * ) xPoolQueue;
+
+	configASSERT( pxPoolQueue );
+
+	return uxQueueMessagesWaiting( pxPoolQueue->xFilledBlocks );
+}
+/*-----------------------------------------------------------*/
+
+void vPoolQueueDelete( xPoolQueueHandle xPoolQueue )
+{
+xPOOL_QUEUE * const pxPoolQueue = ( xPOOL_QUEUE * ) xPoolQueue;
+
+	configASSERT( pxPoolQueue );
+
+	vQueueDelete( pxPoolQueue->xFreeBlocks );
+	vQueueDelete( pxPoolQueue->xFilledBlocks );
+	vPortFree( pxPoolQueue );
+}
+
@@ -0,0 +1,510 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+	FreeRTOS supports many tools and architectures. V7.0.0 is sponsored by:
+	Atollic AB - Atollic provides professional embedded systems development 
+	tools for C/C++ development, code analysis and test automation.  
+	See http://www.atollic.com
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the Posix (Linux)
+ * simulator port.
+ *
+ * Each task is run by its own thread, but only the thread of the task in the
+ * Running state is ever allowed to execute - all the others are blocked on a
+ * semaphore that is only given when the kernel selects their task.  The tick
+ * interrupt is simulated by a POSIX interval timer that raises SIGALRM.  The
+ * signal is blocked in every thread other than the running one, so the signal
+ * handler always executes in the context of the task that was interrupted -
+ * just as a real interrupt would.
+ *
+ * -NOTE- As on the Win32 port, this is a simulation only.  Do not expect real
+ * time behaviour.  Tasks that call into the C library (printf(), etc.) should
+ * do so with the scheduler suspended, otherwise a context switch could occur
+ * while the library is holding an internal lock.
+ *----------------------------------------------------------*/
+
+/* Standard includes. */
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define portNO_CRITICAL_NESTING 		( ( unsigned portBASE_TYPE ) 0 )
+#define portTICK_SIGNAL					SIGALRM
+#define portMICROSECONDS_PER_TICK		( 1000000UL / configTICK_RATE_HZ )
+
+/* Stops the compiler moving memory accesses across the points at which the
+simulated interrupts are enabled and disabled. */
+#define portMEMORY_BARRIER()			__asm volatile( "" ::: "memory" )
+
+/*
+ * The function executed by each task thread.  It waits until the kernel
+ * first selects the task, then calls the task function.
+ */
+static void *prvTaskThreadEntry( void *pvParameters );
+
+/*
+ * Wait until the kernel selects the task owned by the calling thread.  If the
+ * task was deleted while waiting then the thread exits instead.
+ */
+static void prvWaitToRun( void *pvThreadState );
+
+/*
+ * Block or unblock the tick signal in the calling thread.
+ */
+static void prvMaskTickSignal( sigset_t *pxPreviousMask );
+static void prvUnmaskTickSignal( void );
+
+/*
+ * The SIGALRM handler - generates the simulated tick interrupt.
+ */
+static void prvTickSignalHandler( int iSignal );
+
+/*
+ * Process the simulated interrupts (the tick and yield requests) that are
+ * pending.  Must be called with the simulated interrupts enabled.
+ */
+static void prvProcessSimulatedInterrupts( void );
+
+/*
+ * Select the next task to run and, if it is not the task that is already
+ * running, hand the processor over to the thread of the selected task.
+ * Returns pdTRUE if the calling thread was switched out (and has now been
+ * switched back in again).
+ */
+static portBASE_TYPE prvSwitchContext( void );
+
+/*-----------------------------------------------------------*/
+
+/* The context switching is managed by the threads, so the task stack does not
+have to be managed directly.  As on the Win32 port, the stack is still used to
+hold an xThreadState structure, and this is the only thing it will ever hold.
+The structure maps the task handle to the thread that executes the task. */
+typedef struct
+{
+	/* Thread that executes the task. */
+	pthread_t xThread;
+
+	/* Given when the task is selected to enter the Running state. */
+	sem_t xRunSemaphore;
+
+	/* The task function and its parameter, used when the thread starts. */
+	pdTASK_CODE pxCode;
+	void *pvParameters;
+
+	/* Set when the task is deleted so the thread knows to exit. */
+	volatile portBASE_TYPE xDeleted;
+
+} xThreadState;
+
+/* The critical nesting count.  Context switches only happen when this is zero,
+so it does not need to be saved per task.  It is initialised to a non-zero
+value so the simulated interrupts do not become enabled before the scheduler
+is started. */
+static volatile unsigned portBASE_TYPE uxCriticalNesting = 9999UL;
+
+/* The simulated interrupt enable flag.  Clearing the flag is much cheaper than
+masking the tick signal with a system call each time a critical section is
+entered. */
+static volatile sig_atomic_t xInterruptsEnabled = pdFALSE;
+
+/* Simulated interrupts that occurred while interrupts were disabled. */
+static volatile sig_atomic_t xPendingTick = pdFALSE;
+static volatile sig_atomic_t xPendingYield = pdFALSE;
+
+/* Given by vPortEndScheduler() to return control to the thread that called
+vTaskStartScheduler(). */
+static sem_t xSchedulerEndSemaphore;
+
+/* Pointer to the TCB of the currently executing task. */
+extern void *pxCurrentTCB;
+
+/* The thread state is stored in the first member of the TCB. */
+#define prvGetThreadState( pvTCB )		( *( ( xThreadState ** ) ( pvTCB ) ) )
+
+/*-----------------------------------------------------------*/
+
+portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE pxCode, void *pvParameters )
+{
+xThreadState *pxThreadState;
+sigset_t xPreviousMask;
+
+	/* In this simulated case a stack is not initialised, but instead a thread
+	is created that will execute the task being created.  The xThreadState
+	object is placed at the top of the stack that was created for the task,
+	aligned for the pthread and semaphore objects it contains. */
+	pxThreadState = ( xThreadState * ) ( ( ( unsigned long ) pxTopOfStack - sizeof( xThreadState ) ) & ~( ( unsigned long ) 0x0f ) );
+	pxThreadState->pxCode = pxCode;
+	pxThreadState->pvParameters = pvParameters;
+	pxThreadState->xDeleted = pdFALSE;
+	sem_init( &( pxThreadState->xRunSemaphore ), 0, 0 );
+
+	/* The new thread inherits the signal mask of this thread, so block the
+	tick signal while the thread is created.  It only gets unblocked when the
+	task first runs. */
+	prvMaskTickSignal( &xPreviousMask );
+	pthread_create( &( pxThreadState->xThread ), NULL, prvTaskThreadEntry, pxThreadState );
+	pthread_sigmask( SIG_SETMASK, &xPreviousMask, NULL );
+
+	return ( portSTACK_TYPE * ) pxThreadState;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortStartScheduler( void )
+{
+struct sigaction xTickAction;
+struct itimerval xTimer;
+
+	/* The thread that starts the scheduler does not run a task, so must never
+	handle the tick signal. */
+	prvMaskTickSignal( NULL );
+	sem_init( &xSchedulerEndSemaphore, 0, 0 );
+
+	/* Install the simulated tick interrupt handler.  The tick signal is
+	automatically blocked while the handler executes. */
+	xTickAction.sa_handler = prvTickSignalHandler;
+	sigemptyset( &xTickAction.sa_mask );
+	xTickAction.sa_flags = SA_RESTART;
+	sigaction( portTICK_SIGNAL, &xTickAction, NULL );
+
+	/* Start the timer that simulates the tick peripheral. */
+	xTimer.it_interval.tv_sec = 0;
+	xTimer.it_interval.tv_usec = portMICROSECONDS_PER_TICK;
+	xTimer.it_value = xTimer.it_interval;
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+
+	/* Start the highest priority task. */
+	uxCriticalNesting = portNO_CRITICAL_NESTING;
+	sem_post( &( prvGetThreadState( pxCurrentTCB )->xRunSemaphore ) );
+
+	/* Wait here until vPortEndScheduler() is called. */
+	while( sem_wait( &xSchedulerEndSemaphore ) != 0 )
+	{
+		/* Interrupted by a signal other than the tick - try again. */
+	}
+
+	/* Stop the simulated tick. */
+	xTimer.it_interval.tv_usec = 0;
+	xTimer.it_value = xTimer.it_interval;
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	/* Called from a task with interrupts disabled.  Return control to the
+	thread that started the scheduler, then stop this thread for good - the
+	task threads are cleaned up when the process exits. */
+	prvMaskTickSignal( NULL );
+	sem_post( &xSchedulerEndSemaphore );
+
+	for( ;; )
+	{
+		pause();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	/* A yield is a simulated software interrupt, so is held pending if
+	interrupts are disabled - as a PendSV would be on the Cortex-M3. */
+	xPendingYield = pdTRUE;
+	portMEMORY_BARRIER();
+
+	if( ( xInterruptsEnabled != pdFALSE ) && ( uxCriticalNesting == portNO_CRITICAL_NESTING ) )
+	{
+		prvProcessSimulatedInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDeleteThread( void *pvTaskToDelete )
+{
+xThreadState *pxThreadState = prvGetThreadState( pvTaskToDelete );
+
+	/* Called from within a critical section. */
+	pxThreadState->xDeleted = pdTRUE;
+
+	if( pvTaskToDelete != pxCurrentTCB )
+	{
+		/* The thread is blocked in prvWaitToRun(), so wake it up to let it
+		exit, and wait for it to do so before the kernel frees the stack that
+		holds its state. */
+		sem_post( &( pxThreadState->xRunSemaphore ) );
+		pthread_join( pxThreadState->xThread, NULL );
+		sem_destroy( &( pxThreadState->xRunSemaphore ) );
+	}
+
+	/* Otherwise the task is deleting itself.  The thread exits when it is
+	switched out by the yield that follows. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	xInterruptsEnabled = pdFALSE;
+	portMEMORY_BARRIER();
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	portMEMORY_BARRIER();
+	xInterruptsEnabled = pdTRUE;
+
+	/* Were any interrupts set to pending while interrupts were (simulated)
+	disabled? */
+	if( ( xPendingTick != pdFALSE ) || ( xPendingYield != pdFALSE ) )
+	{
+		prvProcessSimulatedInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	vPortDisableInterrupts();
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	if( uxCriticalNesting > portNO_CRITICAL_NESTING )
+	{
+		uxCriticalNesting--;
+
+		if( uxCriticalNesting == portNO_CRITICAL_NESTING )
+		{
+			vPortEnableInterrupts();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickSignalHandler( int iSignal )
+{
+	( void ) iSignal;
+
+	xPendingTick = pdTRUE;
+
+	/* If interrupts are disabled the tick is processed when they are next
+	enabled. */
+	if( xInterruptsEnabled != pdFALSE )
+	{
+		prvProcessSimulatedInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessSimulatedInterrupts( void )
+{
+portBASE_TYPE xSwitchedOut = pdFALSE;
+
+	do
+	{
+		/* Interrupts are disabled while the simulated interrupts are being
+		processed, in the same way that an interrupt could not be nested with
+		itself on the real hardware. */
+		vPortDisableInterrupts();
+
+		if( xPendingTick != pdFALSE )
+		{
+			xPendingTick = pdFALSE;
+			vTaskIncrementTick();
+
+			#if( configUSE_PREEMPTION != 0 )
+			{
+				/* A context switch is only automatically performed from the
+				tick interrupt if the pre-emptive scheduler is being used. */
+				xPendingYield = pdTRUE;
+			}
+			#endif
+		}
+
+		if( xPendingYield != pdFALSE )
+		{
+			xPendingYield = pdFALSE;
+
+			/* If a switch occurs this thread does not return from here until
+			its task is selected to run again. */
+			xSwitchedOut = prvSwitchContext();
+		}
+
+		portMEMORY_BARRIER();
+		xInterruptsEnabled = pdTRUE;
+
+		/* A tick may have arrived after it was checked above but before
+		interrupts were enabled again.  However, if this thread has just been
+		switched back in, a tick that became pending while the threads were
+		being switched is left until the task has had a chance to run - on the
+		real hardware a context switch takes a tiny fraction of a tick period,
+		but a thread switch on a busy host can take longer than a tick.  It is
+		processed when interrupts are next enabled, or by the next tick. */
+	} while( ( xSwitchedOut == pdFALSE ) && ( ( xPendingTick != pdFALSE ) || ( xPendingYield != pdFALSE ) ) );
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvSwitchContext( void )
+{
+void *pvOldTCB;
+xThreadState *pxOldThreadState;
+sigset_t xPreviousMask;
+portBASE_TYPE xSwitchedOut = pdFALSE;
+
+	pvOldTCB = pxCurrentTCB;
+
+	/* Select the next task to run. */
+	vTaskSwitchContext();
+
+	/* If the task selected to enter the running state is not the task that is
+	already in the running state. */
+	if( pvOldTCB != pxCurrentTCB )
+	{
+		pxOldThreadState = prvGetThreadState( pvOldTCB );
+
+		/* From now on this thread is not running a task, so must not handle
+		the tick signal. */
+		prvMaskTickSignal( &xPreviousMask );
+
+		if( pxOldThreadState->xDeleted != pdFALSE )
+		{
+			/* The task deleted itself.  Its stack, which holds the thread
+			state, can be freed by the idle task as soon as the next task
+			starts, so the state must not be accessed after that. */
+			sem_destroy( &( pxOldThreadState->xRunSemaphore ) );
+			sem_post( &( prvGetThreadState( pxCurrentTCB )->xRunSemaphore ) );
+			pthread_detach( pthread_self() );
+			pthread_exit( NULL );
+		}
+
+		/* Start the thread of the selected task, then wait until the task that
+		was running is selected again. */
+		sem_post( &( prvGetThreadState( pxCurrentTCB )->xRunSemaphore ) );
+		prvWaitToRun( pxOldThreadState );
+
+		pthread_sigmask( SIG_SETMASK, &xPreviousMask, NULL );
+		xSwitchedOut = pdTRUE;
+	}
+
+	return xSwitchedOut;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTaskThreadEntry( void *pvParameters )
+{
+xThreadState *pxThreadState = ( xThreadState * ) pvParameters;
+
+	/* Wait for the task to be selected to run for the first time. */
+	prvWaitToRun( pxThreadState );
+
+	/* A task starts with interrupts enabled. */
+	prvUnmaskTickSignal();
+	vPortEnableInterrupts();
+
+	pxThreadState->pxCode( pxThreadState->pvParameters );
+
+	/* Tasks must not return from their implementing function. */
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitToRun( void *pvThreadState )
+{
+xThreadState *pxThreadState = ( xThreadState * ) pvThreadState;
+
+	while( sem_wait( &( pxThreadState->xRunSemaphore ) ) != 0 )
+	{
+		/* Interrupted by a signal other than the tick - try again. */
+	}
+
+	if( pxThreadState->xDeleted != pdFALSE )
+	{
+		/* The task was deleted by another task, which is waiting in
+		vPortDeleteThread() for this thread to exit. */
+		pthread_exit( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMaskTickSignal( sigset_t *pxPreviousMask )
+{
+sigset_t xTickSignal;
+
+	sigemptyset( &xTickSignal );
+	sigaddset( &xTickSignal, portTICK_SIGNAL );
+	pthread_sigmask( SIG_BLOCK, &xTickSignal, pxPreviousMask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnmaskTickSignal( void )
+{
+sigset_t xTickSignal;
+
+	sigemptyset( &xTickSignal );
+	sigaddset( &xTickSignal, portTICK_SIGNAL );
+	pthread_sigmask( SIG_UNBLOCK, &xTickSignal, NULL );
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,361 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that divides the
+ * heap into a number of pools, each of which holds blocks of a single fixed
+ * size (a size class).  A request is served from the smallest class whose
+ * blocks are large enough, falling back to the next larger class if that
+ * class is exhausted.  Allocating and freeing a block is just a pop from, or
+ * a push to, the singly linked free list of its class, so both take a bounded
+ * time that does not depend on how many blocks are in use, and the heap can
+ * never become fragmented.  The cost is that each allocation is rounded up to
+ * the block size of the class that serves it.
+ *
+ * The block size and number of blocks in each class are set by
+ * configHEAP_POOL_BLOCK_SIZES and configHEAP_POOL_BLOCK_COUNTS, which can be
+ * defined in FreeRTOSConfig.h to suit the application.  Their total must not
+ * exceed configTOTAL_HEAP_SIZE.  xPortGetHeapPoolStats() returns the usage of
+ * each class so the table can be tuned.
+ *
+ * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and
+ * the memory management pages of http://www.FreeRTOS.org for more
+ * information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* The default size classes.  The block sizes must be in ascending order, and
+both tables must have the same number of entries. */
+#ifndef configHEAP_POOL_BLOCK_SIZES
+	#define configHEAP_POOL_BLOCK_SIZES		{ 32, 64, 128, 256, 512, 1024, 2048 }
+	#define configHEAP_POOL_BLOCK_COUNTS	{ 24, 24,  16,  12,   8,    4,    2 }
+#endif
+
+/* Allocate the memory for the heap.  The struct is used to force byte
+alignment without using any non-portable code. */
+static union xRTOS_HEAP
+{
+	#if portBYTE_ALIGNMENT == 8
+		volatile portDOUBLE dDummy;
+	#else
+		volatile unsigned long ulDummy;
+	#endif
+	unsigned char ucHeap[ configTOTAL_HEAP_SIZE ];
+} xHeap;
+
+/* A free block holds a pointer to the next free block in the same class.  No
+header is stored in allocated blocks - the class a block belongs to is found
+from its address when it is freed. */
+typedef struct A_FREE_BLOCK
+{
+	struct A_FREE_BLOCK *pxNextFreeBlock;
+} xFreeBlock;
+
+/* The state of a single size class. */
+typedef struct A_HEAP_POOL
+{
+	unsigned char *pucStart;					/*< The first block in the class. */
+	unsigned char *pucEnd;						/*< One past the last block in the class. */
+	xFreeBlock *pxFreeList;						/*< The head of the list of free blocks. */
+	size_t xBlockSize;							/*< The size of every block in the class. */
+	xHeapPoolStats xStats;						/*< Usage statistics returned by xPortGetHeapPoolStats(). */
+} xHeapPool;
+
+static const size_t xRequestedBlockSizes[] = configHEAP_POOL_BLOCK_SIZES;
+static const unsigned short usRequestedBlockCounts[] = configHEAP_POOL_BLOCK_COUNTS;
+
+#define heapNUM_POOLS	( sizeof( xRequestedBlockSizes ) / sizeof( xRequestedBlockSizes[ 0 ] ) )
+
+static xHeapPool xPools[ heapNUM_POOLS ];
+
+/* Keeps track of the number of free bytes remaining, counted in whole
+blocks. */
+static size_t xFreeBytesRemaining = ( size_t ) 0;
+
+static portBASE_TYPE xHeapHasBeenInitialised = pdFALSE;
+
+/*
+ * Carve the heap into the size classes and thread every block onto the free
+ * list of its class.
+ */
+static void prvHeapInit( void );
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+unsigned char *pucNextBlock = xHeap.ucHeap;
+unsigned portBASE_TYPE uxPool, uxBlock;
+xHeapPool *pxPool;
+xFreeBlock *pxBlock;
+size_t xBlockSize;
+
+	configASSERT( ( sizeof( usRequestedBlockCounts ) / sizeof( usRequestedBlockCounts[ 0 ] ) ) == heapNUM_POOLS );
+
+	for( uxPool = 0; uxPool < heapNUM_POOLS; uxPool++ )
+	{
+		pxPool = &( xPools[ uxPool ] );
+
+		/* Every block must be able to hold the free list link, and must keep
+		the following block aligned. */
+		xBlockSize = xRequestedBlockSizes[ uxPool ];
+		if( xBlockSize < sizeof( xFreeBlock ) )
+		{
+			xBlockSize = sizeof( xFreeBlock );
+		}
+		xBlockSize = ( xBlockSize + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+		/* The classes must be in ascending order for the search in
+		pvPortMalloc() to find the best fitting class first. */
+		configASSERT( ( uxPool == 0 ) || ( xBlockSize > xPools[ uxPool - 1 ].xBlockSize ) );
+
+		/* The blocks must all fit within the heap. */
+		configASSERT( ( size_t ) ( pucNextBlock - xHeap.ucHeap ) + ( xBlockSize * usRequestedBlockCounts[ uxPool ] ) <= configTOTAL_HEAP_SIZE );
+
+		pxPool->xBlockSize = xBlockSize;
+		pxPool->pucStart = pucNextBlock;
+		pxPool->pxFreeList = NULL;
+
+		/* Push the blocks in reverse so they are handed out in address
+		order. */
+		pucNextBlock += xBlockSize * usRequestedBlockCounts[ uxPool ];
+		pxPool->pucEnd = pucNextBlock;
+
+		for( uxBlock = usRequestedBlockCounts[ uxPool ]; uxBlock > 0; uxBlock-- )
+		{
+			pxBlock = ( void * ) ( pxPool->pucStart + ( xBlockSize * ( uxBlock - 1 ) ) );
+			pxBlock->pxNextFreeBlock = pxPool->pxFreeList;
+			pxPool->pxFreeList = pxBlock;
+		}
+
+		pxPool->xStats.xBlockSize = xBlockSize;
+		pxPool->xStats.uxTotalBlocks = usRequestedBlockCounts[ uxPool ];
+		pxPool->xStats.uxFreeBlocks = usRequestedBlockCounts[ uxPool ];
+		pxPool->xStats.uxMinimumEverFreeBlocks = usRequestedBlockCounts[ uxPool ];
+		pxPool->xStats.ulAllocations = 0UL;
+		pxPool->xStats.ulOverflows = 0UL;
+
+		xFreeBytesRemaining += xBlockSize * usRequestedBlockCounts[ uxPool ];
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+unsigned portBASE_TYPE uxPool, uxBestFitPool;
+xHeapPool *pxPool;
+xFreeBlock *pxBlock = NULL;
+
+	/* Only a handful of instructions are executed with interrupts masked, so
+	the time taken is bounded and a task calling pvPortMalloc() can never be
+	blocked by another task that is part way through an allocation. */
+	taskENTER_CRITICAL();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the pools. */
+		if( xHeapHasBeenInitialised == pdFALSE )
+		{
+			prvHeapInit();
+			xHeapHasBeenInitialised = pdTRUE;
+		}
+
+		if( xWantedSize > ( size_t ) 0 )
+		{
+			/* Find the smallest class that can hold the request. */
+			for( uxBestFitPool = 0; uxBestFitPool < heapNUM_POOLS; uxBestFitPool++ )
+			{
+				if( xPools[ uxBestFitPool ].xBlockSize >= xWantedSize )
+				{
+					break;
+				}
+			}
+
+			/* Take a block from that class, or from the next larger class
+			that has a block free. */
+			for( uxPool = uxBestFitPool; uxPool < heapNUM_POOLS; uxPool++ )
+			{
+				pxPool = &( xPools[ uxPool ] );
+				pxBlock = pxPool->pxFreeList;
+
+				if( pxBlock != NULL )
+				{
+					pxPool->pxFreeList = pxBlock->pxNextFreeBlock;
+
+					( pxPool->xStats.uxFreeBlocks )--;
+					if( pxPool->xStats.uxFreeBlocks < pxPool->xStats.uxMinimumEverFreeBlocks )
+					{
+						pxPool->xStats.uxMinimumEverFreeBlocks = pxPool->xStats.uxFreeBlocks;
+					}
+					( pxPool->xStats.ulAllocations )++;
+
+					xFreeBytesRemaining -= pxPool->xBlockSize;
+					break;
+				}
+			}
+
+			/* Record that the best fitting class could not serve the request,
+			whether or not a larger class could. */
+			if( ( uxPool != uxBestFitPool ) && ( uxBestFitPool < heapNUM_POOLS ) )
+			{
+				( xPools[ uxBestFitPool ].xStats.ulOverflows )++;
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pxBlock == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	return ( void * ) pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+unsigned char *puc = ( unsigned char * ) pv;
+unsigned portBASE_TYPE uxPool;
+xHeapPool *pxPool;
+xFreeBlock *pxBlock;
+
+	if( pv )
+	{
+		/* Find the class the block came from by its address. */
+		for( uxPool = 0; uxPool < heapNUM_POOLS; uxPool++ )
+		{
+			if( puc < xPools[ uxPool ].pucEnd )
+			{
+				break;
+			}
+		}
+
+		configASSERT( uxPool < heapNUM_POOLS );
+		configASSERT( puc >= xPools[ uxPool ].pucStart );
+		configASSERT( ( ( size_t ) ( puc - xPools[ uxPool ].pucStart ) % xPools[ uxPool ].xBlockSize ) == ( size_t ) 0 );
+
+		pxPool = &( xPools[ uxPool ] );
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxBlock = ( void * ) puc;
+
+		taskENTER_CRITICAL();
+		{
+			pxBlock->pxNextFreeBlock = pxPool->pxFreeList;
+			pxPool->pxFreeList = pxBlock;
+			( pxPool->xStats.uxFreeBlocks )++;
+			xFreeBytesRemaining += pxPool->xBlockSize;
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxPortGetHeapPoolCount( void )
+{
+	return ( unsigned portBASE_TYPE ) heapNUM_POOLS;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortGetHeapPoolStats( unsigned portBASE_TYPE uxPool, xHeapPoolStats *pxStats )
+{
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pxStats );
+
+	if( uxPool < heapNUM_POOLS )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( xHeapHasBeenInitialised == pdFALSE )
+			{
+				prvHeapInit();
+				xHeapHasBeenInitialised = pdTRUE;
+			}
+
+			*pxStats = xPools[ uxPool ].xStats;
+		}
+		taskEXIT_CRITICAL();
+
+		xReturn = pdPASS;
+	}
+
+	return xReturn;
+}
+
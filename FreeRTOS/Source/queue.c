@@ -86,11 +86,24 @@ task.h is included from an application file. */
 #define	queueSEND_TO_FRONT				( 1 )
 
 /* Effectively make a union out of the xQUEUE structure. */
-#define pxMutexHolder					pcTail
 #define uxQueueType						pcHead
 #define uxRecursiveCallCount			pcReadFrom
 #define queueQUEUE_IS_MUTEX				NULL
 
+/* The recursive call count is held in a pointer member, so it is incremented
+and decremented as an integer.  Decrementing the pointer itself to zero is
+undefined behaviour, and GCC will remove the test for the count reaching zero
+if it is done that way. */
+#define queueRECURSIVE_CALL_COUNT( pxMutex )	( ( unsigned portBASE_TYPE ) ( pxMutex )->uxRecursiveCallCount )
+#define queueINCREMENT_RECURSIVE_CALL_COUNT( pxMutex )	( pxMutex )->uxRecursiveCallCount = ( signed char * ) ( queueRECURSIVE_CALL_COUNT( pxMutex ) + 1U )
+#define queueDECREMENT_RECURSIVE_CALL_COUNT( pxMutex )	( pxMutex )->uxRecursiveCallCount = ( signed char * ) ( queueRECURSIVE_CALL_COUNT( pxMutex ) - 1U )
+
+/* The holder of a mutex is the owner of its xMutexHeldItem for as long as the
+item is in the holder's list of held mutexes.  Giving the mutex back removes
+the item from the list, and so does deleting the holder, so a mutex never
+reports a deleted task as its holder. */
+#define queueGET_MUTEX_HOLDER( pxMutex )	( ( ( pxMutex )->xMutexHeldItem.pvContainer != NULL ) ? ( xTaskHandle ) ( ( pxMutex )->xMutexHeldItem.pvOwner ) : NULL )
+
 /* Semaphores do not actually store or copy data, so have an items size of
 zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH ( 0 )
@@ -119,6 +132,18 @@ typedef struct QueueDefinition
 	signed portBASE_TYPE xRxLock;			/*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 	signed portBASE_TYPE xTxLock;			/*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 
+	#if ( configUSE_MUTEXES == 1 )
+		xListItem xMutexHeldItem;			/*< Used to reference a mutex from its holder's list of held mutexes.  Only used by mutexes. */
+	#endif
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+		struct QueueDefinition *pxQueueSetContainer;	/*< The queue set this queue is a member of, or NULL if the queue is not a member of a set. */
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;	/*< Set to pdTRUE if the memory used by the queue was supplied by the application, so must not be freed when the queue is deleted. */
+	#endif
+
 } xQUEUE;
 /*-----------------------------------------------------------*/
 
@@ -137,12 +162,16 @@ typedef xQUEUE * xQueueHandle;
 xQueueHandle xQueueCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize ) PRIVILEGED_FUNCTION;
 signed portBASE_TYPE xQueueGenericSend( xQueueHandle xQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION;
 unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxQueueGetLength( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 void vQueueDelete( xQueueHandle xQueue ) PRIVILEGED_FUNCTION;
 signed portBASE_TYPE xQueueGenericSendFromISR( xQueueHandle pxQueue, const void * const pvItemToQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION;
 signed portBASE_TYPE xQueueGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking ) PRIVILEGED_FUNCTION;
 signed portBASE_TYPE xQueueReceiveFromISR( xQueueHandle pxQueue, void * const pvBuffer, signed portBASE_TYPE *pxTaskWoken ) PRIVILEGED_FUNCTION;
 xQueueHandle xQueueCreateMutex( void ) PRIVILEGED_FUNCTION;
 xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorageBuffer, xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateMutexStatic( xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateCountingSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueTakeMutexRecursive( xQueueHandle xMutex, portTickType xBlockTime ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle xMutex ) PRIVILEGED_FUNCTION;
 signed portBASE_TYPE xQueueAltGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION;
@@ -151,6 +180,15 @@ signed portBASE_TYPE xQueueIsQueueEmptyFromISR( const xQueueHandle pxQueue ) PRI
 signed portBASE_TYPE xQueueIsQueueFullFromISR( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 unsigned portBASE_TYPE uxQueueMessagesWaitingFromISR( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 void vQueueWaitForMessageRestricted( xQueueHandle pxQueue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueSendMultiple( xQueueHandle pxQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueSendMultipleFromISR( xQueueHandle pxQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueReceiveMultiple( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueReceiveMultipleFromISR( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, signed portBASE_TYPE *pxTaskWoken ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xQueueAddToSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xQueueRemoveFromSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueSelectFromSet( xQueueHandle xQueueSet, portTickType xBlockTimeTicks ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueSelectFromSetFromISR( xQueueHandle xQueueSet ) PRIVILEGED_FUNCTION;
 
 /*
  * Co-routine queue functions differ from task queue functions.  Co-routines are
@@ -187,6 +225,7 @@ void vQueueWaitForMessageRestricted( xQueueHandle pxQueue, portTickType xTicksTo
 	member to NULL. */
 	static void vQueueUnregisterQueue( xQueueHandle xQueue ) PRIVILEGED_FUNCTION;
 	void vQueueAddToRegistry( xQueueHandle xQueue, signed char *pcQueueName ) PRIVILEGED_FUNCTION;
+	portBASE_TYPE xQueueGetRegistryEntry( unsigned portBASE_TYPE uxIndex, signed char **ppcQueueName, xQueueHandle *pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 
 /*
@@ -223,6 +262,53 @@ static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, port
  * Copies an item out of a queue.
  */
 static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void *pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies uxItemCount items to the back of a queue, splitting the copy where
+ * the storage area wraps.  There must be space for all the items.
+ */
+static void prvCopyMultipleToQueue( xQUEUE *pxQueue, const void *pvItemsToQueue, unsigned portBASE_TYPE uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies uxItemCount items out of a queue, splitting the copy where the
+ * storage area wraps.  The queue must hold at least uxItemCount items.
+ */
+static void prvCopyMultipleFromQueue( xQUEUE * const pxQueue, void *pvBuffer, unsigned portBASE_TYPE uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes up to uxMaxTasks tasks from pxEventList, one for each item that
+ * was just added to or removed from the queue.  Must be called with
+ * interrupts disabled or the scheduler suspended.
+ *
+ * @return pdTRUE if any task removed from the list has a priority equal to or
+ * higher than the calling task.
+ */
+static signed portBASE_TYPE prvUnblockTasksWaitingOnQueue( const xList * const pxEventList, unsigned portBASE_TYPE uxMaxTasks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Initialises the members of a newly created queue, whether its memory came
+ * from the heap or was supplied by the application.  pcQueueStorage points to
+ * the area that holds the queued items.
+ */
+static void prvInitialiseNewQueue( xQUEUE *pxNewQueue, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, signed char *pcQueueStorage ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_QUEUE_SETS == 1 )
+	/*
+	 * Called when uxItemCount items have been posted to a queue that is a
+	 * member of a queue set.  Posts the handle of the member queue to the queue
+	 * set that contains it once per item.  Returns pdTRUE if doing so unblocked
+	 * a task that has a priority above that of the calling task.
+	 */
+	static signed portBASE_TYPE prvNotifyQueueSetContainer( const xQUEUE * const pxQueue, unsigned portBASE_TYPE uxItemCount ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_MUTEXES == 1 )
+	/*
+	 * Initialises the members of a newly created queue so it can be used as a
+	 * mutex, then places the mutex in the available state.
+	 */
+	static void prvInitialiseMutex( xQUEUE *pxNewQueue ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -268,20 +354,13 @@ xQueueHandle xReturn = NULL;
 			pxNewQueue->pcHead = ( signed char * ) pvPortMalloc( xQueueSizeInBytes );
 			if( pxNewQueue->pcHead != NULL )
 			{
-				/* Initialise the queue members as described above where the
-				queue type is defined. */
-				pxNewQueue->pcTail = pxNewQueue->pcHead + ( uxQueueLength * uxItemSize );
-				pxNewQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
-				pxNewQueue->pcWriteTo = pxNewQueue->pcHead;
-				pxNewQueue->pcReadFrom = pxNewQueue->pcHead + ( ( uxQueueLength - ( unsigned portBASE_TYPE ) 1U ) * uxItemSize );
-				pxNewQueue->uxLength = uxQueueLength;
-				pxNewQueue->uxItemSize = uxItemSize;
-				pxNewQueue->xRxLock = queueUNLOCKED;
-				pxNewQueue->xTxLock = queueUNLOCKED;
-
-				/* Likewise ensure the event queues start with the correct state. */
-				vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
-				vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+				prvInitialiseNewQueue( pxNewQueue, uxQueueLength, uxItemSize, pxNewQueue->pcHead );
+
+				#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+				{
+					pxNewQueue->ucStaticallyAllocated = pdFALSE;
+				}
+				#endif
 
 				traceQUEUE_CREATE( pxNewQueue );
 				xReturn = pxNewQueue;
@@ -300,6 +379,116 @@ xQueueHandle xReturn = NULL;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xQueueHandle xQueueCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorageBuffer, xStaticQueue *pxStaticQueue )
+	{
+	xQUEUE *pxNewQueue = NULL;
+	signed char *pcQueueStorage;
+
+		configASSERT( uxQueueLength > ( unsigned portBASE_TYPE ) 0 );
+		configASSERT( pxStaticQueue != NULL );
+
+		/* A storage area must be provided if, and only if, items are copied
+		into the queue. */
+		configASSERT( !( ( pucQueueStorageBuffer != NULL ) && ( uxItemSize == ( unsigned portBASE_TYPE ) 0U ) ) );
+		configASSERT( !( ( pucQueueStorageBuffer == NULL ) && ( uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
+
+		/* Sanity check that the xStaticQueue structure declared in FreeRTOS.h
+		is the same size as the real queue structure. */
+		configASSERT( sizeof( xStaticQueue ) == sizeof( xQUEUE ) );
+
+		if( ( uxQueueLength > ( unsigned portBASE_TYPE ) 0 ) && ( pxStaticQueue != NULL ) && ( ( pucQueueStorageBuffer != NULL ) || ( uxItemSize == ( unsigned portBASE_TYPE ) 0U ) ) )
+		{
+			pxNewQueue = ( xQUEUE * ) pxStaticQueue;
+
+			if( uxItemSize == ( unsigned portBASE_TYPE ) 0U )
+			{
+				/* Nothing is copied so no storage area is required, but pcHead
+				cannot be left NULL as that would mark the queue as a mutex.
+				Point it at the queue structure itself instead. */
+				pcQueueStorage = ( signed char * ) pxNewQueue;
+			}
+			else
+			{
+				pcQueueStorage = ( signed char * ) pucQueueStorageBuffer;
+			}
+
+			prvInitialiseNewQueue( pxNewQueue, uxQueueLength, uxItemSize, pcQueueStorage );
+			pxNewQueue->ucStaticallyAllocated = pdTRUE;
+
+			traceQUEUE_CREATE( pxNewQueue );
+		}
+		else
+		{
+			traceQUEUE_CREATE_FAILED();
+		}
+
+		return pxNewQueue;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewQueue( xQUEUE *pxNewQueue, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, signed char *pcQueueStorage )
+{
+	/* Initialise the queue members as described above where the queue type
+	is defined. */
+	pxNewQueue->pcHead = pcQueueStorage;
+	pxNewQueue->pcTail = pxNewQueue->pcHead + ( uxQueueLength * uxItemSize );
+	pxNewQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
+	pxNewQueue->pcWriteTo = pxNewQueue->pcHead;
+	pxNewQueue->pcReadFrom = pxNewQueue->pcHead + ( ( uxQueueLength - ( unsigned portBASE_TYPE ) 1U ) * uxItemSize );
+	pxNewQueue->uxLength = uxQueueLength;
+	pxNewQueue->uxItemSize = uxItemSize;
+	pxNewQueue->xRxLock = queueUNLOCKED;
+	pxNewQueue->xTxLock = queueUNLOCKED;
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		pxNewQueue->pxQueueSetContainer = NULL;
+	}
+	#endif
+
+	/* Likewise ensure the event queues start with the correct state. */
+	vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
+	vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static void prvInitialiseMutex( xQUEUE *pxNewQueue )
+	{
+		/* Information required for priority inheritance. */
+		pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+		vListInitialiseItem( &( pxNewQueue->xMutexHeldItem ) );
+
+		/* Queues used as a mutex no data is actually copied into or out
+		of the queue. */
+		pxNewQueue->pcWriteTo = NULL;
+		pxNewQueue->pcReadFrom = NULL;
+
+		/* Each mutex has a length of 1 (like a binary semaphore) and
+		an item size of 0 as nothing is actually copied into or out
+		of the mutex. */
+		pxNewQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
+		pxNewQueue->uxLength = ( unsigned portBASE_TYPE ) 1U;
+		pxNewQueue->uxItemSize = ( unsigned portBASE_TYPE ) 0U;
+		pxNewQueue->xRxLock = queueUNLOCKED;
+		pxNewQueue->xTxLock = queueUNLOCKED;
+
+		/* Ensure the event queues start with the correct state. */
+		vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
+		vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+
+		/* Start with the semaphore in the expected state. */
+		xQueueGenericSend( pxNewQueue, NULL, ( portTickType ) 0U, queueSEND_TO_BACK );
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
 	xQueueHandle xQueueCreateMutex( void )
@@ -310,30 +499,43 @@ xQueueHandle xReturn = NULL;
 		pxNewQueue = ( xQUEUE * ) pvPortMalloc( sizeof( xQUEUE ) );
 		if( pxNewQueue != NULL )
 		{
-			/* Information required for priority inheritance. */
-			pxNewQueue->pxMutexHolder = NULL;
-			pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxNewQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif
+
+			prvInitialiseMutex( pxNewQueue );
+
+			traceCREATE_MUTEX( pxNewQueue );
+		}
+		else
+		{
+			traceCREATE_MUTEX_FAILED();
+		}
+
+		configASSERT( pxNewQueue );
+		return pxNewQueue;
+	}
 
-			/* Queues used as a mutex no data is actually copied into or out
-			of the queue. */
-			pxNewQueue->pcWriteTo = NULL;
-			pxNewQueue->pcReadFrom = NULL;
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	xQueueHandle xQueueCreateMutexStatic( xStaticQueue *pxStaticQueue )
+	{
+	xQUEUE *pxNewQueue = NULL;
 
-			/* Each mutex has a length of 1 (like a binary semaphore) and
-			an item size of 0 as nothing is actually copied into or out
-			of the mutex. */
-			pxNewQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
-			pxNewQueue->uxLength = ( unsigned portBASE_TYPE ) 1U;
-			pxNewQueue->uxItemSize = ( unsigned portBASE_TYPE ) 0U;
-			pxNewQueue->xRxLock = queueUNLOCKED;
-			pxNewQueue->xTxLock = queueUNLOCKED;
+		configASSERT( pxStaticQueue != NULL );
+		configASSERT( sizeof( xStaticQueue ) == sizeof( xQUEUE ) );
 
-			/* Ensure the event queues start with the correct state. */
-			vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
-			vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+		if( pxStaticQueue != NULL )
+		{
+			pxNewQueue = ( xQUEUE * ) pxStaticQueue;
+			pxNewQueue->ucStaticallyAllocated = pdTRUE;
 
-			/* Start with the semaphore in the expected state. */
-			xQueueGenericSend( pxNewQueue, NULL, ( portTickType ) 0U, queueSEND_TO_BACK );
+			prvInitialiseMutex( pxNewQueue );
 
 			traceCREATE_MUTEX( pxNewQueue );
 		}
@@ -342,11 +544,10 @@ xQueueHandle xReturn = NULL;
 			traceCREATE_MUTEX_FAILED();
 		}
 
-		configASSERT( pxNewQueue );
 		return pxNewQueue;
 	}
 
-#endif /* configUSE_MUTEXES */
+#endif /* ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
 /*-----------------------------------------------------------*/
 
 #if configUSE_RECURSIVE_MUTEXES == 1
@@ -357,25 +558,25 @@ xQueueHandle xReturn = NULL;
 
 		configASSERT( pxMutex );
 
-		/* If this is the task that holds the mutex then pxMutexHolder will not
+		/* If this is the task that holds the mutex then the holder will not
 		change outside of this task.  If this task does not hold the mutex then
-		pxMutexHolder can never coincidentally equal the tasks handle, and as
+		the holder can never coincidentally equal the tasks handle, and as
 		this is the only condition we are interested in it does not matter if
-		pxMutexHolder is accessed simultaneously by another task.  Therefore no
-		mutual exclusion is required to test the pxMutexHolder variable. */
-		if( pxMutex->pxMutexHolder == xTaskGetCurrentTaskHandle() )
+		the holder is accessed simultaneously by another task.  Therefore no
+		mutual exclusion is required to test the holder. */
+		if( queueGET_MUTEX_HOLDER( pxMutex ) == xTaskGetCurrentTaskHandle() )
 		{
 			traceGIVE_MUTEX_RECURSIVE( pxMutex );
 
-			/* uxRecursiveCallCount cannot be zero if pxMutexHolder is equal to
+			/* uxRecursiveCallCount cannot be zero if the holder is equal to
 			the task handle, therefore no underflow check is required.  Also,
 			uxRecursiveCallCount is only modified by the mutex holder, and as
 			there can only be one, no mutual exclusion is required to modify the
 			uxRecursiveCallCount member. */
-			( pxMutex->uxRecursiveCallCount )--;
+			queueDECREMENT_RECURSIVE_CALL_COUNT( pxMutex );
 
 			/* Have we unwound the call count? */
-			if( pxMutex->uxRecursiveCallCount == 0 )
+			if( queueRECURSIVE_CALL_COUNT( pxMutex ) == 0U )
 			{
 				/* Return the mutex.  This will automatically unblock any other
 				task that might be waiting to access the mutex. */
@@ -411,9 +612,9 @@ xQueueHandle xReturn = NULL;
 
 		traceTAKE_MUTEX_RECURSIVE( pxMutex );
 
-		if( pxMutex->pxMutexHolder == xTaskGetCurrentTaskHandle() )
+		if( queueGET_MUTEX_HOLDER( pxMutex ) == xTaskGetCurrentTaskHandle() )
 		{
-			( pxMutex->uxRecursiveCallCount )++;
+			queueINCREMENT_RECURSIVE_CALL_COUNT( pxMutex );
 			xReturn = pdPASS;
 		}
 		else
@@ -424,7 +625,7 @@ xQueueHandle xReturn = NULL;
 			we may have blocked to reach here. */
 			if( xReturn == pdPASS )
 			{
-				( pxMutex->uxRecursiveCallCount )++;
+				queueINCREMENT_RECURSIVE_CALL_COUNT( pxMutex );
 			}
 			else
 			{
@@ -438,6 +639,36 @@ xQueueHandle xReturn = NULL;
 #endif /* configUSE_RECURSIVE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+
+	void *xQueueGetMutexHolder( xQueueHandle pxSemaphore )
+	{
+	void *pxReturn;
+
+		configASSERT( pxSemaphore );
+
+		/* The holder may change as soon as the critical section is left, so
+		the value returned is only reliable if the calling task holds the
+		mutex, or controls the tasks that might take it. */
+		taskENTER_CRITICAL();
+		{
+			if( pxSemaphore->uxQueueType == queueQUEUE_IS_MUTEX )
+			{
+				pxReturn = ( void * ) queueGET_MUTEX_HOLDER( pxSemaphore );
+			}
+			else
+			{
+				pxReturn = NULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return pxReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 #if configUSE_COUNTING_SEMAPHORES == 1
 
 	xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount )
@@ -464,6 +695,33 @@ xQueueHandle xReturn = NULL;
 #endif /* configUSE_COUNTING_SEMAPHORES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	xQueueHandle xQueueCreateCountingSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue )
+	{
+	xQueueHandle pxHandle;
+
+		configASSERT( uxInitialCount <= uxCountValue );
+
+		pxHandle = xQueueCreateStatic( uxCountValue, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue );
+
+		if( pxHandle != NULL )
+		{
+			pxHandle->uxMessagesWaiting = uxInitialCount;
+
+			traceCREATE_COUNTING_SEMAPHORE();
+		}
+		else
+		{
+			traceCREATE_COUNTING_SEMAPHORE_FAILED();
+		}
+
+		return pxHandle;
+	}
+
+#endif /* ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
 signed portBASE_TYPE xQueueGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition )
 {
 signed portBASE_TYPE xEntryTimeSet = pdFALSE;
@@ -486,19 +744,42 @@ xTimeOutType xTimeOut;
 				traceQUEUE_SEND( pxQueue );
 				prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
-				/* If there was a task waiting for data to arrive on the
-				queue then unblock it now. */
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				#if ( configUSE_QUEUE_SETS == 1 )
 				{
-					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) == pdTRUE )
+					if( pxQueue->pxQueueSetContainer != NULL )
 					{
-						/* The unblocked task has a priority higher than
-						our own so yield immediately.  Yes it is ok to do
-						this from within the critical section - the kernel
-						takes care of that. */
-						portYIELD_WITHIN_API();
+						/* Tasks never block on a queue set member directly,
+						the task waiting for the data is blocked on the set. */
+						if( prvNotifyQueueSetContainer( pxQueue, ( unsigned portBASE_TYPE ) 1U ) != pdFALSE )
+						{
+							portYIELD_WITHIN_API();
+						}
+					}
+					else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) == pdTRUE )
+						{
+							portYIELD_WITHIN_API();
+						}
+					}
+				}
+				#else
+				{
+					/* If there was a task waiting for data to arrive on the
+					queue then unblock it now. */
+					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) == pdTRUE )
+						{
+							/* The unblocked task has a priority higher than
+							our own so yield immediately.  Yes it is ok to do
+							this from within the critical section - the kernel
+							takes care of that. */
+							portYIELD_WITHIN_API();
+						}
 					}
 				}
+				#endif /* configUSE_QUEUE_SETS */
 
 				taskEXIT_CRITICAL();
 
@@ -695,7 +976,7 @@ xTimeOutType xTimeOut;
 							{
 								/* Record the information required to implement
 								priority inheritance should it become necessary. */
-								pxQueue->pxMutexHolder = xTaskGetCurrentTaskHandle();
+								vTaskMutexTaken( &( pxQueue->xMutexHeldItem ), &( pxQueue->xTasksWaitingToReceive ) );
 							}
 						}
 						#endif
@@ -764,7 +1045,7 @@ xTimeOutType xTimeOut;
 							if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 							{
 								portENTER_CRITICAL();
-									vTaskPriorityInherit( ( void * ) pxQueue->pxMutexHolder );
+									vTaskPriorityInherit( &( pxQueue->xMutexHeldItem ), &( pxQueue->xTasksWaitingToReceive ) );
 								portEXIT_CRITICAL();
 							}
 						}
@@ -776,6 +1057,16 @@ xTimeOutType xTimeOut;
 				}
 				else
 				{
+					#if ( configUSE_MUTEXES == 1 )
+					{
+						if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+						{
+							/* The holder no longer inherits from this task. */
+							vTaskPriorityDisinheritAfterTimeout( &( pxQueue->xMutexHeldItem ) );
+						}
+					}
+					#endif
+
 					taskEXIT_CRITICAL();
 					traceQUEUE_RECEIVE_FAILED( pxQueue );
 					return errQUEUE_EMPTY;
@@ -815,15 +1106,36 @@ unsigned portBASE_TYPE uxSavedInterruptStatus;
 			be done when the queue is unlocked later. */
 			if( pxQueue->xTxLock == queueUNLOCKED )
 			{
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				#if ( configUSE_QUEUE_SETS == 1 )
 				{
-					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+					if( pxQueue->pxQueueSetContainer != NULL )
 					{
-						/* The task waiting has a higher priority so record that a
-						context	switch is required. */
-						*pxHigherPriorityTaskWoken = pdTRUE;
+						if( prvNotifyQueueSetContainer( pxQueue, ( unsigned portBASE_TYPE ) 1U ) != pdFALSE )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+					}
+					else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+					}
+				}
+				#else
+				{
+					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+						{
+							/* The task waiting has a higher priority so record that a
+							context	switch is required. */
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
 					}
 				}
+				#endif /* configUSE_QUEUE_SETS */
 			}
 			else
 			{
@@ -885,7 +1197,7 @@ signed char *pcOriginalReadPosition;
 						{
 							/* Record the information required to implement
 							priority inheritance should it become necessary. */
-							pxQueue->pxMutexHolder = xTaskGetCurrentTaskHandle();
+							vTaskMutexTaken( &( pxQueue->xMutexHeldItem ), &( pxQueue->xTasksWaitingToReceive ) );
 						}
 					}
 					#endif
@@ -964,7 +1276,7 @@ signed char *pcOriginalReadPosition;
 					{
 						portENTER_CRITICAL();
 						{
-							vTaskPriorityInherit( ( void * ) pxQueue->pxMutexHolder );
+							vTaskPriorityInherit( &( pxQueue->xMutexHeldItem ), &( pxQueue->xTasksWaitingToReceive ) );
 						}
 						portEXIT_CRITICAL();
 					}
@@ -987,6 +1299,21 @@ signed char *pcOriginalReadPosition;
 		}
 		else
 		{
+			#if ( configUSE_MUTEXES == 1 )
+			{
+				if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+				{
+					/* The task gave up waiting, so the holder no longer
+					inherits its priority. */
+					portENTER_CRITICAL();
+					{
+						vTaskPriorityDisinheritAfterTimeout( &( pxQueue->xMutexHeldItem ) );
+					}
+					portEXIT_CRITICAL();
+				}
+			}
+			#endif
+
 			prvUnlockQueue( pxQueue );
 			( void ) xTaskResumeAll();
 			traceQUEUE_RECEIVE_FAILED( pxQueue );
@@ -1051,57 +1378,422 @@ unsigned portBASE_TYPE uxSavedInterruptStatus;
 }
 /*-----------------------------------------------------------*/
 
-unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle pxQueue )
+signed portBASE_TYPE xQueueSendMultiple( xQueueHandle pxQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait )
 {
-unsigned portBASE_TYPE uxReturn;
+signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+xTimeOutType xTimeOut;
+unsigned portBASE_TYPE uxSpace;
 
 	configASSERT( pxQueue );
+	configASSERT( pvItemsToQueue );
 
-	taskENTER_CRITICAL();
-		uxReturn = pxQueue->uxMessagesWaiting;
-	taskEXIT_CRITICAL();
-
-	return uxReturn;
-}
-/*-----------------------------------------------------------*/
-
-unsigned portBASE_TYPE uxQueueMessagesWaitingFromISR( const xQueueHandle pxQueue )
-{
-unsigned portBASE_TYPE uxReturn;
+	/* Semaphores and mutexes have no data to batch. */
+	configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
 
-	configASSERT( pxQueue );
+	/* This follows the same structure as xQueueGenericSend(), but copies as
+	many of the items as there is space for in a single pass, and only blocks
+	while the queue is completely full. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			uxSpace = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
 
-	uxReturn = pxQueue->uxMessagesWaiting;
+			if( uxSpace > ( unsigned portBASE_TYPE ) 0 )
+			{
+				if( uxItemCount > uxSpace )
+				{
+					uxItemCount = uxSpace;
+				}
 
-	return uxReturn;
-}
-/*-----------------------------------------------------------*/
+				traceQUEUE_SEND( pxQueue );
+				prvCopyMultipleToQueue( pxQueue, pvItemsToQueue, uxItemCount );
 
-void vQueueDelete( xQueueHandle pxQueue )
-{
-	configASSERT( pxQueue );
+				#if ( configUSE_QUEUE_SETS == 1 )
+				{
+					if( pxQueue->pxQueueSetContainer != NULL )
+					{
+						if( prvNotifyQueueSetContainer( pxQueue, uxItemCount ) != pdFALSE )
+						{
+							portYIELD_WITHIN_API();
+						}
+					}
+					else if( prvUnblockTasksWaitingOnQueue( &( pxQueue->xTasksWaitingToReceive ), uxItemCount ) != pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				#else
+				{
+					/* Wake at most one waiting task per item posted. */
+					if( prvUnblockTasksWaitingOnQueue( &( pxQueue->xTasksWaitingToReceive ), uxItemCount ) != pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				#endif /* configUSE_QUEUE_SETS */
 
-	traceQUEUE_DELETE( pxQueue );
-	vQueueUnregisterQueue( pxQueue );
-	vPortFree( pxQueue->pcHead );
-	vPortFree( pxQueue );
-}
-/*-----------------------------------------------------------*/
+				taskEXIT_CRITICAL();
 
-static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, portBASE_TYPE xPosition )
-{
-	if( pxQueue->uxItemSize == ( unsigned portBASE_TYPE ) 0 )
-	{
-		#if ( configUSE_MUTEXES == 1 )
-		{
-			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+				return ( signed portBASE_TYPE ) uxItemCount;
+			}
+			else
 			{
-				/* The mutex is no longer being held. */
-				vTaskPriorityDisinherit( ( void * ) pxQueue->pxMutexHolder );
-				pxQueue->pxMutexHolder = NULL;
+				if( xTicksToWait == ( portTickType ) 0 )
+				{
+					/* The queue was full and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_SEND_FAILED( pxQueue );
+					return 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
 			}
 		}
-		#endif
+		taskEXIT_CRITICAL();
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( !xTaskResumeAll() )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* The timeout has expired. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+			traceQUEUE_SEND_FAILED( pxQueue );
+			return 0;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xQueueSendMultipleFromISR( xQueueHandle pxQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+unsigned portBASE_TYPE uxSavedInterruptStatus, uxSpace;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItemsToQueue );
+	configASSERT( pxHigherPriorityTaskWoken );
+	configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxSpace = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+		if( uxItemCount > uxSpace )
+		{
+			uxItemCount = uxSpace;
+		}
+
+		if( uxItemCount > ( unsigned portBASE_TYPE ) 0 )
+		{
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+			prvCopyMultipleToQueue( pxQueue, pvItemsToQueue, uxItemCount );
+
+			/* If the queue is locked we do not alter the event list.  This will
+			be done when the queue is unlocked later. */
+			if( pxQueue->xTxLock == queueUNLOCKED )
+			{
+				#if ( configUSE_QUEUE_SETS == 1 )
+				{
+					if( pxQueue->pxQueueSetContainer != NULL )
+					{
+						if( prvNotifyQueueSetContainer( pxQueue, uxItemCount ) != pdFALSE )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+					}
+					else if( prvUnblockTasksWaitingOnQueue( &( pxQueue->xTasksWaitingToReceive ), uxItemCount ) != pdFALSE )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
+				#else
+				{
+					if( prvUnblockTasksWaitingOnQueue( &( pxQueue->xTasksWaitingToReceive ), uxItemCount ) != pdFALSE )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
+				#endif /* configUSE_QUEUE_SETS */
+			}
+			else
+			{
+				/* One lock count per item posted, so the task that unlocks
+				the queue can wake one waiting task per item. */
+				pxQueue->xTxLock += ( signed portBASE_TYPE ) uxItemCount;
+			}
+		}
+		else
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return ( signed portBASE_TYPE ) uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xQueueReceiveMultiple( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait )
+{
+signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+xTimeOutType xTimeOut;
+unsigned portBASE_TYPE uxItemCount;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+
+	/* Semaphores and mutexes have no data to batch. */
+	configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+	/* This follows the same structure as xQueueGenericReceive(), but copies
+	out as many items as are available, up to uxMaxItems, in a single pass. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			uxItemCount = pxQueue->uxMessagesWaiting;
+
+			if( uxItemCount > ( unsigned portBASE_TYPE ) 0 )
+			{
+				if( uxItemCount > uxMaxItems )
+				{
+					uxItemCount = uxMaxItems;
+				}
+
+				traceQUEUE_RECEIVE( pxQueue );
+				prvCopyMultipleFromQueue( pxQueue, pvBuffer, uxItemCount );
+				pxQueue->uxMessagesWaiting -= uxItemCount;
+
+				/* Wake at most one waiting task per item removed. */
+				if( prvUnblockTasksWaitingOnQueue( &( pxQueue->xTasksWaitingToSend ), uxItemCount ) != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+
+				taskEXIT_CRITICAL();
+
+				return ( signed portBASE_TYPE ) uxItemCount;
+			}
+			else
+			{
+				if( xTicksToWait == ( portTickType ) 0 )
+				{
+					/* The queue was empty and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueEmpty( pxQueue ) )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( !xTaskResumeAll() )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+			traceQUEUE_RECEIVE_FAILED( pxQueue );
+			return 0;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xQueueReceiveMultipleFromISR( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, signed portBASE_TYPE *pxTaskWoken )
+{
+unsigned portBASE_TYPE uxSavedInterruptStatus, uxItemCount;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+	configASSERT( pxTaskWoken );
+	configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxItemCount = pxQueue->uxMessagesWaiting;
+
+		if( uxItemCount > uxMaxItems )
+		{
+			uxItemCount = uxMaxItems;
+		}
+
+		if( uxItemCount > ( unsigned portBASE_TYPE ) 0 )
+		{
+			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+			prvCopyMultipleFromQueue( pxQueue, pvBuffer, uxItemCount );
+			pxQueue->uxMessagesWaiting -= uxItemCount;
+
+			/* If the queue is locked we will not modify the event list.
+			Instead we update the lock count so the task that unlocks the
+			queue will know that an ISR has removed data while the queue was
+			locked. */
+			if( pxQueue->xRxLock == queueUNLOCKED )
+			{
+				if( prvUnblockTasksWaitingOnQueue( &( pxQueue->xTasksWaitingToSend ), uxItemCount ) != pdFALSE )
+				{
+					*pxTaskWoken = pdTRUE;
+				}
+			}
+			else
+			{
+				pxQueue->xRxLock += ( signed portBASE_TYPE ) uxItemCount;
+			}
+		}
+		else
+		{
+			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return ( signed portBASE_TYPE ) uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle pxQueue )
+{
+unsigned portBASE_TYPE uxReturn;
+
+	configASSERT( pxQueue );
+
+	taskENTER_CRITICAL();
+		uxReturn = pxQueue->uxMessagesWaiting;
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxQueueGetLength( const xQueueHandle pxQueue )
+{
+	configASSERT( pxQueue );
+
+	/* The length is fixed when the queue is created so no critical section
+	is needed. */
+	return pxQueue->uxLength;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxQueueMessagesWaitingFromISR( const xQueueHandle pxQueue )
+{
+unsigned portBASE_TYPE uxReturn;
+
+	configASSERT( pxQueue );
+
+	uxReturn = pxQueue->uxMessagesWaiting;
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( xQueueHandle pxQueue )
+{
+	configASSERT( pxQueue );
+
+	traceQUEUE_DELETE( pxQueue );
+	vQueueUnregisterQueue( pxQueue );
+
+	#if ( configUSE_MUTEXES == 1 )
+	{
+		if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			/* A mutex deleted while held must not stay in its holder's list
+			of held mutexes. */
+			taskENTER_CRITICAL();
+			{
+				vTaskPriorityDisinherit( &( pxQueue->xMutexHeldItem ) );
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		/* Memory supplied by the application is left for the application to
+		reuse. */
+		if( pxQueue->ucStaticallyAllocated == pdFALSE )
+		{
+			vPortFree( pxQueue->pcHead );
+			vPortFree( pxQueue );
+		}
+	}
+	#else
+	{
+		vPortFree( pxQueue->pcHead );
+		vPortFree( pxQueue );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, portBASE_TYPE xPosition )
+{
+	if( pxQueue->uxItemSize == ( unsigned portBASE_TYPE ) 0 )
+	{
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+			{
+				/* The mutex is no longer being held. */
+				vTaskPriorityDisinherit( &( pxQueue->xMutexHeldItem ) );
+			}
+		}
+		#endif
 	}
 	else if( xPosition == queueSEND_TO_BACK )
 	{
@@ -1140,6 +1832,91 @@ static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void *pvBuffer )
 }
 /*-----------------------------------------------------------*/
 
+static void prvCopyMultipleToQueue( xQUEUE *pxQueue, const void *pvItemsToQueue, unsigned portBASE_TYPE uxItemCount )
+{
+unsigned portBASE_TYPE uxBytes, uxFirstBytes;
+
+	uxBytes = uxItemCount * pxQueue->uxItemSize;
+
+	/* Copy up to the end of the storage area, then wrap to the start for
+	whatever remains. */
+	uxFirstBytes = ( unsigned portBASE_TYPE ) ( pxQueue->pcTail - pxQueue->pcWriteTo );
+	if( uxFirstBytes > uxBytes )
+	{
+		uxFirstBytes = uxBytes;
+	}
+
+	memcpy( ( void * ) pxQueue->pcWriteTo, pvItemsToQueue, ( unsigned ) uxFirstBytes );
+	pxQueue->pcWriteTo += uxFirstBytes;
+
+	if( uxBytes > uxFirstBytes )
+	{
+		memcpy( ( void * ) pxQueue->pcHead, ( const void * ) ( ( const signed char * ) pvItemsToQueue + uxFirstBytes ), ( unsigned ) ( uxBytes - uxFirstBytes ) );
+		pxQueue->pcWriteTo = pxQueue->pcHead + ( uxBytes - uxFirstBytes );
+	}
+
+	if( pxQueue->pcWriteTo >= pxQueue->pcTail )
+	{
+		pxQueue->pcWriteTo = pxQueue->pcHead;
+	}
+
+	pxQueue->uxMessagesWaiting += uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyMultipleFromQueue( xQUEUE * const pxQueue, void *pvBuffer, unsigned portBASE_TYPE uxItemCount )
+{
+unsigned portBASE_TYPE uxBytes, uxFirstBytes;
+signed char *pcNextItem;
+
+	uxBytes = uxItemCount * pxQueue->uxItemSize;
+
+	/* pcReadFrom points to the item that was read last, so the first item to
+	read follows it. */
+	pcNextItem = pxQueue->pcReadFrom + pxQueue->uxItemSize;
+	if( pcNextItem >= pxQueue->pcTail )
+	{
+		pcNextItem = pxQueue->pcHead;
+	}
+
+	uxFirstBytes = ( unsigned portBASE_TYPE ) ( pxQueue->pcTail - pcNextItem );
+	if( uxFirstBytes > uxBytes )
+	{
+		uxFirstBytes = uxBytes;
+	}
+
+	memcpy( pvBuffer, ( void * ) pcNextItem, ( unsigned ) uxFirstBytes );
+
+	if( uxBytes > uxFirstBytes )
+	{
+		memcpy( ( void * ) ( ( signed char * ) pvBuffer + uxFirstBytes ), ( void * ) pxQueue->pcHead, ( unsigned ) ( uxBytes - uxFirstBytes ) );
+		pxQueue->pcReadFrom = pxQueue->pcHead + ( uxBytes - uxFirstBytes ) - pxQueue->uxItemSize;
+	}
+	else
+	{
+		pxQueue->pcReadFrom = pcNextItem + uxBytes - pxQueue->uxItemSize;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static signed portBASE_TYPE prvUnblockTasksWaitingOnQueue( const xList * const pxEventList, unsigned portBASE_TYPE uxMaxTasks )
+{
+signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	while( ( uxMaxTasks > ( unsigned portBASE_TYPE ) 0 ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+	{
+		if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+
+		uxMaxTasks--;
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( xQueueHandle pxQueue )
 {
 	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -1153,6 +1930,23 @@ static void prvUnlockQueue( xQueueHandle pxQueue )
 		/* See if data was added to the queue while it was locked. */
 		while( pxQueue->xTxLock > queueLOCKED_UNMODIFIED )
 		{
+			#if ( configUSE_QUEUE_SETS == 1 )
+			{
+				/* The handle of a set member is posted to its set once for
+				each item, regardless of whether a task is waiting. */
+				if( pxQueue->pxQueueSetContainer != NULL )
+				{
+					if( prvNotifyQueueSetContainer( pxQueue, ( unsigned portBASE_TYPE ) 1U ) != pdFALSE )
+					{
+						vTaskMissedYield();
+					}
+
+					--( pxQueue->xTxLock );
+					continue;
+				}
+			}
+			#endif /* configUSE_QUEUE_SETS */
+
 			/* Data was posted while the queue was locked.  Are any tasks
 			blocked waiting for data to become available? */
 			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
@@ -1485,6 +2279,34 @@ signed portBASE_TYPE xReturn;
 #endif
 /*-----------------------------------------------------------*/
 
+#if configQUEUE_REGISTRY_SIZE > 0
+
+	portBASE_TYPE xQueueGetRegistryEntry( unsigned portBASE_TYPE uxIndex, signed char **ppcQueueName, xQueueHandle *pxQueue )
+	{
+	portBASE_TYPE xReturn = pdFALSE;
+
+		if( uxIndex < ( unsigned portBASE_TYPE ) configQUEUE_REGISTRY_SIZE )
+		{
+			/* Read the name and handle together so a queue being added or
+			removed at the same time cannot give a mismatched pair. */
+			taskENTER_CRITICAL();
+			{
+				if( xQueueRegistry[ uxIndex ].pcQueueName != NULL )
+				{
+					*ppcQueueName = xQueueRegistry[ uxIndex ].pcQueueName;
+					*pxQueue = xQueueRegistry[ uxIndex ].xHandle;
+					xReturn = pdTRUE;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 #if configQUEUE_REGISTRY_SIZE > 0
 
 	static void vQueueUnregisterQueue( xQueueHandle xQueue )
@@ -1537,3 +2359,171 @@ signed portBASE_TYPE xReturn;
 
 #endif
 
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength )
+	{
+	xQueueHandle pxQueue;
+
+		/* A queue set is a queue of handles.  Each item posted to a member
+		queue results in the member's handle being posted to the set, so the
+		set must be long enough to hold one handle for every item that can be
+		held by all of its members. */
+		pxQueue = xQueueCreate( uxEventQueueLength, sizeof( xQUEUE * ) );
+
+		return pxQueue;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	portBASE_TYPE xQueueAddToSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet )
+	{
+	portBASE_TYPE xReturn;
+
+		configASSERT( xQueueOrSemaphore );
+		configASSERT( xQueueSet );
+
+		taskENTER_CRITICAL();
+		{
+			if( xQueueOrSemaphore->pxQueueSetContainer != NULL )
+			{
+				/* Cannot add a queue to more than one set. */
+				xReturn = pdFAIL;
+			}
+			else if( xQueueOrSemaphore->uxMessagesWaiting != ( unsigned portBASE_TYPE ) 0 )
+			{
+				/* Cannot add a queue that already contains items, as the set
+				would not hold a handle for the items already queued. */
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				xQueueOrSemaphore->pxQueueSetContainer = xQueueSet;
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	portBASE_TYPE xQueueRemoveFromSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet )
+	{
+	portBASE_TYPE xReturn;
+
+		configASSERT( xQueueOrSemaphore );
+		configASSERT( xQueueSet );
+
+		taskENTER_CRITICAL();
+		{
+			if( xQueueOrSemaphore->pxQueueSetContainer != xQueueSet )
+			{
+				/* The queue was not a member of the set. */
+				xReturn = pdFAIL;
+			}
+			else if( xQueueOrSemaphore->uxMessagesWaiting != ( unsigned portBASE_TYPE ) 0 )
+			{
+				/* It is dangerous to remove a queue from a set while the set
+				still holds handles that refer to the queue. */
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				xQueueOrSemaphore->pxQueueSetContainer = NULL;
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueHandle xQueueSelectFromSet( xQueueHandle xQueueSet, portTickType xBlockTimeTicks )
+	{
+	xQueueHandle xReturn = NULL;
+
+		( void ) xQueueGenericReceive( xQueueSet, &xReturn, xBlockTimeTicks, pdFALSE );
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueHandle xQueueSelectFromSetFromISR( xQueueHandle xQueueSet )
+	{
+	xQueueHandle xReturn = NULL;
+	signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+		/* Tasks never block to post to a queue set, so reading from the set
+		cannot unblock a task and xHigherPriorityTaskWoken can be ignored. */
+		( void ) xQueueReceiveFromISR( xQueueSet, &xReturn, &xHigherPriorityTaskWoken );
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	static signed portBASE_TYPE prvNotifyQueueSetContainer( const xQUEUE * const pxQueue, unsigned portBASE_TYPE uxItemCount )
+	{
+	xQUEUE *pxQueueSetContainer = pxQueue->pxQueueSetContainer;
+	signed portBASE_TYPE xReturn = pdFALSE;
+
+		/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION, OR WITH
+		INTERRUPTS MASKED. */
+		configASSERT( pxQueueSetContainer );
+
+		/* The set was created large enough to hold a handle for every item
+		its members can hold, so this can only fail if the set was sized
+		incorrectly. */
+		configASSERT( ( pxQueueSetContainer->uxLength - pxQueueSetContainer->uxMessagesWaiting ) >= uxItemCount );
+
+		while( ( uxItemCount > ( unsigned portBASE_TYPE ) 0 ) && ( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength ) )
+		{
+			traceQUEUE_SEND( pxQueueSetContainer );
+			prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+
+			/* The set itself might be locked by a task that is about to block
+			on it, in which case the event list is left for the task to update
+			when it unlocks the set. */
+			if( pxQueueSetContainer->xTxLock == queueUNLOCKED )
+			{
+				if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+				{
+					if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
+					{
+						xReturn = pdTRUE;
+					}
+				}
+			}
+			else
+			{
+				++( pxQueueSetContainer->xTxLock );
+			}
+
+			uxItemCount--;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+
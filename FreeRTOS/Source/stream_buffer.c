@@ -0,0 +1,563 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+	FreeRTOS supports many tools and architectures. V7.0.0 is sponsored by:
+	Atollic AB - Atollic provides professional embedded systems development 
+	tools for C/C++ development, code analysis and test automation.  
+	See http://www.atollic.com
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
+#endif
+
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build stream_buffer.c
+#endif
+
+/*
+ * Definition of a stream buffer.
+ *
+ * One more byte of storage is allocated than was requested so a full buffer
+ * (xHead one behind xTail) can be distinguished from an empty buffer (xHead
+ * equal to xTail) without a shared count.  Only the writer updates xHead and
+ * only the reader updates xTail, so data can be moved without a critical
+ * section provided there is a single writer and a single reader.
+ */
+typedef struct StreamBufferDefinition
+{
+	volatile size_t xTail;							/*< Index of the next byte to read.  Only written by the reader. */
+	volatile size_t xHead;							/*< Index of the next byte to write.  Only written by the writer. */
+	size_t xLength;									/*< The length of the storage area in bytes. */
+	volatile size_t xTriggerLevelBytes;				/*< The number of bytes that must be available before a blocked reader is unblocked. */
+	volatile xTaskHandle xTaskWaitingToReceive;		/*< The task, if any, blocked waiting for data. */
+	volatile xTaskHandle xTaskWaitingToSend;		/*< The task, if any, blocked waiting for space. */
+	unsigned char *pucBuffer;						/*< The storage area, which follows the structure in the same allocation. */
+} xSTREAM_BUFFER;
+
+/*
+ * If a task is blocked waiting for data and enough bytes are now available
+ * then unblock it.  The scheduler is suspended rather than a critical section
+ * being used so interrupts are not disabled while the task is readied.
+ */
+#define sbSEND_COMPLETED( pxStreamBuffer )													\
+	vTaskSuspendAll();																		\
+	{																						\
+		if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )								\
+		{																					\
+			( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToReceive, 0, eNoAction );\
+			( pxStreamBuffer )->xTaskWaitingToReceive = NULL;								\
+		}																					\
+	}																						\
+	( void ) xTaskResumeAll();
+
+/*
+ * If a task is blocked waiting for space then unblock it, as bytes have just
+ * been removed from the stream buffer.
+ */
+#define sbRECEIVE_COMPLETED( pxStreamBuffer )												\
+	vTaskSuspendAll();																		\
+	{																						\
+		if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )								\
+		{																					\
+			( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToSend, 0, eNoAction );	\
+			( pxStreamBuffer )->xTaskWaitingToSend = NULL;									\
+		}																					\
+	}																						\
+	( void ) xTaskResumeAll();
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Copy up to xCount bytes from pucData into the stream buffer, wrapping at the
+ * end of the storage area, then publish them to the reader by updating xHead.
+ * Returns the number of bytes actually written, which is limited by the free
+ * space.
+ */
+static size_t prvWriteBytes( xSTREAM_BUFFER *pxStreamBuffer, const unsigned char *pucData, size_t xCount );
+
+/*
+ * Copy up to xCount bytes out of the stream buffer into pucData, then release
+ * the space to the writer by updating xTail.  Returns the number of bytes
+ * actually read.
+ */
+static size_t prvReadBytes( xSTREAM_BUFFER *pxStreamBuffer, unsigned char *pucData, size_t xCount );
+
+/*-----------------------------------------------------------*/
+
+xStreamBufferHandle xStreamBufferCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes )
+{
+xSTREAM_BUFFER *pxStreamBuffer;
+
+	configASSERT( xBufferSizeBytes > ( size_t ) 0 );
+	configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
+
+	/* A trigger level of 0 would unblock the reader when the buffer was still
+	empty. */
+	if( xTriggerLevelBytes == ( size_t ) 0 )
+	{
+		xTriggerLevelBytes = ( size_t ) 1;
+	}
+
+	/* The structure and the storage area are allocated in one block. */
+	pxStreamBuffer = ( xSTREAM_BUFFER * ) pvPortMalloc( sizeof( xSTREAM_BUFFER ) + xBufferSizeBytes + ( size_t ) 1 );
+
+	if( pxStreamBuffer != NULL )
+	{
+		pxStreamBuffer->pucBuffer = ( unsigned char * ) pxStreamBuffer + sizeof( xSTREAM_BUFFER );
+		pxStreamBuffer->xLength = xBufferSizeBytes + ( size_t ) 1;
+		pxStreamBuffer->xHead = ( size_t ) 0;
+		pxStreamBuffer->xTail = ( size_t ) 0;
+		pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+		pxStreamBuffer->xTaskWaitingToReceive = NULL;
+		pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+		traceSTREAM_BUFFER_CREATE( pxStreamBuffer );
+	}
+	else
+	{
+		traceSTREAM_BUFFER_CREATE_FAILED();
+	}
+
+	return ( xStreamBufferHandle ) pxStreamBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer )
+{
+	configASSERT( xStreamBuffer );
+	traceSTREAM_BUFFER_DELETE( xStreamBuffer );
+	vPortFree( ( void * ) xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pxStreamBuffer );
+
+	taskENTER_CRITICAL();
+	{
+		/* Cannot reset a stream buffer that a task is blocked on. */
+		if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
+		{
+			pxStreamBuffer->xHead = ( size_t ) 0;
+			pxStreamBuffer->xTail = ( size_t ) 0;
+			traceSTREAM_BUFFER_RESET( xStreamBuffer );
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+portBASE_TYPE xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	if( xTriggerLevel == ( size_t ) 0 )
+	{
+		xTriggerLevel = ( size_t ) 1;
+	}
+
+	/* The trigger level cannot exceed the number of bytes the buffer can
+	actually hold. */
+	if( xTriggerLevel < pxStreamBuffer->xLength )
+	{
+		pxStreamBuffer->xTriggerLevelBytes = xTriggerLevel;
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+const xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xCount;
+
+	configASSERT( pxStreamBuffer );
+
+	xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+	xCount -= pxStreamBuffer->xTail;
+	if( xCount >= pxStreamBuffer->xLength )
+	{
+		xCount -= pxStreamBuffer->xLength;
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+const xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xSpace;
+
+	configASSERT( pxStreamBuffer );
+
+	xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
+	xSpace -= pxStreamBuffer->xHead;
+	xSpace -= ( size_t ) 1;
+	if( xSpace >= pxStreamBuffer->xLength )
+	{
+		xSpace -= pxStreamBuffer->xLength;
+	}
+
+	return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xReturn, xSpace;
+xTimeOutType xTimeOut;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvTxData );
+
+	xSpace = xStreamBufferSpacesAvailable( xStreamBuffer );
+
+	if( ( xSpace < xDataLengthBytes ) && ( xTicksToWait != ( portTickType ) 0 ) )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			/* Check the space again with interrupts masked so the reader
+			cannot free space between the check and this task recording that
+			it is waiting. */
+			taskENTER_CRITICAL();
+			{
+				xSpace = xStreamBufferSpacesAvailable( xStreamBuffer );
+
+				if( xSpace < xDataLengthBytes )
+				{
+					/* Clear any notification that was left pending so it is
+					not mistaken for the reader freeing space. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Only one writer is supported, so only one task can ever
+					be waiting to send. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xSpace >= xDataLengthBytes )
+			{
+				break;
+			}
+
+			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+			( void ) xTaskNotifyWait( 0UL, 0UL, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+	}
+
+	/* Write as many bytes as will fit, which is all of them unless the call
+	timed out. */
+	xReturn = prvWriteBytes( pxStreamBuffer, ( const unsigned char * ) pvTxData, xDataLengthBytes );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+		if( xStreamBufferBytesAvailable( xStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED( pxStreamBuffer );
+		}
+	}
+	else
+	{
+		traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xReturn;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvTxData );
+
+	/* The copy itself needs no protection as this is the only writer. */
+	xReturn = prvWriteBytes( pxStreamBuffer, ( const unsigned char * ) pvTxData, xDataLengthBytes );
+
+	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		if( xStreamBufferBytesAvailable( xStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				if( pxStreamBuffer->xTaskWaitingToReceive != NULL )
+				{
+					( void ) xTaskNotifyFromISR( pxStreamBuffer->xTaskWaitingToReceive, 0UL, eNoAction, pxHigherPriorityTaskWoken );
+					pxStreamBuffer->xTaskWaitingToReceive = NULL;
+				}
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xReturn = 0, xBytesAvailable;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvRxData );
+
+	if( xTicksToWait != ( portTickType ) 0 )
+	{
+		/* Check for data with interrupts masked so the writer cannot add data
+		between the check and this task recording that it is waiting. */
+		taskENTER_CRITICAL();
+		{
+			xBytesAvailable = xStreamBufferBytesAvailable( xStreamBuffer );
+
+			if( xBytesAvailable == ( size_t ) 0 )
+			{
+				/* Clear any notification that was left pending so it is not
+				mistaken for the writer adding data. */
+				( void ) xTaskNotifyStateClear( NULL );
+
+				/* Only one reader is supported, so only one task can ever be
+				waiting to receive. */
+				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBytesAvailable == ( size_t ) 0 )
+		{
+			/* Wait for the writer to reach the trigger level, or for the
+			timeout to expire. */
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+			( void ) xTaskNotifyWait( 0UL, 0UL, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToReceive = NULL;
+		}
+	}
+
+	xReturn = prvReadBytes( pxStreamBuffer, ( unsigned char * ) pvRxData, xBufferLengthBytes );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReturn );
+		sbRECEIVE_COMPLETED( pxStreamBuffer );
+	}
+	else
+	{
+		traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xReturn;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pvRxData );
+
+	/* The copy itself needs no protection as this is the only reader. */
+	xReturn = prvReadBytes( pxStreamBuffer, ( unsigned char * ) pvRxData, xBufferLengthBytes );
+
+	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReturn );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( pxStreamBuffer->xTaskWaitingToSend != NULL )
+			{
+				( void ) xTaskNotifyFromISR( pxStreamBuffer->xTaskWaitingToSend, 0UL, eNoAction, pxHigherPriorityTaskWoken );
+				pxStreamBuffer->xTaskWaitingToSend = NULL;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytes( xSTREAM_BUFFER *pxStreamBuffer, const unsigned char *pucData, size_t xCount )
+{
+size_t xSpace, xHead, xFirstLength;
+
+	xSpace = xStreamBufferSpacesAvailable( ( xStreamBufferHandle ) pxStreamBuffer );
+	if( xCount > xSpace )
+	{
+		xCount = xSpace;
+	}
+
+	if( xCount > ( size_t ) 0 )
+	{
+		xHead = pxStreamBuffer->xHead;
+
+		/* Copy up to the end of the storage area, then wrap to the start for
+		whatever remains. */
+		xFirstLength = pxStreamBuffer->xLength - xHead;
+		if( xFirstLength > xCount )
+		{
+			xFirstLength = xCount;
+		}
+		memcpy( ( void * ) &( pxStreamBuffer->pucBuffer[ xHead ] ), ( const void * ) pucData, xFirstLength );
+
+		if( xCount > xFirstLength )
+		{
+			memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength );
+		}
+
+		xHead += xCount;
+		if( xHead >= pxStreamBuffer->xLength )
+		{
+			xHead -= pxStreamBuffer->xLength;
+		}
+
+		/* Only now do the bytes become visible to the reader. */
+		pxStreamBuffer->xHead = xHead;
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytes( xSTREAM_BUFFER *pxStreamBuffer, unsigned char *pucData, size_t xCount )
+{
+size_t xAvailable, xTail, xFirstLength;
+
+	xAvailable = xStreamBufferBytesAvailable( ( xStreamBufferHandle ) pxStreamBuffer );
+	if( xCount > xAvailable )
+	{
+		xCount = xAvailable;
+	}
+
+	if( xCount > ( size_t ) 0 )
+	{
+		xTail = pxStreamBuffer->xTail;
+
+		/* Copy up to the end of the storage area, then wrap to the start for
+		whatever remains. */
+		xFirstLength = pxStreamBuffer->xLength - xTail;
+		if( xFirstLength > xCount )
+		{
+			xFirstLength = xCount;
+		}
+		memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength );
+
+		if( xCount > xFirstLength )
+		{
+			memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( const void * ) pxStreamBuffer->pucBuffer, xCount - xFirstLength );
+		}
+
+		xTail += xCount;
+		if( xTail >= pxStreamBuffer->xLength )
+		{
+			xTail -= pxStreamBuffer->xLength;
+		}
+
+		/* Only now is the space released back to the writer. */
+		pxStreamBuffer->xTail = xTail;
+	}
+
+	return xCount;
+}
+
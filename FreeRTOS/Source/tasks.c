@@ -70,6 +70,7 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
+#include "timing_wheel.h"
 #include "StackMacros.h"
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
@@ -83,6 +84,29 @@ task.h is included from an application file. */
  * Task control block.  A task control block (TCB) is allocated to each task,
  * and stores the context of the task.
  */
+/* Values that can be assigned to the ucNotifyState member of the TCB.  A
+char is used rather than an enum so the size of the TCB does not depend on the
+compiler's enum packing options (see xStaticTask in FreeRTOS.h). */
+#define taskNOT_WAITING_NOTIFICATION	( ( unsigned char ) 0 )
+#define taskWAITING_NOTIFICATION		( ( unsigned char ) 1 )
+#define taskNOTIFICATION_RECEIVED		( ( unsigned char ) 2 )
+
+/* Set in the event list item value of a task that is waiting on an event group,
+while the value holds the bits the task is waiting for rather than the task's
+priority.  The priority functions do not overwrite the value while this bit is
+set.  The event group implementation uses the same bit - see event_groups.c. */
+#if configUSE_16_BIT_TICKS == 1
+	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x8000U
+#else
+	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
+#endif
+
+/* Values that can be assigned to the ucStaticallyAllocated member of the TCB,
+used to decide which memory, if any, must be freed when the task is deleted. */
+#define tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB	( ( unsigned char ) 0 )
+#define tskSTATICALLY_ALLOCATED_STACK_ONLY		( ( unsigned char ) 1 )
+#define tskSTATICALLY_ALLOCATED_STACK_AND_TCB	( ( unsigned char ) 2 )
+
 typedef struct tskTaskControlBlock
 {																
 	volatile portSTACK_TYPE	*pxTopOfStack;		/*< Points to the location of the last item placed on the tasks stack.  THIS MUST BE THE FIRST MEMBER OF THE STRUCT. */
@@ -111,6 +135,9 @@ typedef struct tskTaskControlBlock
 
 	#if ( configUSE_MUTEXES == 1 )
 		unsigned portBASE_TYPE uxBasePriority;	/*< The priority last assigned to the task - used by the priority inheritance mechanism. */
+		xList xMutexesHeld;						/*< The mutexes held by the task, ordered so the mutex with the highest priority waiter is first. */
+		xListItem *pxMutexWaitedOn;				/*< The ownership item of the mutex the task is blocked on, or NULL. */
+		xList *pxMutexWaitList;					/*< The list of tasks waiting for that mutex. */
 	#endif
 
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
@@ -118,7 +145,19 @@ typedef struct tskTaskControlBlock
 	#endif
 
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		unsigned long ulRunTimeCounter;		/*< Used for calculating how much CPU time each task is utilising. */
+		unsigned long long ullRunTimeCounter;	/*< Used for calculating how much CPU time each task is utilising.  64 bits so it does not wrap within the life of the product. */
+		unsigned long ulRunTimeThisWindow;		/*< CPU time used by the task within load window number ulRunTimeWindow. */
+		unsigned long ulRunTimeLastWindow;		/*< CPU time used by the task within the load window before that. */
+		unsigned long ulRunTimeWindow;			/*< The number of the load window ulRunTimeThisWindow belongs to. */
+	#endif
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile unsigned long ulNotifiedValue;	/*< The value sent to the task by xTaskNotify() and friends. */
+		volatile unsigned char ucNotifyState;	/*< Whether the task is waiting for, or has received, a notification. */
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;	/*< Set to one of the tskxxx_ALLOCATED constants so the correct memory is freed when the task is deleted. */
 	#endif
 
 } tskTCB;
@@ -138,10 +177,20 @@ PRIVILEGED_DATA tskTCB * volatile pxCurrentTCB = NULL;
 /* Lists for ready and blocked tasks. --------------------*/
 
 PRIVILEGED_DATA static xList pxReadyTasksLists[ configMAX_PRIORITIES ];	/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static xList xDelayedTaskList1;							/*< Delayed tasks. */
-PRIVILEGED_DATA static xList xDelayedTaskList2;							/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static xList * volatile pxDelayedTaskList ;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	PRIVILEGED_DATA static xTimingWheel xDelayedTaskWheel;				/*< Delayed tasks.  The time of the wheel is kept equal to xTickCount. */
+
+#else
+
+	PRIVILEGED_DATA static xList xDelayedTaskList1;						/*< Delayed tasks. */
+	PRIVILEGED_DATA static xList xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static xList * volatile pxDelayedTaskList ;			/*< Points to the delayed task list currently being used. */
+	PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;	/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#endif
+
 PRIVILEGED_DATA static xList xPendingReadyList;							/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready queue when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -168,13 +217,34 @@ PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxMissedTicks 			= ( unsi
 PRIVILEGED_DATA static volatile portBASE_TYPE xMissedYield 						= ( portBASE_TYPE ) pdFALSE;
 PRIVILEGED_DATA static volatile portBASE_TYPE xNumOfOverflows 					= ( portBASE_TYPE ) 0;
 PRIVILEGED_DATA static unsigned portBASE_TYPE uxTaskNumber 						= ( unsigned portBASE_TYPE ) 0;
-PRIVILEGED_DATA static portTickType xNextTaskUnblockTime						= ( portTickType ) portMAX_DELAY;
+PRIVILEGED_DATA static xTaskHandle xIdleTaskHandle								= NULL;
+
+#if ( configUSE_TIMING_WHEEL == 0 )
+
+	PRIVILEGED_DATA static portTickType xNextTaskUnblockTime					= ( portTickType ) portMAX_DELAY;
+
+#endif
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	PRIVILEGED_DATA static char pcStatsString[ 50 ] ;
 	PRIVILEGED_DATA static unsigned long ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
-	static void prvGenerateRunTimeStatsForTasksInList( const signed char *pcWriteBuffer, xList *pxList, unsigned long ulTotalRunTime ) PRIVILEGED_FUNCTION;
+	PRIVILEGED_DATA static unsigned long long ullTotalRunTime = 0ULL;	/*< The run time accounted to all tasks since the scheduler started. */
+	PRIVILEGED_DATA static unsigned long long ullRunTimeWindowStart = 0ULL;	/*< The value of ullTotalRunTime when the current load window started. */
+	PRIVILEGED_DATA static unsigned long ulRunTimeLastWindowLength = 0UL;	/*< The length of the last complete load window, in run time counter units. */
+	PRIVILEGED_DATA static unsigned long ulRunTimeWindow = 0UL;		/*< The number of the current load window. */
+	PRIVILEGED_DATA static portTickType xRunTimeWindowStartTick = ( portTickType ) 0;
+
+	/*
+	 * Add the time the current task has been running since it was switched in
+	 * to its run time counters.
+	 */
+	static void prvUpdateRunTimeCounters( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns how much of the last complete load window the task used.
+	 */
+	static unsigned long prvRunTimeInLastWindow( const tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
@@ -194,6 +264,12 @@ PRIVILEGED_DATA static portTickType xNextTaskUnblockTime						= ( portTickType )
 #define tskDELETED_CHAR		( ( signed char ) 'D' )
 #define tskSUSPENDED_CHAR	( ( signed char ) 'S' )
 
+/*
+ * Written by the functions that format task information as text when the
+ * task information could not be collected.
+ */
+#define tskSNAPSHOT_ERROR_STRING	( ( const char * ) "Error: task snapshot unavailable\r\n" )
+
 /*
  * Macros and private variables used by the trace facility.
  */
@@ -248,6 +324,74 @@ PRIVILEGED_DATA static portTickType xNextTaskUnblockTime						= ( portTickType )
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+
+	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
+	performed in a generic way that is not optimised to any particular
+	microcontroller architecture.  uxTopReadyPriority holds the priority of the
+	highest priority ready state task. */
+	#define taskRECORD_READY_PRIORITY( uxPriority )														\
+	{																									\
+		if( ( uxPriority ) > uxTopReadyPriority )														\
+		{																								\
+			uxTopReadyPriority = ( uxPriority );														\
+		}																								\
+	}
+	/*-----------------------------------------------------------*/
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()															\
+	{																									\
+		/* Find the highest priority queue that contains ready tasks. */								\
+		while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) )						\
+		{																								\
+			configASSERT( uxTopReadyPriority );															\
+			--uxTopReadyPriority;																		\
+		}																								\
+																										\
+		/* listGET_OWNER_OF_NEXT_ENTRY walks through the list, so the tasks of the						\
+		same priority get an equal share of the processor time. */										\
+		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopReadyPriority ] ) );		\
+	}
+	/*-----------------------------------------------------------*/
+
+	/* uxTopReadyPriority is only a high water mark in the generic method, and
+	is lowered lazily by taskSELECT_HIGHEST_PRIORITY_TASK(), so there is
+	nothing to do when a ready list becomes empty. */
+	#define taskRESET_READY_PRIORITY( uxPriority )
+
+#else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 1 then task selection is
+	performed in a way that is tailored to the particular microcontroller
+	architecture being used.  uxTopReadyPriority holds a bitmap in which bit n
+	is set when the ready list for priority n is not empty. */
+	#define taskRECORD_READY_PRIORITY( uxPriority )	portRECORD_READY_PRIORITY( ( uxPriority ), uxTopReadyPriority )
+	/*-----------------------------------------------------------*/
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()																\
+	{																										\
+	unsigned portBASE_TYPE uxTopPriority;																	\
+																											\
+		/* Find the highest priority list that contains ready tasks. */										\
+		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );										\
+		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );				\
+		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );				\
+	}
+	/*-----------------------------------------------------------*/
+
+	/* A task has been removed from a ready list.  If that ready list is now
+	empty then the bit for its priority must be cleared from the bitmap. */
+	#define taskRESET_READY_PRIORITY( uxPriority )															\
+	{																										\
+		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == 0 )						\
+		{																									\
+			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );								\
+		}																									\
+	}
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
 /*
  * Place the task represented by pxTCB into the appropriate ready queue for
  * the task.  It is inserted at the end of the list.  One quirk of this is
@@ -256,13 +400,41 @@ PRIVILEGED_DATA static portTickType xNextTaskUnblockTime						= ( portTickType )
  * executing task has been rescheduled.
  */
 #define prvAddTaskToReadyQueue( pxTCB )																					\
-	if( ( pxTCB )->uxPriority > uxTopReadyPriority )																	\
-	{																													\
-		uxTopReadyPriority = ( pxTCB )->uxPriority;																		\
-	}																													\
+	traceMOVED_TASK_TO_READY_STATE( pxTCB );																			\
+	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );																	\
 	vListInsertEnd( ( xList * ) &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) )
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+/*
+ * Macro that advances the wheel of delayed tasks to the new tick count, and
+ * wakes the tasks that are due.  Every task held in the list returned by
+ * pxTimingWheelAdvance() is due, so none of the delayed tasks that are not due
+ * are inspected.
+ */
+#define prvCheckDelayedTasks()															\
+{																						\
+xList *pxDueTasks;																		\
+																						\
+	pxDueTasks = pxTimingWheelAdvance( &xDelayedTaskWheel );							\
+																						\
+	while( listLIST_IS_EMPTY( pxDueTasks ) == pdFALSE )									\
+	{																					\
+		pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxDueTasks );					\
+		vListRemove( &( pxTCB->xGenericListItem ) );									\
+																						\
+		/* Is the task waiting on an event also? */										\
+		if( pxTCB->xEventListItem.pvContainer )											\
+		{																				\
+			vListRemove( &( pxTCB->xEventListItem ) );									\
+		}																				\
+		prvAddTaskToReadyQueue( pxTCB );												\
+	}																					\
+}
+
+#else
+
 /*
  * Macro that looks at the list of tasks that are currently delayed to see if
  * any require waking.
@@ -322,6 +494,8 @@ portTickType xItemValue;																\
 		}																				\
 	}																					\
 }
+
+#endif /* configUSE_TIMING_WHEEL */
 /*-----------------------------------------------------------*/
 
 /*
@@ -390,23 +564,111 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake ) PRIVILEGED_FUNCTION;
 
 /*
- * Allocates memory from the heap for a TCB and associated stack.  Checks the
- * allocation was successful.
+ * Move the calling task out of the ready list and into either the delayed or
+ * suspended list while it waits for a direct to task notification.  Must be
+ * called from within a critical section.
  */
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer ) PRIVILEGED_FUNCTION;
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static void prvBlockCurrentTaskForNotification( portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move a task that was waiting for a notification out of the blocked
+	 * state from within an ISR.
+	 */
+	static void prvUnblockNotifiedTaskFromISR( tskTCB *pxTCB, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif
 
 /*
- * Called from vTaskList.  vListTasks details all the tasks currently under
- * control of the scheduler.  The tasks may be in one of a number of lists.
- * prvListTaskWithinSingleList accepts a list and details the tasks from
- * within just that list.
+ * Return the amount of time, in ticks, that will pass before the kernel will
+ * next move a task from the Blocked state to the Running state.
  *
- * THIS FUNCTION IS INTENDED FOR DEBUGGING ONLY, AND SHOULD NOT BE CALLED FROM
- * NORMAL APPLICATION CODE.
+ * This conditional compilation should use inequality to 0, not equality to 1.
+ * This is to ensure portSUPPRESS_TICKS_AND_SLEEP() can be called when user
+ * defined low power mode implementations require configUSE_TICKLESS_IDLE to be
+ * set to a value other than 1.
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	static portTickType prvGetExpectedIdleTime( void ) PRIVILEGED_FUNCTION;
 
-	static void prvListTaskWithinSingleList( const signed char *pcWriteBuffer, xList *pxList, signed char cStatus ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Allocates memory from the heap for a TCB and associated stack.  Checks the
+ * allocation was successful.  If pxTCBBuffer is not NULL then it is used to
+ * hold the TCB instead of memory obtained from the heap, and likewise for
+ * puxStackBuffer and the stack.
+ */
+static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer, tskTCB *pxTCBBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Implements both xTaskGenericCreate() and xTaskCreateStatic().  pxTCBBuffer
+ * is NULL when the TCB is to be allocated from the heap.
+ */
+static signed portBASE_TYPE prvTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions, tskTCB *pxTCBBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from uxTaskGetSystemState.  The tasks under control of the
+ * scheduler may be in one of a number of lists.  prvListTasksWithinSingleList
+ * fills in an xTaskStatusType structure for each task within just that list,
+ * and returns the number of structures written.  eState is the state of the
+ * tasks in the list, although the state of each task is refined where the
+ * list alone does not tell the whole story.
+ */
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configGENERATE_RUN_TIME_STATS == 1 ) )
+
+	static unsigned portBASE_TYPE prvListTasksWithinSingleList( xTaskStatusType *pxTaskStatusArray, xList *pxList, eTaskState eState ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Used by the functions that format task information as text.  Allocates an
+ * array from the FreeRTOS heap and fills it using uxTaskGetSystemState().
+ * NULL is returned if the array could not be allocated or filled, otherwise
+ * the caller must free the array with vPortFree().
+ */
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configGENERATE_RUN_TIME_STATS == 1 ) )
+
+	static xTaskStatusType *prvTakeTaskStatusSnapshot( unsigned portBASE_TYPE *puxArraySize, unsigned long long *pullTotalRunTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Change the priority a task runs at without changing its base priority.  The
+ * task is moved to the ready list for its new priority if it is ready, and to
+ * its new position in the list of tasks waiting for a mutex if it is blocked
+ * on one.
+ */
+#if ( ( INCLUDE_vTaskPrioritySet == 1 ) || ( configUSE_MUTEXES == 1 ) )
+
+	static void prvSetTaskPriority( tskTCB *pxTCB, unsigned portBASE_TYPE uxNewPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_MUTEXES == 1 )
+
+	/*
+	 * Recalculate the priority of pxTCB as the higher of its base priority and
+	 * the priority of the highest priority task waiting for a mutex it holds.
+	 * If the priority changes and pxTCB is itself blocked on a mutex, the holder
+	 * of that mutex is recalculated next, and so on along the chain.
+	 */
+	static void prvUpdateInheritedPriority( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Set the value of a held mutex's ownership item from the priority of the
+	 * highest priority task in pxWaitingTasks, and re-sort the item within its
+	 * holder's list of held mutexes.
+	 */
+	static void prvUpdateMutexCeiling( xListItem *pxMutexItem, const xList *pxWaitingTasks ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called when pxTCB stops waiting for a mutex other than by obtaining it,
+	 * so the holder no longer inherits its priority.
+	 */
+	static void prvLeaveMutexWait( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
@@ -415,7 +677,7 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
  * This function determines the 'high water mark' of the task stack by
  * determining how much of the stack remains at the original preset value.
  */
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configGENERATE_RUN_TIME_STATS == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
 
 	static unsigned short usTaskCheckFreeStackSpace( const unsigned char * pucStackByte ) PRIVILEGED_FUNCTION;
 
@@ -431,6 +693,39 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
  *----------------------------------------------------------*/
 
 signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions )
+{
+	return prvTaskGenericCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, puxStackBuffer, xRegions, NULL );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xTaskHandle xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, portSTACK_TYPE * const puxStackBuffer, xStaticTask * const pxTaskBuffer )
+	{
+	xTaskHandle xReturn = NULL;
+
+		configASSERT( puxStackBuffer != NULL );
+		configASSERT( pxTaskBuffer != NULL );
+
+		/* Sanity check that the xStaticTask structure declared in FreeRTOS.h
+		is the same size as the real TCB. */
+		configASSERT( sizeof( xStaticTask ) == sizeof( tskTCB ) );
+
+		if( ( puxStackBuffer != NULL ) && ( pxTaskBuffer != NULL ) )
+		{
+			if( prvTaskGenericCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, &xReturn, puxStackBuffer, NULL, ( tskTCB * ) pxTaskBuffer ) != pdPASS )
+			{
+				xReturn = NULL;
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static signed portBASE_TYPE prvTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions, tskTCB *pxTCBBuffer )
 {
 signed portBASE_TYPE xReturn;
 tskTCB * pxNewTCB;
@@ -440,7 +735,7 @@ tskTCB * pxNewTCB;
 
 	/* Allocate the memory required by the TCB and stack for the new task,
 	checking that the allocation was successful. */
-	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer );
+	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer, pxTCBBuffer );
 
 	if( pxNewTCB != NULL )
 	{
@@ -615,6 +910,7 @@ tskTCB * pxNewTCB;
 			the termination list and free up any memory allocated by the
 			scheduler for the TCB and stack. */
 			vListRemove( &( pxTCB->xGenericListItem ) );
+			taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 
 			/* Is the task waiting on an event also? */
 			if( pxTCB->xEventListItem.pvContainer )
@@ -622,6 +918,21 @@ tskTCB * pxNewTCB;
 				vListRemove( &( pxTCB->xEventListItem ) );
 			}
 
+			#if ( configUSE_MUTEXES == 1 )
+			{
+				prvLeaveMutexWait( pxTCB );
+
+				/* Any mutex the task still holds is left without a holder, so
+				neither tasks that block on it later nor the recursive mutex
+				functions follow a pointer to the freed TCB.  The mutex is not
+				given back, so it can no longer be taken. */
+				while( listLIST_IS_EMPTY( &( pxTCB->xMutexesHeld ) ) == pdFALSE )
+				{
+					vListRemove( ( xListItem * ) ( pxTCB->xMutexesHeld.xListEnd.pxNext ) );
+				}
+			}
+			#endif
+
 			vListInsertEnd( ( xList * ) &xTasksWaitingTermination, &( pxTCB->xGenericListItem ) );
 
 			/* Increment the ucTasksDeleted variable so the idle task knows
@@ -707,6 +1018,7 @@ tskTCB * pxNewTCB;
 				ourselves to the blocked list as the same list item is used for
 				both lists. */
 				vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+				taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
 				prvAddCurrentTaskToDelayedList( xTimeToWake );
 			}
 		}
@@ -753,6 +1065,7 @@ tskTCB * pxNewTCB;
 				ourselves to the blocked list as the same list item is used for
 				both lists. */
 				vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+				taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
 				prvAddCurrentTaskToDelayedList( xTimeToWake );
 			}
 			xAlreadyYielded = xTaskResumeAll();
@@ -852,41 +1165,20 @@ tskTCB * pxNewTCB;
 					xYieldRequired = pdTRUE;
 				}
 
-
-
 				#if ( configUSE_MUTEXES == 1 )
 				{
-					/* Only change the priority being used if the task is not
-					currently using an inherited priority. */
-					if( pxTCB->uxBasePriority == pxTCB->uxPriority )
-					{
-						pxTCB->uxPriority = uxNewPriority;
-					}
-
-					/* The base priority gets set whatever. */
+					/* The task keeps any higher priority it has inherited from
+					the mutexes it holds.  A change to the priority it runs at
+					is passed on to the holder of any mutex it is blocked on. */
 					pxTCB->uxBasePriority = uxNewPriority;
+					prvUpdateInheritedPriority( pxTCB );
 				}
 				#else
 				{
-					pxTCB->uxPriority = uxNewPriority;
+					prvSetTaskPriority( pxTCB, uxNewPriority );
 				}
 				#endif
 
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( configMAX_PRIORITIES - ( portTickType ) uxNewPriority ) );
-
-				/* If the task is in the blocked or suspended list we need do
-				nothing more than change it's priority variable. However, if
-				the task is in a ready list it needs to be removed and placed
-				in the queue appropriate to its new priority. */
-				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxCurrentPriority ] ), &( pxTCB->xGenericListItem ) ) )
-				{
-					/* The task is currently in its ready list - remove before adding
-					it to it's new ready list.  As we are in a critical section we
-					can do this even if the scheduler is suspended. */
-					vListRemove( &( pxTCB->xGenericListItem ) );
-					prvAddTaskToReadyQueue( pxTCB );
-				}
-
 				if( xYieldRequired == pdTRUE )
 				{
 					portYIELD_WITHIN_API();
@@ -921,6 +1213,7 @@ tskTCB * pxNewTCB;
 
 			/* Remove task from the ready/delayed list and place in the	suspended list. */
 			vListRemove( &( pxTCB->xGenericListItem ) );
+			taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 
 			/* Is the task waiting on an event also? */
 			if( pxTCB->xEventListItem.pvContainer )
@@ -928,6 +1221,14 @@ tskTCB * pxNewTCB;
 				vListRemove( &( pxTCB->xEventListItem ) );
 			}
 
+			#if ( configUSE_MUTEXES == 1 )
+			{
+				/* If the task was blocked on a mutex it will try to take the
+				mutex again when it is resumed, and inherit again then. */
+				prvLeaveMutexWait( pxTCB );
+			}
+			#endif
+
 			vListInsertEnd( ( xList * ) &xSuspendedTaskList, &( pxTCB->xGenericListItem ) );
 		}
 		taskEXIT_CRITICAL();
@@ -1090,7 +1391,32 @@ void vTaskStartScheduler( void )
 portBASE_TYPE xReturn;
 
 	/* Add the idle task at the lowest priority. */
-	xReturn = xTaskCreate( prvIdleTask, ( signed char * ) "IDLE", tskIDLE_STACK_SIZE, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), ( xTaskHandle * ) NULL );
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+	xStaticTask *pxIdleTaskTCBBuffer = NULL;
+	portSTACK_TYPE *pxIdleTaskStackBuffer = NULL;
+	unsigned short usIdleTaskStackSize = tskIDLE_STACK_SIZE;
+
+		/* The idle task is created using memory supplied by the application
+		so the kernel can be used without a heap. */
+		vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &usIdleTaskStackSize );
+
+		xIdleTaskHandle = xTaskCreateStatic( prvIdleTask, ( signed char * ) "IDLE", usIdleTaskStackSize, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), pxIdleTaskStackBuffer, pxIdleTaskTCBBuffer );
+
+		if( xIdleTaskHandle != NULL )
+		{
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+	#else
+	{
+		xReturn = xTaskCreate( prvIdleTask, ( signed char * ) "IDLE", tskIDLE_STACK_SIZE, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), &xIdleTaskHandle );
+	}
+	#endif
 
 	#if ( configUSE_TIMERS == 1 )
 	{
@@ -1120,7 +1446,19 @@ portBASE_TYPE xReturn;
 		macro must be defined to configure the timer/counter used to generate
 		the run time counter time base. */
 		portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
-		
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			/* The counter need not start from zero, so the first task is
+			accounted from whatever it reads now. */
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTaskSwitchedInTime );
+			#else
+				ulTaskSwitchedInTime = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
+		}
+		#endif
+
 		/* Setting up the timer tick is hardware specific and thus in the
 		portable interface. */
 		if( xPortStartScheduler() )
@@ -1281,147 +1619,325 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configGENERATE_RUN_TIME_STATS == 1 ) )
 
-	void vTaskList( signed char *pcWriteBuffer )
+	unsigned portBASE_TYPE uxTaskGetSystemState( xTaskStatusType *pxTaskStatusArray, unsigned portBASE_TYPE uxArraySize, unsigned long long *pullTotalRunTime )
 	{
-	unsigned portBASE_TYPE uxQueue;
+	unsigned portBASE_TYPE uxQueue, uxTask = 0;
 
-		/* This is a VERY costly function that should be used for debug only.
-		It leaves interrupts disabled for a LONG time. */
+		configASSERT( pxTaskStatusArray );
 
 		vTaskSuspendAll();
 		{
-			/* Run through all the lists that could potentially contain a TCB and
-			report the task name, state and stack high water mark. */
+			/* Is there space in the array for each task in the system? */
+			if( uxArraySize >= uxCurrentNumberOfTasks )
+			{
+				#if ( configGENERATE_RUN_TIME_STATS == 1 )
+				{
+					/* Account the calling task up to now. */
+					taskENTER_CRITICAL();
+					{
+						prvUpdateRunTimeCounters();
+					}
+					taskEXIT_CRITICAL();
+				}
+				#endif
 
-			*pcWriteBuffer = ( signed char ) 0x00;
-			strcat( ( char * ) pcWriteBuffer, ( const char * ) "\r\n" );
+				/* Run through all the lists that could potentially contain a
+				TCB, filling in an xTaskStatusType structure for each task. */
+				uxQueue = uxTopUsedPriority + ( unsigned portBASE_TYPE ) 1U;
 
-			uxQueue = uxTopUsedPriority + ( unsigned portBASE_TYPE ) 1U;
+				do
+				{
+					uxQueue--;
 
-			do
-			{
-				uxQueue--;
+					if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxQueue ] ) ) == pdFALSE )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) &( pxReadyTasksLists[ uxQueue ] ), eReady );
+					}
+				}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
 
-				if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxQueue ] ) ) == pdFALSE )
+				#if ( configUSE_TIMING_WHEEL == 1 )
 				{
-					prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) &( pxReadyTasksLists[ uxQueue ] ), tskREADY_CHAR );
+					for( uxQueue = 0; uxQueue < ( unsigned portBASE_TYPE ) wheelNUMBER_OF_SLOTS; uxQueue++ )
+					{
+						if( listLIST_IS_EMPTY( wheelGET_SLOT( &xDelayedTaskWheel, uxQueue ) ) == pdFALSE )
+						{
+							uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), wheelGET_SLOT( &xDelayedTaskWheel, uxQueue ), eBlocked );
+						}
+					}
 				}
-			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
+				#else
+				{
+					if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxDelayedTaskList, eBlocked );
+					}
 
-			if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
-			{
-				prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, tskBLOCKED_CHAR );
-			}
+					if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxOverflowDelayedTaskList, eBlocked );
+					}
+				}
+				#endif
 
-			if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
-			{
-				prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, tskBLOCKED_CHAR );
-			}
+				#if( INCLUDE_vTaskDelete == 1 )
+				{
+					if( listLIST_IS_EMPTY( &xTasksWaitingTermination ) == pdFALSE )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) &xTasksWaitingTermination, eDeleted );
+					}
+				}
+				#endif
 
-			#if( INCLUDE_vTaskDelete == 1 )
-			{
-				if( listLIST_IS_EMPTY( &xTasksWaitingTermination ) == pdFALSE )
+				#if ( INCLUDE_vTaskSuspend == 1 )
 				{
-					prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) &xTasksWaitingTermination, tskDELETED_CHAR );
+					if( listLIST_IS_EMPTY( &xSuspendedTaskList ) == pdFALSE )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) &xSuspendedTaskList, eSuspended );
+					}
 				}
-			}
-			#endif
+				#endif
 
-			#if ( INCLUDE_vTaskSuspend == 1 )
-			{
-				if( listLIST_IS_EMPTY( &xSuspendedTaskList ) == pdFALSE )
+				if( pullTotalRunTime != NULL )
 				{
-					prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) &xSuspendedTaskList, tskSUSPENDED_CHAR );
+					#if ( configGENERATE_RUN_TIME_STATS == 1 )
+					{
+						*pullTotalRunTime = ullTotalRunTime;
+					}
+					#else
+					{
+						*pullTotalRunTime = 0ULL;
+					}
+					#endif
 				}
 			}
-			#endif
 		}
-		xTaskResumeAll();
+		( void ) xTaskResumeAll();
+
+		return uxTask;
 	}
 
 #endif
 /*----------------------------------------------------------*/
 
-#if ( configGENERATE_RUN_TIME_STATS == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configGENERATE_RUN_TIME_STATS == 1 ) )
 
-	void vTaskGetRunTimeStats( signed char *pcWriteBuffer )
+	static xTaskStatusType *prvTakeTaskStatusSnapshot( unsigned portBASE_TYPE *puxArraySize, unsigned long long *pullTotalRunTime )
 	{
-	unsigned portBASE_TYPE uxQueue;
-	unsigned long ulTotalRunTime;
+	xTaskStatusType *pxTaskStatusArray = NULL;
+	unsigned portBASE_TYPE uxArraySize, uxAttempt;
 
-		/* This is a VERY costly function that should be used for debug only.
-		It leaves interrupts disabled for a LONG time. */
-
-		vTaskSuspendAll();
+		/* A task created between reading the number of tasks and taking the
+		snapshot would make the array too small, so allow a spare entry and
+		try a second time if even that was not enough. */
+		for( uxAttempt = 0U; ( uxAttempt < 2U ) && ( pxTaskStatusArray == NULL ); uxAttempt++ )
 		{
-			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-			#else
-				ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-			#endif
-
-			/* Divide ulTotalRunTime by 100 to make the percentage caluclations
-			simpler in the prvGenerateRunTimeStatsForTasksInList() function. */
-			ulTotalRunTime /= 100UL;
-			
-			/* Run through all the lists that could potentially contain a TCB,
-			generating a table of run timer percentages in the provided
-			buffer. */
-
-			*pcWriteBuffer = ( signed char ) 0x00;
-			strcat( ( char * ) pcWriteBuffer, ( const char * ) "\r\n" );
+			uxArraySize = uxCurrentNumberOfTasks + ( unsigned portBASE_TYPE ) 1U;
+			pxTaskStatusArray = ( xTaskStatusType * ) pvPortMalloc( uxArraySize * sizeof( xTaskStatusType ) );
 
-			uxQueue = uxTopUsedPriority + ( unsigned portBASE_TYPE ) 1U;
-
-			do
+			if( pxTaskStatusArray != NULL )
 			{
-				uxQueue--;
+				*puxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, pullTotalRunTime );
 
-				if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxQueue ] ) ) == pdFALSE )
+				if( *puxArraySize == ( unsigned portBASE_TYPE ) 0U )
 				{
-					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) &( pxReadyTasksLists[ uxQueue ] ), ulTotalRunTime );
+					vPortFree( pxTaskStatusArray );
+					pxTaskStatusArray = NULL;
 				}
-			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
-
-			if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
-			{
-				prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, ulTotalRunTime );
 			}
+		}
 
-			if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
-			{
-				prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, ulTotalRunTime );
-			}
+		return pxTaskStatusArray;
+	}
 
-			#if ( INCLUDE_vTaskDelete == 1 )
-			{
-				if( listLIST_IS_EMPTY( &xTasksWaitingTermination ) == pdFALSE )
-				{
-					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) &xTasksWaitingTermination, ulTotalRunTime );
-				}
-			}
-			#endif
+#endif
+/*----------------------------------------------------------*/
 
-			#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vTaskList( signed char *pcWriteBuffer )
+	{
+	xTaskStatusType *pxTaskStatusArray;
+	unsigned portBASE_TYPE uxArraySize, x;
+	signed char cStatus;
+
+		/* This is a costly function that should be used for debug only.  The
+		scheduler is only suspended while the snapshot is taken - the text is
+		formatted afterwards. */
+
+		*pcWriteBuffer = ( signed char ) 0x00;
+		strcat( ( char * ) pcWriteBuffer, ( const char * ) "\r\n" );
+
+		pxTaskStatusArray = prvTakeTaskStatusSnapshot( &uxArraySize, NULL );
+
+		if( pxTaskStatusArray != NULL )
+		{
+			/* Report the task name, state, priority, stack high water mark
+			and task number of each task, in human readable form. */
+			for( x = 0; x < uxArraySize; x++ )
 			{
-				if( listLIST_IS_EMPTY( &xSuspendedTaskList ) == pdFALSE )
+				switch( pxTaskStatusArray[ x ].eCurrentState )
 				{
-					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) &xSuspendedTaskList, ulTotalRunTime );
+					case eBlocked:		cStatus = tskBLOCKED_CHAR;
+										break;
+
+					case eSuspended:	cStatus = tskSUSPENDED_CHAR;
+										break;
+
+					case eDeleted:		cStatus = tskDELETED_CHAR;
+										break;
+
+					case eRunning:
+					case eReady:
+					default:			cStatus = tskREADY_CHAR;
+										break;
 				}
+
+				sprintf( pcStatusString, ( char * ) "%s\t\t%c\t%u\t%u\t%u\r\n", pxTaskStatusArray[ x ].pcTaskName, cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber );
+				strcat( ( char * ) pcWriteBuffer, ( char * ) pcStatusString );
 			}
-			#endif
+
+			vPortFree( pxTaskStatusArray );
+		}
+		else
+		{
+			strcat( ( char * ) pcWriteBuffer, tskSNAPSHOT_ERROR_STRING );
 		}
-		xTaskResumeAll();
 	}
 
 #endif
 /*----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-	void vTaskStartTrace( signed char * pcBuffer, unsigned long ulBufferSize )
+	void vTaskGetRunTimeStats( signed char *pcWriteBuffer )
+	{
+	xTaskStatusType *pxTaskStatusArray;
+	unsigned portBASE_TYPE uxArraySize, x;
+	unsigned long long ullTotalTime, ullTotalRunTimeDiv100;
+	unsigned long ulStatsAsPercentage, ulHigh, ulLow;
+	char cCounterString[ 21 ];
+
+		/* This is a costly function that should be used for debug only.  The
+		scheduler is only suspended while the snapshot is taken - the text is
+		formatted afterwards. */
+
+		*pcWriteBuffer = ( signed char ) 0x00;
+		strcat( ( char * ) pcWriteBuffer, ( const char * ) "\r\n" );
+
+		pxTaskStatusArray = prvTakeTaskStatusSnapshot( &uxArraySize, &ullTotalTime );
+
+		if( pxTaskStatusArray != NULL )
+		{
+			/* Divide the total run time by 100 to make the percentage
+			calculations simpler. */
+			ullTotalRunTimeDiv100 = ullTotalTime / 100ULL;
+
+			/* Divide by zero check. */
+			if( ullTotalRunTimeDiv100 > 0ULL )
+			{
+				for( x = 0; x < uxArraySize; x++ )
+				{
+					/* The counter is 64 bits but a small printf() library may
+					not support long long conversions, so print it as two
+					halves of up to nine decimal digits each. */
+					ulHigh = ( unsigned long ) ( pxTaskStatusArray[ x ].ullRunTimeCounter / 1000000000ULL );
+					ulLow = ( unsigned long ) ( pxTaskStatusArray[ x ].ullRunTimeCounter % 1000000000ULL );
+
+					#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+					{
+						if( ulHigh > 0UL )
+						{
+							sprintf( cCounterString, "%lu%09lu", ulHigh, ulLow );
+						}
+						else
+						{
+							sprintf( cCounterString, "%lu", ulLow );
+						}
+					}
+					#else
+					{
+						/* sizeof( int ) == sizeof( long ) so a smaller
+						printf() library can be used. */
+						if( ulHigh > 0UL )
+						{
+							sprintf( cCounterString, "%u%09u", ( unsigned int ) ulHigh, ( unsigned int ) ulLow );
+						}
+						else
+						{
+							sprintf( cCounterString, "%u", ( unsigned int ) ulLow );
+						}
+					}
+					#endif
+
+					/* What percentage of the total run time has the task used?
+					This will always be rounded down to the nearest integer.
+					ullTotalRunTimeDiv100 has already been divided by 100. */
+					ulStatsAsPercentage = ( unsigned long ) ( pxTaskStatusArray[ x ].ullRunTimeCounter / ullTotalRunTimeDiv100 );
+
+					if( ( ulStatsAsPercentage > 0UL ) || ( pxTaskStatusArray[ x ].ullRunTimeCounter == 0ULL ) )
+					{
+						sprintf( pcStatsString, ( char * ) "%s\t\t%s\t\t%u%%\r\n", pxTaskStatusArray[ x ].pcTaskName, cCounterString, ( unsigned int ) ulStatsAsPercentage );
+					}
+					else
+					{
+						/* If the percentage is zero here then the task has
+						consumed less than 1% of the total run time. */
+						sprintf( pcStatsString, ( char * ) "%s\t\t%s\t\t<1%%\r\n", pxTaskStatusArray[ x ].pcTaskName, cCounterString );
+					}
+
+					strcat( ( char * ) pcWriteBuffer, ( char * ) pcStatsString );
+				}
+			}
+
+			vPortFree( pxTaskStatusArray );
+		}
+		else
+		{
+			strcat( ( char * ) pcWriteBuffer, tskSNAPSHOT_ERROR_STRING );
+		}
+	}
+
+#endif
+/*----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	unsigned portBASE_TYPE uxTaskGetIdleRunTimePercent( void )
+	{
+	unsigned long ulIdleRunTime, ulWindowLength;
+
+		taskENTER_CRITICAL();
+		{
+			ulWindowLength = ulRunTimeLastWindowLength;
+
+			if( xIdleTaskHandle != NULL )
+			{
+				ulIdleRunTime = prvRunTimeInLastWindow( ( tskTCB * ) xIdleTaskHandle );
+			}
+			else
+			{
+				ulIdleRunTime = 0UL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( ulWindowLength == 0UL )
+		{
+			/* No load window has completed yet. */
+			return ( unsigned portBASE_TYPE ) 0U;
+		}
+
+		return ( unsigned portBASE_TYPE ) ( ( ( unsigned long long ) ulIdleRunTime * 100ULL ) / ( unsigned long long ) ulWindowLength );
+	}
+
+#endif
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vTaskStartTrace( signed char * pcBuffer, unsigned long ulBufferSize )
 	{
 		configASSERT( pcBuffer );
 		configASSERT( ulBufferSize );
@@ -1471,42 +1987,73 @@ tskTCB * pxTCB;
 	/* Called by the portable layer each time a tick interrupt occurs.
 	Increments the tick then checks to see if the new tick value will cause any
 	tasks to be unblocked. */
+	traceTASK_INCREMENT_TICK( xTickCount );
 	if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
 	{
 		++xTickCount;
-		if( xTickCount == ( portTickType ) 0 )
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
-			xList *pxTemp;
+			if( ( portTickType ) ( xTickCount - xRunTimeWindowStartTick ) >= ( portTickType ) configRUN_TIME_STATS_WINDOW_TICKS )
+			{
+				/* Close the load window.  The running task is accounted up
+				to now so none of its time is carried into the next window,
+				however long it has been since it was switched in. */
+				prvUpdateRunTimeCounters();
+				ulRunTimeLastWindowLength = ( unsigned long ) ( ullTotalRunTime - ullRunTimeWindowStart );
+				ullRunTimeWindowStart = ullTotalRunTime;
+				ulRunTimeWindow++;
+				xRunTimeWindowStartTick = xTickCount;
+			}
+		}
+		#endif
 
-			/* Tick count has overflowed so we need to swap the delay lists.
-			If there are any items in pxDelayedTaskList here then there is
-			an error! */
-			configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );
-			
-			pxTemp = pxDelayedTaskList;
-			pxDelayedTaskList = pxOverflowDelayedTaskList;
-			pxOverflowDelayedTaskList = pxTemp;
-			xNumOfOverflows++;
-	
-			if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+		#if ( configUSE_TIMING_WHEEL == 1 )
+		{
+			/* The wheel holds the wake times that have overflowed itself, so
+			there are no lists to swap. */
+			if( xTickCount == ( portTickType ) 0 )
 			{
-				/* The new current delayed list is empty.  Set 
-				xNextTaskUnblockTime to the maximum possible value so it is 
-				extremely unlikely that the	
-				if( xTickCount >= xNextTaskUnblockTime ) test will pass until 
-				there is an item in the delayed list. */
-				xNextTaskUnblockTime = portMAX_DELAY;
+				xNumOfOverflows++;
 			}
-			else
+		}
+		#else
+		{
+			if( xTickCount == ( portTickType ) 0 )
 			{
-				/* The new current delayed list is not empty, get the value of 
-				the item at the head of the delayed list.  This is the time at 
-				which the task at the head of the delayed list should be removed 
-				from the Blocked state. */
-				pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
-				xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) );
+				xList *pxTemp;
+
+				/* Tick count has overflowed so we need to swap the delay lists.
+				If there are any items in pxDelayedTaskList here then there is
+				an error! */
+				configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );
+			
+				pxTemp = pxDelayedTaskList;
+				pxDelayedTaskList = pxOverflowDelayedTaskList;
+				pxOverflowDelayedTaskList = pxTemp;
+				xNumOfOverflows++;
+	
+				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+				{
+					/* The new current delayed list is empty.  Set 
+					xNextTaskUnblockTime to the maximum possible value so it is 
+					extremely unlikely that the	
+					if( xTickCount >= xNextTaskUnblockTime ) test will pass until 
+					there is an item in the delayed list. */
+					xNextTaskUnblockTime = portMAX_DELAY;
+				}
+				else
+				{
+					/* The new current delayed list is not empty, get the value of 
+					the item at the head of the delayed list.  This is the time at 
+					which the task at the head of the delayed list should be removed 
+					from the Blocked state. */
+					pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+					xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) );
+				}
 			}
 		}
+		#endif /* configUSE_TIMING_WHEEL */
 
 		/* See if this tick has made a timeout expire. */
 		prvCheckDelayedTasks();
@@ -1539,6 +2086,30 @@ tskTCB * pxTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	void vTaskStepTick( portTickType xTicksToJump )
+	{
+		/* Correct the tick count value after a period during which the tick
+		was suppressed.  Note this does *not* call the tick hook function for
+		each stepped tick.  The port guarantees the jump never passes the time
+		at which the next task is due to leave the Blocked state, so there are
+		no delayed tasks to check here. */
+		#if ( configUSE_TIMING_WHEEL == 1 )
+		{
+			vTimingWheelSkip( &xDelayedTaskWheel, xTicksToJump );
+		}
+		#else
+		{
+			configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+		}
+		#endif
+		xTickCount += xTicksToJump;
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_vTaskCleanUpResources == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
 
 	void vTaskCleanUpResources( void )
@@ -1562,23 +2133,43 @@ tskTCB * pxTCB;
 			}
 		}while( usQueue > ( unsigned short ) tskIDLE_PRIORITY );
 
-		/* Remove any TCB's from the delayed queue. */
-		while( listLIST_IS_EMPTY( &xDelayedTaskList1 ) == pdFALSE )
+		#if ( configUSE_TIMING_WHEEL == 1 )
 		{
-			listGET_OWNER_OF_NEXT_ENTRY( pxTCB, &xDelayedTaskList1 );
-			vListRemove( ( xListItem * ) &( pxTCB->xGenericListItem ) );
+		unsigned portBASE_TYPE uxSlot;
 
-			prvDeleteTCB( ( tskTCB * ) pxTCB );
-		}
+			/* Remove any TCB's from the delayed task wheel. */
+			for( uxSlot = 0; uxSlot < ( unsigned portBASE_TYPE ) wheelNUMBER_OF_SLOTS; uxSlot++ )
+			{
+				while( listLIST_IS_EMPTY( wheelGET_SLOT( &xDelayedTaskWheel, uxSlot ) ) == pdFALSE )
+				{
+					listGET_OWNER_OF_NEXT_ENTRY( pxTCB, wheelGET_SLOT( &xDelayedTaskWheel, uxSlot ) );
+					vListRemove( ( xListItem * ) &( pxTCB->xGenericListItem ) );
 
-		/* Remove any TCB's from the overflow delayed queue. */
-		while( listLIST_IS_EMPTY( &xDelayedTaskList2 ) == pdFALSE )
+					prvDeleteTCB( ( tskTCB * ) pxTCB );
+				}
+			}
+		}
+		#else
 		{
-			listGET_OWNER_OF_NEXT_ENTRY( pxTCB, &xDelayedTaskList2 );
-			vListRemove( ( xListItem * ) &( pxTCB->xGenericListItem ) );
+			/* Remove any TCB's from the delayed queue. */
+			while( listLIST_IS_EMPTY( &xDelayedTaskList1 ) == pdFALSE )
+			{
+				listGET_OWNER_OF_NEXT_ENTRY( pxTCB, &xDelayedTaskList1 );
+				vListRemove( ( xListItem * ) &( pxTCB->xGenericListItem ) );
 
-			prvDeleteTCB( ( tskTCB * ) pxTCB );
+				prvDeleteTCB( ( tskTCB * ) pxTCB );
+			}
+
+			/* Remove any TCB's from the overflow delayed queue. */
+			while( listLIST_IS_EMPTY( &xDelayedTaskList2 ) == pdFALSE )
+			{
+				listGET_OWNER_OF_NEXT_ENTRY( pxTCB, &xDelayedTaskList2 );
+				vListRemove( ( xListItem * ) &( pxTCB->xGenericListItem ) );
+
+				prvDeleteTCB( ( tskTCB * ) pxTCB );
+			}
 		}
+		#endif
 
 		while( listLIST_IS_EMPTY( &xSuspendedTaskList ) == pdFALSE )
 		{
@@ -1693,37 +2284,18 @@ void vTaskSwitchContext( void )
 	
 		#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
-			unsigned long ulTempCounter;
-			
-				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-					portALT_GET_RUN_TIME_COUNTER_VALUE( ulTempCounter );
-				#else
-					ulTempCounter = portGET_RUN_TIME_COUNTER_VALUE();
-				#endif
-	
-				/* Add the amount of time the task has been running to the accumulated
-				time so far.  The time the task started running was stored in
-				ulTaskSwitchedInTime.  Note that there is no overflow protection here
-				so count values are only valid until the timer overflows.  Generally
-				this will be about 1 hour assuming a 1uS timer increment. */
-				pxCurrentTCB->ulRunTimeCounter += ( ulTempCounter - ulTaskSwitchedInTime );
-				ulTaskSwitchedInTime = ulTempCounter;
+			/* Add the amount of time the task has been running to the
+			accumulated time so far. */
+			prvUpdateRunTimeCounters();
 		}
 		#endif
 	
 		taskFIRST_CHECK_FOR_STACK_OVERFLOW();
 		taskSECOND_CHECK_FOR_STACK_OVERFLOW();
 	
-		/* Find the highest priority queue that contains ready tasks. */
-		while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) )
-		{
-			configASSERT( uxTopReadyPriority );
-			--uxTopReadyPriority;
-		}
-	
-		/* listGET_OWNER_OF_NEXT_ENTRY walks through the list, so the tasks of the
-		same priority get an equal share of the processor time. */
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopReadyPriority ] ) );
+		/* Select a new task to run using either the generic C or port
+		optimised method. */
+		taskSELECT_HIGHEST_PRIORITY_TASK();
 	
 		traceTASK_SWITCHED_IN();
 		vWriteTraceToBuffer();
@@ -1749,6 +2321,7 @@ portTickType xTimeToWake;
 	to the blocked list as the same list item is used for both lists.  We have
 	exclusive access to the ready lists as the scheduler is locked. */
 	vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+	taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
 
 
 	#if ( INCLUDE_vTaskSuspend == 1 )
@@ -1803,6 +2376,7 @@ portTickType xTimeToWake;
 		blocked list as the same list item is used for both lists.  This
 		function is called form a critical section. */
 		vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
 
 		/* Calculate the time at which the task should be woken if the event does
 		not occur.  This may overflow but this doesn't matter. */
@@ -1864,6 +2438,117 @@ portBASE_TYPE xReturn;
 }
 /*-----------------------------------------------------------*/
 
+void vTaskPlaceOnUnorderedEventList( xList * pxEventList, portTickType xItemValue, portTickType xTicksToWait )
+{
+portTickType xTimeToWake;
+
+	configASSERT( pxEventList );
+
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+	the event group implementation. */
+	configASSERT( uxSchedulerSuspended != 0 );
+
+	/* Store the item value in the event list item.  It is safe to access the
+	event list item here as interrupts won't access the event list item of a
+	task that is not in the Blocked state.  The in use bit stops the priority
+	functions overwriting the value while the task is waiting. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	/* Place the event list item of the TCB at the end of the event list.  It
+	is safe to access the event list here because interrupts don't access event
+	groups directly - instead they pend a function call to the timer task. */
+	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+	/* The task must be removed from the ready list before it is added to the
+	blocked list.  Exclusive access can be assured to the ready list as the
+	scheduler is locked. */
+	vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+	taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
+
+	#if ( INCLUDE_vTaskSuspend == 1 )
+	{
+		if( xTicksToWait == portMAX_DELAY )
+		{
+			/* Add the task to the suspended task list instead of a delayed task
+			list to ensure it is not woken by a timing event.  It will block
+			indefinitely. */
+			vListInsertEnd( ( xList * ) &xSuspendedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		}
+		else
+		{
+			/* Calculate the time at which the task should be woken if the event does
+			not occur.  This may overflow but this doesn't matter. */
+			xTimeToWake = xTickCount + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
+		}
+	}
+	#else
+	{
+			/* Calculate the time at which the task should be woken if the event does
+			not occur.  This may overflow but this doesn't matter. */
+			xTimeToWake = xTickCount + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem * pxEventListItem, portTickType xItemValue )
+{
+tskTCB *pxUnblockedTCB;
+portBASE_TYPE xReturn;
+
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+	the event group implementation. */
+	configASSERT( uxSchedulerSuspended != 0 );
+
+	/* Store the new item value in the event list item, so the unblocked task
+	can see which bits unblocked it. */
+	listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	/* Remove the event list item from the event list.  Interrupts do not
+	access event groups. */
+	pxUnblockedTCB = ( tskTCB * ) pxEventListItem->pvOwner;
+	configASSERT( pxUnblockedTCB );
+	vListRemove( pxEventListItem );
+
+	/* Remove the task from the delayed list and add it to the ready list.  The
+	scheduler is suspended so interrupts will not be accessing the ready
+	lists. */
+	vListRemove( &( pxUnblockedTCB->xGenericListItem ) );
+	prvAddTaskToReadyQueue( pxUnblockedTCB );
+
+	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	{
+		/* Return true if the task removed from the event list has a higher
+		priority than the calling task.  The context switch is performed when
+		the scheduler is resumed. */
+		xReturn = pdTRUE;
+		xMissedYield = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portTickType uxTaskResetEventItemValue( void )
+{
+portTickType uxReturn;
+
+	uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+
+	/* Reset the event list item to its normal value - so it can be used with
+	queues and semaphores. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority ) );
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( xTimeOutType * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -1984,8 +2669,92 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			vApplicationIdleHook();
 		}
 		#endif
+
+		/* This conditional compilation should use inequality to 0, not equality
+		to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
+		user defined low power mode	implementations require
+		configUSE_TICKLESS_IDLE to be set to a value other than 1. */
+		#if ( configUSE_TICKLESS_IDLE != 0 )
+		{
+		portTickType xExpectedIdleTime;
+
+			/* It is not desirable to suspend then resume the scheduler on
+			each iteration of the idle task.  Therefore, a preliminary test of
+			the expected idle time is performed without the scheduler
+			suspended.  The result here is not necessarily valid. */
+			xExpectedIdleTime = prvGetExpectedIdleTime();
+
+			if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+			{
+				vTaskSuspendAll();
+				{
+					/* Now the scheduler is suspended, the expected idle
+					time can be sampled again, and this time its value can
+					be used. */
+					#if ( configUSE_TIMING_WHEEL == 0 )
+					{
+						configASSERT( xNextTaskUnblockTime >= xTickCount );
+					}
+					#endif
+					xExpectedIdleTime = prvGetExpectedIdleTime();
+
+					if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+					{
+						portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+					}
+				}
+				xTaskResumeAll();
+			}
+		}
+		#endif /* configUSE_TICKLESS_IDLE */
 	}
 } /*lint !e715 pvParameters is not accessed but all task functions require the same prototype. */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+	{
+	eSleepModeStatus eReturn = eStandardSleep;
+
+		/* This function must be called from a critical section with the
+		scheduler suspended. */
+		if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+		{
+			/* A task was made ready while the scheduler was suspended. */
+			eReturn = eAbortSleep;
+		}
+		else if( xMissedYield != pdFALSE )
+		{
+			/* A yield was pended while the scheduler was suspended. */
+			eReturn = eAbortSleep;
+		}
+		else if( uxMissedTicks != ( unsigned portBASE_TYPE ) 0 )
+		{
+			/* A tick occurred after the expected idle time was calculated,
+			so the calculation is now stale. */
+			eReturn = eAbortSleep;
+		}
+		else
+		{
+			#if ( INCLUDE_vTaskSuspend == 1 )
+			{
+				/* If all the tasks other than the idle task are in the
+				suspended list (which also holds tasks blocked with an infinite
+				timeout) then it is safe to shut down all clocks and wait for a
+				reset or an external interrupt. */
+				if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - ( unsigned portBASE_TYPE ) 1 ) )
+				{
+					eReturn = eNoTasksWaitingTimeout;
+				}
+			}
+			#endif /* INCLUDE_vTaskSuspend */
+		}
+
+		return eReturn;
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
 
 
 
@@ -2021,6 +2790,9 @@ static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const
 	#if ( configUSE_MUTEXES == 1 )
 	{
 		pxTCB->uxBasePriority = uxPriority;
+		vListInitialise( &( pxTCB->xMutexesHeld ) );
+		pxTCB->pxMutexWaitedOn = NULL;
+		pxTCB->pxMutexWaitList = NULL;
 	}
 	#endif
 
@@ -2049,7 +2821,17 @@ static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const
 
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 	{
-		pxTCB->ulRunTimeCounter = 0UL;
+		pxTCB->ullRunTimeCounter = 0ULL;
+		pxTCB->ulRunTimeThisWindow = 0UL;
+		pxTCB->ulRunTimeLastWindow = 0UL;
+		pxTCB->ulRunTimeWindow = ulRunTimeWindow;
+	}
+	#endif
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+	{
+		pxTCB->ulNotifiedValue = 0UL;
+		pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
 	}
 	#endif
 
@@ -2094,8 +2876,17 @@ unsigned portBASE_TYPE uxPriority;
 		vListInitialise( ( xList * ) &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( ( xList * ) &xDelayedTaskList1 );
-	vListInitialise( ( xList * ) &xDelayedTaskList2 );
+	#if ( configUSE_TIMING_WHEEL == 1 )
+	{
+		vTimingWheelInitialise( &xDelayedTaskWheel, xTickCount );
+	}
+	#else
+	{
+		vListInitialise( ( xList * ) &xDelayedTaskList1 );
+		vListInitialise( ( xList * ) &xDelayedTaskList2 );
+	}
+	#endif
+
 	vListInitialise( ( xList * ) &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -2110,10 +2901,14 @@ unsigned portBASE_TYPE uxPriority;
 	}
 	#endif
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if ( configUSE_TIMING_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the
+		pxOverflowDelayedTaskList using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -2157,34 +2952,103 @@ static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
 	/* The list item will be inserted in wake time order. */
 	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
 
-	if( xTimeToWake < xTickCount )
+	#if ( configUSE_TIMING_WHEEL == 1 )
 	{
-		/* Wake time has overflowed.  Place this item in the overflow list. */
-		vListInsert( ( xList * ) pxOverflowDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		/* The time taken does not depend on the number of delayed tasks, and
+		wake times that have overflowed are handled by the wheel itself. */
+		vTimingWheelInsert( &xDelayedTaskWheel, &( pxCurrentTCB->xGenericListItem ) );
 	}
-	else
+	#else
 	{
-		/* The wake time has not overflowed, so we can use the current block list. */
-		vListInsert( ( xList * ) pxDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
-
-		/* If the task entering the blocked state was placed at the head of the
-		list of blocked tasks then xNextTaskUnblockTime needs to be updated
-		too. */
-		if( xTimeToWake < xNextTaskUnblockTime )
+		if( xTimeToWake < xTickCount )
+		{
+			/* Wake time has overflowed.  Place this item in the overflow list. */
+			vListInsert( ( xList * ) pxOverflowDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		}
+		else
 		{
-			xNextTaskUnblockTime = xTimeToWake;
+			/* The wake time has not overflowed, so we can use the current block list. */
+			vListInsert( ( xList * ) pxDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+
+			/* If the task entering the blocked state was placed at the head of the
+			list of blocked tasks then xNextTaskUnblockTime needs to be updated
+			too. */
+			if( xTimeToWake < xNextTaskUnblockTime )
+			{
+				xNextTaskUnblockTime = xTimeToWake;
+			}
 		}
 	}
+	#endif /* configUSE_TIMING_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer )
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	static portTickType prvGetExpectedIdleTime( void )
+	{
+	portTickType xReturn;
+
+		if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
+		{
+			/* A task other than the idle task is running, so the idle task
+			has only just been preempted or is about to be. */
+			xReturn = 0;
+		}
+		else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1 )
+		{
+			/* There are other idle priority tasks in the ready state.  If
+			time slicing is used then the very next tick interrupt must be
+			processed. */
+			xReturn = 0;
+		}
+		else
+		{
+			/* Software timers are not considered separately because the timer
+			service task blocks on its command queue with a timeout that
+			expires when the next timer is due, so the next timer expiry is
+			already reflected in the delayed task list. */
+			#if ( configUSE_TIMING_WHEEL == 1 )
+			{
+				/* The wheel is not always accessed with the scheduler
+				suspended here, so must be protected from the tick interrupt.
+				The time is the time to the next cascade if that is sooner
+				than the next wake time, so the processor may wake before it
+				strictly needs to. */
+				taskENTER_CRITICAL();
+				{
+					xReturn = xTimingWheelTicksToNextEvent( &xDelayedTaskWheel );
+				}
+				taskEXIT_CRITICAL();
+			}
+			#else
+			{
+				xReturn = xNextTaskUnblockTime - xTickCount;
+			}
+			#endif
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer, tskTCB *pxTCBBuffer )
 {
 tskTCB *pxNewTCB;
 
-	/* Allocate space for the TCB.  Where the memory comes from depends on
-	the implementation of the port malloc function. */
-	pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
+	if( pxTCBBuffer != NULL )
+	{
+		/* The application provided the memory for the TCB. */
+		pxNewTCB = pxTCBBuffer;
+	}
+	else
+	{
+		/* Allocate space for the TCB.  Where the memory comes from depends on
+		the implementation of the port malloc function. */
+		pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
+	}
 
 	if( pxNewTCB != NULL )
 	{
@@ -2196,13 +3060,35 @@ tskTCB *pxNewTCB;
 		if( pxNewTCB->pxStack == NULL )
 		{
 			/* Could not allocate the stack.  Delete the allocated TCB. */
-			vPortFree( pxNewTCB );
+			if( pxTCBBuffer == NULL )
+			{
+				vPortFree( pxNewTCB );
+			}
 			pxNewTCB = NULL;
 		}
 		else
 		{
 			/* Just to help debugging. */
 			memset( pxNewTCB->pxStack, tskSTACK_FILL_BYTE, usStackDepth * sizeof( portSTACK_TYPE ) );
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				/* Remember which memory the kernel is responsible for
+				freeing should the task be deleted. */
+				if( pxTCBBuffer != NULL )
+				{
+					pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+				}
+				else if( puxStackBuffer != NULL )
+				{
+					pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_ONLY;
+				}
+				else
+				{
+					pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
+				}
+			}
+			#endif
 		}
 	}
 
@@ -2210,32 +3096,117 @@ tskTCB *pxNewTCB;
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configGENERATE_RUN_TIME_STATS == 1 ) )
 
-	static void prvListTaskWithinSingleList( const signed char *pcWriteBuffer, xList *pxList, signed char cStatus )
+	static unsigned portBASE_TYPE prvListTasksWithinSingleList( xTaskStatusType *pxTaskStatusArray, xList *pxList, eTaskState eState )
 	{
 	volatile tskTCB *pxNextTCB, *pxFirstTCB;
-	unsigned short usStackRemaining;
+	unsigned portBASE_TYPE uxTask = 0;
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		unsigned long ulWindowRunTime, ulWindowLength;
+	#endif
 
-		/* Write the details of all the TCB's in pxList into the buffer. */
+		/* Fill in a structure for each TCB in pxList. */
 		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
 		do
 		{
 			listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+
+			pxTaskStatusArray[ uxTask ].xHandle = ( xTaskHandle ) pxNextTCB;
+			pxTaskStatusArray[ uxTask ].pcTaskName = ( const signed char * ) &( pxNextTCB->pcTaskName[ 0 ] );
+			pxTaskStatusArray[ uxTask ].eCurrentState = eState;
+			pxTaskStatusArray[ uxTask ].uxCurrentPriority = pxNextTCB->uxPriority;
+
+			if( pxNextTCB == pxCurrentTCB )
+			{
+				pxTaskStatusArray[ uxTask ].eCurrentState = eRunning;
+			}
+			else if( eState == eSuspended )
+			{
+				/* A task that is blocked with no time out is held in the
+				suspended list too, but is still waiting on an event list or
+				for a notification. */
+				if( pxNextTCB->xEventListItem.pvContainer != NULL )
+				{
+					pxTaskStatusArray[ uxTask ].eCurrentState = eBlocked;
+				}
+
+				#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+				{
+					if( pxNextTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+					{
+						pxTaskStatusArray[ uxTask ].eCurrentState = eBlocked;
+					}
+				}
+				#endif
+			}
+
+			#if ( configUSE_TRACE_FACILITY == 1 )
+			{
+				pxTaskStatusArray[ uxTask ].xTaskNumber = pxNextTCB->uxTCBNumber;
+			}
+			#else
+			{
+				pxTaskStatusArray[ uxTask ].xTaskNumber = ( unsigned portBASE_TYPE ) 0U;
+			}
+			#endif
+
+			#if ( configUSE_MUTEXES == 1 )
+			{
+				pxTaskStatusArray[ uxTask ].uxBasePriority = pxNextTCB->uxBasePriority;
+			}
+			#else
+			{
+				pxTaskStatusArray[ uxTask ].uxBasePriority = pxNextTCB->uxPriority;
+			}
+			#endif
+
+			#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			{
+				pxTaskStatusArray[ uxTask ].ullRunTimeCounter = pxNextTCB->ullRunTimeCounter;
+
+				/* The window counters are rolled by the tick interrupt. */
+				taskENTER_CRITICAL();
+				{
+					ulWindowRunTime = prvRunTimeInLastWindow( ( const tskTCB * ) pxNextTCB );
+					ulWindowLength = ulRunTimeLastWindowLength;
+				}
+				taskEXIT_CRITICAL();
+
+				pxTaskStatusArray[ uxTask ].ulWindowRunTime = ulWindowRunTime;
+
+				if( ulWindowLength > 0UL )
+				{
+					pxTaskStatusArray[ uxTask ].uxWindowLoad = ( unsigned portBASE_TYPE ) ( ( ( unsigned long long ) ulWindowRunTime * 100ULL ) / ( unsigned long long ) ulWindowLength );
+				}
+				else
+				{
+					pxTaskStatusArray[ uxTask ].uxWindowLoad = ( unsigned portBASE_TYPE ) 0U;
+				}
+			}
+			#else
+			{
+				pxTaskStatusArray[ uxTask ].ullRunTimeCounter = 0ULL;
+				pxTaskStatusArray[ uxTask ].ulWindowRunTime = 0UL;
+				pxTaskStatusArray[ uxTask ].uxWindowLoad = ( unsigned portBASE_TYPE ) 0U;
+			}
+			#endif
+
 			#if ( portSTACK_GROWTH > 0 )
 			{
-				usStackRemaining = usTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxEndOfStack );
+				pxTaskStatusArray[ uxTask ].usStackHighWaterMark = usTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxEndOfStack );
 			}
 			#else
 			{
-				usStackRemaining = usTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxStack );
+				pxTaskStatusArray[ uxTask ].usStackHighWaterMark = usTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxStack );
 			}
-			#endif			
-			
-			sprintf( pcStatusString, ( char * ) "%s\t\t%c\t%u\t%u\t%u\r\n", pxNextTCB->pcTaskName, cStatus, ( unsigned int ) pxNextTCB->uxPriority, usStackRemaining, ( unsigned int ) pxNextTCB->uxTCBNumber );
-			strcat( ( char * ) pcWriteBuffer, ( char * ) pcStatusString );
+			#endif
+
+			uxTask++;
 
 		} while( pxNextTCB != pxFirstTCB );
+
+		return uxTask;
 	}
 
 #endif
@@ -2243,76 +3214,79 @@ tskTCB *pxNewTCB;
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-	static void prvGenerateRunTimeStatsForTasksInList( const signed char *pcWriteBuffer, xList *pxList, unsigned long ulTotalRunTime )
+	static void prvUpdateRunTimeCounters( void )
 	{
-	volatile tskTCB *pxNextTCB, *pxFirstTCB;
-	unsigned long ulStatsAsPercentage;
+	unsigned long ulTempCounter, ulDelta;
 
-		/* Write the run time stats of all the TCB's in pxList into the buffer. */
-		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
-		do
-		{
-			/* Get next TCB in from the list. */
-			listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulTempCounter );
+		#else
+			ulTempCounter = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
 
-			/* Divide by zero check. */
-			if( ulTotalRunTime > 0UL )
-			{
-				/* Has the task run at all? */
-				if( pxNextTCB->ulRunTimeCounter == 0 )
-				{
-					/* The task has used no CPU time at all. */
-					sprintf( pcStatsString, ( char * ) "%s\t\t0\t\t0%%\r\n", pxNextTCB->pcTaskName );
-				}
-				else
-				{
-					/* What percentage of the total run time has the task used?
-					This will always be rounded down to the nearest integer.
-					ulTotalRunTime has already been divided by 100. */
-					ulStatsAsPercentage = pxNextTCB->ulRunTimeCounter / ulTotalRunTime;
+		/* The time the task started running was stored in
+		ulTaskSwitchedInTime.  The unsigned subtraction gives the right answer
+		across a single wrap of the counter, and the tick interrupt calls this
+		function at least once per load window, so the counter only has to
+		be wider than one window rather than the whole up time. */
+		ulDelta = ulTempCounter - ulTaskSwitchedInTime;
+		ulTaskSwitchedInTime = ulTempCounter;
 
-					if( ulStatsAsPercentage > 0UL )
-					{
-						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-						{
-							sprintf( pcStatsString, ( char * ) "%s\t\t%lu\t\t%lu%%\r\n", pxNextTCB->pcTaskName, pxNextTCB->ulRunTimeCounter, ulStatsAsPercentage );							
-						}
-						#else
-						{
-							/* sizeof( int ) == sizeof( long ) so a smaller
-							printf() library can be used. */
-							sprintf( pcStatsString, ( char * ) "%s\t\t%u\t\t%u%%\r\n", pxNextTCB->pcTaskName, ( unsigned int ) pxNextTCB->ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage );
-						}
-						#endif
-					}
-					else
-					{
-						/* If the percentage is zero here then the task has
-						consumed less than 1% of the total run time. */
-						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-						{
-							sprintf( pcStatsString, ( char * ) "%s\t\t%lu\t\t<1%%\r\n", pxNextTCB->pcTaskName, pxNextTCB->ulRunTimeCounter );							
-						}
-						#else
-						{
-							/* sizeof( int ) == sizeof( long ) so a smaller
-							printf() library can be used. */
-							sprintf( pcStatsString, ( char * ) "%s\t\t%u\t\t<1%%\r\n", pxNextTCB->pcTaskName, ( unsigned int ) pxNextTCB->ulRunTimeCounter );
-						}
-						#endif
-					}
-				}
+		ullTotalRunTime += ( unsigned long long ) ulDelta;
+		pxCurrentTCB->ullRunTimeCounter += ( unsigned long long ) ulDelta;
 
-				strcat( ( char * ) pcWriteBuffer, ( char * ) pcStatsString );
+		if( pxCurrentTCB->ulRunTimeWindow != ulRunTimeWindow )
+		{
+			/* The task has not run since a window closed.  Its count for
+			the window it last ran in only belongs to the last complete
+			window if that was the window immediately before this one. */
+			if( pxCurrentTCB->ulRunTimeWindow == ( ulRunTimeWindow - 1UL ) )
+			{
+				pxCurrentTCB->ulRunTimeLastWindow = pxCurrentTCB->ulRunTimeThisWindow;
+			}
+			else
+			{
+				pxCurrentTCB->ulRunTimeLastWindow = 0UL;
 			}
 
-		} while( pxNextTCB != pxFirstTCB );
+			pxCurrentTCB->ulRunTimeThisWindow = 0UL;
+			pxCurrentTCB->ulRunTimeWindow = ulRunTimeWindow;
+		}
+
+		pxCurrentTCB->ulRunTimeThisWindow += ulDelta;
 	}
 
 #endif
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static unsigned long prvRunTimeInLastWindow( const tskTCB *pxTCB )
+	{
+	unsigned long ulReturn;
+
+		/* The window counters of a task are only rolled when it runs, so
+		work out which of them, if either, is the last complete window. */
+		if( pxTCB->ulRunTimeWindow == ulRunTimeWindow )
+		{
+			ulReturn = pxTCB->ulRunTimeLastWindow;
+		}
+		else if( pxTCB->ulRunTimeWindow == ( ulRunTimeWindow - 1UL ) )
+		{
+			ulReturn = pxTCB->ulRunTimeThisWindow;
+		}
+		else
+		{
+			ulReturn = 0UL;
+		}
+
+		return ulReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configGENERATE_RUN_TIME_STATS == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
 
 	static unsigned short usTaskCheckFreeStackSpace( const unsigned char * pucStackByte )
 	{
@@ -2366,8 +3340,25 @@ tskTCB *pxNewTCB;
 	{
 		/* Free up the memory allocated by the scheduler for the task.  It is up to
 		the task to free any memory allocated at the application level. */
-		vPortFreeAligned( pxTCB->pxStack );
-		vPortFree( pxTCB );
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			/* Only free the memory that was not supplied by the application. */
+			if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+			{
+				vPortFreeAligned( pxTCB->pxStack );
+				vPortFree( pxTCB );
+			}
+			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+			{
+				vPortFree( pxTCB );
+			}
+		}
+		#else
+		{
+			vPortFreeAligned( pxTCB->pxStack );
+			vPortFree( pxTCB );
+		}
+		#endif
 	}
 
 #endif
@@ -2421,33 +3412,127 @@ tskTCB *pxNewTCB;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( ( INCLUDE_vTaskPrioritySet == 1 ) || ( configUSE_MUTEXES == 1 ) )
+
+	static void prvSetTaskPriority( tskTCB *pxTCB, unsigned portBASE_TYPE uxNewPriority )
+	{
+	unsigned portBASE_TYPE uxPriorityUsedOnEntry;
+
+		/* Remember the ready list the task might be referenced from before its
+		uxPriority member is changed so the taskRESET_READY_PRIORITY() macro
+		can function correctly. */
+		uxPriorityUsedOnEntry = pxTCB->uxPriority;
+		pxTCB->uxPriority = uxNewPriority;
+
+		/* Only reset the event list item value if the value is not being used
+		for anything else. */
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0 )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( configMAX_PRIORITIES - ( portTickType ) uxNewPriority ) );
+
+			#if ( configUSE_MUTEXES == 1 )
+			{
+				/* The task at the head of a mutex's wait list sets the
+				priority the mutex holder inherits, so the list must be kept
+				in priority order. */
+				if( ( pxTCB->pxMutexWaitList != NULL ) && ( listIS_CONTAINED_WITHIN( pxTCB->pxMutexWaitList, &( pxTCB->xEventListItem ) ) ) )
+				{
+					vListRemove( &( pxTCB->xEventListItem ) );
+					vListInsert( pxTCB->pxMutexWaitList, &( pxTCB->xEventListItem ) );
+				}
+			}
+			#endif
+		}
+
+		/* If the task is in the blocked or suspended list we need do nothing
+		more than change it's priority variable. However, if the task is in a
+		ready list it needs to be removed and placed in the queue appropriate
+		to its new priority.  This is only called from within a critical
+		section or with the scheduler suspended, so the ready lists can be
+		changed here. */
+		if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xGenericListItem ) ) )
+		{
+			vListRemove( &( pxTCB->xGenericListItem ) );
+			taskRESET_READY_PRIORITY( uxPriorityUsedOnEntry );
+			prvAddTaskToReadyQueue( pxTCB );
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
-	void vTaskPriorityInherit( xTaskHandle * const pxMutexHolder )
+	static void prvUpdateMutexCeiling( xListItem *pxMutexItem, const xList *pxWaitingTasks )
 	{
-	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+	xList *pxMutexesHeld;
+	tskTCB *pxWaitingTCB;
+
+		/* The value is the inverse of the priority, as for event list items,
+		so the mutex with the highest priority waiter sorts first.  A mutex
+		nobody is waiting for contributes priority 0. */
+		if( listLIST_IS_EMPTY( pxWaitingTasks ) == pdFALSE )
+		{
+			pxWaitingTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxWaitingTasks );
+			listSET_LIST_ITEM_VALUE( pxMutexItem, configMAX_PRIORITIES - ( portTickType ) pxWaitingTCB->uxPriority );
+		}
+		else
+		{
+			listSET_LIST_ITEM_VALUE( pxMutexItem, ( portTickType ) configMAX_PRIORITIES );
+		}
+
+		pxMutexesHeld = ( xList * ) pxMutexItem->pvContainer;
+		if( pxMutexesHeld != NULL )
+		{
+			vListRemove( pxMutexItem );
+			vListInsert( pxMutexesHeld, pxMutexItem );
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
 
-		configASSERT( pxMutexHolder );
+	static void prvUpdateInheritedPriority( tskTCB *pxTCB )
+	{
+	unsigned portBASE_TYPE uxNewPriority, uxInheritedPriority;
+	xListItem *pxMutexItem;
 
-		if( pxTCB->uxPriority < pxCurrentTCB->uxPriority )
+		/* Each pass handles one task in the chain.  The walk stops at the
+		first task whose priority does not change, which also ends it if the
+		tasks in the chain are deadlocked on each other. */
+		while( pxTCB != NULL )
 		{
-			/* Adjust the mutex holder state to account for its new priority. */
-			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority );
+			uxNewPriority = pxTCB->uxBasePriority;
 
-			/* If the task being modified is in the ready state it will need to
-			be moved in to a new list. */
-			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xGenericListItem ) ) )
+			if( listLIST_IS_EMPTY( &( pxTCB->xMutexesHeld ) ) == pdFALSE )
 			{
-				vListRemove( &( pxTCB->xGenericListItem ) );
+				uxInheritedPriority = configMAX_PRIORITIES - ( unsigned portBASE_TYPE ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxTCB->xMutexesHeld ) );
+				if( uxInheritedPriority > uxNewPriority )
+				{
+					uxNewPriority = uxInheritedPriority;
+				}
+			}
 
-				/* Inherit the priority before being moved into the new list. */
-				pxTCB->uxPriority = pxCurrentTCB->uxPriority;
-				prvAddTaskToReadyQueue( pxTCB );
+			if( uxNewPriority == pxTCB->uxPriority )
+			{
+				break;
+			}
+
+			prvSetTaskPriority( pxTCB, uxNewPriority );
+
+			/* If the task is blocked on a mutex that is held, the holder of
+			that mutex inherits from it in turn. */
+			pxMutexItem = pxTCB->pxMutexWaitedOn;
+			if( ( pxMutexItem != NULL ) && ( pxMutexItem->pvContainer != NULL ) && ( listIS_CONTAINED_WITHIN( pxTCB->pxMutexWaitList, &( pxTCB->xEventListItem ) ) ) )
+			{
+				prvUpdateMutexCeiling( pxMutexItem, pxTCB->pxMutexWaitList );
+				pxTCB = ( tskTCB * ) pxMutexItem->pvOwner;
 			}
 			else
 			{
-				/* Just inherit the priority. */
-				pxTCB->uxPriority = pxCurrentTCB->uxPriority;
+				pxTCB = NULL;
 			}
 		}
 	}
@@ -2457,23 +3542,53 @@ tskTCB *pxNewTCB;
 
 #if ( configUSE_MUTEXES == 1 )
 
-	void vTaskPriorityDisinherit( xTaskHandle * const pxMutexHolder )
+	static void prvLeaveMutexWait( tskTCB *pxTCB )
 	{
-	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+	xListItem *pxMutexItem = pxTCB->pxMutexWaitedOn;
 
-		if( pxMutexHolder != NULL )
+		if( pxMutexItem != NULL )
 		{
-			if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+			pxTCB->pxMutexWaitedOn = NULL;
+
+			if( pxMutexItem->pvContainer != NULL )
 			{
-				/* We must be the running task to be able to give the mutex back.
-				Remove ourselves from the ready list we currently appear in. */
-				vListRemove( &( pxTCB->xGenericListItem ) );
+				prvUpdateMutexCeiling( pxMutexItem, pxTCB->pxMutexWaitList );
+				prvUpdateInheritedPriority( ( tskTCB * ) pxMutexItem->pvOwner );
+			}
 
-				/* Disinherit the priority before adding ourselves into the new
-				ready list. */
-				pxTCB->uxPriority = pxTCB->uxBasePriority;
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) pxTCB->uxPriority );
-				prvAddTaskToReadyQueue( pxTCB );
+			pxTCB->pxMutexWaitList = NULL;
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	void vTaskPriorityInherit( xListItem * const pxMutexItem, xList * const pxWaitingTasks )
+	{
+	xList *pxMutexesHeld;
+
+		configASSERT( pxMutexItem );
+
+		/* Remember the mutex the calling task is about to block on, so any
+		later change to its priority is passed on to the mutex holder. */
+		pxCurrentTCB->pxMutexWaitedOn = pxMutexItem;
+		pxCurrentTCB->pxMutexWaitList = pxWaitingTasks;
+
+		pxMutexesHeld = ( xList * ) pxMutexItem->pvContainer;
+		if( pxMutexesHeld != NULL )
+		{
+			if( listGET_LIST_ITEM_VALUE( pxMutexItem ) > ( configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority ) )
+			{
+				/* The calling task is about to become the highest priority
+				task waiting for the mutex.  It is not in the wait list yet, so
+				the value is set directly rather than from the list. */
+				listSET_LIST_ITEM_VALUE( pxMutexItem, configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority );
+				vListRemove( pxMutexItem );
+				vListInsert( pxMutexesHeld, pxMutexItem );
+
+				prvUpdateInheritedPriority( ( tskTCB * ) pxMutexItem->pvOwner );
 			}
 		}
 	}
@@ -2481,6 +3596,59 @@ tskTCB *pxNewTCB;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 )
+
+	void vTaskPriorityDisinherit( xListItem * const pxMutexItem )
+	{
+	tskTCB *pxTCB;
+
+		if( pxMutexItem->pvContainer != NULL )
+		{
+			/* Drop the mutex from its holder's list, then recalculate the
+			holder's priority from the mutexes it still holds. */
+			pxTCB = ( tskTCB * ) pxMutexItem->pvOwner;
+			vListRemove( pxMutexItem );
+			prvUpdateInheritedPriority( pxTCB );
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	void vTaskPriorityDisinheritAfterTimeout( xListItem * const pxMutexItem )
+	{
+		/* The calling task gave up waiting and is no longer in the wait
+		list, so the holder's priority is recalculated without it. */
+		if( pxCurrentTCB->pxMutexWaitedOn == pxMutexItem )
+		{
+			prvLeaveMutexWait( pxCurrentTCB );
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	void vTaskMutexTaken( xListItem * const pxMutexItem, const xList * const pxWaitingTasks )
+	{
+		pxCurrentTCB->pxMutexWaitedOn = NULL;
+		pxCurrentTCB->pxMutexWaitList = NULL;
+
+		/* The calling task now holds the mutex, and inherits from any tasks
+		still waiting for it. */
+		listSET_LIST_ITEM_OWNER( pxMutexItem, pxCurrentTCB );
+		listSET_LIST_ITEM_VALUE( pxMutexItem, ( portTickType ) configMAX_PRIORITIES );
+		vListInsert( &( pxCurrentTCB->xMutexesHeld ), pxMutexItem );
+		prvUpdateMutexCeiling( pxMutexItem, pxWaitingTasks );
+		prvUpdateInheritedPriority( pxCurrentTCB );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
 	void vTaskEnterCritical( void )
@@ -2517,6 +3685,418 @@ void vTaskExitCritical( void )
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static void prvBlockCurrentTaskForNotification( portTickType xTicksToWait )
+	{
+	portTickType xTimeToWake;
+
+		/* The generic list item is used for both the ready and the blocked
+		lists, so the task must first be removed from the ready list.  The
+		event list item is not used as a notification has only one possible
+		receiver. */
+		vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		{
+			if( xTicksToWait == portMAX_DELAY )
+			{
+				/* Block indefinitely without a timeout. */
+				vListInsertEnd( ( xList * ) &xSuspendedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+			}
+			else
+			{
+				/* This may overflow but this doesn't matter. */
+				xTimeToWake = xTickCount + xTicksToWait;
+				prvAddCurrentTaskToDelayedList( xTimeToWake );
+			}
+		}
+		#else
+		{
+			/* This may overflow but this doesn't matter. */
+			xTimeToWake = xTickCount + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
+		}
+		#endif
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait )
+	{
+	unsigned long ulReturn;
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if the notification count is not already non-zero. */
+			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			{
+				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+
+				if( xTicksToWait > ( portTickType ) 0 )
+				{
+					traceTASK_NOTIFY_TAKE_BLOCK();
+					prvBlockCurrentTaskForNotification( xTicksToWait );
+
+					/* All ports are written to allow a yield in a critical
+					section (some will yield immediately, others wait until the
+					critical section exits) - but it is not something that
+					application code should ever do. */
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
+		{
+			traceTASK_NOTIFY_TAKE();
+			ulReturn = pxCurrentTCB->ulNotifiedValue;
+
+			if( ulReturn != 0UL )
+			{
+				if( xClearCountOnExit != pdFALSE )
+				{
+					pxCurrentTCB->ulNotifiedValue = 0UL;
+				}
+				else
+				{
+					( pxCurrentTCB->ulNotifiedValue )--;
+				}
+			}
+
+			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		}
+		taskEXIT_CRITICAL();
+
+		return ulReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait )
+	{
+	portBASE_TYPE xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if a notification is not already pending. */
+			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			{
+				/* Clear bits in the task's notification value as bits may get
+				set	by the notifying task or interrupt.  This can be used to
+				clear the value to zero. */
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+
+				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+
+				if( xTicksToWait > ( portTickType ) 0 )
+				{
+					traceTASK_NOTIFY_WAIT_BLOCK();
+					prvBlockCurrentTaskForNotification( xTicksToWait );
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
+		{
+			traceTASK_NOTIFY_WAIT();
+
+			if( pulNotificationValue != NULL )
+			{
+				/* Output the current notification value, which may or may not
+				have changed. */
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+			}
+
+			/* If ucNotifyState is set then either the task never entered the
+			blocked state (because a notification was already pending) or the
+			task unblocked because of a notification.  Otherwise the task
+			unblocked because of a timeout. */
+			if( pxCurrentTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			{
+				/* A notification was not received. */
+				xReturn = pdFALSE;
+			}
+			else
+			{
+				/* A notification was already pending or a notification was
+				received while the task was waiting. */
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				xReturn = pdTRUE;
+			}
+
+			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue )
+	{
+	tskTCB *pxTCB;
+	unsigned char ucOriginalNotifyState;
+	portBASE_TYPE xReturn = pdPASS;
+
+		configASSERT( xTaskToNotify );
+		pxTCB = ( tskTCB * ) xTaskToNotify;
+
+		taskENTER_CRITICAL();
+		{
+			if( pulPreviousNotificationValue != NULL )
+			{
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+			}
 
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
 
+			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+
+			switch( eAction )
+			{
+				case eSetBits	:
+					pxTCB->ulNotifiedValue |= ulValue;
+					break;
+
+				case eIncrement	:
+					( pxTCB->ulNotifiedValue )++;
+					break;
+
+				case eSetValueWithOverwrite	:
+					pxTCB->ulNotifiedValue = ulValue;
+					break;
+
+				case eSetValueWithoutOverwrite :
+					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+					{
+						pxTCB->ulNotifiedValue = ulValue;
+					}
+					else
+					{
+						/* The value could not be written to the task. */
+						xReturn = pdFAIL;
+					}
+					break;
+
+				case eNoAction:
+				default:
+					/* The task is being notified without its notify value
+					being updated. */
+					break;
+			}
+
+			traceTASK_NOTIFY();
+
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				vListRemove( &( pxTCB->xGenericListItem ) );
+				prvAddTaskToReadyQueue( pxTCB );
+
+				/* The task should not have been on an event list. */
+				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static void prvUnblockNotifiedTaskFromISR( tskTCB *pxTCB, portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+		/* The task should not have been on an event list. */
+		configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+		/* If the scheduler is suspended the ready lists cannot be accessed,
+		so the task is held in the pending ready list until the scheduler is
+		resumed - as is done by xTaskRemoveFromEventList(). */
+		if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+		{
+			vListRemove( &( pxTCB->xGenericListItem ) );
+			prvAddTaskToReadyQueue( pxTCB );
+		}
+		else
+		{
+			vListInsertEnd( ( xList * ) &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+		}
+
+		if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+		{
+			/* The notified task has a priority above the currently
+			executing task so a yield is required. */
+			if( pxHigherPriorityTaskWoken != NULL )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskGenericNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue, portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	tskTCB *pxTCB;
+	unsigned char ucOriginalNotifyState;
+	portBASE_TYPE xReturn = pdPASS;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		configASSERT( xTaskToNotify );
+		pxTCB = ( tskTCB * ) xTaskToNotify;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( pulPreviousNotificationValue != NULL )
+			{
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+			}
+
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+
+			switch( eAction )
+			{
+				case eSetBits	:
+					pxTCB->ulNotifiedValue |= ulValue;
+					break;
+
+				case eIncrement	:
+					( pxTCB->ulNotifiedValue )++;
+					break;
+
+				case eSetValueWithOverwrite	:
+					pxTCB->ulNotifiedValue = ulValue;
+					break;
+
+				case eSetValueWithoutOverwrite :
+					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+					{
+						pxTCB->ulNotifiedValue = ulValue;
+					}
+					else
+					{
+						/* The value could not be written to the task. */
+						xReturn = pdFAIL;
+					}
+					break;
+
+				case eNoAction :
+				default:
+					/* The task is being notified without its notify value
+					being updated. */
+					break;
+			}
+
+			traceTASK_NOTIFY_FROM_ISR();
+
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				prvUnblockNotifiedTaskFromISR( pxTCB, pxHigherPriorityTaskWoken );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	tskTCB *pxTCB;
+	unsigned char ucOriginalNotifyState;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		configASSERT( xTaskToNotify );
+		pxTCB = ( tskTCB * ) xTaskToNotify;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+
+			/* 'Giving' is equivalent to incrementing a count in a counting
+			semaphore. */
+			( pxTCB->ulNotifiedValue )++;
+
+			traceTASK_NOTIFY_GIVE_FROM_ISR();
+
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+			{
+				prvUnblockNotifiedTaskFromISR( pxTCB, pxHigherPriorityTaskWoken );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	portBASE_TYPE xTaskNotifyStateClear( xTaskHandle xTask )
+	{
+	tskTCB *pxTCB;
+	portBASE_TYPE xReturn;
+
+		/* If null is passed in here then it is the calling task that is having
+		its notification state cleared. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		taskENTER_CRITICAL();
+		{
+			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			{
+				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
 
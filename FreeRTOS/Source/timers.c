@@ -66,6 +66,7 @@ task.h is included from an application file. */
 #include "task.h"
 #include "queue.h"
 #include "timers.h"
+#include "timing_wheel.h"
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
@@ -87,29 +88,71 @@ typedef struct tmrTimerControl
 	unsigned portBASE_TYPE	uxAutoReload;		/*<< Set to pdTRUE if the timer should be automatically restarted once expired.  Set to pdFALSE if the timer is, in effect, a one shot timer. */
 	void 					*pvTimerID;			/*<< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
 	tmrTIMER_CALLBACK		pxCallbackFunction;	/*<< The function that will be called when the timer expires. */
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char		ucStaticallyAllocated;	/*<< Set to pdTRUE if the timer structure was supplied by the application, so must not be freed when the timer is deleted. */
+	#endif
 } xTIMER;
 
 /* The definition of messages that can be sent and received on the timer
-queue. */
-typedef struct tmrTimerQueueMessage
+queue.  A message either carries a command to be applied to a timer, or (when
+xMessageID is tmrCOMMAND_EXECUTE_CALLBACK) a function to be executed in the
+context of the timer service task. */
+typedef struct tmrTimerParameters
 {
-	portBASE_TYPE			xMessageID;			/*<< The command being sent to the timer service task. */
 	portTickType			xMessageValue;		/*<< An optional value used by a subset of commands, for example, when changing the period of a timer. */
 	xTIMER *				pxTimer;			/*<< The timer to which the command will be applied. */
+} xTIMER_PARAMETERS;
+
+typedef struct tmrCallbackParameters
+{
+	tmrPENDED_FUNCTION		pxCallbackFunction;	/*<< The function to execute. */
+	void *					pvParameter1;		/*<< The value that will be used as the callback function's first parameter. */
+	unsigned long			ulParameter2;		/*<< The value that will be used as the callback function's second parameter. */
+} xCALLBACK_PARAMETERS;
+
+typedef struct tmrTimerQueueMessage
+{
+	portBASE_TYPE			xMessageID;			/*<< The command being sent to the timer service task. */
+	union
+	{
+		xTIMER_PARAMETERS		xTimerParameters;
+		xCALLBACK_PARAMETERS	xCallbackParameters;
+	} u;
 } xTIMER_MESSAGE;
 
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access xActiveTimerList. */
-PRIVILEGED_DATA static xList xActiveTimerList1;
-PRIVILEGED_DATA static xList xActiveTimerList2;
-PRIVILEGED_DATA static xList *pxCurrentTimerList;
-PRIVILEGED_DATA static xList *pxOverflowTimerList;
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	/* The wheel in which active timers are stored.  The time of the wheel is
+	the time up to which expired timers have been processed, which can lag
+	behind the tick count.  Only the timer service task is allowed to access
+	xActiveTimerWheel. */
+	PRIVILEGED_DATA static xTimingWheel xActiveTimerWheel;
+
+#else
+
+	/* The list in which active timers are stored.  Timers are referenced in
+	expire time order, with the nearest expiry time at the front of the list.
+	Only the timer service task is allowed to access xActiveTimerList. */
+	PRIVILEGED_DATA static xList xActiveTimerList1;
+	PRIVILEGED_DATA static xList xActiveTimerList2;
+	PRIVILEGED_DATA static xList *pxCurrentTimerList;
+	PRIVILEGED_DATA static xList *pxOverflowTimerList;
+
+#endif
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static xQueueHandle xTimerQueue = NULL;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* The timer command queue is created in statically allocated memory so
+	timers can be used without a heap. */
+	PRIVILEGED_DATA static xStaticQueue xStaticTimerQueue;
+	PRIVILEGED_DATA static unsigned char ucStaticTimerQueueStorage[ configTIMER_QUEUE_LENGTH * sizeof( xTIMER_MESSAGE ) ];
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -118,6 +161,12 @@ PRIVILEGED_DATA static xQueueHandle xTimerQueue = NULL;
  */
 static void prvCheckForValidListAndQueue( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the members of a newly created timer, whether its memory came
+ * from the heap or was supplied by the application.
+ */
+static void prvInitialiseNewTimer( xTIMER *pxNewTimer, const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction ) PRIVILEGED_FUNCTION;
+
 /*
  * The timer service task (daemon).  Timer functionality is controlled by this
  * task.  Other tasks communicate with the timer service task using the
@@ -133,41 +182,65 @@ static void	prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * depending on if the expire time causes a timer counter overflow - or into
+ * xActiveTimerWheel if configUSE_TIMING_WHEEL is 1.  Returns pdTRUE if the
+ * timer has already expired, in which case it is not inserted.
  */
 static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime ) PRIVILEGED_FUNCTION;
 
-/*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
- */
-static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
-
-/*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
- */
-static void prvSwitchTimerLists( portTickType xLastTime ) PRIVILEGED_FUNCTION;
-
-/*
- * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
- * if a tick count overflow occurred since prvSampleTimeNow() was last called.
- */
-static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
-
-/*
- * If the timer list contains any active timers then return the expire time of
- * the timer that will expire first and set *pxListWasEmpty to false.  If the
- * timer list does not contain any timers then return 0 and set *pxListWasEmpty
- * to pdTRUE.
- */
-static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty ) PRIVILEGED_FUNCTION;
-
-/*
- * If a timer has expired, process it.  Otherwise, block the timer service task
- * until either a timer does expire or a command is received.
- */
-static void prvProcessTimerOrBlockTask( portTickType xNextExpireTime, portBASE_TYPE xListWasEmpty ) PRIVILEGED_FUNCTION;
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	/*
+	 * Advance the wheel of active timers to xTimeNow, processing every timer
+	 * that expires on the way.  Auto reload timers are reloaded relative to
+	 * the time at which they expired.
+	 */
+	static void prvProcessExpiredTimers( portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * If the wheel has fallen behind the tick count far enough for a timer to
+	 * have expired, process the expired timers.  Otherwise, block the timer
+	 * service task until either the wheel next needs to be advanced or a
+	 * command is received.
+	 */
+	static void prvProcessTimerWheelOrBlockTask( void ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * An active timer has reached its expire time.  Reload the timer if it is
+	 * an auto reload timer, then call its callback.
+	 */
+	static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( portTickType xLastTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Obtain the current tick count, setting *pxTimerListsWereSwitched to
+	 * pdTRUE if a tick count overflow occurred since prvSampleTimeNow() was
+	 * last called.
+	 */
+	static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * If the timer list contains any active timers then return the expire time
+	 * of the timer that will expire first and set *pxListWasEmpty to false.  If
+	 * the timer list does not contain any timers then return 0 and set
+	 * *pxListWasEmpty to pdTRUE.
+	 */
+	static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * If a timer has expired, process it.  Otherwise, block the timer service
+	 * task until either a timer does expire or a command is received.
+	 */
+	static void prvProcessTimerOrBlockTask( portTickType xNextExpireTime, portBASE_TYPE xListWasEmpty ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMING_WHEEL */
 
 /*-----------------------------------------------------------*/
 
@@ -183,7 +256,24 @@ portBASE_TYPE xReturn = pdFAIL;
 
 	if( xTimerQueue != NULL )
 	{
-		xReturn = xTaskCreate( prvTimerTask, ( const signed char * ) "Tmr Svc", ( unsigned short ) configTIMER_TASK_STACK_DEPTH, NULL, ( unsigned portBASE_TYPE ) configTIMER_TASK_PRIORITY, NULL);
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+		xStaticTask *pxTimerTaskTCBBuffer = NULL;
+		portSTACK_TYPE *pxTimerTaskStackBuffer = NULL;
+		unsigned short usTimerTaskStackSize = ( unsigned short ) configTIMER_TASK_STACK_DEPTH;
+
+			vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &usTimerTaskStackSize );
+
+			if( xTaskCreateStatic( prvTimerTask, ( const signed char * ) "Tmr Svc", usTimerTaskStackSize, NULL, ( unsigned portBASE_TYPE ) configTIMER_TASK_PRIORITY, pxTimerTaskStackBuffer, pxTimerTaskTCBBuffer ) != NULL )
+			{
+				xReturn = pdPASS;
+			}
+		}
+		#else
+		{
+			xReturn = xTaskCreate( prvTimerTask, ( const signed char * ) "Tmr Svc", ( unsigned short ) configTIMER_TASK_STACK_DEPTH, NULL, ( unsigned portBASE_TYPE ) configTIMER_TASK_PRIORITY, NULL);
+		}
+		#endif
 	}
 
 	configASSERT( xReturn );
@@ -211,12 +301,13 @@ xTIMER *pxNewTimer;
 			prvCheckForValidListAndQueue();
 	
 			/* Initialise the timer structure members using the function parameters. */
-			pxNewTimer->pcTimerName = pcTimerName;
-			pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
-			pxNewTimer->uxAutoReload = uxAutoReload;
-			pxNewTimer->pvTimerID = pvTimerID;
-			pxNewTimer->pxCallbackFunction = pxCallbackFunction;
-			vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+			prvInitialiseNewTimer( pxNewTimer, pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction );
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxNewTimer->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif
 			
 			traceTIMER_CREATE( pxNewTimer );
 		}
@@ -230,6 +321,54 @@ xTIMER *pxNewTimer;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xTimerHandle xTimerCreateStatic( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xStaticTimer *pxTimerBuffer )
+	{
+	xTIMER *pxNewTimer = NULL;
+
+		configASSERT( ( xTimerPeriodInTicks > 0 ) );
+		configASSERT( pxTimerBuffer != NULL );
+
+		/* Sanity check that the xStaticTimer structure declared in FreeRTOS.h
+		is the same size as the real timer structure. */
+		configASSERT( sizeof( xStaticTimer ) == sizeof( xTIMER ) );
+
+		if( ( xTimerPeriodInTicks != ( portTickType ) 0U ) && ( pxTimerBuffer != NULL ) )
+		{
+			pxNewTimer = ( xTIMER * ) pxTimerBuffer;
+
+			/* Ensure the infrastructure used by the timer service task has been
+			created/initialised. */
+			prvCheckForValidListAndQueue();
+
+			prvInitialiseNewTimer( pxNewTimer, pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction );
+			pxNewTimer->ucStaticallyAllocated = pdTRUE;
+
+			traceTIMER_CREATE( pxNewTimer );
+		}
+		else
+		{
+			traceTIMER_CREATE_FAILED();
+		}
+
+		return ( xTimerHandle ) pxNewTimer;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewTimer( xTIMER *pxNewTimer, const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction )
+{
+	pxNewTimer->pcTimerName = pcTimerName;
+	pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
+	pxNewTimer->uxAutoReload = uxAutoReload;
+	pxNewTimer->pvTimerID = pvTimerID;
+	pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+	vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+}
+/*-----------------------------------------------------------*/
+
 portBASE_TYPE xTimerGenericCommand( xTimerHandle xTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, portBASE_TYPE *pxHigherPriorityTaskWoken, portTickType xBlockTime )
 {
 portBASE_TYPE xReturn = pdFAIL;
@@ -241,8 +380,8 @@ xTIMER_MESSAGE xMessage;
 	{
 		/* Send a command to the timer service task to start the xTimer timer. */
 		xMessage.xMessageID = xCommandID;
-		xMessage.xMessageValue = xOptionalValue;
-		xMessage.pxTimer = ( xTIMER * ) xTimer;
+		xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
+		xMessage.u.xTimerParameters.pxTimer = ( xTIMER * ) xTimer;
 
 		if( pxHigherPriorityTaskWoken == NULL )
 		{
@@ -267,162 +406,341 @@ xTIMER_MESSAGE xMessage;
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow )
+portBASE_TYPE xTimerPendFunctionCallFromISR( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, portBASE_TYPE *pxHigherPriorityTaskWoken )
 {
-xTIMER *pxTimer;
-portBASE_TYPE xResult;
-
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
-	pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
-	vListRemove( &( pxTimer->xTimerListItem ) );
-	traceTIMER_EXPIRED( pxTimer );
+xTIMER_MESSAGE xMessage;
+portBASE_TYPE xReturn = pdFAIL;
 
-	/* If the timer is an auto reload timer then calculate the next
-	expiry time and re-insert the timer in the list of active timers. */
-	if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+	/* Complete the message with the function parameters and post it to the
+	timer service task. */
+	if( xTimerQueue != NULL )
 	{
-		/* This is the only time a timer is inserted into a list using
-		a time relative to anything other than the current time.  It
-		will therefore be inserted into the correct list relative to
-		the time this task thinks it is now, even if a command to
-		switch lists due to a tick count overflow is already waiting in
-		the timer queue. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) == pdTRUE )
-		{
-			/* The timer expired before it was added to the active timer
-			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
-			configASSERT( xResult );
-			( void ) xResult;
-		}
+		xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK;
+		xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
+		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
+		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+
+		xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+
+		tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 	}
 
-	/* Call the timer callback. */
-	pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static void prvTimerTask( void *pvParameters )
+portBASE_TYPE xTimerPendFunctionCall( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, portTickType xTicksToWait )
 {
-portTickType xNextExpireTime;
-portBASE_TYPE xListWasEmpty;
+xTIMER_MESSAGE xMessage;
+portBASE_TYPE xReturn;
 
-	/* Just to avoid compiler warnings. */
-	( void ) pvParameters;
+	/* This function can be called before the scheduler has started, so make
+	sure the queue exists, as xTimerCreate() does. */
+	prvCheckForValidListAndQueue();
+	configASSERT( xFunctionToPend );
 
-	for( ;; )
+	if( xTimerQueue != NULL )
 	{
-		/* Query the timers list to see if it contains any timers, and if so,
-		obtain the time at which the next timer will expire. */
-		xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+		/* Complete the message with the function parameters and post it to
+		the timer service task. */
+		xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK;
+		xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
+		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
+		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+
+		if( xTaskGetSchedulerState() != taskSCHEDULER_RUNNING )
+		{
+			xTicksToWait = tmrNO_DELAY;
+		}
 
-		/* If a timer has expired, process it.  Otherwise, block this task
-		until either a timer does expire, or a command is received. */
-		prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
-		
-		/* Empty the command queue. */
-		prvProcessReceivedCommands();		
+		xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
 	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
+
+	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessTimerOrBlockTask( portTickType xNextExpireTime, portBASE_TYPE xListWasEmpty )
-{
-portTickType xTimeNow;
-portBASE_TYPE xTimerListsWereSwitched;
+#if ( configUSE_TIMING_WHEEL == 0 )
 
-	vTaskSuspendAll();
+	static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow )
 	{
-		/* Obtain the time now to make an assessment as to whether the timer
-		has expired or not.  If obtaining the time causes the lists to switch
-		then don't process this timer as any timers that remained in the list
-		when the lists were switched will have been processed within the
-		prvSampelTimeNow() function. */
-		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
-		if( xTimerListsWereSwitched == pdFALSE )
+	xTIMER *pxTimer;
+	portBASE_TYPE xResult;
+
+		/* Remove the timer from the list of active timers.  A check has already
+		been performed to ensure the list is not empty. */
+		pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+		vListRemove( &( pxTimer->xTimerListItem ) );
+		traceTIMER_EXPIRED( pxTimer );
+
+		/* If the timer is an auto reload timer then calculate the next
+		expiry time and re-insert the timer in the list of active timers. */
+		if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
 		{
-			/* The tick count has not overflowed, has the timer expired? */
-			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+			/* This is the only time a timer is inserted into a list using
+			a time relative to anything other than the current time.  It
+			will therefore be inserted into the correct list relative to
+			the time this task thinks it is now, even if a command to
+			switch lists due to a tick count overflow is already waiting in
+			the timer queue. */
+			if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) == pdTRUE )
+			{
+				/* The timer expired before it was added to the active timer
+				list.  Reload it now.  */
+				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
+				configASSERT( xResult );
+				( void ) xResult;
+			}
+		}
+
+		/* Call the timer callback. */
+		pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+		traceTIMER_CALLBACK_RETURN( pxTimer );
+	}
+
+#endif /* configUSE_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+	static void prvProcessExpiredTimers( portTickType xTimeNow )
+	{
+	portTickType xTicksToCatchUp, xTicksToNextEvent;
+	xList *pxExpiredList;
+	xTIMER *pxTimer;
+
+		while( xActiveTimerWheel.xTime != xTimeNow )
+		{
+			xTicksToCatchUp = ( portTickType ) ( xTimeNow - xActiveTimerWheel.xTime );
+			xTicksToNextEvent = xTimingWheelTicksToNextEvent( &xActiveTimerWheel );
+
+			if( xTicksToNextEvent > xTicksToCatchUp )
+			{
+				/* Nothing expires or cascades before xTimeNow. */
+				vTimingWheelSkip( &xActiveTimerWheel, xTicksToCatchUp );
+			}
+			else
+			{
+				/* Move straight to the tick before the next event, then step
+				onto it so the wheel can cascade or expire the slot. */
+				vTimingWheelSkip( &xActiveTimerWheel, xTicksToNextEvent - ( portTickType ) 1 );
+				pxExpiredList = pxTimingWheelAdvance( &xActiveTimerWheel );
+
+				while( listLIST_IS_EMPTY( pxExpiredList ) == pdFALSE )
+				{
+					pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxExpiredList );
+					vListRemove( &( pxTimer->xTimerListItem ) );
+					traceTIMER_EXPIRED( pxTimer );
+
+					/* Reload relative to the time the timer expired, which
+					is the time of the wheel.  The period cannot be zero so the
+					timer is always placed ahead of the wheel. */
+					if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+					{
+						( void ) prvInsertTimerInActiveList( pxTimer, ( xActiveTimerWheel.xTime + pxTimer->xTimerPeriodInTicks ), xActiveTimerWheel.xTime, xActiveTimerWheel.xTime );
+					}
+
+					/* Call the timer callback. */
+					pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+					traceTIMER_CALLBACK_RETURN( pxTimer );
+				}
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvProcessTimerWheelOrBlockTask( void )
+	{
+	portTickType xTimeNow, xTicksToNextEvent;
+
+		vTaskSuspendAll();
+		{
+			/* The wheel only lags behind the tick count, so there is no
+			overflow to detect here - the distance between the two is always
+			correct even if the tick count has wrapped. */
+			xTimeNow = xTaskGetTickCount();
+			xTicksToNextEvent = xTimingWheelTicksToNextEvent( &xActiveTimerWheel );
+
+			if( xTicksToNextEvent <= ( portTickType ) ( xTimeNow - xActiveTimerWheel.xTime ) )
 			{
 				xTaskResumeAll();
-				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				prvProcessExpiredTimers( xTimeNow );
 			}
 			else
 			{
-				/* The tick count has not overflowed, and the next expire
-				time has not been reached yet.  This task should therefore
-				block to wait for the next expire time or a command to be
-				received - whichever comes first.  The following line cannot
-				be reached unless xNextExpireTime > xTimeNow, except in the
-				case when the current timer list is empty. */
-				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ) );
+				/* Nothing is due, so the wheel can be brought up to date
+				without processing any timers, then this task blocks until
+				either the next expiry or cascade, or a command is received. */
+				vTimingWheelSkip( &xActiveTimerWheel, ( portTickType ) ( xTimeNow - xActiveTimerWheel.xTime ) );
+				xTicksToNextEvent = xTimingWheelTicksToNextEvent( &xActiveTimerWheel );
+				vQueueWaitForMessageRestricted( xTimerQueue, xTicksToNextEvent );
 
 				if( xTaskResumeAll() == pdFALSE )
 				{
-					/* Yield to wait for either a command to arrive, or the block time
-					to expire.  If a command arrived between the critical section being
-					exited and this yield then the yield will not cause the task
-					to block. */
+					/* Yield to wait for either a command to arrive, or the
+					block time to expire.  If a command arrived between the
+					scheduler being resumed and this yield then the yield will
+					not cause the task to block. */
 					portYIELD_WITHIN_API();
 				}
 			}
 		}
-		else
-		{
-			xTaskResumeAll();
-		}
 	}
-}
+
+#endif /* configUSE_TIMING_WHEEL */
 /*-----------------------------------------------------------*/
 
-static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty )
+static void prvTimerTask( void *pvParameters )
 {
-portTickType xNextExpireTime;
-
-	/* Timers are listed in expiry time order, with the head of the list
-	referencing the task that will expire first.  Obtain the time at which
-	the timer with the nearest expiry time will expire.  If there are no
-	active timers then just set the next expire time to 0.  That will cause
-	this task to unblock when the tick count overflows, at which point the
-	timer lists will be switched and the next expiry time can be
-	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-	if( *pxListWasEmpty == pdFALSE )
+#if ( configUSE_TIMING_WHEEL == 0 )
+	portTickType xNextExpireTime;
+	portBASE_TYPE xListWasEmpty;
+#endif
+
+	/* Just to avoid compiler warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		#if ( configUSE_TIMING_WHEEL == 1 )
+		{
+			/* If timers have expired, process them.  Otherwise, block this
+			task until either a timer does expire, or a command is
+			received. */
+			prvProcessTimerWheelOrBlockTask();
+		}
+		#else
+		{
+			/* Query the timers list to see if it contains any timers, and if
+			so, obtain the time at which the next timer will expire. */
+			xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+
+			/* If a timer has expired, process it.  Otherwise, block this task
+			until either a timer does expire, or a command is received. */
+			prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+		}
+		#endif
+		
+		/* Empty the command queue. */
+		prvProcessReceivedCommands();		
 	}
-	else
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMING_WHEEL == 0 )
+
+	static void prvProcessTimerOrBlockTask( portTickType xNextExpireTime, portBASE_TYPE xListWasEmpty )
 	{
-		/* Ensure the task unblocks when the tick count rolls over. */
-		xNextExpireTime = ( portTickType ) 0U;
+	portTickType xTimeNow;
+	portBASE_TYPE xTimerListsWereSwitched;
+
+		vTaskSuspendAll();
+		{
+			/* Obtain the time now to make an assessment as to whether the timer
+			has expired or not.  If obtaining the time causes the lists to switch
+			then don't process this timer as any timers that remained in the list
+			when the lists were switched will have been processed within the
+			prvSampelTimeNow() function. */
+			xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+			if( xTimerListsWereSwitched == pdFALSE )
+			{
+				/* The tick count has not overflowed, has the timer expired? */
+				if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+				{
+					xTaskResumeAll();
+					prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				}
+				else
+				{
+					/* The tick count has not overflowed, and the next expire
+					time has not been reached yet.  This task should therefore
+					block to wait for the next expire time or a command to be
+					received - whichever comes first.  The following line cannot
+					be reached unless xNextExpireTime > xTimeNow, except in the
+					case when the current timer list is empty. */
+					vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ) );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						/* Yield to wait for either a command to arrive, or the block time
+						to expire.  If a command arrived between the critical section being
+						exited and this yield then the yield will not cause the task
+						to block. */
+						portYIELD_WITHIN_API();
+					}
+				}
+			}
+			else
+			{
+				xTaskResumeAll();
+			}
+		}
 	}
 
-	return xNextExpireTime;
-}
+#endif /* configUSE_TIMING_WHEEL */
 /*-----------------------------------------------------------*/
 
-static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
-{
-portTickType xTimeNow;
-static portTickType xLastTime = ( portTickType ) 0U;
+#if ( configUSE_TIMING_WHEEL == 0 )
 
-	xTimeNow = xTaskGetTickCount();
-	
-	if( xTimeNow < xLastTime )
+	static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty )
 	{
-		prvSwitchTimerLists( xLastTime );
-		*pxTimerListsWereSwitched = pdTRUE;
+	portTickType xNextExpireTime;
+
+		/* Timers are listed in expiry time order, with the head of the list
+		referencing the task that will expire first.  Obtain the time at which
+		the timer with the nearest expiry time will expire.  If there are no
+		active timers then just set the next expire time to 0.  That will cause
+		this task to unblock when the tick count overflows, at which point the
+		timer lists will be switched and the next expiry time can be
+		re-assessed.  */
+		*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+		if( *pxListWasEmpty == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		}
+		else
+		{
+			/* Ensure the task unblocks when the tick count rolls over. */
+			xNextExpireTime = ( portTickType ) 0U;
+		}
+
+		return xNextExpireTime;
 	}
-	else
+
+#endif /* configUSE_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMING_WHEEL == 0 )
+
+	static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
 	{
-		*pxTimerListsWereSwitched = pdFALSE;
-	}
+	portTickType xTimeNow;
+	static portTickType xLastTime = ( portTickType ) 0U;
+
+		xTimeNow = xTaskGetTickCount();
+	
+		if( xTimeNow < xLastTime )
+		{
+			prvSwitchTimerLists( xLastTime );
+			*pxTimerListsWereSwitched = pdTRUE;
+		}
+		else
+		{
+			*pxTimerListsWereSwitched = pdFALSE;
+		}
 	
-	xLastTime = xTimeNow;
+		xLastTime = xTimeNow;
 	
-	return xTimeNow;
-}
+		return xTimeNow;
+	}
+
+#endif /* configUSE_TIMING_WHEEL */
 /*-----------------------------------------------------------*/
 
 static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime )
@@ -431,36 +749,56 @@ portBASE_TYPE xProcessTimerNow = pdFALSE;
 
 	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
 	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-	
-	if( xNextExpiryTime <= xTimeNow )
+
+	#if ( configUSE_TIMING_WHEEL == 1 )
 	{
-		/* Has the expiry time elapsed between the command to start/reset a
-		timer was issued, and the time the command was processed? */
+		/* xTimeNow is the time of the wheel.  The wheel holds expiry times
+		that have overflowed itself, so only the time that has passed since the
+		command was issued needs to be considered. */
+		( void ) xNextExpiryTime;
+
 		if( ( ( portTickType ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks )
 		{
-			/* The time between a command being issued and the command being
-			processed actually exceeds the timers period.  */
 			xProcessTimerNow = pdTRUE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			vTimingWheelInsert( &xActiveTimerWheel, &( pxTimer->xTimerListItem ) );
 		}
 	}
-	else
+	#else
 	{
-		if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+		if( xNextExpiryTime <= xTimeNow )
 		{
-			/* If, since the command was issued, the tick count has overflowed
-			but the expiry time has not, then the timer must have already passed
-			its expiry time and should be processed immediately. */
-			xProcessTimerNow = pdTRUE;
+			/* Has the expiry time elapsed between the command to start/reset a
+			timer was issued, and the time the command was processed? */
+			if( ( ( portTickType ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks )
+			{
+				/* The time between a command being issued and the command being
+				processed actually exceeds the timers period.  */
+				xProcessTimerNow = pdTRUE;
+			}
+			else
+			{
+				vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			}
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+			{
+				/* If, since the command was issued, the tick count has overflowed
+				but the expiry time has not, then the timer must have already passed
+				its expiry time and should be processed immediately. */
+				xProcessTimerNow = pdTRUE;
+			}
+			else
+			{
+				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			}
 		}
 	}
+	#endif
 
 	return xProcessTimerNow;
 }
@@ -470,16 +808,42 @@ static void	prvProcessReceivedCommands( void )
 {
 xTIMER_MESSAGE xMessage;
 xTIMER *pxTimer;
-portBASE_TYPE xTimerListsWereSwitched, xResult;
+portBASE_TYPE xResult;
 portTickType xTimeNow;
 
-	/* In this case the xTimerListsWereSwitched parameter is not used, but it
-	must be present in the function call. */
-	xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+	#if ( configUSE_TIMING_WHEEL == 0 )
+	{
+	portBASE_TYPE xTimerListsWereSwitched;
+
+		/* In this case the xTimerListsWereSwitched parameter is not used, but
+		it must be present in the function call. */
+		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+	}
+	#endif
 
 	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL )
 	{
-		pxTimer = xMessage.pxTimer;
+		#if ( configUSE_TIMING_WHEEL == 1 )
+		{
+			/* Sample the time after the message has been received so the
+			command can never appear to have been issued in the future, then
+			bring the wheel up to that time so xTimeNow is also the time of
+			the wheel. */
+			xTimeNow = xTaskGetTickCount();
+			prvProcessExpiredTimers( xTimeNow );
+		}
+		#endif
+
+		/* Commands that execute a pended function rather than operate on a
+		timer are processed first. */
+		if( xMessage.xMessageID == tmrCOMMAND_EXECUTE_CALLBACK )
+		{
+			configASSERT( xMessage.u.xCallbackParameters.pxCallbackFunction );
+			xMessage.u.xCallbackParameters.pxCallbackFunction( xMessage.u.xCallbackParameters.pvParameter1, xMessage.u.xCallbackParameters.ulParameter2 );
+			continue;
+		}
+
+		pxTimer = xMessage.u.xTimerParameters.pxTimer;
 
 		/* Is the timer already in a list of active timers?  When the command
 		is trmCOMMAND_PROCESS_TIMER_OVERFLOW, the timer will be NULL as the
@@ -493,13 +857,13 @@ portTickType xTimeNow;
 			}
 		}
 
-		traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.xMessageValue );
+		traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
 		
 		switch( xMessage.xMessageID )
 		{
 			case tmrCOMMAND_START :	
 				/* Start or restart a timer. */
-				if( prvInsertTimerInActiveList( pxTimer,  xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.xMessageValue ) == pdTRUE )
+				if( prvInsertTimerInActiveList( pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) == pdTRUE )
 				{
 					/* The timer expired before it was added to the active timer
 					list.  Process it now. */
@@ -507,7 +871,7 @@ portTickType xTimeNow;
 
 					if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
 					{
-						xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
+						xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
 						configASSERT( xResult );
 						( void ) xResult;
 					}
@@ -520,15 +884,26 @@ portTickType xTimeNow;
 				break;
 
 			case tmrCOMMAND_CHANGE_PERIOD :
-				pxTimer->xTimerPeriodInTicks = xMessage.xMessageValue;
+				pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
 				configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
 				prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
 				break;
 
 			case tmrCOMMAND_DELETE :
 				/* The timer has already been removed from the active list,
-				just free up the memory. */
-				vPortFree( pxTimer );
+				just free up the memory if it was allocated by the kernel. */
+				#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+				{
+					if( pxTimer->ucStaticallyAllocated == pdFALSE )
+					{
+						vPortFree( pxTimer );
+					}
+				}
+				#else
+				{
+					vPortFree( pxTimer );
+				}
+				#endif
 				break;
 
 			default	:			
@@ -539,61 +914,65 @@ portTickType xTimeNow;
 }
 /*-----------------------------------------------------------*/
 
-static void prvSwitchTimerLists( portTickType xLastTime )
-{
-portTickType xNextExpireTime, xReloadTime;
-xList *pxTemp;
-xTIMER *pxTimer;
-portBASE_TYPE xResult;
+#if ( configUSE_TIMING_WHEEL == 0 )
 
-	/* Remove compiler warnings if configASSERT() is not defined. */
-	( void ) xLastTime;
-	
-	/* The tick count has overflowed.  The timer lists must be switched.
-	If there are any timers still referenced from the current timer list
-	then they must have expired and should be processed before the lists
-	are switched. */
-	while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+	static void prvSwitchTimerLists( portTickType xLastTime )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+	portTickType xNextExpireTime, xReloadTime;
+	xList *pxTemp;
+	xTIMER *pxTimer;
+	portBASE_TYPE xResult;
 
-		/* Remove the timer from the list. */
-		pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
-		vListRemove( &( pxTimer->xTimerListItem ) );
+		/* Remove compiler warnings if configASSERT() is not defined. */
+		( void ) xLastTime;
+	
+		/* The tick count has overflowed.  The timer lists must be switched.
+		If there are any timers still referenced from the current timer list
+		then they must have expired and should be processed before the lists
+		are switched. */
+		while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
 
-		/* Execute its callback, then send a command to restart the timer if
-		it is an auto-reload timer.  It cannot be restarted here as the lists
-		have not yet been switched. */
-		pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+			/* Remove the timer from the list. */
+			pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+			vListRemove( &( pxTimer->xTimerListItem ) );
 
-		if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
-		{
-			/* Calculate the reload value, and if the reload value results in
-			the timer going into the same timer list then it has already expired
-			and the timer should be re-inserted into the current list so it is
-			processed again within this loop.  Otherwise a command should be sent
-			to restart the timer to ensure it is only inserted into a list after
-			the lists have been swapped. */
-			xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
-			if( xReloadTime > xNextExpireTime )
-			{
-				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
-				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
-			}
-			else
+			/* Execute its callback, then send a command to restart the timer if
+			it is an auto-reload timer.  It cannot be restarted here as the lists
+			have not yet been switched. */
+			pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+
+			if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
 			{
-				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
-				configASSERT( xResult );
-				( void ) xResult;
+				/* Calculate the reload value, and if the reload value results in
+				the timer going into the same timer list then it has already expired
+				and the timer should be re-inserted into the current list so it is
+				processed again within this loop.  Otherwise a command should be sent
+				to restart the timer to ensure it is only inserted into a list after
+				the lists have been swapped. */
+				xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
+				if( xReloadTime > xNextExpireTime )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
+					listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+					vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+				}
+				else
+				{
+					xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
 			}
 		}
+
+		pxTemp = pxCurrentTimerList;
+		pxCurrentTimerList = pxOverflowTimerList;
+		pxOverflowTimerList = pxTemp;
 	}
 
-	pxTemp = pxCurrentTimerList;
-	pxCurrentTimerList = pxOverflowTimerList;
-	pxOverflowTimerList = pxTemp;
-}
+#endif /* configUSE_TIMING_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
@@ -605,11 +984,28 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
-			xTimerQueue = xQueueCreate( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ) );
+			#if ( configUSE_TIMING_WHEEL == 1 )
+			{
+				vTimingWheelInitialise( &xActiveTimerWheel, xTaskGetTickCount() );
+			}
+			#else
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#endif
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				xTimerQueue = xQueueCreateStatic( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ), ucStaticTimerQueueStorage, &xStaticTimerQueue );
+			}
+			#else
+			{
+				xTimerQueue = xQueueCreate( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ) );
+			}
+			#endif
 		}
 	}
 	taskEXIT_CRITICAL();
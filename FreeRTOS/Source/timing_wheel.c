@@ -0,0 +1,316 @@
+/*
+    FreeRTOS V7.0.1 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+	FreeRTOS supports many tools and architectures. V7.0.0 is sponsored by:
+	Atollic AB - Atollic provides professional embedded systems development 
+	tools for C/C++ development, code analysis and test automation.  
+	See http://www.atollic.com
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "list.h"
+#include "timing_wheel.h"
+
+/* The timing wheel is only built when it is used as the delayed list
+backend. */
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+#define wheelSLOT_MASK				( ( portTickType ) ( wheelSLOTS_PER_LEVEL - 1 ) )
+#define wheelTOP_LEVEL				( ( unsigned portBASE_TYPE ) ( wheelNUMBER_OF_LEVELS - 1 ) )
+
+/* The slot within uxLevel that a time falls in. */
+#define wheelSLOT_OF( xTime, uxLevel )	( ( unsigned portBASE_TYPE ) ( ( ( xTime ) >> ( ( uxLevel ) * wheelSLOT_BITS ) ) & wheelSLOT_MASK ) )
+
+/*
+ * Place an item in the level and slot determined by its expiry time relative
+ * to the current time of the wheel.
+ */
+static void prvPlaceItem( xTimingWheel *pxWheel, xListItem *pxItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Redistribute the items held in the slot of uxLevel that starts at the
+ * current time of the wheel into the lower levels.
+ */
+static void prvCascadeSlot( xTimingWheel *pxWheel, unsigned portBASE_TYPE uxLevel ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the slot contains at least one item.  The bit for a slot
+ * that is found to be empty is cleared, so it is not inspected again until an
+ * item is placed in the slot.
+ */
+static portBASE_TYPE prvSlotIsInUse( xTimingWheel *pxWheel, unsigned portBASE_TYPE uxLevel, unsigned portBASE_TYPE uxSlot ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of ticks from the current time of the wheel until the
+ * start of the given slot.
+ */
+static portTickType prvTicksToSlot( const xTimingWheel *pxWheel, unsigned portBASE_TYPE uxLevel, unsigned portBASE_TYPE uxSlot ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+void vTimingWheelInitialise( xTimingWheel *pxWheel, portTickType xTime )
+{
+unsigned portBASE_TYPE uxLevel, uxSlot;
+
+	pxWheel->xTime = xTime;
+
+	for( uxLevel = 0; uxLevel < ( unsigned portBASE_TYPE ) wheelNUMBER_OF_LEVELS; uxLevel++ )
+	{
+		pxWheel->ulSlotsInUse[ uxLevel ] = 0UL;
+
+		for( uxSlot = 0; uxSlot < ( unsigned portBASE_TYPE ) wheelSLOTS_PER_LEVEL; uxSlot++ )
+		{
+			vListInitialise( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ) );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTimingWheelInsert( xTimingWheel *pxWheel, xListItem *pxNewListItem )
+{
+	/* Time pxWheel->xTime has already been processed, so an item that
+	expires now is moved on to the next tick. */
+	if( listGET_LIST_ITEM_VALUE( pxNewListItem ) == pxWheel->xTime )
+	{
+		listSET_LIST_ITEM_VALUE( pxNewListItem, ( portTickType ) ( pxWheel->xTime + ( portTickType ) 1 ) );
+	}
+
+	prvPlaceItem( pxWheel, pxNewListItem );
+}
+/*-----------------------------------------------------------*/
+
+xList *pxTimingWheelAdvance( xTimingWheel *pxWheel )
+{
+portTickType xTime;
+unsigned portBASE_TYPE uxLevel, uxSlot;
+
+	pxWheel->xTime++;
+	xTime = pxWheel->xTime;
+
+	/* A slot in level n starts when the slots of every level below n are
+	zero.  Count how many levels have reached the start of a slot... */
+	uxLevel = 0;
+	while( ( uxLevel < wheelTOP_LEVEL ) && ( wheelSLOT_OF( xTime, uxLevel ) == 0 ) )
+	{
+		uxLevel++;
+	}
+
+	/* ...then move the items in those slots down, starting with the highest
+	level so items can fall through more than one level in a single tick. */
+	while( uxLevel > ( unsigned portBASE_TYPE ) 0 )
+	{
+		prvCascadeSlot( pxWheel, uxLevel );
+		uxLevel--;
+	}
+
+	/* Every item in the level 0 slot for the current time has now expired.
+	The caller empties the list, so the slot will not be in use. */
+	uxSlot = wheelSLOT_OF( xTime, 0 );
+	pxWheel->ulSlotsInUse[ 0 ] &= ~( 1UL << uxSlot );
+
+	return &( pxWheel->xSlots[ 0 ][ uxSlot ] );
+}
+/*-----------------------------------------------------------*/
+
+portTickType xTimingWheelTicksToNextEvent( xTimingWheel *pxWheel )
+{
+unsigned portBASE_TYPE uxLevel, uxSlot, uxCurrentSlot;
+
+	/* Every slot in a lower level starts before any slot in a higher level
+	that is in use, so the first slot found in use is the next event. */
+	for( uxLevel = 0; uxLevel < ( unsigned portBASE_TYPE ) wheelNUMBER_OF_LEVELS; uxLevel++ )
+	{
+		uxCurrentSlot = wheelSLOT_OF( pxWheel->xTime, uxLevel );
+
+		/* Slots at or below the current slot have already been passed. */
+		for( uxSlot = uxCurrentSlot + 1; uxSlot < ( unsigned portBASE_TYPE ) wheelSLOTS_PER_LEVEL; uxSlot++ )
+		{
+			if( prvSlotIsInUse( pxWheel, uxLevel, uxSlot ) != pdFALSE )
+			{
+				return prvTicksToSlot( pxWheel, uxLevel, uxSlot );
+			}
+		}
+
+		if( uxLevel == wheelTOP_LEVEL )
+		{
+			/* Except in the top level, where the slots at or below the current
+			slot hold items that expire after the tick count has wrapped. */
+			for( uxSlot = 0; uxSlot <= uxCurrentSlot; uxSlot++ )
+			{
+				if( prvSlotIsInUse( pxWheel, uxLevel, uxSlot ) != pdFALSE )
+				{
+					return prvTicksToSlot( pxWheel, uxLevel, uxSlot );
+				}
+			}
+		}
+	}
+
+	return portMAX_DELAY;
+}
+/*-----------------------------------------------------------*/
+
+void vTimingWheelSkip( xTimingWheel *pxWheel, portTickType xTicksToSkip )
+{
+	/* Nothing needs to be cascaded or expired in the skipped ticks, so only
+	the time needs to be updated. */
+	configASSERT( xTicksToSkip < xTimingWheelTicksToNextEvent( pxWheel ) );
+	pxWheel->xTime += xTicksToSkip;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPlaceItem( xTimingWheel *pxWheel, xListItem *pxItem )
+{
+portTickType xExpiry, xDifference;
+unsigned portBASE_TYPE uxLevel, uxSlot;
+
+	xExpiry = listGET_LIST_ITEM_VALUE( pxItem );
+
+	if( xExpiry < pxWheel->xTime )
+	{
+		/* The expiry time has wrapped.  Hold the item in the top level until
+		the current time wraps too. */
+		uxLevel = wheelTOP_LEVEL;
+	}
+	else
+	{
+		/* Find the most significant group of bits that differs between the
+		expiry time and the current time.  The loop is bounded by the number
+		of levels, not the number of items. */
+		xDifference = ( portTickType ) ( ( xExpiry ^ pxWheel->xTime ) >> wheelSLOT_BITS );
+		uxLevel = 0;
+		while( xDifference != ( portTickType ) 0 )
+		{
+			xDifference = ( portTickType ) ( xDifference >> wheelSLOT_BITS );
+			uxLevel++;
+		}
+	}
+
+	uxSlot = wheelSLOT_OF( xExpiry, uxLevel );
+	vListInsertEnd( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ), pxItem );
+	pxWheel->ulSlotsInUse[ uxLevel ] |= ( 1UL << uxSlot );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCascadeSlot( xTimingWheel *pxWheel, unsigned portBASE_TYPE uxLevel )
+{
+unsigned portBASE_TYPE uxSlot;
+xList *pxSlot;
+xListItem *pxItem;
+
+	uxSlot = wheelSLOT_OF( pxWheel->xTime, uxLevel );
+
+	if( ( pxWheel->ulSlotsInUse[ uxLevel ] & ( 1UL << uxSlot ) ) != 0UL )
+	{
+		pxWheel->ulSlotsInUse[ uxLevel ] &= ~( 1UL << uxSlot );
+		pxSlot = &( pxWheel->xSlots[ uxLevel ][ uxSlot ] );
+
+		/* Every item in the slot now differs from the current time in a lower
+		level only, so each is placed in a lower level. */
+		while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+		{
+			pxItem = ( xListItem * ) pxSlot->xListEnd.pxNext;
+			vListRemove( pxItem );
+			prvPlaceItem( pxWheel, pxItem );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvSlotIsInUse( xTimingWheel *pxWheel, unsigned portBASE_TYPE uxLevel, unsigned portBASE_TYPE uxSlot )
+{
+portBASE_TYPE xReturn = pdFALSE;
+
+	if( ( pxWheel->ulSlotsInUse[ uxLevel ] & ( 1UL << uxSlot ) ) != 0UL )
+	{
+		if( listLIST_IS_EMPTY( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ) ) == pdFALSE )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			/* The items were removed with vListRemove(). */
+			pxWheel->ulSlotsInUse[ uxLevel ] &= ~( 1UL << uxSlot );
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static portTickType prvTicksToSlot( const xTimingWheel *pxWheel, unsigned portBASE_TYPE uxLevel, unsigned portBASE_TYPE uxSlot )
+{
+portTickType xSlotStart;
+
+	if( uxLevel == wheelTOP_LEVEL )
+	{
+		xSlotStart = ( portTickType ) ( ( portTickType ) uxSlot << ( uxLevel * wheelSLOT_BITS ) );
+	}
+	else
+	{
+		/* Keep the bits of the current time above this level, and replace
+		this level and those below it with the start of the slot. */
+		xSlotStart = ( portTickType ) ( pxWheel->xTime & ~( portTickType ) ( ( ( portTickType ) 1 << ( ( uxLevel + 1 ) * wheelSLOT_BITS ) ) - ( portTickType ) 1 ) );
+		xSlotStart |= ( portTickType ) ( ( portTickType ) uxSlot << ( uxLevel * wheelSLOT_BITS ) );
+	}
+
+	/* The subtraction wraps correctly for slots that start after the tick
+	count has wrapped. */
+	return ( portTickType ) ( xSlotStart - pxWheel->xTime );
+}
+
+#endif /* configUSE_TIMING_WHEEL */
+
@@ -47,7 +47,9 @@
 
 #include "FreeRTOS.h"
 #include "task.h"
-#include "queue.h"
+#include "timers.h"
+#include "semphr.h"
+#include "stream_buffer.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -94,7 +96,12 @@ static TLineCoding LineCoding = {115200, 0, 0, 8};
 static unsigned char abBulkBuf[64];
 static unsigned char abClassReqData[8];
 
-static xQueueHandle xRxedChars = NULL, xCharsForTx = NULL;
+/* Byte streams between the USB interrupt and the tasks.  A stream buffer allows
+only one writer and one reader, so a whole packet is moved with a single copy
+rather than one queue operation per character.  Any task can print, so the
+writers of xCharsForTx take xTxMutex around each send. */
+static xStreamBufferHandle xRxedChars = NULL, xCharsForTx = NULL;
+static xSemaphoreHandle xTxMutex = NULL;
 
 // forward declaration of interrupt handler
 void USBIntHandler(void);
@@ -220,16 +227,16 @@ static const unsigned char abDescriptors[] = {
  */
 static void BulkOut(unsigned char bEP, unsigned char bEPStatus)
 {
-	int i, iLen;
+	int iLen;
 	long lHigherPriorityTaskWoken = pdFALSE;
 
 	( void ) bEPStatus;
 
 	// get data from USB into intermediate buffer
 	iLen = USBHwEPRead(bEP, abBulkBuf, sizeof(abBulkBuf));
-	for (i = 0; i < iLen; i++) {
-		// put into queue
-		xQueueSendFromISR( xRxedChars, &( abBulkBuf[ i ] ), &lHigherPriorityTaskWoken );
+	if (iLen > 0) {
+		// put the whole packet into the receive stream
+		xStreamBufferSendFromISR( xRxedChars, abBulkBuf, ( size_t ) iLen, &lHigherPriorityTaskWoken );
 	}
 
 	portEND_SWITCHING_ISR( lHigherPriorityTaskWoken );
@@ -244,25 +251,19 @@ static void BulkOut(unsigned char bEP, unsigned char bEPStatus)
  */
 static void BulkIn(unsigned char bEP, unsigned char bEPStatus)
 {
-	int i, iLen;
+	int iLen;
 	long lHigherPriorityTaskWoken = pdFALSE;
 
 	( void ) bEPStatus;
 
-	if (uxQueueMessagesWaitingFromISR( xCharsForTx ) == 0) {
+	if (xStreamBufferIsEmpty( xCharsForTx ) != pdFALSE) {
 		// no more data, disable further NAK interrupts until next USB frame
 		USBHwNakIntEnable(0);
 		return;
 	}
 
-	// get bytes from transmit FIFO into intermediate buffer
-	for (i = 0; i < MAX_PACKET_SIZE; i++) {
-		if( xQueueReceiveFromISR( xCharsForTx, ( &abBulkBuf[i] ), &lHigherPriorityTaskWoken ) != pdPASS )
-		{
-			break;
-		}
-	}
-	iLen = i;
+	// get up to a packet of bytes from transmit FIFO into intermediate buffer
+	iLen = ( int ) xStreamBufferReceiveFromISR( xCharsForTx, abBulkBuf, MAX_PACKET_SIZE, &lHigherPriorityTaskWoken );
 
 	// send over USB
 	if (iLen > 0) {
@@ -325,8 +326,15 @@ DBG("SET_CONTROL_LINE_STATE %X\n", pSetup->wValue);
 int VCOM_putchar(int c)
 {
 char cc = ( char ) c;
+size_t xSent;
 
-	if( xQueueSend( xCharsForTx, &cc, usbMAX_SEND_BLOCK ) == pdPASS )
+	/* The holder never blocks for longer than usbMAX_SEND_BLOCK per send, so
+	waiting indefinitely for the mutex cannot deadlock. */
+	xSemaphoreTake( xTxMutex, portMAX_DELAY );
+	xSent = xStreamBufferSend( xCharsForTx, &cc, sizeof( cc ), usbMAX_SEND_BLOCK );
+	xSemaphoreGive( xTxMutex );
+
+	if( xSent == sizeof( cc ) )
 	{
 		return c;
 	}
@@ -342,6 +350,46 @@ int writeUSBChar(char c)
 	return(VCOM_putchar(c));
 }
 
+/**
+	Writes a block of bytes to the VCOM port
+
+	The stream buffer is smaller than a packet of binary data, so the block is
+	written a buffer's worth at a time.  The Tx mutex is held for the whole
+	block, so characters written by other tasks are not mixed into it.
+
+	@param [in] buf bytes to write
+	@param [in] len number of bytes to write
+	@returns number of bytes written, which is less than len if the host stopped reading
+ */
+int writeUSBBuffer(const char *buf, int len)
+{
+int sent = 0;
+size_t chunk, written;
+
+	xSemaphoreTake( xTxMutex, portMAX_DELAY );
+
+	while( sent < len )
+	{
+		chunk = ( size_t ) ( len - sent );
+		if( chunk > usbBUFFER_LEN )
+		{
+			chunk = usbBUFFER_LEN;
+		}
+
+		written = xStreamBufferSend( xCharsForTx, buf + sent, chunk, usbMAX_SEND_BLOCK );
+		sent += ( int ) written;
+
+		if( written < chunk )
+		{
+			break;
+		}
+	}
+
+	xSemaphoreGive( xTxMutex );
+
+	return sent;
+}
+
 
 /**
 	Reads one character from VCOM port
@@ -353,7 +401,7 @@ int VCOM_getchar(void)
 	unsigned char c;
 
 	/* Block the task until a character is available. */
-	xQueueReceive( xRxedChars, &c, portMAX_DELAY );
+	while( xStreamBufferReceive( xRxedChars, &c, sizeof( c ), portMAX_DELAY ) == 0 );
 	return c;
 }
 
@@ -380,7 +428,7 @@ static void USBFrameHandler(unsigned short wFrame)
 {
 	( void ) wFrame;
 
-	if( uxQueueMessagesWaitingFromISR( xCharsForTx ) > 0 )
+	if( xStreamBufferIsEmpty( xCharsForTx ) == pdFALSE )
 	{
 		// data available, enable NAK interrupt on bulk in
 		USBHwNakIntEnable(INACK_BI);
@@ -413,33 +461,47 @@ unsigned long CPUcpsie(void)
 void initUSB()
 {
 	if (xRxedChars == NULL) {
-		xRxedChars = xQueueCreate( usbBUFFER_LEN, sizeof( char ) );
+		xRxedChars = xStreamBufferCreate( usbBUFFER_LEN, 1 );
 	}
 	if (xCharsForTx == NULL) {
-		xCharsForTx = xQueueCreate( usbBUFFER_LEN, sizeof( char ) );
+		xCharsForTx = xStreamBufferCreate( usbBUFFER_LEN, 1 );
+	}
+	if (xTxMutex == NULL) {
+		xTxMutex = xSemaphoreCreateMutex();
 	}
 }
 
-void vUSBTask( void *pvParameters )
-{
-	//int c;
+/**
+	Brings up the USB stack and connects to the bus.  Pended to the timer
+	service task with xTimerPendFunctionCall(), as it only has to run once -
+	after that everything happens in the USB interrupt, so a task (and a stack)
+	of its own would spend its whole life suspended.
 
-	/* Just to prevent compiler warnings about the unused parameter. */
-	( void ) pvParameters;
+	@param [in] pvParameter1 not used
+	@param [in] ulParameter2 not used
+ */
+void vUSBStart( void *pvParameter1, unsigned long ulParameter2 )
+{
+	/* Just to prevent compiler warnings about the unused parameters. */
+	( void ) pvParameter1;
+	( void ) ulParameter2;
 	DBG("Initialising USB stack\n");
 
 	if (xRxedChars == NULL) {
-		xRxedChars = xQueueCreate( usbBUFFER_LEN, sizeof( char ) );
+		xRxedChars = xStreamBufferCreate( usbBUFFER_LEN, 1 );
 	}
 	if (xCharsForTx == NULL) {
-		xCharsForTx = xQueueCreate( usbBUFFER_LEN, sizeof( char ) );
+		xCharsForTx = xStreamBufferCreate( usbBUFFER_LEN, 1 );
+	}
+	if (xTxMutex == NULL) {
+		xTxMutex = xSemaphoreCreateMutex();
 	}
 
-	if( ( xRxedChars == NULL ) || ( xCharsForTx == NULL ) )
+	if( ( xRxedChars == NULL ) || ( xCharsForTx == NULL ) || ( xTxMutex == NULL ) )
 	{
-		/* Not enough heap available to create the buffer queues, can't do
-		anything so just delete ourselves. */
-		vTaskDelete( NULL );
+		/* Not enough heap available to create the stream buffers, can't do
+		anything so leave the USB disconnected. */
+		return;
 	}
 
 
@@ -472,22 +534,5 @@ void vUSBTask( void *pvParameters )
 
 	DBG("Connecting to USB bus\n");
 	USBHwConnect(TRUE);
-	// put this task to sleep -- we don't really need a task at all
-	vTaskSuspend(xTaskGetCurrentTaskHandle());
-	for( ;; )
-	{	
-	}
-	// Below is the old version of this task (which was just an echo thing)
-	// echo any character received (do USB stuff in interrupt)
-	/*for( ;; )
-	{
-		c = VCOM_getchar();
-		if (c != EOF)
-		{
-			// Echo character back with INCREMENT_ECHO_BY offset, so for example if
-			// INCREMENT_ECHO_BY is 1 and 'A' is received, 'B' will be echoed back.
-			VCOM_putchar(c + INCREMENT_ECHO_BY );
-		}		 
-	}  	*/
 }
 
@@ -1,6 +1,9 @@
 #ifndef extUSB_H
 #define extUSB_H
 int writeUSBChar(char c);
+int writeUSBBuffer(const char *buf, int len);
 char readUSBInputBuffer();
 void initUSB();
+// Pend to the timer service task to bring up the USB stack
+void vUSBStart(void *pvParameter1, unsigned long ulParameter2);
 #endif
\ No newline at end of file
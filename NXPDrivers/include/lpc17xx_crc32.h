@@ -0,0 +1,63 @@
+/***********************************************************************//**
+ * @file		lpc17xx_crc32.h
+ * @brief		Contains the function prototypes for the table driven
+ * 				CRC-32 (IEEE 802.3) calculation shared by the LPC17xx drivers
+ **************************************************************************
+ * Written for this project, not taken from the NXP firmware library.
+ **************************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup CRC32 CRC32
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC17XX_CRC32_H_
+#define LPC17XX_CRC32_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup CRC32_Public_Macros CRC32 Public Macros
+ * @{
+ */
+
+/** Initial CRC register value for a new CRC-32 calculation */
+#define CRC32_INIT_VALUE		(0xFFFFFFFFUL)
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup CRC32_Public_Functions CRC32 Public Functions
+ * @{
+ */
+
+uint32_t CRC32_Update(uint32_t crc, const uint8_t *data, uint32_t len);
+uint32_t CRC32_Calc(const uint8_t *data, uint32_t len);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC17XX_CRC32_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
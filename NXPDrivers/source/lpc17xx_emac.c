@@ -25,6 +25,7 @@
 /* Includes ------------------------------------------------------------------- */
 #include "lpc17xx_emac.h"
 #include "lpc17xx_clkpwr.h"
+#include "lpc17xx_crc32.h"
 
 /* If this source file built with example, the LPC17xx FW library configuration
  * file in each example directory ("lpc17xx_libcfg.h") must be included,
@@ -219,40 +220,12 @@ static void setEmacAddr(uint8_t abStationAddr[])
  **********************************************************************/
 static int32_t emac_CRCCalc(uint8_t frame_no_fcs[], int32_t frame_len)
 {
-	int i; 		// iterator
-	int j; 		// another iterator
-	char byte; 	// current byte
-	int crc; 	// CRC result
-	int q0, q1, q2, q3; // temporary variables
-	crc = 0xFFFFFFFF;
-	for (i = 0; i < frame_len; i++) {
-		byte = *frame_no_fcs++;
-		for (j = 0; j < 2; j++) {
-			if (((crc >> 28) ^ (byte >> 3)) & 0x00000001) {
-				q3 = 0x04C11DB7;
-			} else {
-				q3 = 0x00000000;
-			}
-			if (((crc >> 29) ^ (byte >> 2)) & 0x00000001) {
-				q2 = 0x09823B6E;
-			} else {
-				q2 = 0x00000000;
-			}
-			if (((crc >> 30) ^ (byte >> 1)) & 0x00000001) {
-				q1 = 0x130476DC;
-			} else {
-				q1 = 0x00000000;
-			}
-			if (((crc >> 31) ^ (byte >> 0)) & 0x00000001) {
-				q0 = 0x2608EDB8;
-			} else {
-				q0 = 0x00000000;
-			}
-			crc = (crc << 4) ^ q3 ^ q2 ^ q1 ^ q0;
-			byte >>= 4;
-		}
-	}
-	return crc;
+	uint32_t crc;
+
+	crc = CRC32_Update(CRC32_INIT_VALUE, frame_no_fcs, (uint32_t)frame_len);
+	/* The table driven CRC keeps the register LSB first, the hash filter
+	 * bit numbering expects it MSB first */
+	return (int32_t)__RBIT(crc);
 }
 /* End of Private Functions --------------------------------------------------- */
 
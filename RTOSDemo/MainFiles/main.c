@@ -4,6 +4,7 @@
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "timers.h"
 #include "system_LPC17xx.h"
 
 #ifndef   PCONP_PCTIM0
@@ -22,6 +23,10 @@ You should read the note above.
 #define USE_NAVIGATION_TASK 1
 // Define whether to use my USB task
 #define USE_MTJ_USE_USB 0
+// Define whether to run the kernel benchmarks (the results are printed as lines of JSON, see KernelBench.c)
+#define USE_KERNEL_BENCHMARKS 0
+// Define whether to send task snapshots to the host over USB (see vtTaskMon.h; needs USE_MTJ_USE_USB)
+#define USE_TASK_MONITOR 0
 
 #include "partest.h"
 
@@ -38,6 +43,12 @@ You should read the note above.
 /* syscalls initialization -- *must* occur first */
 #include "syscalls.h"
 #include "extUSB.h"
+#if USE_KERNEL_BENCHMARKS == 1
+#include "KernelBench.h"
+#endif
+#if USE_TASK_MONITOR == 1
+#include "vtTaskMon.h"
+#endif
 #include <stdio.h>
 /*-----------------------------------------------------------*/
 
@@ -57,10 +68,12 @@ tick hook). */
 #define mainLCD_TASK_PRIORITY				( tskIDLE_PRIORITY)
 #define mainI2CTEMP_TASK_PRIORITY			( tskIDLE_PRIORITY)
 #define mainI2CSENSOR_TASK_PRIORITY			( tskIDLE_PRIORITY)
-#define mainUSB_TASK_PRIORITY				( tskIDLE_PRIORITY)
 #define mainI2CMONITOR_TASK_PRIORITY		( tskIDLE_PRIORITY)
 #define mainCONDUCTOR_TASK_PRIORITY			( tskIDLE_PRIORITY)
 #define mainNAVIGATION_TASK_PRIORITY		( tskIDLE_PRIORITY)
+#define mainKERNEL_BENCH_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define mainTASK_MONITOR_PRIORITY			( tskIDLE_PRIORITY )
+#define mainTASK_MONITOR_PERIOD				( ( portTickType ) 1000 / portTICK_RATE_MS )
 
 /* The WEB server has a larger stack as it utilises stack hungry string
 handling library calls. */
@@ -83,11 +96,6 @@ static void prvSetupHardware( void );
  */
 extern void vuIP_Task( void *pvParameters );
 
-/*
- * The task that handles the USB stack.
- */
-extern void vUSBTask( void *pvParameters );
-
 /*
  * Simply returns the current status message for display on served WEB pages.
  */
@@ -142,6 +150,16 @@ int main( void )
 	/* Configure the hardware for use by this demo. */
 	prvSetupHardware();
 
+	#if configUSE_TRACE_RECORDER == 1
+	// Start the kernel trace recorder before any tasks are created so that their names are captured
+	vtTraceInit();
+	#endif
+
+	#if USE_KERNEL_BENCHMARKS == 1
+	// The benchmark tasks run above the priority of the other tasks, so they are only disturbed by interrupts
+	vStartKernelBenchmarks(mainKERNEL_BENCH_PRIORITY);
+	#endif
+
 	#if USE_WEB_SERVER == 1
 	// Not a standard demo -- but also not one of mine (MTJ)
 	/* Create the uIP task.  The WEB server runs in this task. */
@@ -238,10 +256,19 @@ int main( void )
 	vStartConductorTask(&conductorData,mainCONDUCTOR_TASK_PRIORITY,&vtI2C0,&infraredSensorData,NULL);
 	#endif
 
-    /* Create the USB task. MTJ: This routine has been modified from the original example (which is not a FreeRTOS standard demo) */
+    /* Start USB. MTJ: This routine has been modified from the original example (which is not a FreeRTOS standard demo) */
 	#if USE_MTJ_USE_USB == 1
 	initUSB();  // MTJ: This is my routine used to make sure we can do printf() with USB
-    xTaskCreate( vUSBTask, ( signed char * ) "USB", configMINIMAL_STACK_SIZE, ( void * ) NULL, mainUSB_TASK_PRIORITY, NULL );
+	// The USB stack is brought up by the timer service task once the scheduler starts, rather than by a task of its own
+	if (xTimerPendFunctionCall( vUSBStart, NULL, 0, 0 ) != pdPASS) {
+		VT_HANDLE_FATAL_ERROR(0);
+	}
+	#if USE_TASK_MONITOR == 1
+	// Send a binary snapshot of the tasks to the host every mainTASK_MONITOR_PERIOD
+	if (vtTaskMonStartUSB(mainTASK_MONITOR_PRIORITY,mainTASK_MONITOR_PERIOD) != pdPASS) {
+		VT_HANDLE_FATAL_ERROR(0);
+	}
+	#endif
 	#endif
 	
 	/* Start the scheduler. */
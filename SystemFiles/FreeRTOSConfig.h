@@ -69,7 +69,7 @@
 
 #define configUSE_PREEMPTION		1
 #define configUSE_IDLE_HOOK			1
-#define configMAX_PRIORITIES		( ( unsigned portBASE_TYPE ) 5 )
+#define configMAX_PRIORITIES		( 5 )
 #define configUSE_TICK_HOOK			1
 // Old Definition -- changed by MTJ because it didn't make sense to him... #define configCPU_CLOCK_HZ			( ( unsigned long ) 99000000 )
 #define configCPU_CLOCK_HZ			( ( unsigned long ) 100000000 )	// 100Mhz
@@ -92,6 +92,53 @@
 #define configQUEUE_REGISTRY_SIZE		10
 #define configGENERATE_RUN_TIME_STATS	1
 
+/* Select the next task to run with the Cortex-M3 CLZ instruction rather than
+by walking down the ready lists.  Requires configMAX_PRIORITIES <= 32. */
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
+
+/* Stop the SysTick interrupt while the idle task runs and sleep until the next
+task is due to unblock, instead of waking every tick. */
+#define configUSE_TICKLESS_IDLE					1
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP	2
+
+/* Allow tasks to be unblocked by a notification sent directly to them, without
+the need for a separate semaphore or queue. */
+#define configUSE_TASK_NOTIFICATIONS			1
+
+/* Allow a task to block on several queues and semaphores at once.  The uIP task
+uses a queue set to wait for both Ethernet and application events. */
+#define configUSE_QUEUE_SETS					1
+
+/* Set to 1 to hold delayed tasks and active software timers in a hierarchical
+timing wheel (timing_wheel.c) instead of sorted lists, making blocking O(1)
+however many tasks are delayed.  Each level of the wheel has
+2^configTIMING_WHEEL_SLOT_BITS slots. */
+#define configUSE_TIMING_WHEEL					0
+#define configTIMING_WHEEL_SLOT_BITS			4
+
+/* Software timers.  The timer service (daemon) task also runs the interrupt
+processing that the I2C, USB and Ethernet drivers defer to it with
+xTimerPendFunctionCallFromISR(), in place of a task per driver.  It therefore
+runs above every application task, and its stack is sized for the I2C driver
+calls it makes. */
+#define configUSE_TIMERS						1
+#define configTIMER_TASK_PRIORITY				( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH				10
+#define configTIMER_TASK_STACK_DEPTH			( configMINIMAL_STACK_SIZE * 3 )
+
+/* Set to 1 to make the xTaskCreateStatic(), xQueueCreateStatic() and similar
+functions available.  The application must then also provide
+vApplicationGetIdleTaskMemory() and vApplicationGetTimerTaskMemory(). */
+#define configSUPPORT_STATIC_ALLOCATION			0
+
+/* Set to 1 to record kernel events with the vtTrace recorder (vtCode/vtTrace).
+vtTrace.h maps the trace macros onto the recorder, and selects whether the
+records go to a RAM ring or out of the ITM port. */
+#define configUSE_TRACE_RECORDER				0
+#if configUSE_TRACE_RECORDER == 1
+	#include "vtTrace.h"
+#endif
+
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 
@@ -104,6 +151,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay					1
 #define INCLUDE_uxTaskGetStackHighWaterMark	1
 #define	INCLUDE_xTaskGetSchedulerState		1
+#define INCLUDE_xTaskGetCurrentTaskHandle	1
 
 /*-----------------------------------------------------------
  * Ethernet configuration.
@@ -158,6 +206,19 @@ extern void vConfigureTimerForRunTimeStats( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vConfigureTimerForRunTimeStats()
 #define portGET_RUN_TIME_COUNTER_VALUE() TIM0->TC
 
+/*-----------------------------------------------------------
+ * Macros required to time the kernel benchmarks (KernelBench.c).
+ *-----------------------------------------------------------*/
+/* The DWT cycle counter is used, so the benchmark times are in CPU cycles.
+The counter is enabled through DEMCR.TRCENA then DWT_CTRL.CYCCNTENA. */
+#define benchCONFIGURE_TIMESTAMP() \
+	do { \
+		*( ( volatile unsigned long * ) 0xE000EDFCUL ) |= 0x01000000UL; \
+		*( ( volatile unsigned long * ) 0xE0001000UL ) |= 0x00000001UL; \
+	} while( 0 )
+#define benchGET_TIMESTAMP() ( *( ( volatile unsigned long * ) 0xE0001004UL ) )
+#define benchTIMESTAMP_HZ configCPU_CLOCK_HZ
+
 
 /* The structure that is passed on the xLCDQueue.  Put here for convenience. */
 typedef struct
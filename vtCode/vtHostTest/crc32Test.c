@@ -0,0 +1,162 @@
+// crc32Test -- checks the table driven CRC-32 in NXPDrivers/source/lpc17xx_crc32.c
+//
+// CRC32_Calc is checked against the standard CRC-32 check values, split CRC32_Update calls against
+//   a single call, and a frame followed by its FCS against the IEEE 802.3 residue.
+//
+// lpc17xx_emac.c used to compute the CRC for its hash filter a nibble at a time.  That code is kept
+//   below, and emac_CRCCalc's replacement (CRC32_Update, then a bit reversal - __RBIT on the target)
+//   is compared with it on random frames at unaligned offsets.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "lpc17xx_crc32.h"
+
+#define maxErrorsShown 10
+#define frameCases 200000
+#define maxFrameLen 64
+#define maxOffset 8
+
+// The CRC left in the register after a frame and its own FCS have been run through it
+#define crc32Residue 0xDEBB20E3UL
+
+static int errors = 0;
+static long cases = 0;
+
+static const struct {
+	const char *data;
+	uint32_t crc;
+} vectors[] = {
+	{ "", 0x00000000UL },
+	{ "a", 0xE8B7BE43UL },
+	{ "abc", 0x352441C2UL },
+	{ "123456789", 0xCBF43926UL },
+	{ "message digest", 0x20159D7FUL },
+	{ "The quick brown fox jumps over the lazy dog", 0x414FA339UL },
+};
+
+// emac_CRCCalc from lpc17xx_emac.c before the table driven CRC was added
+static int32_t oldEmacCRCCalc(uint8_t frame_no_fcs[], int32_t frame_len)
+{
+	int i; 		// iterator
+	int j; 		// another iterator
+	char byte; 	// current byte
+	int crc; 	// CRC result
+	int q0, q1, q2, q3; // temporary variables
+	crc = 0xFFFFFFFF;
+	for (i = 0; i < frame_len; i++) {
+		byte = *frame_no_fcs++;
+		for (j = 0; j < 2; j++) {
+			if (((crc >> 28) ^ (byte >> 3)) & 0x00000001) {
+				q3 = 0x04C11DB7;
+			} else {
+				q3 = 0x00000000;
+			}
+			if (((crc >> 29) ^ (byte >> 2)) & 0x00000001) {
+				q2 = 0x09823B6E;
+			} else {
+				q2 = 0x00000000;
+			}
+			if (((crc >> 30) ^ (byte >> 1)) & 0x00000001) {
+				q1 = 0x130476DC;
+			} else {
+				q1 = 0x00000000;
+			}
+			if (((crc >> 31) ^ (byte >> 0)) & 0x00000001) {
+				q0 = 0x2608EDB8;
+			} else {
+				q0 = 0x00000000;
+			}
+			crc = (crc << 4) ^ q3 ^ q2 ^ q1 ^ q0;
+			byte >>= 4;
+		}
+	}
+	return crc;
+}
+
+// What __RBIT does on the Cortex-M3
+static uint32_t reverseBits(uint32_t v)
+{
+	uint32_t r = 0;
+	int i;
+
+	for (i = 0; i < 32; i++) {
+		r = (r << 1) | (v & 1);
+		v >>= 1;
+	}
+	return r;
+}
+
+static void fail(const char *fmt, uint32_t a, uint32_t b, uint32_t c)
+{
+	if (errors < maxErrorsShown) {
+		printf(fmt, a, b, c);
+	}
+	errors++;
+}
+
+static void testVectors(void)
+{
+	uint32_t crc;
+	unsigned i;
+
+	for (i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+		crc = CRC32_Calc((const uint8_t *) vectors[i].data, strlen(vectors[i].data));
+		if (crc != vectors[i].crc) {
+			fail("CRC32_Calc: vector %u: expected %08x, got %08x\n", i, vectors[i].crc, crc);
+		}
+		cases++;
+	}
+}
+
+static void testFrames(void)
+{
+	static uint8_t buf[maxOffset + maxFrameLen + 4];
+	uint8_t *frame;
+	uint32_t crc, split, oldCrc, newCrc;
+	int len, offset, cut, i;
+	long k;
+
+	for (k = 0; k < frameCases; k++) {
+		offset = rand() % maxOffset;
+		len = rand() % (maxFrameLen + 1);
+		frame = buf + offset;
+		for (i = 0; i < len; i++) {
+			frame[i] = (uint8_t) rand();
+		}
+
+		// One call and two calls over the same bytes must agree
+		crc = CRC32_Update(CRC32_INIT_VALUE, frame, len);
+		cut = (len > 0) ? rand() % (len + 1) : 0;
+		split = CRC32_Update(CRC32_Update(CRC32_INIT_VALUE, frame, cut), frame + cut, len - cut);
+		if (split != crc) {
+			fail("CRC32_Update: length %u split at %u: got %08x\n", len, cut, split);
+		}
+
+		// The FCS is the complemented register, sent least significant byte first
+		crc = ~crc;
+		for (i = 0; i < 4; i++) {
+			frame[len + i] = (uint8_t) (crc >> (8 * i));
+		}
+		crc = CRC32_Update(CRC32_INIT_VALUE, frame, len + 4);
+		if (crc != crc32Residue) {
+			fail("CRC32_Update: length %u with FCS: expected %08x, got %08x\n", len, crc32Residue, crc);
+		}
+
+		oldCrc = (uint32_t) oldEmacCRCCalc(frame, len);
+		newCrc = reverseBits(CRC32_Update(CRC32_INIT_VALUE, frame, len));
+		if (newCrc != oldCrc) {
+			fail("emac_CRCCalc: length %u: expected %08x, got %08x\n", len, oldCrc, newCrc);
+		}
+		cases += 3;
+	}
+}
+
+int main(void)
+{
+	srand(3);
+	testVectors();
+	testFrames();
+	printf("crc32Test: %ld cases, %d errors\n", cases, errors);
+	return (errors == 0) ? 0 : 1;
+}
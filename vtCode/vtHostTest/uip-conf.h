@@ -0,0 +1,42 @@
+// uIP configuration for building the web server's uIP code on the host (see Makefile).
+//
+// The values match FreeRTOS/Demo/CORTEX_LPC1768_GCC_Rowley/webserver/uip-conf.h, except:
+//   - the byte order is given as UIP_LITTLE_ENDIAN.  The target file says LITTLE_ENDIAN, which the
+//     Keil and Rowley headers leave undefined (so it compares as 0, which uIP also treats as little
+//     endian), but which glibc defines as 1234.
+//   - UIP_CONF_ARPTAB_SIZE and the UIP_ARCH_ options can be overridden on the command line, so the
+//     ARP table can be tested at several sizes and uip.c can be built with its generic checksum.
+#ifndef __UIP_CONF_H__
+#define __UIP_CONF_H__
+
+#include <stdint.h>
+
+#define UIP_CONF_EXTERNAL_BUFFER
+
+typedef uint8_t u8_t;
+typedef uint16_t u16_t;
+typedef uint32_t u32_t;
+typedef unsigned short uip_stats_t;
+
+#define UIP_CONF_MAX_CONNECTIONS 40
+#define UIP_CONF_MAX_LISTENPORTS 40
+#ifndef UIP_CONF_ARPTAB_SIZE
+#define UIP_CONF_ARPTAB_SIZE     64
+#endif
+#define UIP_CONF_BUFFER_SIZE     1480
+#define UIP_CONF_BYTE_ORDER      UIP_LITTLE_ENDIAN
+#define UIP_CONF_LOGGING         0
+#define UIP_CONF_UDP             0
+#define UIP_CONF_UDP_CHECKSUMS   1
+#define UIP_CONF_STATISTICS      1
+
+#ifndef UIP_ARCH_CHKSUM
+#define UIP_ARCH_CHKSUM          1
+#endif
+#ifndef UIP_ARCH_ADD32
+#define UIP_ARCH_ADD32           1
+#endif
+
+#include "webserver.h"
+
+#endif /* __UIP_CONF_H__ */
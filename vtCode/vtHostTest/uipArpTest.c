@@ -0,0 +1,196 @@
+// uipArpTest -- checks the hashed, least recently used uIP ARP table
+//   (FreeRTOS/Demo/Common/ethernet/uIP/uip-1.0/uip/uip_arp.c) against a reference model
+//
+// The model is a plain array searched linearly.  Each entry records when it was last used, for
+//   eviction, and when it was last refreshed, for ageing.  A random mix of ARP replies (which add
+//   or refresh an entry), outgoing IP packets (which look an entry up and mark it used) and timer
+//   ticks is fed to both, and every lookup must give the same answer.  The hosts are drawn from a
+//   range a little larger than the table, so entries are evicted all the time.
+//
+// The first round starts from the zeroed static table, as the demos do (none call uip_arp_init()),
+//   and the second from uip_arp_init().  The Makefile builds the test once for each table size.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "uip.h"
+#include "uip_arp.h"
+
+#define maxErrorsShown 10
+#define rounds 2
+#define opsPerRound 2000000L
+
+// Percentages of each operation (the rest are timer ticks)
+#define replyPercent 40
+#define sendPercent 59
+
+#define tableSize UIP_ARPTAB_SIZE
+#define hostRange ((tableSize + tableSize / 2 + 2 > 253) ? 253 : tableSize + tableSize / 2 + 2)
+
+// uIP needs an application, but none of it runs here
+void httpd_appcall(void) {}
+
+static u32_t frame[(UIP_BUFSIZE + 3) / 4];
+u8_t *uip_buf = (u8_t *) frame;
+
+// An ARP packet as uip_arp.c expects to find it in uip_buf
+struct arpPacket {
+	struct uip_eth_hdr eth;
+	u16_t hwtype, protocol;
+	u8_t hwlen, protolen;
+	u16_t opcode;
+	struct uip_eth_addr shwaddr;
+	u16_t sipaddr[2];
+	struct uip_eth_addr dhwaddr;
+	u16_t dipaddr[2];
+} __attribute__((packed));
+
+// The reference model.  Hosts are 192.168.0.host and the MAC address is the host's "mac" byte
+//   repeated, so one byte identifies each.
+static struct {
+	int used;
+	u8_t host;
+	u8_t mac;
+	unsigned long lastUse;
+	u8_t refreshed;
+} model[tableSize];
+static unsigned long modelClock;
+static u8_t modelArpTime;
+
+static int modelFind(u8_t host)
+{
+	int i;
+
+	for (i = 0; i < tableSize; i++) {
+		if (model[i].used && model[i].host == host) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static void modelUpdate(u8_t host, u8_t mac)
+{
+	int i, j;
+
+	i = modelFind(host);
+	if (i < 0) {
+		for (i = 0; i < tableSize && model[i].used; i++) {
+		}
+		if (i == tableSize) {
+			// Full, so evict the least recently used entry
+			i = 0;
+			for (j = 1; j < tableSize; j++) {
+				if (model[j].lastUse < model[i].lastUse) {
+					i = j;
+				}
+			}
+		}
+	}
+	model[i].used = 1;
+	model[i].host = host;
+	model[i].mac = mac;
+	model[i].lastUse = ++modelClock;
+	model[i].refreshed = modelArpTime;
+}
+
+// Returns the MAC byte for the host, or -1 if it is not in the table
+static int modelSend(u8_t host)
+{
+	int i = modelFind(host);
+
+	if (i < 0) {
+		return -1;
+	}
+	model[i].lastUse = ++modelClock;
+	return model[i].mac;
+}
+
+static void modelTimer(void)
+{
+	int i;
+
+	++modelArpTime;
+	for (i = 0; i < tableSize; i++) {
+		if (model[i].used && (u8_t) (modelArpTime - model[i].refreshed) >= UIP_ARP_MAXAGE) {
+			model[i].used = 0;
+		}
+	}
+}
+
+static void arpReply(u8_t host, u8_t mac)
+{
+	struct arpPacket *arp = (struct arpPacket *) uip_buf;
+
+	memset(frame, 0, sizeof(frame));
+	arp->opcode = HTONS(2);
+	uip_ipaddr(arp->sipaddr, 192, 168, 0, host);
+	uip_ipaddr_copy(arp->dipaddr, uip_hostaddr);
+	memset(arp->shwaddr.addr, mac, sizeof(arp->shwaddr.addr));
+	uip_len = sizeof(struct arpPacket);
+	uip_arp_arpin();
+}
+
+// Returns the MAC byte uip_arp_out() addressed the packet to, or -1 if it sent an ARP request
+static int ipSend(u8_t host)
+{
+	struct uip_tcpip_hdr *ip = (struct uip_tcpip_hdr *) &uip_buf[UIP_LLH_LEN];
+	struct uip_eth_hdr *eth = (struct uip_eth_hdr *) uip_buf;
+
+	memset(frame, 0, sizeof(frame));
+	uip_ipaddr(ip->destipaddr, 192, 168, 0, host);
+	uip_len = UIP_IPTCPH_LEN;
+	uip_arp_out();
+	if (eth->type == HTONS(UIP_ETHTYPE_ARP)) {
+		return -1;
+	}
+	return eth->dest.addr[0];
+}
+
+int main(void)
+{
+	uip_ipaddr_t addr;
+	int round, op, got, expected, errors = 0;
+	u8_t host, mac;
+	long n, ops = 0;
+
+	uip_ipaddr(addr, 192, 168, 0, 200);
+	uip_sethostaddr(addr);
+	uip_ipaddr(addr, 255, 255, 255, 0);
+	uip_setnetmask(addr);
+	uip_ipaddr(addr, 192, 168, 0, 1);
+	uip_setdraddr(addr);
+
+	srand(7);
+	for (round = 0; round < rounds; round++) {
+		if (round > 0) {
+			uip_arp_init();
+			memset(model, 0, sizeof(model));
+		}
+		for (n = 0; n < opsPerRound; n++) {
+			op = rand() % 100;
+			host = (u8_t) (1 + rand() % hostRange);
+			if (op < replyPercent) {
+				mac = (u8_t) rand();
+				arpReply(host, mac);
+				modelUpdate(host, mac);
+			} else if (op < replyPercent + sendPercent) {
+				got = ipSend(host);
+				expected = modelSend(host);
+				if (got != expected) {
+					if (errors < maxErrorsShown) {
+						printf("round %d op %ld: send to host %u: expected %d, got %d\n",
+							round, n, host, expected, got);
+					}
+					errors++;
+				}
+			} else {
+				uip_arp_timer();
+				modelTimer();
+			}
+			ops++;
+		}
+	}
+	printf("uipArpTest: table size %d, %d buckets: %ld operations, %d errors\n",
+		tableSize, UIP_ARPTAB_HASHSIZE, ops, errors);
+	return (errors == 0) ? 0 : 1;
+}
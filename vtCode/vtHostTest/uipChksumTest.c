@@ -0,0 +1,159 @@
+// uipChksumTest -- checks the word-at-a-time uIP checksum in the LPC1768 web server
+//   (FreeRTOS/Demo/CORTEX_LPC1768_GCC_Rowley/webserver/uip_arch.c) against the generic
+//   byte-at-a-time one in uip.c.
+//
+// The Makefile builds uip.c a second time with UIP_ARCH_CHKSUM and UIP_ARCH_ADD32 set to 0, then
+//   renames its checksum functions to generic_*, so both versions link into this program.
+//
+// Every start offset from 0 to 7 is tried (uip_arch.c takes a different path for odd and for
+//   halfword aligned starts) with every length up to a full frame, on random data, on data that is
+//   mostly 0xff (so nearly every addition carries), and on all-0xff data (where the ones complement
+//   sum is 0xffff or 0).  The IP and TCP header checksums are checked on frames built in uip_buf, and
+//   uip_add32 on random operands.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "uip.h"
+#include "uip_arch.h"
+
+// The generic versions, renamed by objcopy
+u16_t generic_uip_chksum(u16_t *data, u16_t len);
+u16_t generic_uip_ipchksum(void);
+u16_t generic_uip_tcpchksum(void);
+void generic_uip_add32(u8_t *op32, u16_t op16);
+
+// uIP needs an application, but none of it runs here
+void httpd_appcall(void) {}
+
+#define maxOffset 8
+#define maxErrorsShown 10
+#define add32Cases 1000000
+
+// uip_buf is external to uIP in this configuration.  Keep it word aligned, as on the target.
+static u32_t frame[(UIP_BUFSIZE + 3) / 4];
+u8_t *uip_buf = (u8_t *) frame;
+
+static u32_t data[(UIP_BUFSIZE + maxOffset + 3) / 4];
+static int errors = 0;
+static long cases = 0;
+
+enum { patternRandom, patternMostlyOnes, patternAllOnes, patternCount };
+static const char *patternNames[patternCount] = { "random", "mostly 0xff", "all 0xff" };
+
+static void fill(u8_t *p, int len, int pattern)
+{
+	int i;
+
+	for (i = 0; i < len; i++) {
+		switch (pattern) {
+		case patternRandom:
+			p[i] = (u8_t) rand();
+			break;
+		case patternMostlyOnes:
+			p[i] = (rand() % 8 != 0) ? 0xff : (u8_t) rand();
+			break;
+		default:
+			p[i] = 0xff;
+			break;
+		}
+	}
+}
+
+static void report(const char *what, int pattern, int offset, int len, unsigned expected, unsigned got)
+{
+	if (errors < maxErrorsShown) {
+		printf("%s: %s data, offset %d, length %d: expected %04x, got %04x\n",
+			what, patternNames[pattern], offset, len, expected, got);
+	}
+	errors++;
+}
+
+static void testChksum(void)
+{
+	u8_t *base = (u8_t *) data;
+	int pattern, offset, len;
+	u16_t expected, got;
+
+	for (pattern = 0; pattern < patternCount; pattern++) {
+		for (offset = 0; offset < maxOffset; offset++) {
+			for (len = 0; len <= UIP_BUFSIZE; len++) {
+				fill(base + offset, len, pattern);
+				expected = generic_uip_chksum((u16_t *) (base + offset), len);
+				got = uip_chksum((u16_t *) (base + offset), len);
+				if (got != expected) {
+					report("uip_chksum", pattern, offset, len, expected, got);
+				}
+				cases++;
+			}
+		}
+	}
+}
+
+// Build an IPv4/TCP frame of the given TCP length in uip_buf, then compare the header checksums
+static void testHeaderChksums(void)
+{
+	struct uip_tcpip_hdr *hdr = (struct uip_tcpip_hdr *) &uip_buf[UIP_LLH_LEN];
+	int pattern, len;
+	u16_t ipLen, expected, got;
+
+	for (pattern = 0; pattern < patternCount; pattern++) {
+		for (len = 0; len <= UIP_BUFSIZE - UIP_LLH_LEN - UIP_IPH_LEN; len++) {
+			fill(uip_buf, UIP_BUFSIZE, pattern);
+			ipLen = (u16_t) (UIP_IPH_LEN + len);
+			hdr->vhl = 0x45;
+			hdr->len[0] = (u8_t) (ipLen >> 8);
+			hdr->len[1] = (u8_t) ipLen;
+			hdr->proto = UIP_PROTO_TCP;
+
+			expected = generic_uip_ipchksum();
+			got = uip_ipchksum();
+			if (got != expected) {
+				report("uip_ipchksum", pattern, UIP_LLH_LEN, UIP_IPH_LEN, expected, got);
+			}
+			expected = generic_uip_tcpchksum();
+			got = uip_tcpchksum();
+			if (got != expected) {
+				report("uip_tcpchksum", pattern, UIP_LLH_LEN + UIP_IPH_LEN, len, expected, got);
+			}
+			cases += 2;
+		}
+	}
+}
+
+static void testAdd32(void)
+{
+	u8_t op32[4], expected[4];
+	u16_t op16;
+	long i;
+	int j;
+
+	for (i = 0; i < add32Cases; i++) {
+		for (j = 0; j < 4; j++) {
+			op32[j] = (i % 4 == 0) ? 0xff : (u8_t) rand();
+		}
+		op16 = (u16_t) rand();
+		generic_uip_add32(op32, op16);
+		memcpy(expected, uip_acc32, sizeof(expected));
+		uip_add32(op32, op16);
+		if (memcmp(expected, uip_acc32, sizeof(expected)) != 0) {
+			if (errors < maxErrorsShown) {
+				printf("uip_add32: %02x%02x%02x%02x + %04x: expected %02x%02x%02x%02x, got %02x%02x%02x%02x\n",
+					op32[0], op32[1], op32[2], op32[3], op16,
+					expected[0], expected[1], expected[2], expected[3],
+					uip_acc32[0], uip_acc32[1], uip_acc32[2], uip_acc32[3]);
+			}
+			errors++;
+		}
+		cases++;
+	}
+}
+
+int main(void)
+{
+	srand(1);
+	testChksum();
+	testHeaderChksums();
+	testAdd32();
+	printf("uipChksumTest: %ld cases, %d errors\n", cases, errors);
+	return (errors == 0) ? 0 : 1;
+}
@@ -6,7 +6,8 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "projdefs.h"
-#include "semphr.h"
+#include "queue.h"
+#include "timers.h"
 
 /* include files. */
 #include "lpc17xx_i2c.h"
@@ -37,32 +38,38 @@ typedef struct __vtI2CMsg {
 // Here is where we define an array of pointers that lets communication occur between the interrupt handler and the rest of the code in this file
 static 	vtI2CStruct *devStaticPtr[3];
 
-// I have set this to a large stack size because of (a) using printf() and (b) the depth of function calls
-//   for some of the I2C operations -- it is possible/very likely these are much larger than needed (see LCDtask.c for how to check the stack size)
-#define baseStack 3
-#if PRINTF_VERSION == 1
-#define i2cSTACK_SIZE		((baseStack+5)*configMINIMAL_STACK_SIZE)
-#else
-#define i2cSTACK_SIZE		(baseStack*configMINIMAL_STACK_SIZE)
-#endif
-
-/* The I2C monitor tasks. */
-static portTASK_FUNCTION_PROTO( vI2CMonitorTask, pvParameters );
+// There is no I2C task -- the I2C work is done by functions that are pended to the timer service (daemon) task
+//   with xTimerPendFunctionCall() and xTimerPendFunctionCallFromISR(), so the daemon's stack is shared instead of
+//   each I2C peripheral having a stack of its own.  Everything below is only touched from the daemon task, so no
+//   locking is needed.  Each array is indexed by the number of the I2C peripheral.
+static vtI2CMsg curMsg[3];					// The message whose transfer is on the bus
+static I2C_M_SETUP_Type transferMCfg[3];	// The NXP driver's description of that transfer
+static uint8_t tmpRxBuf[3][vtI2CMLen];		// Where the NXP driver puts the received bytes
+static uint8_t transferBusy[3];				// Non-zero while a transfer is on the bus
+// Set by the interrupt handler when a transfer completed but the timer command queue was full, so
+//   vtI2CTransferDone() could not be pended -- the next vtI2CStartNext() finishes the transfer instead
+static volatile uint8_t transferDoneLost[3];
+// How often vtI2CDeQ() checks for a lost completion while it waits for a result
+#define vtI2CDeQRetryTicks (10 / portTICK_RATE_MS)
+
+// Start the next queued transfer for the device pointed to by pvParameter1, if the bus is free
+static void vtI2CStartNext(void *pvParameter1, unsigned long ulParameter2);
+// Finish the transfer for the device pointed to by pvParameter1 after the interrupt handler saw it complete
+static void vtI2CTransferDone(void *pvParameter1, unsigned long ulParameter2);
 // End of private definitions
 /* ************************************************ */
 
 /* ************************************************ */
 // Public API Functions
 //
-// Note: This will startup an I2C thread, once for each call to this routine
+// Note: The transfers are run by the timer service task, so taskPriority is no longer used
 int vtI2CInit(vtI2CStruct *devPtr,uint8_t i2cDevNum,unsigned portBASE_TYPE taskPriority,uint32_t i2cSpeed)
 {
 	PINSEL_CFG_Type PinCfg;
 
+	( void ) taskPriority;
 	devPtr->devNum = i2cDevNum;
-	devPtr->taskPriority = taskPriority;
 
-	int retval = vtI2CInitSuccess;
 	switch (devPtr->devNum) {
 		case 0: {
 			devStaticPtr[0] = devPtr; // Setup the permanent variable for use by the interrupt handler
@@ -104,30 +111,17 @@ int vtI2CInit(vtI2CStruct *devPtr,uint8_t i2cDevNum,unsigned portBASE_TYPE taskP
 		}
 	}
 
-	// Create semaphore to communicate with interrupt handler
-	vSemaphoreCreateBinary(devPtr->binSemaphore);
-	if (devPtr->binSemaphore == NULL) {
-		return(vtI2CErrInit);
-	}
-	// Need to do an initial "take" on the semaphore to ensure that it is initially blocked
-	if (xSemaphoreTake(devPtr->binSemaphore,0) != pdTRUE) {
-		// free up everyone and go home
-		vQueueDelete(devPtr->binSemaphore);
-		return(vtI2CErrInit);
-	}
-
 	// Allocate the two queues to be used to communicate with other tasks
 	if ((devPtr->inQ = xQueueCreate(vtI2CQLen,sizeof(vtI2CMsg))) == NULL) {
-		// free up everyone and go home
-		vQueueDelete(devPtr->binSemaphore);
 		return(vtI2CErrInit);
 	}
 	if ((devPtr->outQ = xQueueCreate(vtI2CQLen,sizeof(vtI2CMsg))) == NULL) {
 		// free up everyone and go home
-		vQueueDelete(devPtr->binSemaphore);
-		vQueueDelete(devPtr->outQ);
+		vQueueDelete(devPtr->inQ);
 		return(vtI2CErrInit);
 	}
+	transferBusy[devPtr->devNum] = 0;
+	transferDoneLost[devPtr->devNum] = 0;
 
 	// Initialize  I2C peripheral
 	I2C_Init(devPtr->devAddr, i2cSpeed);
@@ -135,15 +129,7 @@ int vtI2CInit(vtI2CStruct *devPtr,uint8_t i2cDevNum,unsigned portBASE_TYPE taskP
 	// Enable  I2C operation
 	I2C_Cmd(devPtr->devAddr, ENABLE);
 
-	/* Start the task */
-	char taskLabel[8];
-	sprintf(taskLabel,"I2C%d",devPtr->devNum);
-	if ((retval = xTaskCreate( vI2CMonitorTask, (signed char*) taskLabel, i2cSTACK_SIZE,(void *) devPtr, devPtr->taskPriority, ( xTaskHandle * ) NULL )) != pdPASS) {
-		VT_HANDLE_FATAL_ERROR(retval);
-		return(vtI2CErrInit); // return is just to keep the compiler happy, we will never get here
-	} else {
-		return vtI2CInitSuccess;
-	}
+	return(vtI2CInitSuccess);
 }
 
 // A simple routine to use for filling out and sending a message to the I2C thread
@@ -166,7 +152,11 @@ portBASE_TYPE vtI2CEnQ(vtI2CStruct *dev,uint8_t msgType,uint8_t slvAddr,uint8_t
 	for (i=0;i<msgBuf.txLen;i++) {
 		msgBuf.buf[i] = txBuf[i];
 	}
-	return(xQueueSend(dev->inQ,(void *) (&msgBuf),portMAX_DELAY));
+	if (xQueueSend(dev->inQ,(void *) (&msgBuf),portMAX_DELAY) != pdTRUE) {
+		return(pdFALSE);
+	}
+	// Have the timer service task start the transfer if the bus is free (otherwise it will be started when the bus is)
+	return(xTimerPendFunctionCall(vtI2CStartNext,(void *) dev,0,portMAX_DELAY));
 }
 
 // A simple routine to use for retrieving a message from the I2C thread
@@ -175,8 +165,13 @@ portBASE_TYPE vtI2CDeQ(vtI2CStruct *dev,uint8_t maxRxLen,uint8_t *rxBuf,uint8_t
 	vtI2CMsg msgBuf;
 	int i;
 
-	if (xQueueReceive(dev->outQ,(void *) (&msgBuf),portMAX_DELAY) != pdTRUE) {
-		return(pdFALSE);
+	while (xQueueReceive(dev->outQ,(void *) (&msgBuf),vtI2CDeQRetryTicks) != pdTRUE) {
+		// If the interrupt handler could not hand the completion over, nothing else may come along to
+		//   finish it, so have the timer service task do it
+		if ((transferDoneLost[dev->devNum]) &&
+			(xTimerPendFunctionCall(vtI2CStartNext,(void *) dev,0,portMAX_DELAY) != pdPASS)) {
+			return(pdFALSE);
+		}
 	}
 	(*status) = msgBuf.status;
 	(*rxLen) = msgBuf.rxLen;
@@ -185,6 +180,10 @@ portBASE_TYPE vtI2CDeQ(vtI2CStruct *dev,uint8_t maxRxLen,uint8_t *rxBuf,uint8_t
 		rxBuf[i] = msgBuf.buf[i];
 	}
 	(*msgType) = msgBuf.msgType;
+	// There is now room for another result, so a transfer held back by a full outQ can be started
+	if (xTimerPendFunctionCall(vtI2CStartNext,(void *) dev,0,portMAX_DELAY) != pdPASS) {
+		VT_HANDLE_FATAL_ERROR(0);
+	}
 	return(pdTRUE);
 }
 
@@ -192,77 +191,103 @@ portBASE_TYPE vtI2CDeQ(vtI2CStruct *dev,uint8_t maxRxLen,uint8_t *rxBuf,uint8_t
 /* ************************************************ */
 
 // i2c interrupt handler
-static __INLINE void vtI2CIsr(LPC_I2C_TypeDef *devAddr,xSemaphoreHandle *binSemaphore) {
-	I2C_MasterHandler(devAddr);
-	if (I2C_MasterTransferComplete(devAddr)) {
-		static signed portBASE_TYPE xHigherPriorityTaskWoken;
-		xHigherPriorityTaskWoken = pdFALSE;
-		xSemaphoreGiveFromISR(*binSemaphore,&xHigherPriorityTaskWoken);
+static __INLINE void vtI2CIsr(vtI2CStruct *devPtr) {
+	I2C_MasterHandler(devPtr->devAddr);
+	if (I2C_MasterTransferComplete(devPtr->devAddr)) {
+		portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+		// Do the rest of the work in the timer service task rather than in the interrupt handler
+		if (xTimerPendFunctionCallFromISR(vtI2CTransferDone,(void *) devPtr,0,&xHigherPriorityTaskWoken) != pdPASS) {
+			// The timer command queue is full -- this is transient, so record it and let the next
+			//   vtI2CStartNext() (from vtI2CEnQ(), vtI2CDeQ() or its retry) finish the transfer
+			transferDoneLost[devPtr->devNum] = 1;
+		}
 		portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
 	}
 }
 // Simply pass on the information to the real interrupt handler above (have to do this to work for multiple i2c peripheral units on the LPC1768
 void vtI2C0Isr(void) {
+	traceISR_ENTER(vtTraceIsrI2C0);
 	// Log the I2C status code
 	vtITMu8(vtITMPortI2C0IntHandler,((devStaticPtr[0]->devAddr)->I2STAT & I2C_STAT_CODE_BITMASK));
-	vtI2CIsr(devStaticPtr[0]->devAddr,&(devStaticPtr[0]->binSemaphore));
+	vtI2CIsr(devStaticPtr[0]);
+	traceISR_EXIT(vtTraceIsrI2C0);
 }
 
 // Simply pass on the information to the real interrupt handler above (have to do this to work for multiple i2c peripheral units on the LPC1768
 void vtI2C1Isr(void) {
+	traceISR_ENTER(vtTraceIsrI2C1);
 	// Log the I2C status code
 	vtITMu8(vtITMPortI2C1IntHandler,((devStaticPtr[1]->devAddr)->I2STAT & I2C_STAT_CODE_BITMASK));
-	vtI2CIsr(devStaticPtr[1]->devAddr,&(devStaticPtr[1]->binSemaphore));
+	vtI2CIsr(devStaticPtr[1]);
+	traceISR_EXIT(vtTraceIsrI2C1);
 }
 // Simply pass on the information to the real interrupt handler above (have to do this to work for multiple i2c peripheral units on the LPC1768
 void vtI2C2Isr(void) {
-	vtI2CIsr(devStaticPtr[2]->devAddr,&(devStaticPtr[2]->binSemaphore));
+	traceISR_ENTER(vtTraceIsrI2C2);
+	vtI2CIsr(devStaticPtr[2]);
+	traceISR_EXIT(vtTraceIsrI2C2);
 }
 
 
-// This is the actual task that is run
-static portTASK_FUNCTION( vI2CMonitorTask, pvParameters )
+// These run in the timer service task -- they must never block
+static void vtI2CStartNext(void *pvParameter1, unsigned long ulParameter2)
 {
-	// Get the i2c structure for this task/device
-	vtI2CStruct *devPtr = (vtI2CStruct *) pvParameters;
-	vtI2CMsg msgBuffer;
-	uint8_t tmpRxBuf[vtI2CMLen];
-	I2C_M_SETUP_Type transferMCfg;
+	vtI2CStruct *devPtr = (vtI2CStruct *) pvParameter1;
+	uint8_t devNum = devPtr->devNum;
+
+	( void ) ulParameter2;
+
+	// Finish a transfer whose completion the interrupt handler could not pend (this starts the next one as well)
+	if (transferDoneLost[devNum]) {
+		transferDoneLost[devNum] = 0;
+		vtI2CTransferDone(pvParameter1,0);
+		return;
+	}
+	// We *cannot* overlap operations on the I2C bus, and we only start a transfer if there will be room for its result
+	if ((transferBusy[devNum]) || (uxQueueMessagesWaiting(devPtr->outQ) >= vtI2CQLen)) {
+		return;
+	}
+	// see if another task has sent us a message telling us to send/recv over i2c
+	if (xQueueReceive(devPtr->inQ,(void *) &curMsg[devNum],0) != pdTRUE) {
+		return;
+	}
+	transferBusy[devNum] = 1;
+	//Log that we are processing a message
+	vtITMu8(vtITMPortI2CMsg,curMsg[devNum].msgType);
+
+	// process the messsage and start the I2C transaction -- the interrupt handler tells us when it is complete
+	transferMCfg[devNum].sl_addr7bit = curMsg[devNum].slvAddr;
+	transferMCfg[devNum].tx_data = curMsg[devNum].buf;
+	transferMCfg[devNum].tx_length = curMsg[devNum].txLen;
+	transferMCfg[devNum].rx_data = tmpRxBuf[devNum];
+	transferMCfg[devNum].rx_length = curMsg[devNum].rxLen;
+	transferMCfg[devNum].retransmissions_max = 3;
+	transferMCfg[devNum].retransmissions_count = 0;	 // this *should* be initialized in the LPC code, but is not for interrupt mode
+	curMsg[devNum].status = I2C_MasterTransferData(devPtr->devAddr, &transferMCfg[devNum], I2C_TRANSFER_INTERRUPT);
+}
+
+static void vtI2CTransferDone(void *pvParameter1, unsigned long ulParameter2)
+{
+	vtI2CStruct *devPtr = (vtI2CStruct *) pvParameter1;
+	uint8_t devNum = devPtr->devNum;
 	int i;
 
-	for (;;) {
-		// wait for a message from another task telling us to send/recv over i2c
-		if (xQueueReceive(devPtr->inQ,(void *) &msgBuffer,portMAX_DELAY) != pdTRUE) {
-			VT_HANDLE_FATAL_ERROR(0);
-		}
-		//Log that we are processing a message
-		vtITMu8(vtITMPortI2CMsg,msgBuffer.msgType);
-
-		// process the messsage and perform the I2C transaction
-		transferMCfg.sl_addr7bit = msgBuffer.slvAddr;
-		transferMCfg.tx_data = msgBuffer.buf;
-		transferMCfg.tx_length = msgBuffer.txLen;
-		transferMCfg.rx_data = tmpRxBuf;
-		transferMCfg.rx_length = msgBuffer.rxLen;
-		transferMCfg.retransmissions_max = 3;
-		transferMCfg.retransmissions_count = 0;	 // this *should* be initialized in the LPC code, but is not for interrupt mode
-		msgBuffer.status = I2C_MasterTransferData(devPtr->devAddr, &transferMCfg, I2C_TRANSFER_INTERRUPT);
-		// Block until the I2C operation is complete -- we *cannot* overlap operations on the I2C bus...
-		if (xSemaphoreTake(devPtr->binSemaphore,portMAX_DELAY) != pdTRUE) {
-			// something went wrong 
-			VT_HANDLE_FATAL_ERROR(0);
-		}
-		msgBuffer.txLen = transferMCfg.tx_count;
-		msgBuffer.rxLen = transferMCfg.rx_count;
-		// Now send out a message with the data that was read
-		// First, copy over the buffer that was received (if any)
-		for (i=0;i<msgBuffer.rxLen;i++) {
-			msgBuffer.buf[i] = tmpRxBuf[i];
-		}
-		// now put a message in the message queue
-		if (xQueueSend(devPtr->outQ,(void*)(&msgBuffer),portMAX_DELAY) != pdTRUE) {
-			// something went wrong 
-			VT_HANDLE_FATAL_ERROR(0);
-		} 
+	( void ) ulParameter2;
+
+	curMsg[devNum].txLen = transferMCfg[devNum].tx_count;
+	curMsg[devNum].rxLen = transferMCfg[devNum].rx_count;
+	// Now send out a message with the data that was read
+	// First, copy over the buffer that was received (if any)
+	for (i=0;i<curMsg[devNum].rxLen;i++) {
+		curMsg[devNum].buf[i] = tmpRxBuf[devNum][i];
 	}
-}
\ No newline at end of file
+	// now put a message in the message queue -- vtI2CStartNext() made sure there is room
+	if (xQueueSend(devPtr->outQ,(void*)(&curMsg[devNum]),0) != pdTRUE) {
+		// something went wrong 
+		VT_HANDLE_FATAL_ERROR(0);
+	}
+	transferBusy[devNum] = 0;
+
+	// The bus is free again
+	vtI2CStartNext(pvParameter1,0);
+}
@@ -5,7 +5,7 @@
 #include "vtUtilities.h"
 #include "FreeRTOS.h"
 #include "projDefs.h"
-#include "semphr.h"
+#include "queue.h"
 
 // return codes for vtI2CInit()
 #define vtI2CErrInit -1
@@ -20,19 +20,19 @@
 typedef struct __vtI2CStruct {
 	uint8_t devNum;	  						// Number of the I2C peripheral (0,1,2 on the 1768)
 	LPC_I2C_TypeDef *devAddr;	 			// Memory address of the I2C peripheral
-	unsigned portBASE_TYPE taskPriority;   	// Priority of the I2C task
-	xSemaphoreHandle binSemaphore;		   	// Semaphore used between I2C task and I2C interrupt handler
-	xQueueHandle inQ;					   	// Queue used to send messages from other tasks to the I2C task
-	xQueueHandle outQ;						// Queue used by the I2C task to send out results
+	xQueueHandle inQ;					   	// Queue used to send messages from other tasks to the I2C driver
+	xQueueHandle outQ;						// Queue used by the I2C driver to send out results
 } vtI2CStruct;
 
 /* ********************************************************************* */
-// The following are the public API calls that other tasks should use to work with the I2C task
+// The following are the public API calls that other tasks should use to work with the I2C driver
+//   There is no I2C task: the transfers are started and finished by the timer service (daemon) task, using
+//   xTimerPendFunctionCall() and xTimerPendFunctionCallFromISR(), so configUSE_TIMERS must be 1
 
 // Args:
 //   dev: pointer to the vtI2CStruct data structure
 //   i2cDevNum: The number of the i2c device -- 0, 1, or 2
-//   taskPriority: At what priority should this task be run?
+//   taskPriority: Not used -- the transfers run at configTIMER_TASK_PRIORITY
 //   i2cSpeed: Clock speed of the i2c bus
 // Return:
 //   if successful, returns vtI2CInitSuccess
@@ -40,7 +40,7 @@ typedef struct __vtI2CStruct {
 // Must be called for each I2C device initialized (0, 1, or 2) and used
 int vtI2CInit(vtI2CStruct *devPtr,uint8_t i2cDevNum,unsigned portBASE_TYPE taskPriority,uint32_t i2cSpeed);
 
-// A simple routine to use for filling out and sending a message to the I2C thread
+// A simple routine to use for filling out and sending a message to the I2C driver
 //   You may want to make your own versions of these as they are not suited to all purposes
 // Args
 //   dev: pointer to the vtI2CStruct data structure
@@ -50,10 +50,10 @@ int vtI2CInit(vtI2CStruct *devPtr,uint8_t i2cDevNum,unsigned portBASE_TYPE taskP
 //   txBuf: The buffer holding the bytes you want to send
 //   rxLen: The number of bytes that you would like to receive
 // Return:
-//   Result of the call to xQueueSend()
+//   pdTRUE if the message was queued and the timer service task was asked to start it
 portBASE_TYPE vtI2CEnQ(vtI2CStruct *dev,uint8_t msgType,uint8_t slvAddr,uint8_t txLen,const uint8_t *txBuf,uint8_t rxLen);
 
-// A simple routine to use for retrieving a message from the I2C thread
+// A simple routine to use for retrieving a message from the I2C driver
 // Args
 //   dev: pointer to the vtI2CStruct data structure
 //   maxRxLen: The maximum number of bytes that your receive buffer can hold
@@ -0,0 +1,121 @@
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* include files. */
+#include "vtUtilities.h"
+#include "vtTaskMon.h"
+#include "extUSB.h"
+
+#if configUSE_TRACE_FACILITY == 1
+
+/* ************************************************ */
+// Private definitions
+
+// Stack for the USB sender task -- the frame buffer is static, so it does not need much
+#define vtTaskMonStackSize (configMINIMAL_STACK_SIZE * 2)
+
+// The snapshot taken by uxTaskGetSystemState() (static as it is too big for most task stacks)
+static xTaskStatusType taskStatus[vtTaskMonMaxTasks];
+// The frame sent by the USB task
+static uint8_t usbFrame[vtTaskMonFrameSize(vtTaskMonMaxTasks)];
+// How often the USB task sends a frame
+static portTickType usbPeriod;
+
+// Little-endian packing, so the frame is the same whatever the compiler does with structures
+static uint8_t *vtTaskMonPut16(uint8_t *p,uint16_t val)
+{
+	p[0] = (uint8_t) val;
+	p[1] = (uint8_t) (val >> 8);
+	return(p + 2);
+}
+
+static uint8_t *vtTaskMonPut32(uint8_t *p,uint32_t val)
+{
+	p = vtTaskMonPut16(p,(uint16_t) val);
+	return(vtTaskMonPut16(p,(uint16_t) (val >> 16)));
+}
+
+static uint8_t *vtTaskMonPut64(uint8_t *p,uint64_t val)
+{
+	p = vtTaskMonPut32(p,(uint32_t) val);
+	return(vtTaskMonPut32(p,(uint32_t) (val >> 32)));
+}
+
+static portTASK_FUNCTION(vtTaskMonUSBTask,pvParameters)
+{
+	portTickType lastWake = xTaskGetTickCount();
+	int len;
+
+	for (;;) {
+		vTaskDelayUntil(&lastWake,usbPeriod);
+		len = vtTaskMonSnapshot(usbFrame,sizeof(usbFrame));
+		if (len > 0) {
+			// writeUSBBuffer() holds the USB Tx lock for the whole frame, so printf text from other
+			// tasks can only appear between frames, where the host skips it while looking for the magic.
+			// A frame that does not go out completely is resynchronised by the host on the next magic.
+			writeUSBBuffer((const char *) usbFrame,len);
+		}
+	}
+}
+
+/* ************************************************ */
+// Public API Functions
+
+int vtTaskMonSnapshot(uint8_t *buf,int bufLen)
+{
+	unsigned long long totalRunTime;
+	unsigned portBASE_TYPE count, i;
+	uint8_t *p = buf;
+	uint16_t sum = 0;
+	int len;
+
+	count = uxTaskGetSystemState(taskStatus,vtTaskMonMaxTasks,&totalRunTime);
+	if (count == 0) {
+		// More tasks than vtTaskMonMaxTasks
+		return(0);
+	}
+	len = vtTaskMonFrameSize(count);
+	if (len > bufLen) {
+		return(0);
+	}
+
+	p = vtTaskMonPut32(p,vtTaskMonMagic);
+	p = vtTaskMonPut16(p,vtTaskMonVersion);
+	p = vtTaskMonPut16(p,vtTaskMonRecordSize);
+	p = vtTaskMonPut16(p,(uint16_t) count);
+	p = vtTaskMonPut16(p,0);
+	p = vtTaskMonPut32(p,(uint32_t) xTaskGetTickCount());
+	p = vtTaskMonPut64(p,totalRunTime);
+
+	for (i = 0; i < count; i++) {
+		p = vtTaskMonPut16(p,(uint16_t) taskStatus[i].xTaskNumber);
+		*p++ = (uint8_t) taskStatus[i].eCurrentState;
+		*p++ = (uint8_t) taskStatus[i].uxCurrentPriority;
+		*p++ = (uint8_t) taskStatus[i].uxBasePriority;
+		*p++ = 0;
+		p = vtTaskMonPut16(p,taskStatus[i].usStackHighWaterMark);
+		p = vtTaskMonPut64(p,taskStatus[i].ullRunTimeCounter);
+		// strncpy() zero pads the rest of the field
+		strncpy((char *) p,(const char *) taskStatus[i].pcTaskName,vtTaskMonNameLen);
+		p += vtTaskMonNameLen;
+	}
+
+	for (i = 0; i < (unsigned portBASE_TYPE) (len - 2); i++) {
+		sum += buf[i];
+	}
+	vtTaskMonPut16(p,sum);
+	return(len);
+}
+
+portBASE_TYPE vtTaskMonStartUSB(unsigned portBASE_TYPE uxPriority,portTickType period)
+{
+	usbPeriod = period;
+	return(xTaskCreate(vtTaskMonUSBTask,(signed char *) "TaskMon",vtTaskMonStackSize,NULL,uxPriority,NULL));
+}
+// End of public API Functions
+/* ************************************************ */
+
+#endif
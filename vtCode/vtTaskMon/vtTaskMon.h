@@ -0,0 +1,69 @@
+#ifndef __vtTaskMonh
+#define __vtTaskMonh
+/* ************************************************************
+   Task monitor
+   ************************************************************ */
+// Takes a snapshot of every task with uxTaskGetSystemState() and packs it into a small binary frame,
+//   so that a host tool can display the task list instead of the MCU formatting text with sprintf().
+// The frame can be sent over any byte stream.  vtTaskMonStartUSB() starts a task that sends one over
+//   the USB CDC port every period; the web server (or anything else) can call vtTaskMonSnapshot()
+//   directly.
+//
+// To use it:
+//   1) configUSE_TRACE_FACILITY must be 1 in FreeRTOSConfig.h (configGENERATE_RUN_TIME_STATS
+//      should also be 1 if you want the run times)
+//   2) Either call vtTaskMonSnapshot() yourself, or call vtTaskMonStartUSB() in main() after initUSB()
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Largest number of tasks that can be reported (the snapshot array is static, one xTaskStatusType
+//   per task: sizeof(xTaskStatusType) is 48 bytes on the Cortex-M3)
+#define vtTaskMonMaxTasks 16
+// Task names are truncated/zero padded to this length in the frame
+#define vtTaskMonNameLen 16
+
+// Frame format -- host tools depend on these so only ever add to them
+// All fields are little-endian with no padding
+//   header (24 bytes)
+//     uint32_t magic                 vtTaskMonMagic
+//     uint16_t version               vtTaskMonVersion
+//     uint16_t recordSize            vtTaskMonRecordSize
+//     uint16_t count                 number of records that follow
+//     uint16_t reserved
+//     uint32_t tickCount             xTaskGetTickCount() when the snapshot was taken
+//     uint64_t totalRunTime          sum of the run times of all tasks (0 without run time stats)
+//   count records (32 bytes each)
+//     uint16_t taskNumber
+//     uint8_t  state                 0 running, 1 ready, 2 blocked, 3 suspended, 4 deleted
+//     uint8_t  currentPriority
+//     uint8_t  basePriority          differs from currentPriority while a mutex priority is inherited
+//     uint8_t  reserved
+//     uint16_t stackHighWaterMark    in words
+//     uint64_t runTime               in run time counter units (0 without run time stats)
+//     char     name[vtTaskMonNameLen]
+//   trailer (2 bytes)
+//     uint16_t checksum              16-bit sum of all the preceding bytes of the frame
+#define vtTaskMonVersion 1
+#define vtTaskMonMagic 0x4D547476UL	// "vtTM" in memory
+#define vtTaskMonHeaderSize 24
+#define vtTaskMonRecordSize (16 + vtTaskMonNameLen)
+#define vtTaskMonFrameSize(count) (vtTaskMonHeaderSize + ((count) * vtTaskMonRecordSize) + 2)
+
+/* ********************************************************************* */
+// Public API
+
+// Writes a frame describing every task into buf
+// Returns the length of the frame, or 0 if it does not fit in bufLen (or there are more than vtTaskMonMaxTasks tasks)
+// Must be called from a task; only one task at a time may call it
+int vtTaskMonSnapshot(uint8_t *buf,int bufLen);
+
+// Starts a task that sends a frame over the USB CDC port every period ticks
+// Returns pdPASS if the task was created
+portBASE_TYPE vtTaskMonStartUSB(unsigned portBASE_TYPE uxPriority,portTickType period);
+
+/* ************************************************************
+   End of task monitor
+   ************************************************************ */
+#endif
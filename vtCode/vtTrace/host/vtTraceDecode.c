@@ -0,0 +1,678 @@
+// vtTraceDecode -- host side decoder for the records written by vtCode/vtTrace/vtTrace.c
+//
+// Build on Linux with:
+//   gcc -O2 -Wall -o vtTraceDecode vtTraceDecode.c
+//
+// Usage:
+//   vtTraceDecode [-t] [-i] [-p port] [-f hz] file
+//     file   a dump of the vtTraceRAM structure, either raw binary (gdb "dump binary memory") or
+//            Intel HEX (Keil "SAVE"), or with -i a capture of the SWO/ITM stream
+//     -t     print the timeline of every event as well as the summary
+//     -i     the file is an ITM packet stream (e.g. from OpenOCD "tpiu config ... <file>")
+//     -p     ITM stimulus port the records were sent on (default 8, see vtITMPortTrace)
+//     -f     override the CPU clock rate, in Hz, used to convert cycle counts to time
+//
+// The summary gives, for each task, a histogram of its scheduling latency (time from being made
+//   ready to running) and of how long it ran each time it was switched in; and the same for each
+//   traced interrupt handler and timer callback.  These are the places to look for jitter.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+// These must match vtTrace.h
+#define vtTraceVersion 1
+#define vtTraceMagic 0x52547476UL
+#define vtTraceEvtStart				0x01
+#define vtTraceEvtCpuHz				0x02
+#define vtTraceEvtTaskName			0x03
+#define vtTraceEvtTaskCreate		0x10
+#define vtTraceEvtTaskDelete		0x11
+#define vtTraceEvtTaskSwitchedIn	0x12
+#define vtTraceEvtTaskReady			0x13
+#define vtTraceEvtTaskDelay			0x14
+#define vtTraceEvtTaskDelayUntil	0x15
+#define vtTraceEvtTick				0x16
+#define vtTraceEvtQueueSend			0x20
+#define vtTraceEvtQueueSendFailed	0x21
+#define vtTraceEvtQueueReceive		0x22
+#define vtTraceEvtQueueReceiveFailed 0x23
+#define vtTraceEvtQueuePeek			0x24
+#define vtTraceEvtQueueSendFromISR	0x25
+#define vtTraceEvtQueueReceiveFromISR 0x26
+#define vtTraceEvtQueueBlockSend	0x27
+#define vtTraceEvtQueueBlockReceive	0x28
+#define vtTraceEvtIsrEnter			0x30
+#define vtTraceEvtIsrExit			0x31
+#define vtTraceEvtTimerExpired		0x40
+#define vtTraceEvtTimerCallbackDone	0x41
+
+// Size of the fixed part of the vtTraceBuffer header (before the name table)
+#define headerSize 28
+
+#define maxTasks 256
+#define maxIsrs 256
+#define maxTimers 64
+#define histBuckets 28
+#define defaultCpuHz 100000000UL
+
+typedef struct {
+	uint32_t timestamp;
+	uint32_t info;
+} record;
+
+// A histogram of durations in cycles, with power of two buckets of microseconds
+typedef struct {
+	unsigned long count;
+	uint64_t min, max, total;
+	unsigned long buckets[histBuckets];
+} histogram;
+
+typedef struct {
+	char name[32];
+	int seen;
+	int readyPending;
+	uint64_t readyTime;
+	uint64_t switchInTime;
+	histogram latency;
+	histogram run;
+} taskInfo;
+
+typedef struct {
+	int active;
+	uint64_t enterTime;
+	histogram duration;
+} isrInfo;
+
+typedef struct {
+	uint16_t id;
+	int active;
+	uint64_t startTime;
+	histogram duration;
+} timerInfo;
+
+static taskInfo tasks[maxTasks];
+static isrInfo isrs[maxIsrs];
+static timerInfo timers[maxTimers];
+static int timerCount = 0;
+static double cpuHz = 0.0;
+static int printTimeline = 0;
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,"usage: %s [-t] [-i] [-p port] [-f hz] file\n",prog);
+	exit(2);
+}
+
+static uint32_t getU32(const uint8_t *p)
+{
+	return ((uint32_t) p[0]) | (((uint32_t) p[1]) << 8) | (((uint32_t) p[2]) << 16) | (((uint32_t) p[3]) << 24);
+}
+
+static uint16_t getU16(const uint8_t *p)
+{
+	return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+static uint8_t *readFile(const char *path,size_t *len)
+{
+	FILE *f = fopen(path,"rb");
+	uint8_t *buf = NULL;
+	size_t size = 0, cap = 0, n;
+
+	if (f == NULL) {
+		perror(path);
+		exit(1);
+	}
+	do {
+		if (size == cap) {
+			cap = (cap == 0) ? 65536 : cap * 2;
+			buf = realloc(buf,cap);
+			if (buf == NULL) {
+				fprintf(stderr,"out of memory\n");
+				exit(1);
+			}
+		}
+		n = fread(buf + size,1,cap - size,f);
+		size += n;
+	} while (n > 0);
+	fclose(f);
+	*len = size;
+	return buf;
+}
+
+static int hexByte(const char *p)
+{
+	unsigned int v;
+	if (sscanf(p,"%2x",&v) != 1) {
+		return -1;
+	}
+	return (int) v;
+}
+
+// Converts an Intel HEX file to a binary image starting at the lowest address in the file
+static uint8_t *hexToBinary(const uint8_t *text,size_t textLen,size_t *binLen)
+{
+	uint8_t *bin;
+	uint32_t base = 0, lowest = 0xFFFFFFFFUL, highest = 0;
+	int pass;
+
+	bin = NULL;
+	// First pass finds the address range, second pass fills in the data
+	for (pass = 0; pass < 2; pass++) {
+		const char *line = (const char *) text;
+		const char *end = (const char *) text + textLen;
+		base = 0;
+		if (pass == 1) {
+			if (highest <= lowest) {
+				fprintf(stderr,"no data in HEX file\n");
+				exit(1);
+			}
+			*binLen = highest - lowest;
+			bin = calloc(1,*binLen);
+			if (bin == NULL) {
+				fprintf(stderr,"out of memory\n");
+				exit(1);
+			}
+		}
+		while (line < end) {
+			const char *next = memchr(line,'\n',end - line);
+			if (next == NULL) {
+				next = end;
+			}
+			if ((*line == ':') && (next - line >= 11)) {
+				int count = hexByte(line + 1);
+				int addr = (hexByte(line + 3) << 8) | hexByte(line + 5);
+				int type = hexByte(line + 7);
+				int i;
+				if ((count < 0) || (next - line < 11 + (count * 2))) {
+					fprintf(stderr,"bad HEX record\n");
+					exit(1);
+				}
+				if (type == 0) {
+					uint32_t a = base + (uint32_t) addr;
+					if (pass == 0) {
+						if (a < lowest) {
+							lowest = a;
+						}
+						if (a + (uint32_t) count > highest) {
+							highest = a + (uint32_t) count;
+						}
+					} else {
+						for (i = 0; i < count; i++) {
+							bin[a - lowest + i] = (uint8_t) hexByte(line + 9 + (i * 2));
+						}
+					}
+				} else if (type == 2) {
+					base = (uint32_t) ((hexByte(line + 9) << 8) | hexByte(line + 11)) << 4;
+				} else if (type == 4) {
+					base = (uint32_t) ((hexByte(line + 9) << 8) | hexByte(line + 11)) << 16;
+				}
+			}
+			line = next + 1;
+		}
+	}
+	return bin;
+}
+
+// Extracts the records from a dump of vtTraceRAM, oldest first
+static record *recordsFromRAM(const uint8_t *img,size_t len,size_t *nrec)
+{
+	size_t off;
+	uint32_t capacity, head, count, i;
+	uint16_t version, recordSize, nTasks, nameLen;
+	const uint8_t *recs;
+	record *out;
+
+	// Look for the header (the dump may start before the structure)
+	for (off = 0; off + headerSize <= len; off += 4) {
+		if (getU32(img + off) == vtTraceMagic) {
+			break;
+		}
+	}
+	if (off + headerSize > len) {
+		fprintf(stderr,"trace header not found -- is this a dump of vtTraceRAM?\n");
+		exit(1);
+	}
+	img += off;
+	len -= off;
+	version = getU16(img + 4);
+	recordSize = getU16(img + 6);
+	capacity = getU32(img + 8);
+	head = getU32(img + 12);
+	count = getU32(img + 16);
+	if (cpuHz == 0.0) {
+		cpuHz = (double) getU32(img + 20);
+	}
+	nTasks = getU16(img + 24);
+	nameLen = getU16(img + 26);
+	if ((version != vtTraceVersion) || (recordSize != sizeof(record)) || (head >= capacity) || (count > capacity)) {
+		fprintf(stderr,"unsupported or corrupt trace header\n");
+		exit(1);
+	}
+	if (len < headerSize + ((size_t) nTasks * nameLen) + ((size_t) capacity * recordSize)) {
+		fprintf(stderr,"dump is too short: it must cover the whole vtTraceRAM structure\n");
+		exit(1);
+	}
+	for (i = 0; (i < nTasks) && (i < maxTasks); i++) {
+		const char *name = (const char *) img + headerSize + (i * nameLen);
+		if (name[0] != 0) {
+			size_t l = strnlen(name,nameLen);
+			if (l >= sizeof(tasks[i].name)) {
+				l = sizeof(tasks[i].name) - 1;
+			}
+			memcpy(tasks[i].name,name,l);
+			tasks[i].name[l] = 0;
+		}
+	}
+	recs = img + headerSize + ((size_t) nTasks * nameLen);
+
+	out = malloc((count + 1) * sizeof(record));
+	if (out == NULL) {
+		fprintf(stderr,"out of memory\n");
+		exit(1);
+	}
+	// If the ring has wrapped, the oldest record is the one at head
+	for (i = 0; i < count; i++) {
+		uint32_t idx = (count < capacity) ? i : ((head + i) % capacity);
+		out[i].timestamp = getU32(recs + (idx * recordSize));
+		out[i].info = getU32(recs + (idx * recordSize) + 4);
+	}
+	*nrec = count;
+	return out;
+}
+
+// Extracts the records sent on one stimulus port from an ITM packet stream
+static record *recordsFromITM(const uint8_t *data,size_t len,int port,size_t *nrec)
+{
+	uint8_t *payload = malloc(len);
+	size_t plen = 0, i = 0, n, j;
+	record *out;
+	unsigned long overflows = 0;
+	int zeros = 0;
+
+	if (payload == NULL) {
+		fprintf(stderr,"out of memory\n");
+		exit(1);
+	}
+	while (i < len) {
+		uint8_t h = data[i++];
+		// A synchronisation packet is a run of zero bytes ended by 0x80
+		if (h == 0x00) {
+			zeros++;
+			continue;
+		}
+		if ((h == 0x80) && (zeros != 0)) {
+			zeros = 0;
+			continue;
+		}
+		zeros = 0;
+		if (h == 0x70) {
+			overflows++;
+			continue;
+		}
+		if ((h & 0x03) == 0) {
+			// Timestamp or extension packet: skip the continuation bytes
+			if (h & 0x80) {
+				while ((i < len) && (data[i++] & 0x80)) {
+				}
+			}
+			continue;
+		}
+		n = ((h & 0x03) == 3) ? 4 : (size_t) (h & 0x03);
+		if (((h & 0x04) == 0) && ((h >> 3) == port)) {
+			for (j = 0; (j < n) && (i + j < len); j++) {
+				payload[plen++] = data[i + j];
+			}
+		}
+		i += n;
+	}
+	if (overflows != 0) {
+		fprintf(stderr,"warning: the ITM reported %lu overflows, so records were lost\n",overflows);
+	}
+	*nrec = plen / sizeof(record);
+	out = malloc((*nrec + 1) * sizeof(record));
+	if (out == NULL) {
+		fprintf(stderr,"out of memory\n");
+		exit(1);
+	}
+	for (i = 0; i < *nrec; i++) {
+		out[i].timestamp = getU32(payload + (i * 8));
+		out[i].info = getU32(payload + (i * 8) + 4);
+	}
+	free(payload);
+	return out;
+}
+
+static double toUs(uint64_t cycles)
+{
+	return ((double) cycles * 1000000.0) / cpuHz;
+}
+
+static void histAdd(histogram *h,uint64_t cycles)
+{
+	double us = toUs(cycles);
+	int b = 0;
+
+	if ((h->count == 0) || (cycles < h->min)) {
+		h->min = cycles;
+	}
+	if (cycles > h->max) {
+		h->max = cycles;
+	}
+	h->count++;
+	h->total += cycles;
+	// Bucket 0 is under 1us, bucket b covers 2^(b-1) to 2^b us, the last bucket is everything above that
+	while ((us >= 1.0) && (b < histBuckets - 1)) {
+		us /= 2.0;
+		b++;
+	}
+	h->buckets[b]++;
+}
+
+static void histPrint(const char *title,const char *name,const histogram *h)
+{
+	int b, first = -1, last = -1;
+	unsigned long most = 0;
+
+	if (h->count == 0) {
+		return;
+	}
+	printf("  %-16s %s: n=%lu min=%.2fus avg=%.2fus max=%.2fus\n",name,title,h->count,
+		toUs(h->min),toUs(h->total) / (double) h->count,toUs(h->max));
+	for (b = 0; b < histBuckets; b++) {
+		if (h->buckets[b] != 0) {
+			if (first < 0) {
+				first = b;
+			}
+			last = b;
+			if (h->buckets[b] > most) {
+				most = h->buckets[b];
+			}
+		}
+	}
+	for (b = first; b <= last; b++) {
+		char range[48];
+		int bar = (int) ((h->buckets[b] * 50 + most - 1) / most);
+		if (b == 0) {
+			snprintf(range,sizeof(range),"< 1us");
+		} else if (b == histBuckets - 1) {
+			snprintf(range,sizeof(range),">= %luus",1UL << (b - 1));
+		} else {
+			snprintf(range,sizeof(range),"%lu-%luus",1UL << (b - 1),1UL << b);
+		}
+		printf("    %16s %8lu ",range,h->buckets[b]);
+		while (bar-- > 0) {
+			putchar('#');
+		}
+		putchar('\n');
+	}
+}
+
+static const char *taskName(int num)
+{
+	static char buf[4][16];
+	static int next = 0;
+
+	if ((num >= 0) && (num < maxTasks) && (tasks[num].name[0] != 0)) {
+		return tasks[num].name;
+	}
+	next = (next + 1) % 4;
+	if (num == 0xFF) {
+		snprintf(buf[next],sizeof(buf[next]),"(none)");
+	} else {
+		snprintf(buf[next],sizeof(buf[next]),"task%d",num);
+	}
+	return buf[next];
+}
+
+static timerInfo *findTimer(uint16_t id)
+{
+	int i;
+
+	for (i = 0; i < timerCount; i++) {
+		if (timers[i].id == id) {
+			return &timers[i];
+		}
+	}
+	if (timerCount == maxTimers) {
+		return NULL;
+	}
+	timers[timerCount].id = id;
+	return &timers[timerCount++];
+}
+
+static const char *eventName(uint8_t ev)
+{
+	switch (ev) {
+		case vtTraceEvtStart: return "trace start";
+		case vtTraceEvtTaskCreate: return "task create";
+		case vtTraceEvtTaskDelete: return "task delete";
+		case vtTraceEvtTaskSwitchedIn: return "switched in";
+		case vtTraceEvtTaskReady: return "ready";
+		case vtTraceEvtTaskDelay: return "delay";
+		case vtTraceEvtTaskDelayUntil: return "delay until";
+		case vtTraceEvtTick: return "tick";
+		case vtTraceEvtQueueSend: return "queue send";
+		case vtTraceEvtQueueSendFailed: return "queue send failed";
+		case vtTraceEvtQueueReceive: return "queue receive";
+		case vtTraceEvtQueueReceiveFailed: return "queue receive failed";
+		case vtTraceEvtQueuePeek: return "queue peek";
+		case vtTraceEvtQueueSendFromISR: return "queue send from ISR";
+		case vtTraceEvtQueueReceiveFromISR: return "queue receive from ISR";
+		case vtTraceEvtQueueBlockSend: return "blocked on queue send";
+		case vtTraceEvtQueueBlockReceive: return "blocked on queue receive";
+		case vtTraceEvtIsrEnter: return "ISR enter";
+		case vtTraceEvtIsrExit: return "ISR exit";
+		case vtTraceEvtTimerExpired: return "timer callback";
+		case vtTraceEvtTimerCallbackDone: return "timer callback done";
+		default: return NULL;
+	}
+}
+
+static void decode(const record *recs,size_t nrec)
+{
+	size_t i;
+	int haveTime = 0;
+	uint32_t lastTs = 0;
+	uint64_t now = 0;
+	int running = -1;
+	unsigned long unknown = 0;
+
+	for (i = 0; i < nrec; i++) {
+		uint8_t ev = (uint8_t) (recs[i].info & 0xFF);
+		uint8_t task = (uint8_t) ((recs[i].info >> 8) & 0xFF);
+		uint16_t param = (uint16_t) (recs[i].info >> 16);
+
+		// Records that carry data rather than a timestamp
+		if (ev == vtTraceEvtCpuHz) {
+			if (cpuHz == 0.0) {
+				cpuHz = (double) recs[i].timestamp;
+			}
+			continue;
+		}
+		if (ev == vtTraceEvtTaskName) {
+			int num = param >> 8;
+			int chunk = param & 0xFF;
+			int c;
+			for (c = 0; c < 4; c++) {
+				int pos = (chunk * 4) + c;
+				if (pos < (int) sizeof(tasks[num].name) - 1) {
+					tasks[num].name[pos] = (char) ((recs[i].timestamp >> (c * 8)) & 0xFF);
+				}
+			}
+			continue;
+		}
+		if (cpuHz == 0.0) {
+			cpuHz = (double) defaultCpuHz;
+		}
+
+		// The cycle counter is 32 bits, so keep a 64 bit time that does not wrap.  This relies on there being
+		//   at least one event per counter period (43 seconds at 100MHz).
+		if (ev == vtTraceEvtStart) {
+			haveTime = 0;
+			running = -1;
+		}
+		if (haveTime) {
+			now += (uint32_t) (recs[i].timestamp - lastTs);
+		} else {
+			now = 0;
+			haveTime = 1;
+		}
+		lastTs = recs[i].timestamp;
+
+		switch (ev) {
+			case vtTraceEvtTaskCreate:
+				tasks[param & 0xFF].seen = 1;
+				tasks[param & 0xFF].readyPending = 0;
+				break;
+			case vtTraceEvtTaskDelete:
+				tasks[param & 0xFF].readyPending = 0;
+				break;
+			case vtTraceEvtTaskReady:
+				// A task already running can be put back in the ready list (e.g. by a priority change)
+				if (((int) (param & 0xFF) != running) && (!tasks[param & 0xFF].readyPending)) {
+					tasks[param & 0xFF].readyPending = 1;
+					tasks[param & 0xFF].readyTime = now;
+				}
+				break;
+			case vtTraceEvtTaskSwitchedIn:
+				if (running >= 0) {
+					histAdd(&tasks[running].run,now - tasks[running].switchInTime);
+				}
+				running = param & 0xFF;
+				tasks[running].seen = 1;
+				tasks[running].switchInTime = now;
+				if (tasks[running].readyPending) {
+					histAdd(&tasks[running].latency,now - tasks[running].readyTime);
+					tasks[running].readyPending = 0;
+				}
+				break;
+			case vtTraceEvtIsrEnter:
+				isrs[param & 0xFF].active = 1;
+				isrs[param & 0xFF].enterTime = now;
+				break;
+			case vtTraceEvtIsrExit:
+				if (isrs[param & 0xFF].active) {
+					histAdd(&isrs[param & 0xFF].duration,now - isrs[param & 0xFF].enterTime);
+					isrs[param & 0xFF].active = 0;
+				}
+				break;
+			case vtTraceEvtTimerExpired: {
+				timerInfo *t = findTimer(param);
+				if (t != NULL) {
+					t->active = 1;
+					t->startTime = now;
+				}
+				break;
+			}
+			case vtTraceEvtTimerCallbackDone: {
+				timerInfo *t = findTimer(param);
+				if ((t != NULL) && (t->active)) {
+					histAdd(&t->duration,now - t->startTime);
+					t->active = 0;
+				}
+				break;
+			}
+			default:
+				if (eventName(ev) == NULL) {
+					unknown++;
+				}
+				break;
+		}
+
+		if (printTimeline) {
+			const char *what = eventName(ev);
+			printf("%14.3fus  %-16s ",toUs(now),taskName(task));
+			if (what == NULL) {
+				printf("unknown event 0x%02x param 0x%04x\n",ev,param);
+			} else if ((ev >= vtTraceEvtTaskCreate) && (ev <= vtTraceEvtTaskReady)) {
+				printf("%s %s\n",what,taskName(param & 0xFF));
+			} else if ((ev == vtTraceEvtIsrEnter) || (ev == vtTraceEvtIsrExit)) {
+				printf("%s %u\n",what,param);
+			} else if (ev >= vtTraceEvtQueueSend) {
+				printf("%s 0x%04x\n",what,param);
+			} else if (ev == vtTraceEvtTick) {
+				printf("%s %u\n",what,param);
+			} else {
+				printf("%s\n",what);
+			}
+		}
+	}
+	if (unknown != 0) {
+		fprintf(stderr,"warning: %lu records with unknown event codes (is the ITM stream aligned?)\n",unknown);
+	}
+	if (printTimeline) {
+		printf("\n");
+	}
+	printf("%lu records, %.3fms, CPU clock %.0fHz\n\n",(unsigned long) nrec,toUs(now) / 1000.0,cpuHz);
+}
+
+static void summary(void)
+{
+	int i;
+
+	printf("Scheduling latency (made ready -> running) and run time per switch in, by task:\n");
+	for (i = 0; i < maxTasks; i++) {
+		if (tasks[i].seen) {
+			histPrint("latency",taskName(i),&tasks[i].latency);
+			histPrint("run time",taskName(i),&tasks[i].run);
+		}
+	}
+	printf("\nInterrupt handlers (traceISR_ENTER -> traceISR_EXIT), by id:\n");
+	for (i = 0; i < maxIsrs; i++) {
+		char name[16];
+		snprintf(name,sizeof(name),"isr%d",i);
+		histPrint("duration",name,&isrs[i].duration);
+	}
+	printf("\nTimer callbacks, by timer:\n");
+	for (i = 0; i < timerCount; i++) {
+		char name[16];
+		snprintf(name,sizeof(name),"timer 0x%04x",timers[i].id);
+		histPrint("duration",name,&timers[i].duration);
+	}
+}
+
+int main(int argc,char *argv[])
+{
+	int opt;
+	int itm = 0;
+	int port = 8;
+	size_t len, nrec;
+	uint8_t *data;
+	record *recs;
+
+	while ((opt = getopt(argc,argv,"tip:f:")) != -1) {
+		switch (opt) {
+			case 't': printTimeline = 1; break;
+			case 'i': itm = 1; break;
+			case 'p': port = atoi(optarg); break;
+			case 'f': cpuHz = atof(optarg); break;
+			default: usage(argv[0]);
+		}
+	}
+	if (optind != argc - 1) {
+		usage(argv[0]);
+	}
+	data = readFile(argv[optind],&len);
+
+	if (itm) {
+		recs = recordsFromITM(data,len,port,&nrec);
+	} else {
+		if ((len > 0) && (data[0] == ':')) {
+			size_t binLen = 0;
+			uint8_t *bin = hexToBinary(data,len,&binLen);
+			free(data);
+			data = bin;
+			len = binLen;
+		}
+		recs = recordsFromRAM(data,len,&nrec);
+	}
+	decode(recs,nrec);
+	summary();
+
+	free(recs);
+	free(data);
+	return 0;
+}
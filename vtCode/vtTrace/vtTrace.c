@@ -0,0 +1,153 @@
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* include files. */
+#include "vtUtilities.h"
+#include "vtTrace.h"
+
+#if configUSE_TRACE_RECORDER == 1
+
+/* ************************************************ */
+// Private definitions
+
+// The DWT registers are not described by the CMSIS header used by this project
+#define vtDWTCtrl (*((volatile uint32_t *) 0xE0001000UL))
+#define vtDWTCycCnt (*((volatile uint32_t *) 0xE0001004UL))
+#define vtDWTCtrlCycCntEna 0x00000001UL
+
+// Task number used until the first task switch has been recorded
+#define vtTraceNoTask 0xFF
+
+// The RAM ring.  It is not static so the debugger can find it by name, e.g. in gdb:
+//   dump binary memory trace.bin &vtTraceRAM ((char *) &vtTraceRAM)+sizeof(vtTraceRAM)
+//   or in the Keil debugger: SAVE trace.hex &vtTraceRAM, ((char *) &vtTraceRAM)+sizeof(vtTraceRAM)-1
+vtTraceBuffer vtTraceRAM;
+
+// Number of the task that is currently running
+static uint8_t currentTask = vtTraceNoTask;
+// Recording is on when this is non-zero
+static volatile uint8_t recording = 0;
+
+// Writes one record.  If isData is zero, the first word of the record is the cycle counter, otherwise it is data.
+// Interrupts are disabled (rather than using a kernel critical section) because this is called from inside
+//   critical sections, from the scheduler and from interrupt handlers.  It also makes sure that the
+//   timestamps are in the same order as the records.
+static void vtTraceWrite(uint8_t event,uint16_t param,uint32_t data,uint8_t isData)
+{
+	uint32_t primask = __get_PRIMASK();
+	uint32_t word0, info;
+
+	__disable_irq();
+	if (recording) {
+		word0 = isData ? data : vtDWTCycCnt;
+		info = ((uint32_t) event) | (((uint32_t) currentTask) << 8) | (((uint32_t) param) << 16);
+		#if vtTraceOutput == vtTraceOutputRAM
+		if ((vtTraceStopWhenFull == 0) || (vtTraceRAM.count < vtTraceRAMRecords)) {
+			vtTraceRecord *rec = &(vtTraceRAM.records[vtTraceRAM.head]);
+			rec->timestamp = word0;
+			rec->info = info;
+			if (++vtTraceRAM.head >= vtTraceRAMRecords) {
+				vtTraceRAM.head = 0;
+			}
+			if (vtTraceRAM.count < vtTraceRAMRecords) {
+				vtTraceRAM.count++;
+			}
+		}
+		#elif vtTraceOutput == vtTraceOutputITM
+		vtITMu32(vtITMPortTrace,word0);
+		vtITMu32(vtITMPortTrace,info);
+		#else
+		Something is wrong
+		#endif
+	}
+	__set_PRIMASK(primask);
+}
+
+/* ************************************************ */
+// Public API Functions
+
+void vtTraceInit(void)
+{
+	// Start the cycle counter
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	vtDWTCycCnt = 0;
+	vtDWTCtrl |= vtDWTCtrlCycCntEna;
+
+	recording = 0;
+	memset(&vtTraceRAM,0,sizeof(vtTraceRAM));
+	vtTraceRAM.version = vtTraceVersion;
+	vtTraceRAM.recordSize = sizeof(vtTraceRecord);
+	vtTraceRAM.capacity = vtTraceRAMRecords;
+	vtTraceRAM.cpuHz = configCPU_CLOCK_HZ;
+	vtTraceRAM.maxTasks = vtTraceMaxTasks;
+	vtTraceRAM.nameLen = vtTraceNameLen;
+	vtTraceRAM.magic = vtTraceMagic;
+	currentTask = vtTraceNoTask;
+	recording = 1;
+
+	// Put the clock rate in the stream as well, for when the records are sent out of the ITM port
+	vtTraceWrite(vtTraceEvtStart,vtTraceVersion,0,0);
+	vtTraceWrite(vtTraceEvtCpuHz,0,configCPU_CLOCK_HZ,1);
+}
+
+void vtTraceStop(void)
+{
+	recording = 0;
+}
+
+void vtTraceResume(void)
+{
+	recording = 1;
+}
+
+void vtTraceEvent(uint8_t event,uint16_t param)
+{
+	vtTraceWrite(event,param,0,0);
+}
+
+void vtTraceTaskSwitchedIn(uint8_t taskNum)
+{
+	// The scheduler calls this each time it runs, even if it picks the same task again, so only
+	//   record real switches
+	if (taskNum != currentTask) {
+		currentTask = taskNum;
+		vtTraceWrite(vtTraceEvtTaskSwitchedIn,taskNum,0,0);
+	}
+}
+
+void vtTraceTaskCreate(uint8_t taskNum,const signed char *name)
+{
+	uint8_t chunk;
+	uint8_t i;
+	uint32_t chars;
+	uint8_t done = 0;
+
+	// Keep the name in the table that goes with the RAM ring, as the name records may be overwritten
+	if (taskNum < vtTraceMaxTasks) {
+		strncpy(vtTraceRAM.names[taskNum],(const char *) name,vtTraceNameLen - 1);
+	}
+	vtTraceWrite(vtTraceEvtTaskCreate,taskNum,0,0);
+
+	// Then send the name four characters at a time, up to and including the terminating zero
+	for (chunk = 0; (chunk < (configMAX_TASK_NAME_LEN + 3) / 4) && (!done); chunk++) {
+		chars = 0;
+		for (i = 0; i < 4; i++) {
+			uint8_t c = 0;
+			if ((!done) && ((chunk * 4) + i < configMAX_TASK_NAME_LEN)) {
+				c = (uint8_t) name[(chunk * 4) + i];
+			}
+			if (c == 0) {
+				done = 1;
+			}
+			chars |= ((uint32_t) c) << (i * 8);
+		}
+		vtTraceWrite(vtTraceEvtTaskName,(uint16_t) ((((uint16_t) taskNum) << 8) | chunk),chars,1);
+	}
+}
+// End of public API Functions
+/* ************************************************ */
+
+#endif
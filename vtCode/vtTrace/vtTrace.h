@@ -0,0 +1,157 @@
+#ifndef __vtTraceh
+#define __vtTraceh
+/* ************************************************************
+   Kernel trace recorder
+   ************************************************************ */
+// The recorder hooks into the trace macros that FreeRTOS calls at each kernel event (task switch,
+//   queue send/receive, timer expiry, ...) and writes a small binary record for each one.  Each record
+//   is timestamped with the DWT cycle counter, so it is accurate to a single CPU clock.
+// The records either go into a RAM ring (read out later with the debugger, without stopping the
+//   target) or are streamed out of the ITM port vtITMPortTrace (see vtUtilities.h) over SWO.
+// The host side decoder in vtCode/vtTrace/host turns the records into a timeline and per-task
+//   latency histograms.
+//
+// To use it:
+//   1) Set configUSE_TRACE_RECORDER to 1 in FreeRTOSConfig.h (which then includes this file)
+//   2) Call vtTraceInit() in main() before any tasks or queues are created
+//   3) Optionally call traceISR_ENTER(id)/traceISR_EXIT(id) in your interrupt handlers
+//
+// This file is included by FreeRTOSConfig.h, and so by every kernel source file, so it must
+//   only contain definitions that are safe everywhere.
+
+#include <stdint.h>
+
+// Where the records are written -- pick one
+#define vtTraceOutputRAM 1
+#define vtTraceOutputITM 2
+#define vtTraceOutput vtTraceOutputRAM
+
+// Number of records in the RAM ring (each record is 8 bytes)
+#define vtTraceRAMRecords 1024
+// If 1, recording stops when the RAM ring is full (keeps the start of a run); if 0, the oldest
+//   records are overwritten (keeps the most recent history)
+#define vtTraceStopWhenFull 0
+// If 1, every tick interrupt is recorded.  This is useful to line up a trace with the tick count,
+//   but at 1KHz it fills the RAM ring quickly
+#define vtTraceRecordTicks 0
+
+// Size of the task name table kept with the RAM ring (the names are also sent as records)
+#define vtTraceMaxTasks 32
+#define vtTraceNameLen 16
+
+// Record format -- the decoder depends on these so only ever add to them
+//   word 0: DWT cycle count when the event happened (or data, for the information records)
+//   word 1: bits 0-7 event code, bits 8-15 number of the running task, bits 16-31 event parameter
+typedef struct __vtTraceRecord {
+	uint32_t timestamp;
+	uint32_t info;
+} vtTraceRecord;
+
+#define vtTraceVersion 1
+#define vtTraceMagic 0x52547476UL	// "vtTR" in memory
+
+// Information records (word 0 holds data rather than a timestamp)
+#define vtTraceEvtStart				0x01	// param: vtTraceVersion, word 0: cycle count at start
+#define vtTraceEvtCpuHz				0x02	// word 0: CPU clock in Hz
+#define vtTraceEvtTaskName			0x03	// param: (task number << 8) | chunk, word 0: four characters of the name
+// Task events (param: task number the event applies to)
+#define vtTraceEvtTaskCreate		0x10
+#define vtTraceEvtTaskDelete		0x11
+#define vtTraceEvtTaskSwitchedIn	0x12
+#define vtTraceEvtTaskReady			0x13
+#define vtTraceEvtTaskDelay			0x14	// param: none
+#define vtTraceEvtTaskDelayUntil	0x15	// param: none
+#define vtTraceEvtTick				0x16	// param: low 16 bits of the tick count
+// Queue events (param: low 16 bits of the queue address)
+#define vtTraceEvtQueueSend			0x20
+#define vtTraceEvtQueueSendFailed	0x21
+#define vtTraceEvtQueueReceive		0x22
+#define vtTraceEvtQueueReceiveFailed 0x23
+#define vtTraceEvtQueuePeek			0x24
+#define vtTraceEvtQueueSendFromISR	0x25
+#define vtTraceEvtQueueReceiveFromISR 0x26
+#define vtTraceEvtQueueBlockSend	0x27
+#define vtTraceEvtQueueBlockReceive	0x28
+// Interrupt events (param: interrupt id, one of the vtTraceIsr values below)
+#define vtTraceEvtIsrEnter			0x30
+#define vtTraceEvtIsrExit			0x31
+// Timer events (param: low 16 bits of the timer address)
+#define vtTraceEvtTimerExpired		0x40
+#define vtTraceEvtTimerCallbackDone	0x41
+
+// Here is where you should define an id for each interrupt handler that is traced
+#define vtTraceIsrI2C0 1
+#define vtTraceIsrI2C1 2
+#define vtTraceIsrI2C2 3
+#define vtTraceIsrEMAC 4
+// #define vtTraceIsr??? 255
+// End of list of interrupt ids
+
+// Layout of the RAM ring.  The decoder reads a dump of this structure, so the header fields
+//   describe everything it needs to know.
+typedef struct __vtTraceBuffer {
+	uint32_t magic;				// vtTraceMagic
+	uint16_t version;			// vtTraceVersion
+	uint16_t recordSize;		// sizeof(vtTraceRecord)
+	uint32_t capacity;			// vtTraceRAMRecords
+	volatile uint32_t head;		// index of the next record to be written
+	volatile uint32_t count;	// number of valid records
+	uint32_t cpuHz;				// clock rate of the timestamps
+	uint16_t maxTasks;			// vtTraceMaxTasks
+	uint16_t nameLen;			// vtTraceNameLen
+	char names[vtTraceMaxTasks][vtTraceNameLen];
+	vtTraceRecord records[vtTraceRAMRecords];
+} vtTraceBuffer;
+
+/* ********************************************************************* */
+// Public API
+
+// Enables the DWT cycle counter and (re)starts the recording
+// Must be called before any tasks or queues are created so that the task names are captured
+void vtTraceInit(void);
+
+// Stops and restarts recording (for example, to freeze the RAM ring around an interesting event)
+void vtTraceStop(void);
+void vtTraceResume(void);
+
+// Functions called by the trace macros below -- not for direct use
+void vtTraceEvent(uint8_t event,uint16_t param);
+void vtTraceTaskSwitchedIn(uint8_t taskNum);
+void vtTraceTaskCreate(uint8_t taskNum,const signed char *name);
+
+// Object ids are the low bits of the object address, which is enough to tell objects apart
+#define vtTraceObjectId(obj) ((uint16_t) ((uintptr_t) (obj)))
+
+/* ********************************************************************* */
+// Mapping of the FreeRTOS trace macros onto the recorder
+// The task macros are only expanded in tasks.c, where the TCB is visible
+#define traceTASK_SWITCHED_IN() vtTraceTaskSwitchedIn((uint8_t) pxCurrentTCB->uxTCBNumber)
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) vtTraceEvent(vtTraceEvtTaskReady,(uint16_t) (pxTCB)->uxTCBNumber)
+#define traceTASK_CREATE(pxNewTCB) vtTraceTaskCreate((uint8_t) (pxNewTCB)->uxTCBNumber,(pxNewTCB)->pcTaskName)
+#define traceTASK_DELETE(pxTaskToDelete) vtTraceEvent(vtTraceEvtTaskDelete,(uint16_t) (pxTaskToDelete)->uxTCBNumber)
+#define traceTASK_DELAY() vtTraceEvent(vtTraceEvtTaskDelay,0)
+#define traceTASK_DELAY_UNTIL() vtTraceEvent(vtTraceEvtTaskDelayUntil,0)
+#if vtTraceRecordTicks == 1
+#define traceTASK_INCREMENT_TICK(xTickCount) vtTraceEvent(vtTraceEvtTick,(uint16_t) (xTickCount))
+#endif
+
+#define traceQUEUE_SEND(pxQueue) vtTraceEvent(vtTraceEvtQueueSend,vtTraceObjectId(pxQueue))
+#define traceQUEUE_SEND_FAILED(pxQueue) vtTraceEvent(vtTraceEvtQueueSendFailed,vtTraceObjectId(pxQueue))
+#define traceQUEUE_RECEIVE(pxQueue) vtTraceEvent(vtTraceEvtQueueReceive,vtTraceObjectId(pxQueue))
+#define traceQUEUE_RECEIVE_FAILED(pxQueue) vtTraceEvent(vtTraceEvtQueueReceiveFailed,vtTraceObjectId(pxQueue))
+#define traceQUEUE_PEEK(pxQueue) vtTraceEvent(vtTraceEvtQueuePeek,vtTraceObjectId(pxQueue))
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) vtTraceEvent(vtTraceEvtQueueSendFromISR,vtTraceObjectId(pxQueue))
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) vtTraceEvent(vtTraceEvtQueueReceiveFromISR,vtTraceObjectId(pxQueue))
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) vtTraceEvent(vtTraceEvtQueueBlockSend,vtTraceObjectId(pxQueue))
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) vtTraceEvent(vtTraceEvtQueueBlockReceive,vtTraceObjectId(pxQueue))
+
+#define traceISR_ENTER(ucIsrId) vtTraceEvent(vtTraceEvtIsrEnter,(ucIsrId))
+#define traceISR_EXIT(ucIsrId) vtTraceEvent(vtTraceEvtIsrExit,(ucIsrId))
+
+#define traceTIMER_EXPIRED(pxTimer) vtTraceEvent(vtTraceEvtTimerExpired,vtTraceObjectId(pxTimer))
+#define traceTIMER_CALLBACK_RETURN(pxTimer) vtTraceEvent(vtTraceEvtTimerCallbackDone,vtTraceObjectId(pxTimer))
+
+/* ************************************************************
+   End of kernel trace recorder
+   ************************************************************ */
+#endif
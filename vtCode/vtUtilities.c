@@ -394,4 +394,8 @@ int snprintf( char *buf, unsigned int count, const char *format, ... )
 #include "heap_3.c"
 #elif MALLOC_VERSION==2
 #include "heap_2.c"
+#elif MALLOC_VERSION==3
+#include "heap_4.c"
+#elif MALLOC_VERSION==4
+#include "heap_5.c"
 #endif
\ No newline at end of file
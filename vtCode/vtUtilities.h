@@ -23,6 +23,7 @@
 #define vtITMPortTempVals 5
 #define vtITMPortI2C1IntHandler 6
 #define vtITMPortLCDMsg 7 
+#define vtITMPortTrace 8	// kernel trace records from vtTrace.c (when vtTraceOutput is vtTraceOutputITM)
 // #define vtITMPort??? 31
 // End of list of port definitions
 
@@ -93,6 +94,12 @@ Something is wrong
 //   the size of the heap used by FreeRTOS is defined in freertosconfig.h
 // If you are using this option *and* your code (or a routine it calls) makes a call to malloc(), then my
 //   code in syscalls.c will catch this and bring execution to a halt to let you know what happened.
+#elif MALLOC_VERSION==3
+// same as 2, but FreeRTOS uses the fixed block pool allocator (heap_4.c) so allocation time is bounded
+//   and the heap cannot fragment.  The pool sizes are set by configHEAP_POOL_BLOCK_SIZES/COUNTS in freertosconfig.h
+#elif MALLOC_VERSION==4
+// same as 2, but FreeRTOS uses the coalescing allocator (heap_5.c), which merges neighbouring free blocks
+//   and reports fragmentation through vPortGetHeapStats()
 #else
 Something is not right
 #endif